@@ -81,6 +81,10 @@ class DiscretizationCMakeWriter(CMakeFileWriter):
                 local_fh.write('TARGET_SOURCES(%s PUBLIC ${%s})\n' % (self.project_name, 'SRCS'))
 
             fh.write('SET_TARGET_PROPERTIES({0} PROPERTIES LINKER_LANGUAGE CXX)\n'.format(self.project_name))
+
+            if self.configuration["zlib"]["USE_ZLIB"]:
+                fh.write('TARGET_LINK_LIBRARIES({0} z)\n'.format(self.project_name))
+
             fh.write('INSTALL(TARGETS %s DESTINATION ${CMAKE_INSTALL_PREFIX})\n' % self.project_name)
             fh.write('MESSAGE(STATUS "Installation destination at: ${CMAKE_INSTALL_PREFIX}")\n')
 
@@ -118,6 +122,9 @@ class DiscretizationCMakeWriter(CMakeFileWriter):
         if self.configuration["opencv"]["USE_OPEN_CV"]:
             fh.write('SET(USE_OPEN_CV {0})\n'.format(self.configuration["opencv"]["USE_OPEN_CV"]))
 
+        if self.configuration["zlib"]["USE_ZLIB"]:
+            fh.write('SET(USE_ZLIB {0})\n'.format(self.configuration["zlib"]["USE_ZLIB"]))
+
         current_dir = Path(os.getcwd())
         fh.write('SET(DATA_SET_FOLDER {0}/data)\n'.format(current_dir))
         fh.write('SET(TEST_DATA_DIR {0})\n'.format(current_dir / 'test_data'))
@@ -187,6 +194,9 @@ class DiscretizationCMakeWriter(CMakeFileWriter):
                 for lib in libs:
                     tfh.write('TARGET_LINK_LIBRARIES(${EXECUTABLE} %s)\n' % lib)
 
+            if self.configuration["zlib"]["USE_ZLIB"]:
+                tfh.write('TARGET_LINK_LIBRARIES(${EXECUTABLE} z)\n')
+
     def _write_multiple_cmakes(self, path: Path, example: bool):
 
         # get the test directories
@@ -109,6 +109,9 @@ class KernelCMakeWriter(CMakeFileWriter):
         if self.configuration["pytorch"]["USE_PYTORCH"]:
             fh.write('SET(USE_PYTORCH {0})\n'.format(self.configuration["pytorch"]["USE_PYTORCH"]))
 
+        if self.configuration["zlib"]["USE_ZLIB"]:
+            fh.write('SET(USE_ZLIB {0})\n'.format(self.configuration["zlib"]["USE_ZLIB"]))
+
         current_dir = Path(os.getcwd())
         fh.write('SET(DATA_SET_FOLDER {0}/data)\n'.format(current_dir))
         fh.write('SET(TEST_DATA_DIR {0})\n'.format(current_dir / 'test_data'))
@@ -0,0 +1,149 @@
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_hnsw_index.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_distance_kernels.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_control.h"
+#include "kernel/maths/lp_metric.h"
+#include "kernel/utilities/range_1d.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace example
+{
+
+using cengine::uint_t;
+using cengine::real_t;
+using cengine::DynMat;
+
+typedef std::vector<std::vector<std::pair<uint_t, real_t>>> neighbors_t;
+
+/// \brief Rows scattered around a few random centers
+/// so that the neighbors are not all at the same distance
+DynMat<real_t>
+clustered_rows(uint_t n_rows, uint_t n_columns, uint_t n_clusters, uint_t seed){
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<real_t> uniform(-1.0, 1.0);
+    std::normal_distribution<real_t> normal(0.0, 0.2);
+
+    // the same seed gives the same centers
+    std::mt19937 center_generator(42);
+    DynMat<real_t> centers(n_clusters, n_columns);
+    for(uint_t i=0; i<n_clusters; ++i){
+        for(uint_t j=0; j<n_columns; ++j){
+            centers(i, j) = uniform(center_generator);
+        }
+    }
+
+    DynMat<real_t> rows(n_rows, n_columns);
+    for(uint_t i=0; i<n_rows; ++i){
+
+        const uint_t cluster = generator() % n_clusters;
+        for(uint_t j=0; j<n_columns; ++j){
+            rows(i, j) = centers(cluster, j) + normal(generator);
+        }
+    }
+
+    return rows;
+}
+
+/// \brief The fraction of the exact neighbors that were found
+real_t
+recall(const neighbors_t& exact, const neighbors_t& approximate){
+
+    uint_t found = 0;
+    uint_t total = 0;
+
+    for(uint_t q=0; q<exact.size(); ++q){
+        for(const auto& neighbor : exact[q]){
+
+            ++total;
+            for(const auto& candidate : approximate[q]){
+                if(candidate.first == neighbor.first){
+                    ++found;
+                    break;
+                }
+            }
+        }
+    }
+
+    return static_cast<real_t>(found)/static_cast<real_t>(total);
+}
+
+}
+
+int main(int argc, char** argv){
+
+    using namespace example;
+
+    // usage: example_13 [n_rows] [n_columns] [n_queries] [k]
+    const uint_t n_rows = argc > 1 ? std::atoi(argv[1]) : 50000;
+    const uint_t n_columns = argc > 2 ? std::atoi(argv[2]) : 64;
+    const uint_t n_queries = argc > 3 ? std::atoi(argv[3]) : 1000;
+    const uint_t k = argc > 4 ? std::atoi(argv[4]) : 10;
+
+    try{
+
+        auto data = clustered_rows(n_rows, n_columns, 50, 1);
+        auto queries = clustered_rows(n_queries, n_columns, 50, 2);
+
+        std::cout<<"Rows: "<<n_rows<<" columns: "<<n_columns
+                 <<" queries: "<<n_queries<<" k: "<<k<<std::endl;
+
+        // the exact neighbors
+        kernel::EuclideanMetric sim;
+        cengine::KnnDistanceWorkspace workspace;
+        neighbors_t exact;
+
+        auto start = std::chrono::steady_clock::now();
+        cengine::knn_top_k(data, kernel::range1d<uint_t>(0, n_rows), queries, k, sim, exact, workspace);
+        auto end = std::chrono::steady_clock::now();
+
+        const real_t exact_time = std::chrono::duration<real_t>(end - start).count();
+        std::cout<<"Brute force QPS: "<<n_queries/exact_time<<std::endl;
+
+        cengine::HnswOptions options;
+
+        cengine::KnnHnswIndex<kernel::EuclideanMetric> index(options);
+
+        start = std::chrono::steady_clock::now();
+        index.build(data);
+        end = std::chrono::steady_clock::now();
+
+        std::cout<<"HNSW build time (s): "<<std::chrono::duration<real_t>(end - start).count()
+                 <<" levels: "<<index.max_level() + 1<<std::endl;
+
+        std::cout<<std::setw(12)<<"ef_search"<<std::setw(14)<<"recall@k"<<std::setw(14)<<"QPS"<<std::endl;
+
+        for(uint_t ef_search : {10, 20, 50, 100, 200, 400}){
+
+            index.set_ef_search(ef_search);
+            neighbors_t approximate;
+
+            start = std::chrono::steady_clock::now();
+            index.query(queries, k, approximate);
+            end = std::chrono::steady_clock::now();
+
+            const real_t time = std::chrono::duration<real_t>(end - start).count();
+
+            std::cout<<std::setw(12)<<ef_search
+                     <<std::setw(14)<<recall(exact, approximate)
+                     <<std::setw(14)<<n_queries/time<<std::endl;
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "cubic_engine/ml/datasets/csv_batch_reader.h"
+#include "kernel/base/kernel_consts.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+namespace cengine{
+namespace ml{
+
+CSVBatchReader::CSVBatchReader(const std::string& file_name, bool has_header,
+                               const std::vector<uint_t>& columns, const std::string& delimiter)
+    :
+      file_name_(file_name),
+      has_header_(has_header),
+      columns_(columns),
+      reader_(file_name, false, delimiter),
+      n_columns_(0),
+      n_rows_read_(0),
+      exhausted_(false),
+      row_()
+{
+    reset();
+}
+
+void
+CSVBatchReader::reset(){
+
+    // the reader does not report a failed open
+    if(!std::ifstream(file_name_).good()){
+        throw std::logic_error("Could not open file: "+file_name_);
+    }
+
+    reader_.close();
+    reader_.open();
+
+    if(has_header_){
+        reader_.read_line();
+    }
+
+    n_rows_read_ = 0;
+    exhausted_ = false;
+}
+
+bool
+CSVBatchReader::read_row_(){
+
+    while(!reader_.eof()){
+
+        auto line = reader_.read_line();
+
+        // skip the empty lines. The last line of
+        // a file is usually empty
+        if(line.empty() || (line.size() == 1 && line[0].empty())){
+            continue;
+        }
+
+        if(line.size() == 1 && line[0] == kernel::KernelConsts::eof_string()){
+            break;
+        }
+
+        if(columns_.empty()){
+
+            row_.resize(line.size());
+            for(uint_t c=0; c<line.size(); ++c){
+                row_[c] = std::atof(line[c].c_str());
+            }
+        }
+        else{
+
+            row_.resize(columns_.size());
+            for(uint_t c=0; c<columns_.size(); ++c){
+
+                if(columns_[c] >= line.size()){
+                    throw std::logic_error("Column: "+std::to_string(columns_[c])+
+                                           " not in [0, "+std::to_string(line.size())+")");
+                }
+
+                row_[c] = std::atof(line[columns_[c]].c_str());
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+uint_t
+CSVBatchReader::next_batch(DynMat<real_t>& batch, uint_t batch_size){
+
+    if(batch_size == 0){
+        throw std::logic_error("The batch size should be positive");
+    }
+
+    uint_t n_rows = 0;
+
+    while(!exhausted_ && n_rows < batch_size){
+
+        if(!read_row_()){
+            exhausted_ = true;
+            break;
+        }
+
+        if(n_columns_ == 0){
+            n_columns_ = row_.size();
+        }
+        else if(row_.size() != n_columns_){
+            throw std::logic_error("Row: "+std::to_string(n_rows_read_)+" has "+std::to_string(row_.size())+
+                                   " columns but "+std::to_string(n_columns_)+" columns were expected");
+        }
+
+        // the batch keeps its capacity between calls
+        if(batch.rows() != batch_size || batch.columns() != n_columns_){
+            batch.resize(batch_size, n_columns_, false);
+        }
+
+        for(uint_t c=0; c<n_columns_; ++c){
+            batch(n_rows, c) = row_[c];
+        }
+
+        ++n_rows;
+        ++n_rows_read_;
+    }
+
+    if(n_rows != batch.rows()){
+        batch.resize(n_rows, n_columns_, true);
+    }
+
+    return n_rows;
+}
+
+}
+}
@@ -0,0 +1,113 @@
+#ifndef CSV_BATCH_READER_H
+#define CSV_BATCH_READER_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "kernel/utilities/csv_file_reader.h"
+
+#include <string>
+#include <vector>
+
+namespace cengine {
+namespace ml {
+
+///
+/// \brief The CSVBatchReader class. Reads the rows of a CSV file
+/// in batches of bounded size so that a file that does not fit in memory
+/// can be consumed one batch at a time. Only the current batch is held
+/// in memory
+///
+class CSVBatchReader
+{
+public:
+
+    ///
+    /// \brief Constructor. If has_header is true the first line of the file
+    /// is skipped. If columns is empty every column of the file is read,
+    /// otherwise only the given columns are read in the given order
+    ///
+    CSVBatchReader(const std::string& file_name, bool has_header=true,
+                   const std::vector<uint_t>& columns=std::vector<uint_t>(),
+                   const std::string& delimiter=kernel::CSVFileReader::default_delimeter());
+
+    ///
+    /// \brief Read at most batch_size rows into the batch. Returns the number
+    /// of rows read which is zero when the file is exhausted. The batch is
+    /// resized to the rows read. Throws std::logic_error if a row has a
+    /// different number of columns than the first row read
+    ///
+    uint_t next_batch(DynMat<real_t>& batch, uint_t batch_size);
+
+    ///
+    /// \brief Rewind to the first row of the file
+    ///
+    void reset();
+
+    ///
+    /// \brief Returns true if all the rows of the file have been read
+    ///
+    bool exhausted()const{return exhausted_;}
+
+    ///
+    /// \brief The number of columns of a batch. It is zero
+    /// until the first row is read
+    ///
+    uint_t n_columns()const{return n_columns_;}
+
+    ///
+    /// \brief The number of rows read since the last reset
+    ///
+    uint_t n_rows_read()const{return n_rows_read_;}
+
+private:
+
+    ///
+    /// \brief The file to read
+    ///
+    const std::string file_name_;
+
+    ///
+    /// \brief Flag indicating if the file starts with a header
+    ///
+    const bool has_header_;
+
+    ///
+    /// \brief The columns to read
+    ///
+    const std::vector<uint_t> columns_;
+
+    ///
+    /// \brief The reader of the lines
+    ///
+    kernel::CSVFileReader reader_;
+
+    ///
+    /// \brief The number of columns of a batch
+    ///
+    uint_t n_columns_;
+
+    ///
+    /// \brief The number of rows read
+    ///
+    uint_t n_rows_read_;
+
+    ///
+    /// \brief Flag indicating that the file is exhausted
+    ///
+    bool exhausted_;
+
+    ///
+    /// \brief The values of the row being read
+    ///
+    std::vector<real_t> row_;
+
+    ///
+    /// \brief Read the next non empty row into row_.
+    /// Returns false at the end of the file
+    ///
+    bool read_row_();
+};
+
+}
+}
+
+#endif // CSV_BATCH_READER_H
@@ -3,6 +3,9 @@
 
 #include "cubic_engine/ml/instance_learning/utils/knn_control.h"
 #include "cubic_engine/ml/instance_learning/utils/knn_info.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_distance_kernels.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_spatial_index.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_hnsw_index.h"
 #include "kernel/utilities/range_1d.h"
 #include "kernel/maths/matrix_utilities.h"
 
@@ -33,10 +36,18 @@ public:
      Knn(const KnnControl& control);
 
 	 ///
-     /// \brief Train the model
+     /// \brief Train the model. When the control asks for an
+     /// index, the index is built over the dataset
 	 ///
      void train(const DataSetType& data_set, const LabelType& labels);
 
+	 ///
+     /// \brief Train on a dataset that grew since the last call to train or
+     /// update. With HNSW only the new rows are inserted in the graph, the
+     /// other indices are rebuilt
+	 ///
+     void update(const DataSetType& data_set, const LabelType& labels);
+
 	 ///
      /// \brief Predict outcome for the given vector
 	 ///
@@ -44,15 +55,58 @@ public:
      std::pair<return_t, output_t> predict(const DataPoint& data);
 
 	 ///
-     /// \brief Predict outcome for the given dataset
+     /// \brief Predict outcome for the given dataset. The distances of
+     /// a block of points from a block of data rows are computed at once
+     /// and only the k closest rows of every point are kept
 	 ///
      std::pair<std::vector<return_t>, output_t> predict(const DataSetType& data);
 
+     ///
+     /// \brief Set the block sizes used by predict for a dataset
+     ///
+     void set_block_options(const KnnBlockOptions& options){block_options_ = options;}
+
+     ///
+     /// \brief The index built by train
+     ///
+     const KnnSpatialIndex<DataSetType, Similarity>& get_index()const{return index_;}
+
+     ///
+     /// \brief The HNSW index built by train
+     ///
+     const KnnHnswIndex<Similarity>& get_hnsw_index()const{return hnsw_;}
+
+     ///
+     /// \brief Set the candidates the HNSW queries keep
+     ///
+     void set_hnsw_ef_search(uint_t ef_search){hnsw_.set_ef_search(ef_search);}
+
 private:
 
       const KnnControl input_;
       const DataSetType* data_ptr_;
       const LabelType* labels_ptr_;
+
+      /// \brief The block sizes of the distance computation
+      KnnBlockOptions block_options_;
+
+      /// \brief Buffers reused by the distance computation
+      KnnDistanceWorkspace workspace_;
+
+      /// \brief The k closest rows of every predicted point
+      std::vector<std::vector<std::pair<uint_t, real_t>>> neighbors_;
+
+      /// \brief The index over the dataset. Empty for brute force
+      KnnSpatialIndex<DataSetType, Similarity> index_;
+
+      /// \brief Buffers reused by the index queries
+      KnnIndexWorkspace index_workspace_;
+
+      /// \brief The approximate index. Empty unless HNSW is used
+      KnnHnswIndex<Similarity> hnsw_;
+
+      /// \brief Buffers reused by the HNSW queries
+      KnnHnswWorkspace hnsw_workspace_;
 };
 
 template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
@@ -60,7 +114,14 @@ Knn<DataSetType, LabelType, Similarity, Actor>::Knn(const KnnControl& control)
     :
    input_(control),
    data_ptr_(nullptr),
-   labels_ptr_(nullptr)
+   labels_ptr_(nullptr),
+   block_options_(),
+   workspace_(),
+   neighbors_(),
+   index_(),
+   index_workspace_(),
+   hnsw_(control.hnsw),
+   hnsw_workspace_()
 {}
 
 
@@ -69,6 +130,35 @@ void
 Knn<DataSetType, LabelType, Similarity, Actor>::train(const DataSetType& data_set, const LabelType& labels){
     data_ptr_ = &data_set;
     labels_ptr_ = &labels;
+
+    index_.clear();
+    hnsw_.clear();
+
+    if(input_.index == KnnIndexType::HNSW){
+        hnsw_.build(data_set);
+    }
+    else if(input_.index != KnnIndexType::BRUTE_FORCE){
+        index_.build(data_set, input_);
+    }
+}
+
+template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
+void
+Knn<DataSetType, LabelType, Similarity, Actor>::update(const DataSetType& data_set, const LabelType& labels){
+
+    if(input_.index != KnnIndexType::HNSW || hnsw_.empty()){
+        train(data_set, labels);
+        return;
+    }
+
+    if(data_set.rows() < hnsw_.n_points()){
+        throw std::logic_error("The dataset has "+std::to_string(data_set.rows())+
+                               " rows but "+std::to_string(hnsw_.n_points())+" are already indexed");
+    }
+
+    data_ptr_ = &data_set;
+    labels_ptr_ = &labels;
+    hnsw_.insert_rows(data_set, hnsw_.n_points());
 }
 
 template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
@@ -119,9 +209,26 @@ Knn<DataSetType, LabelType, Similarity, Actor>::predict(const DataVec& point){
     // the metric used for classification
     Similarity sim;
     
-    //find the k smallest distances of
-    //the given point from the given data set
-    actor(*this->data_ptr_, *this->labels_ptr_, point, sim, r);
+    if(!index_.empty()){
+
+        //the index finds the k smallest distances
+        std::vector<std::pair<uint_t, real_t>> neighbors;
+        index_.query(point, k, neighbors, index_workspace_);
+        actor.fillin_majority_vote(*this->labels_ptr_, std::move(neighbors));
+    }
+    else if(!hnsw_.empty()){
+
+        //the neighbors are approximate
+        std::vector<std::pair<uint_t, real_t>> neighbors;
+        hnsw_.query(point, k, neighbors, hnsw_workspace_);
+        actor.fillin_majority_vote(*this->labels_ptr_, std::move(neighbors));
+    }
+    else{
+
+        //find the k smallest distances of
+        //the given point from the given data set
+        actor(*this->data_ptr_, *this->labels_ptr_, point, sim, r);
+    }
     
     //get the result
     auto rslt = actor.get_result();
@@ -178,19 +285,28 @@ Knn<DataSetType, LabelType, Similarity, Actor>::predict(const DataSetType& data)
     std::vector<typename Knn<DataSetType, LabelType, Similarity, Actor>::return_t> result(data.rows());
 
     //find the k smallest distances of
-    //the given point from the given data set
-
-    for(uint row_idx=0; row_idx<data.rows(); ++row_idx){
+    //every point from the given data set
+    if(!index_.empty()){
+        index_.query(data, k, neighbors_);
+    }
+    else if(!hnsw_.empty()){
+        hnsw_.query(data, k, neighbors_);
+    }
+    else{
+        knn_top_k(*this->data_ptr_, range, data, k, sim, neighbors_, workspace_, block_options_);
+    }
 
-        auto point = kernel::get_row(data, row_idx);
+    for(uint_t row_idx=0; row_idx<data.rows(); ++row_idx){
 
-        actor(*this->data_ptr_, *this->labels_ptr_, point, sim, range);
+        // the neighbors are passed by reference so that
+        // the next predict reuses their storage
+        actor.fillin_majority_vote(*this->labels_ptr_, neighbors_[row_idx]);
 
         //get the result
-        auto rslt = actor.get_result();
-        result[row_idx] = rslt;
+        result[row_idx] = actor.get_result();
     }
 
+    info.n_pts_predicted = data.rows();
     end = std::chrono::system_clock::now();
     info.runtime = end-start;
     return std::make_pair(std::move(result), std::move(info));
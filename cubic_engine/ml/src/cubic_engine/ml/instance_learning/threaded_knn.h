@@ -4,6 +4,8 @@
 #include "cubic_engine/base/cubic_engine_types.h"
 #include "cubic_engine/ml/instance_learning/utils/knn_control.h"
 #include "cubic_engine/ml/instance_learning/utils/knn_info.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_spatial_index.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_hnsw_index.h"
 
 #include "kernel/utilities/range_1d.h"
 #include "kernel/maths/matrix_utilities.h"
@@ -38,15 +40,24 @@ public:
     /// \brief Constructor
     ThreadedKnn(const KnnControl& control);
 
-    /// \brief Train the model
+    /// \brief Train the model. When the control asks
+    /// for an index, the index is built serially
     void train(const DataSetType& data_set, const LabelType& labels);
 
+    /// \brief Train the model. When the control asks for a KD-tree
+    /// or a ball tree, the index is built with the executor. The HNSW
+    /// graph is built serially
+    template<typename Executor, typename Options>
+    void train(const DataSetType& data_set, const LabelType& labels,
+               Executor& executor, const Options& options);
+
     /// \brief Predict outcome for the given vector
     template<typename DataPoint, typename Executor, typename Options>
     std::pair<return_t, output_t> predict(const DataPoint& data,
                                           Executor& execute, const Options& option);
 
-    /// \brief Predict outcome for the given dataset
+    /// \brief Predict outcome for the given dataset. With an
+    /// index every processing element queries a block of rows
     template<typename Executor, typename Options>
     std::pair<std::vector<return_t>, output_t> predict(const DataSetType& data, Executor& execuotor, const Options& options);
 
@@ -62,6 +73,12 @@ private:
 
      /// \brief list of tasks
      std::vector<std::unique_ptr<kernel::SimpleTaskBase<typename Actor::return_t>>> tasks_;
+
+     /// \brief The index over the dataset. Empty for brute force
+     KnnSpatialIndex<DataSetType, Similarity> index_;
+
+     /// \brief The approximate index. Empty unless HNSW is used
+     KnnHnswIndex<Similarity> hnsw_;
        
 };
 
@@ -70,7 +87,10 @@ ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::ThreadedKnn(const KnnCon
     :
    input_(control),
    data_ptr_(nullptr),
-   labels_ptr_(nullptr)
+   labels_ptr_(nullptr),
+   tasks_(),
+   index_(),
+   hnsw_(control.hnsw)
 {}
 
 
@@ -79,6 +99,35 @@ void
 ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::train(const DataSetType& data_set, const LabelType& labels){
     data_ptr_ = &data_set;
     labels_ptr_ = &labels;
+
+    index_.clear();
+    hnsw_.clear();
+
+    if(input_.index == KnnIndexType::HNSW){
+        hnsw_.build(data_set);
+    }
+    else if(input_.index != KnnIndexType::BRUTE_FORCE){
+        index_.build(data_set, input_);
+    }
+}
+
+template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
+template<typename Executor, typename Options>
+void
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::train(const DataSetType& data_set, const LabelType& labels,
+                                                              Executor& executor, const Options& options){
+    data_ptr_ = &data_set;
+    labels_ptr_ = &labels;
+
+    index_.clear();
+    hnsw_.clear();
+
+    if(input_.index == KnnIndexType::HNSW){
+        hnsw_.build(data_set);
+    }
+    else if(input_.index != KnnIndexType::BRUTE_FORCE){
+        index_.build(data_set, input_, executor, options);
+    }
 }
 
 
@@ -147,7 +196,7 @@ template<typename DataPoint>
 ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task<DataPoint>::Task(uint_t id, uint_t k, const DataSetType& data,
                                                                               const LabelType& labels, const DataPoint& point)
  :
-kernel::SimpleTaskBase<Null>(id),
+kernel::SimpleTaskBase<typename Actor::return_t>(id),
 data_(&data),
 labels_(&labels),
 point_(&point),
@@ -225,6 +274,36 @@ ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::predict(const DataPoint&
     info.nprocs = 1;
     info.nthreads = executor.get_n_threads();
 
+    if(!index_.empty()){
+
+        // a single query is cheap with the
+        // index so it is done by this thread
+        KnnIndexWorkspace workspace;
+        std::vector<std::pair<uint_t, real_t>> neighbors;
+        index_.query(point, k, neighbors, workspace);
+
+        Actor actor(k);
+        actor.fillin_majority_vote(*labels_ptr_, std::move(neighbors));
+
+        end = std::chrono::system_clock::now();
+        info.runtime = end-start;
+        return {actor.get_result(), info};
+    }
+
+    if(!hnsw_.empty()){
+
+        KnnHnswWorkspace workspace;
+        std::vector<std::pair<uint_t, real_t>> neighbors;
+        hnsw_.query(point, k, neighbors, workspace);
+
+        Actor actor(k);
+        actor.fillin_majority_vote(*labels_ptr_, std::move(neighbors));
+
+        end = std::chrono::system_clock::now();
+        info.runtime = end-start;
+        return {actor.get_result(), info};
+    }
+
     typedef ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task<DataPoint> task_t;
 
     if(tasks_.empty()){
@@ -296,6 +375,31 @@ ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::predict(const DataSetTyp
     info.nprocs = 1;
     info.nthreads = executor.get_n_threads();
 
+    if(!index_.empty() || !hnsw_.empty()){
+
+        std::vector<std::vector<std::pair<uint_t, real_t>>> neighbors;
+
+        if(!index_.empty()){
+            index_.query(data, k, neighbors, executor, options);
+        }
+        else{
+            hnsw_.query(data, k, neighbors, executor, options);
+        }
+
+        Actor actor(k);
+        std::vector<typename ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::return_t> result(data.rows());
+
+        for(uint_t r=0; r<data.rows(); ++r){
+            actor.fillin_majority_vote(*labels_ptr_, std::move(neighbors[r]));
+            result[r] = actor.get_result();
+        }
+
+        info.n_pts_predicted = data.rows();
+        end = std::chrono::system_clock::now();
+        info.runtime = end-start;
+        return {std::move(result), info};
+    }
+
     typedef typename kernel::matrix_row_trait<DataSetType>::row_t row_t;
     typedef ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task<row_t> task_t;
 
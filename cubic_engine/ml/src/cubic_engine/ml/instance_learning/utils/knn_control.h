@@ -6,15 +6,57 @@
 namespace cengine
 {
 
+/// \brief The spatial index the KNN models build when trained.
+/// BRUTE_FORCE builds nothing and compares every point with every row.
+/// KD_TREE splits the rows on one coordinate at a time and suits low
+/// dimensional data. BALL_TREE bounds the rows of every node with a
+/// sphere and degrades less as the number of columns grows. AUTO uses
+/// a KD-tree up to KnnControl::kd_tree_max_dim columns and a ball tree above.
+/// HNSW builds a navigable small world graph that returns approximate
+/// neighbors and is never selected by AUTO
+enum class KnnIndexType{BRUTE_FORCE, KD_TREE, BALL_TREE, AUTO, HNSW};
+
+/// \brief The parameters of the HNSW index. Larger
+/// values trade speed for recall
+struct HnswOptions
+{
+    /// \brief The number of links of a point on every
+    /// level but the lowest one that has 2m links
+    uint_t m{16};
+
+    /// \brief The candidates kept while a point is inserted
+    uint_t ef_construction{200};
+
+    /// \brief The candidates kept while a query runs. It is
+    /// raised to the number of neighbors when smaller
+    uint_t ef_search{50};
+
+    /// \brief The seed of the generator of the point levels
+    uint_t seed{42};
+};
+
 struct KnnControl
 {
     /// \brief k: The number of neighbors to consider
     uint_t k;
 
+    /// \brief The spatial index built by train
+    KnnIndexType index{KnnIndexType::BRUTE_FORCE};
+
+    /// \brief The maximum number of rows in a leaf of the index
+    uint_t leaf_size{32};
+
+    /// \brief The number of columns up to which AUTO uses a KD-tree
+    uint_t kd_tree_max_dim{16};
+
+    /// \brief The parameters used when index is HNSW
+    HnswOptions hnsw;
+
     /// \brief Constructor
-    KnnControl(uint_t k_)
+    KnnControl(uint_t k_, KnnIndexType index_=KnnIndexType::BRUTE_FORCE)
         :
-        k(k_)
+        k(k_),
+        index(index_)
     {}
 
 };
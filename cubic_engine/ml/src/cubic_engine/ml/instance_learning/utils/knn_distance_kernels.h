@@ -0,0 +1,280 @@
+#ifndef KNN_DISTANCE_KERNELS_H
+#define KNN_DISTANCE_KERNELS_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "kernel/maths/lp_metric.h"
+#include "kernel/utilities/range_1d.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace cengine
+{
+
+/// \brief Keeps the k (row index, distance) pairs with the smallest
+/// distances out of all the pairs pushed into it. The candidates are held
+/// in a max-heap of size k so a push costs at most O(log k) and the
+/// storage is reused when the object is reset for the next query
+class KnnTopK
+{
+public:
+
+    /// \brief The type of the pair used for storing row-distance values
+    typedef std::pair<uint_t, real_t> Pair;
+
+    /// \brief Constructor
+    explicit KnnTopK(uint_t k=0)
+        :
+        k_(k),
+        heap_()
+    {
+        heap_.reserve(k_);
+    }
+
+    /// \brief Remove the candidates and set the number of neighbors
+    void reset(uint_t k){k_ = k; heap_.clear(); heap_.reserve(k_);}
+
+    /// \brief The number of candidates kept
+    uint_t size()const{return heap_.size();}
+
+    /// \brief Returns true if k candidates are kept
+    bool full()const{return heap_.size() == k_;}
+
+    /// \brief The largest distance a new pair may have to be kept
+    real_t worst()const{return full() && k_ != 0 ? heap_.front().second : std::numeric_limits<real_t>::max();}
+
+    /// \brief Offer a candidate
+    void push(uint_t row, real_t distance){
+
+        if(heap_.size() < k_){
+            heap_.emplace_back(row, distance);
+            std::push_heap(heap_.begin(), heap_.end(), &KnnTopK::closer);
+        }
+        else if(k_ != 0 && closer(Pair(row, distance), heap_.front())){
+            std::pop_heap(heap_.begin(), heap_.end(), &KnnTopK::closer);
+            heap_.back() = Pair(row, distance);
+            std::push_heap(heap_.begin(), heap_.end(), &KnnTopK::closer);
+        }
+    }
+
+    /// \brief Copy the candidates sorted by increasing distance into
+    /// the given vector. Ties are ordered by the row index
+    void sorted(std::vector<Pair>& out)const{
+
+        out.assign(heap_.begin(), heap_.end());
+        std::sort(out.begin(), out.end(), &KnnTopK::closer);
+    }
+
+private:
+
+    /// \brief The order of the candidates
+    static bool closer(const Pair& p1, const Pair& p2){
+        return p1.second < p2.second || (p1.second == p2.second && p1.first < p2.first);
+    }
+
+    uint_t k_;
+    std::vector<Pair> heap_;
+};
+
+/// \brief Tells knn_top_k whether the similarity is the Euclidean distance
+/// so that the distances can be computed with a matrix product
+template<typename Similarity>
+struct knn_l2_trait
+{
+    static const bool is_l2 = false;
+    static const bool take_root = false;
+};
+
+template<bool TakeRoot>
+struct knn_l2_trait<kernel::LpMetric<2, TakeRoot>>
+{
+    static const bool is_l2 = true;
+    static const bool take_root = TakeRoot;
+};
+
+/// \brief The block sizes knn_top_k uses. A block of queries is
+/// compared against a block of data rows at a time
+struct KnnBlockOptions
+{
+    /// \brief How many queries form a block
+    uint_t query_block_size{64};
+
+    /// \brief How many data rows form a block
+    uint_t data_block_size{1024};
+};
+
+/// \brief Buffers that knn_top_k reuses between calls so that
+/// predicting many points does not allocate per query
+struct KnnDistanceWorkspace
+{
+    /// \brief The query block times data block products
+    DynMat<real_t> products;
+
+    /// \brief The squared norms of the data rows
+    DynVec<real_t> data_norms;
+
+    /// \brief The squared norms of the queries
+    DynVec<real_t> query_norms;
+
+    /// \brief Copies of the rows passed to a generic similarity
+    DynVec<real_t> data_row;
+    DynVec<real_t> query_row;
+
+    /// \brief The candidates of every query of a block
+    std::vector<KnnTopK> top_k;
+};
+
+namespace detail
+{
+
+/// \brief Squared Euclidean distances computed block by block as
+/// ||q||^2 + ||x||^2 - 2 q.x. The q.x terms of a whole block come
+/// from one matrix product
+template<bool TakeRoot, typename DataMat, typename QueryMat>
+void
+knn_top_k_l2(const DataMat& data, const kernel::range1d<uint_t>& range, const QueryMat& queries, uint_t k,
+             std::vector<std::vector<std::pair<uint_t, real_t>>>& neighbors, KnnDistanceWorkspace& workspace,
+             const KnnBlockOptions& options){
+
+    const uint_t n_queries = queries.rows();
+    const uint_t n_columns = data.columns();
+
+    workspace.data_norms.resize(range.size(), false);
+    for(uint_t r=range.begin(); r<range.end(); ++r){
+        workspace.data_norms[r - range.begin()] = blaze::sqrNorm(blaze::row(data, r));
+    }
+
+    workspace.query_norms.resize(n_queries, false);
+    for(uint_t q=0; q<n_queries; ++q){
+        workspace.query_norms[q] = blaze::sqrNorm(blaze::row(queries, q));
+    }
+
+    for(uint_t q_begin=0; q_begin<n_queries; q_begin += options.query_block_size){
+
+        const uint_t n_block_queries = std::min(options.query_block_size, n_queries - q_begin);
+        const auto query_block = blaze::submatrix(queries, q_begin, 0, n_block_queries, n_columns);
+
+        for(uint_t q=0; q<n_block_queries; ++q){
+            workspace.top_k[q].reset(k);
+        }
+
+        for(uint_t d_begin=range.begin(); d_begin<range.end(); d_begin += options.data_block_size){
+
+            const uint_t n_block_rows = std::min(options.data_block_size, range.end() - d_begin);
+            const auto data_block = blaze::submatrix(data, d_begin, 0, n_block_rows, n_columns);
+
+            // the products matrix keeps its capacity between blocks
+            workspace.products = query_block * blaze::trans(data_block);
+
+            for(uint_t q=0; q<n_block_queries; ++q){
+
+                const real_t query_norm = workspace.query_norms[q_begin + q];
+                auto& top_k = workspace.top_k[q];
+
+                for(uint_t r=0; r<n_block_rows; ++r){
+
+                    // rounding may make the distance of
+                    // almost identical points negative
+                    const real_t distance = std::max(query_norm + workspace.data_norms[d_begin - range.begin() + r]
+                                                     - 2.0*workspace.products(q, r), real_t(0));
+
+                    if(distance < top_k.worst()){
+                        top_k.push(d_begin + r, distance);
+                    }
+                }
+            }
+        }
+
+        for(uint_t q=0; q<n_block_queries; ++q){
+
+            auto& result = neighbors[q_begin + q];
+            workspace.top_k[q].sorted(result);
+
+            if(TakeRoot){
+                for(auto& pair : result){
+                    pair.second = std::sqrt(pair.second);
+                }
+            }
+        }
+    }
+}
+
+/// \brief Distances of any similarity computed row by row
+/// into buffers that are reused between rows
+template<typename Similarity, typename DataMat, typename QueryMat>
+void
+knn_top_k_generic(const DataMat& data, const kernel::range1d<uint_t>& range, const QueryMat& queries, uint_t k,
+                  const Similarity& sim, std::vector<std::vector<std::pair<uint_t, real_t>>>& neighbors,
+                  KnnDistanceWorkspace& workspace){
+
+    auto& top_k = workspace.top_k[0];
+
+    for(uint_t q=0; q<queries.rows(); ++q){
+
+        workspace.query_row = blaze::trans(blaze::row(queries, q));
+        top_k.reset(k);
+
+        for(uint_t r=range.begin(); r<range.end(); ++r){
+
+            workspace.data_row = blaze::trans(blaze::row(data, r));
+            top_k.push(r, sim(workspace.data_row, workspace.query_row));
+        }
+
+        top_k.sorted(neighbors[q]);
+    }
+}
+
+}
+
+/// \brief Find the k rows of data in the given range that are closest to
+/// every row of queries. On output neighbors[q] holds the (row index, distance)
+/// pairs of query q sorted by increasing distance. When there are fewer than
+/// k rows in the range all of them are returned. For the Euclidean metrics
+/// the distances are computed block by block with a matrix product, otherwise
+/// the similarity is evaluated for every pair. Only k candidates per query
+/// are kept at any time and the workspace buffers are reused between calls
+template<typename Similarity, typename DataMat, typename QueryMat>
+void
+knn_top_k(const DataMat& data, const kernel::range1d<uint_t>& range, const QueryMat& queries, uint_t k,
+          const Similarity& sim, std::vector<std::vector<std::pair<uint_t, real_t>>>& neighbors,
+          KnnDistanceWorkspace& workspace, const KnnBlockOptions& options=KnnBlockOptions()){
+
+    if(data.columns() != queries.columns()){
+        throw std::logic_error("Data columns: "+std::to_string(data.columns())+
+                               " do not match query columns: "+std::to_string(queries.columns()));
+    }
+
+    if(options.query_block_size == 0 || options.data_block_size == 0){
+        throw std::logic_error("The block sizes should be positive");
+    }
+
+    neighbors.resize(queries.rows());
+
+    const uint_t n_neighbors = std::min(k, range.size());
+
+    if(knn_l2_trait<Similarity>::is_l2){
+
+        if(workspace.top_k.size() < options.query_block_size){
+            workspace.top_k.resize(options.query_block_size);
+        }
+
+        detail::knn_top_k_l2<knn_l2_trait<Similarity>::take_root>(data, range, queries, n_neighbors,
+                                                                   neighbors, workspace, options);
+    }
+    else{
+
+        if(workspace.top_k.empty()){
+            workspace.top_k.resize(1);
+        }
+
+        detail::knn_top_k_generic(data, range, queries, n_neighbors, sim, neighbors, workspace);
+    }
+}
+
+}
+
+#endif // KNN_DISTANCE_KERNELS_H
@@ -0,0 +1,616 @@
+#ifndef KNN_HNSW_INDEX_H
+#define KNN_HNSW_INDEX_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_control.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_spatial_index.h"
+#include "kernel/utilities/range_1d.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace cengine
+{
+
+/// \brief Buffers a query of KnnHnswIndex uses. Every
+/// thread that queries the index needs its own workspace
+struct KnnHnswWorkspace
+{
+    /// \brief The query copied into contiguous memory
+    std::vector<real_t> query;
+
+    /// \brief visited[p] == visit_mark if point p was seen by the current search
+    std::vector<uint_t> visited;
+    uint_t visit_mark{0};
+
+    /// \brief The points left to expand, closest first
+    std::vector<std::pair<real_t, uint_t>> candidates;
+
+    /// \brief The closest points found, farthest first
+    std::vector<std::pair<real_t, uint_t>> results;
+
+    /// \brief Copies of the points passed to a similarity that is not an Lp metric
+    DynVec<real_t> lhs;
+    DynVec<real_t> rhs;
+};
+
+/// \brief Approximate nearest neighbor index based on hierarchical navigable
+/// small world graphs. Every point is linked to its closest points on the
+/// lowest level and on a random number of sparser levels above it. A query
+/// descends greedily from the top level and explores the lowest level keeping
+/// ef_search candidates. The neighbors returned are not guaranteed to be the
+/// exact ones; larger HnswOptions values give higher recall at a higher cost.
+/// Points can be inserted after the index is built. Queries can run in
+/// parallel with different workspaces but not while a point is inserted
+template<typename Similarity>
+class KnnHnswIndex
+{
+public:
+
+    /// \brief The type of the pair used for storing row-distance values
+    typedef std::pair<uint_t, real_t> Pair;
+
+    /// \brief Constructor. Throws std::logic_error
+    /// if m is smaller than two or ef_construction is zero
+    explicit KnnHnswIndex(const HnswOptions& options=HnswOptions());
+
+    /// \brief Remove all the points. The options are kept
+    void clear();
+
+    /// \brief Returns true if there are no points
+    bool empty()const{return levels_.empty();}
+
+    /// \brief The number of points inserted
+    uint_t n_points()const{return levels_.size();}
+
+    /// \brief The number of columns of the points
+    uint_t n_columns()const{return n_columns_;}
+
+    /// \brief The highest level of the graph
+    uint_t max_level()const{return max_level_;}
+
+    /// \brief The options of the index
+    const HnswOptions& get_options()const{return options_;}
+
+    /// \brief Change the number of candidates kept by
+    /// the queries. Throws std::logic_error if zero
+    void set_ef_search(uint_t ef_search);
+
+    /// \brief Remove all the points and insert the rows of the dataset
+    template<typename DataMat>
+    void build(const DataMat& data);
+
+    /// \brief Insert the rows [begin, data.rows()) of the dataset.
+    /// The i-th row inserted gets the index n_points() + i
+    template<typename DataMat>
+    void insert_rows(const DataMat& data, uint_t begin);
+
+    /// \brief Insert the point and return its index
+    template<typename DataPoint>
+    uint_t insert(const DataPoint& point);
+
+    /// \brief Find the k points closest to the point. On output neighbors holds
+    /// the (point index, distance) pairs sorted by increasing distance
+    template<typename DataPoint>
+    void query(const DataPoint& point, uint_t k, std::vector<Pair>& neighbors,
+               KnnHnswWorkspace& workspace)const;
+
+    /// \brief Find the k points closest to every row of queries
+    template<typename QueryMat>
+    void query(const QueryMat& queries, uint_t k, std::vector<std::vector<Pair>>& neighbors)const;
+
+    /// \brief Find the k points closest to every row of queries with the
+    /// executor. Every processing element handles a block of queries
+    template<typename QueryMat, typename Executor, typename Options>
+    void query(const QueryMat& queries, uint_t k, std::vector<std::vector<Pair>>& neighbors,
+               Executor& executor, const Options& options)const;
+
+private:
+
+    typedef knn_index_metric_trait<Similarity> metric_t;
+
+    /// \brief A point and its distance from the query
+    typedef std::pair<real_t, uint_t> Candidate;
+
+    HnswOptions options_;
+    uint_t n_columns_;
+
+    /// \brief The coordinates of the points one after the other
+    std::vector<real_t> points_;
+
+    /// \brief The top level of every point
+    std::vector<uint_t> levels_;
+
+    /// \brief links_[p][l] are the neighbors of point p on level l
+    std::vector<std::vector<std::vector<uint_t>>> links_;
+
+    /// \brief Where the searches start. It is on the top level
+    uint_t entry_point_;
+    uint_t max_level_;
+
+    /// \brief Generates the levels of the inserted points
+    std::mt19937 generator_;
+
+    /// \brief Buffers used by insert
+    KnnHnswWorkspace insert_workspace_;
+
+    /// \brief The similarity used when it is not an Lp metric
+    Similarity sim_;
+
+    /// \brief Insert the point already copied at the back of points_
+    void insert_last();
+
+    /// \brief The maximum number of links of a point on the level
+    uint_t max_links(uint_t level)const{return level == 0 ? 2*options_.m : options_.m;}
+
+    /// \brief The coordinates of the point
+    const real_t* point(uint_t p)const{return &points_[p*n_columns_];}
+
+    /// \brief The distance between two points. For the Lp metrics it is the sum
+    /// of the coordinate terms, i.e. without the root
+    real_t distance(const real_t* lhs, const real_t* rhs, KnnHnswWorkspace& workspace)const;
+
+    /// \brief Move from the entry point to the closest point on the level
+    void greedy_search(const real_t* x, uint_t& entry, real_t& entry_distance, uint_t level,
+                       KnnHnswWorkspace& workspace)const;
+
+    /// \brief Explore the level from the entry point keeping the ef closest
+    /// points found. On output workspace.results holds them sorted by distance
+    void search_level(const real_t* x, uint_t entry, real_t entry_distance, uint_t ef, uint_t level,
+                      KnnHnswWorkspace& workspace)const;
+
+    /// \brief Choose at most n_links of the candidates sorted by distance. A
+    /// candidate is kept if it is closer to the base point than to every point
+    /// kept so far, so the links spread in different directions
+    void select_links(const std::vector<Candidate>& candidates, uint_t n_links,
+                      std::vector<uint_t>& selected, KnnHnswWorkspace& workspace)const;
+
+    /// \brief Search the graph for the query copied in workspace.query
+    void search(uint_t k, std::vector<Pair>& neighbors, KnnHnswWorkspace& workspace)const;
+};
+
+template<typename Similarity>
+KnnHnswIndex<Similarity>::KnnHnswIndex(const HnswOptions& options)
+    :
+    options_(options),
+    n_columns_(0),
+    points_(),
+    levels_(),
+    links_(),
+    entry_point_(0),
+    max_level_(0),
+    generator_(options.seed),
+    insert_workspace_(),
+    sim_()
+{
+    if(options_.m < 2){
+        throw std::logic_error("The HNSW number of links should be at least 2");
+    }
+
+    if(options_.ef_construction == 0 || options_.ef_search == 0){
+        throw std::logic_error("The HNSW number of candidates should be positive");
+    }
+}
+
+template<typename Similarity>
+void
+KnnHnswIndex<Similarity>::clear(){
+
+    n_columns_ = 0;
+    points_.clear();
+    levels_.clear();
+    links_.clear();
+    entry_point_ = 0;
+    max_level_ = 0;
+    generator_.seed(options_.seed);
+}
+
+template<typename Similarity>
+void
+KnnHnswIndex<Similarity>::set_ef_search(uint_t ef_search){
+
+    if(ef_search == 0){
+        throw std::logic_error("The HNSW number of candidates should be positive");
+    }
+
+    options_.ef_search = ef_search;
+}
+
+template<typename Similarity>
+template<typename DataMat>
+void
+KnnHnswIndex<Similarity>::build(const DataMat& data){
+
+    clear();
+
+    if(data.rows() == 0 || data.columns() == 0){
+        throw std::logic_error("Cannot build a KNN index for an empty dataset");
+    }
+
+    insert_rows(data, 0);
+}
+
+template<typename Similarity>
+template<typename DataMat>
+void
+KnnHnswIndex<Similarity>::insert_rows(const DataMat& data, uint_t begin){
+
+    if(!empty() && data.columns() != n_columns_){
+        throw std::logic_error("Data columns: "+std::to_string(data.columns())+
+                               " do not match the index columns: "+std::to_string(n_columns_));
+    }
+
+    n_columns_ = data.columns();
+    points_.reserve(data.rows()*n_columns_);
+
+    for(uint_t r=begin; r<data.rows(); ++r){
+
+        for(uint_t c=0; c<n_columns_; ++c){
+            points_.push_back(data(r, c));
+        }
+
+        insert_last();
+    }
+}
+
+template<typename Similarity>
+template<typename DataPoint>
+uint_t
+KnnHnswIndex<Similarity>::insert(const DataPoint& point){
+
+    if(!empty() && point.size() != n_columns_){
+        throw std::logic_error("Point size: "+std::to_string(point.size())+
+                               " does not match the index columns: "+std::to_string(n_columns_));
+    }
+
+    n_columns_ = point.size();
+
+    for(uint_t c=0; c<n_columns_; ++c){
+        points_.push_back(point[c]);
+    }
+
+    insert_last();
+    return n_points() - 1;
+}
+
+template<typename Similarity>
+void
+KnnHnswIndex<Similarity>::insert_last(){
+
+    const uint_t id = levels_.size();
+
+    // the levels are geometrically distributed so that
+    // every level has about m times fewer points
+    std::uniform_real_distribution<real_t> uniform(0.0, 1.0);
+    const real_t level_scale = 1.0/std::log(static_cast<real_t>(options_.m));
+    const uint_t level = static_cast<uint_t>(-std::log(1.0 - uniform(generator_))*level_scale);
+
+    levels_.push_back(level);
+    links_.emplace_back(level + 1);
+
+    if(id == 0){
+        entry_point_ = 0;
+        max_level_ = level;
+        return;
+    }
+
+    auto& workspace = insert_workspace_;
+    const real_t* x = point(id);
+
+    uint_t entry = entry_point_;
+    real_t entry_distance = distance(x, point(entry), workspace);
+
+    for(uint_t l=max_level_; l>level; --l){
+        greedy_search(x, entry, entry_distance, l, workspace);
+    }
+
+    std::vector<Candidate> candidates;
+    std::vector<uint_t> selected;
+
+    for(uint_t l=std::min(level, max_level_) + 1; l-- > 0; ){
+
+        search_level(x, entry, entry_distance, options_.ef_construction, l, workspace);
+        candidates = workspace.results;
+
+        select_links(candidates, options_.m, selected, workspace);
+        links_[id][l] = selected;
+
+        for(uint_t neighbor : selected){
+
+            auto& neighbor_links = links_[neighbor][l];
+            neighbor_links.push_back(id);
+
+            if(neighbor_links.size() > max_links(l)){
+
+                // keep the best spread links of the neighbor
+                std::vector<Candidate> neighbor_candidates;
+                neighbor_candidates.reserve(neighbor_links.size());
+
+                for(uint_t link : neighbor_links){
+                    neighbor_candidates.push_back(std::make_pair(distance(point(neighbor), point(link), workspace), link));
+                }
+
+                std::sort(neighbor_candidates.begin(), neighbor_candidates.end());
+                select_links(neighbor_candidates, max_links(l), neighbor_links, workspace);
+            }
+        }
+
+        // the next level starts from the closest point found
+        entry = candidates.front().second;
+        entry_distance = candidates.front().first;
+    }
+
+    if(level > max_level_){
+        entry_point_ = id;
+        max_level_ = level;
+    }
+}
+
+template<typename Similarity>
+real_t
+KnnHnswIndex<Similarity>::distance(const real_t* lhs, const real_t* rhs, KnnHnswWorkspace& workspace)const{
+
+    if(metric_t::is_supported){
+
+        real_t reduced = 0.0;
+        for(uint_t c=0; c<n_columns_; ++c){
+            reduced += metric_t::term(lhs[c] - rhs[c]);
+        }
+
+        return reduced;
+    }
+
+    workspace.lhs.resize(n_columns_);
+    workspace.rhs.resize(n_columns_);
+
+    for(uint_t c=0; c<n_columns_; ++c){
+        workspace.lhs[c] = lhs[c];
+        workspace.rhs[c] = rhs[c];
+    }
+
+    return sim_(workspace.lhs, workspace.rhs);
+}
+
+template<typename Similarity>
+void
+KnnHnswIndex<Similarity>::greedy_search(const real_t* x, uint_t& entry, real_t& entry_distance, uint_t level,
+                                        KnnHnswWorkspace& workspace)const{
+
+    bool changed = true;
+
+    while(changed){
+
+        changed = false;
+
+        for(uint_t link : links_[entry][level]){
+
+            const real_t link_distance = distance(x, point(link), workspace);
+
+            if(link_distance < entry_distance){
+                entry = link;
+                entry_distance = link_distance;
+                changed = true;
+            }
+        }
+    }
+}
+
+template<typename Similarity>
+void
+KnnHnswIndex<Similarity>::search_level(const real_t* x, uint_t entry, real_t entry_distance, uint_t ef, uint_t level,
+                                       KnnHnswWorkspace& workspace)const{
+
+    if(workspace.visited.size() < n_points()){
+        workspace.visited.resize(n_points(), workspace.visit_mark);
+    }
+
+    ++workspace.visit_mark;
+
+    auto& candidates = workspace.candidates;
+    auto& results = workspace.results;
+
+    candidates.clear();
+    results.clear();
+
+    // candidates is a min-heap and results a max-heap on the distance
+    candidates.push_back(std::make_pair(entry_distance, entry));
+    results.push_back(std::make_pair(entry_distance, entry));
+    workspace.visited[entry] = workspace.visit_mark;
+
+    while(!candidates.empty()){
+
+        std::pop_heap(candidates.begin(), candidates.end(), std::greater<Candidate>());
+        const Candidate current = candidates.back();
+        candidates.pop_back();
+
+        if(current.first > results.front().first && results.size() >= ef){
+            break;
+        }
+
+        for(uint_t link : links_[current.second][level]){
+
+            if(workspace.visited[link] == workspace.visit_mark){
+                continue;
+            }
+
+            workspace.visited[link] = workspace.visit_mark;
+            const real_t link_distance = distance(x, point(link), workspace);
+
+            if(results.size() < ef || link_distance < results.front().first){
+
+                candidates.push_back(std::make_pair(link_distance, link));
+                std::push_heap(candidates.begin(), candidates.end(), std::greater<Candidate>());
+
+                results.push_back(std::make_pair(link_distance, link));
+                std::push_heap(results.begin(), results.end());
+
+                if(results.size() > ef){
+                    std::pop_heap(results.begin(), results.end());
+                    results.pop_back();
+                }
+            }
+        }
+    }
+
+    std::sort_heap(results.begin(), results.end());
+}
+
+template<typename Similarity>
+void
+KnnHnswIndex<Similarity>::select_links(const std::vector<Candidate>& candidates, uint_t n_links,
+                                       std::vector<uint_t>& selected, KnnHnswWorkspace& workspace)const{
+
+    // the candidates may alias the selected links
+    std::vector<uint_t> result;
+    result.reserve(n_links);
+
+    for(const auto& candidate : candidates){
+
+        if(result.size() >= n_links){
+            break;
+        }
+
+        bool keep = true;
+        for(uint_t kept : result){
+
+            if(distance(point(candidate.second), point(kept), workspace) < candidate.first){
+                keep = false;
+                break;
+            }
+        }
+
+        if(keep){
+            result.push_back(candidate.second);
+        }
+    }
+
+    selected = std::move(result);
+}
+
+template<typename Similarity>
+void
+KnnHnswIndex<Similarity>::search(uint_t k, std::vector<Pair>& neighbors, KnnHnswWorkspace& workspace)const{
+
+    if(empty()){
+        throw std::logic_error("The KNN index is not built");
+    }
+
+    const real_t* x = workspace.query.data();
+
+    uint_t entry = entry_point_;
+    real_t entry_distance = distance(x, point(entry), workspace);
+
+    for(uint_t l=max_level_; l>0; --l){
+        greedy_search(x, entry, entry_distance, l, workspace);
+    }
+
+    search_level(x, entry, entry_distance, std::max(options_.ef_search, k), 0, workspace);
+
+    const uint_t n_neighbors = std::min(k, static_cast<uint_t>(workspace.results.size()));
+    neighbors.resize(n_neighbors);
+
+    // equal distances are ordered by the point index
+    std::sort(workspace.results.begin(), workspace.results.end());
+
+    for(uint_t n=0; n<n_neighbors; ++n){
+
+        const auto& result = workspace.results[n];
+        neighbors[n] = std::make_pair(result.second, metric_t::to_distance(result.first));
+    }
+}
+
+template<typename Similarity>
+template<typename DataPoint>
+void
+KnnHnswIndex<Similarity>::query(const DataPoint& point, uint_t k, std::vector<Pair>& neighbors,
+                                KnnHnswWorkspace& workspace)const{
+
+    if(point.size() != n_columns_){
+        throw std::logic_error("Point size: "+std::to_string(point.size())+
+                               " does not match the index columns: "+std::to_string(n_columns_));
+    }
+
+    workspace.query.resize(n_columns_);
+    for(uint_t c=0; c<n_columns_; ++c){
+        workspace.query[c] = point[c];
+    }
+
+    search(k, neighbors, workspace);
+}
+
+template<typename Similarity>
+template<typename QueryMat>
+void
+KnnHnswIndex<Similarity>::query(const QueryMat& queries, uint_t k,
+                                std::vector<std::vector<Pair>>& neighbors)const{
+
+    if(queries.columns() != n_columns_){
+        throw std::logic_error("Query columns: "+std::to_string(queries.columns())+
+                               " do not match the index columns: "+std::to_string(n_columns_));
+    }
+
+    neighbors.resize(queries.rows());
+    KnnHnswWorkspace workspace;
+    workspace.query.resize(n_columns_);
+
+    for(uint_t q=0; q<queries.rows(); ++q){
+
+        for(uint_t c=0; c<n_columns_; ++c){
+            workspace.query[c] = queries(q, c);
+        }
+
+        search(k, neighbors[q], workspace);
+    }
+}
+
+template<typename Similarity>
+template<typename QueryMat, typename Executor, typename Options>
+void
+KnnHnswIndex<Similarity>::query(const QueryMat& queries, uint_t k,
+                                std::vector<std::vector<Pair>>& neighbors,
+                                Executor& executor, const Options& options)const{
+
+    if(queries.columns() != n_columns_){
+        throw std::logic_error("Query columns: "+std::to_string(queries.columns())+
+                               " do not match the index columns: "+std::to_string(n_columns_));
+    }
+
+    neighbors.resize(queries.rows());
+
+    if(queries.rows() == 0){
+        return;
+    }
+
+    const uint_t n_parts = std::min(std::max(executor.n_processing_elements(), static_cast<uint_t>(1)),
+                                    static_cast<uint_t>(queries.rows()));
+
+    std::vector<kernel::range1d<uint_t>> partitions;
+    kernel::partition_range(0, queries.rows(), partitions, n_parts);
+
+    auto query_block = [&](uint_t p){
+
+        KnnHnswWorkspace workspace;
+        workspace.query.resize(n_columns_);
+
+        for(uint_t q=partitions[p].begin(); q<partitions[p].end(); ++q){
+
+            for(uint_t c=0; c<n_columns_; ++c){
+                workspace.query[c] = queries(q, c);
+            }
+
+            search(k, neighbors[q], workspace);
+        }
+    };
+
+    detail::execute_knn_index_tasks(partitions.size(), query_block, executor, options);
+}
+
+}
+
+#endif // KNN_HNSW_INDEX_H
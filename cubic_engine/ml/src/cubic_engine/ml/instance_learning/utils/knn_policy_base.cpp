@@ -90,7 +90,8 @@ knn_policy_base_data_handler<false>::get_top_k_results(boost::scoped_array<knn_p
 template<bool is_regressor>
 knn_policy_base<is_regressor>::knn_policy_base(uint_t k)
 :
-data_handler_(k)
+data_handler_(k),
+top_k_(k)
 {}
 
 template<bool is_regressor>
@@ -3,6 +3,7 @@
 #define	KNN_POLICY_BASE_H
 
 #include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_distance_kernels.h"
 
 #include "kernel/utilities/range_1d.h"
 #include "kernel/utilities/map_utilities.h"
@@ -10,6 +11,7 @@
 #include "kernel/parallel/utilities/result_holder.h"
 
 
+#include <algorithm>
 #include <vector>
 #include <utility>
 #include <map>
@@ -100,7 +102,7 @@ template<typename DataVec>
 void 
 knn_policy_base_data_handler<true>::fillin_majority_vote(const DataVec& labels){
      
-    if( k <= k_distances.size()){
+    if(k < k_distances.size()){
         throw std::logic_error("Incompatible number of neighbors: "+
                                std::to_string(k)+
                                " and k_distances size: "+
@@ -109,8 +111,9 @@ knn_policy_base_data_handler<true>::fillin_majority_vote(const DataVec& labels){
 
 
     //we loop ove all the k-distances as we want
-    //the average
-    for(uint_t d=0; d<k; ++d){
+    //the average. There are fewer than k when the
+    //range has fewer than k rows
+    for(uint_t d=0; d<k_distances.size(); ++d){
         
         uint_t row_idx = k_distances[d].first;
         real_t value = labels[row_idx];
@@ -205,7 +208,7 @@ knn_policy_base_data_handler<false>::fillin_majority_vote(const DataVec& labels)
     
    typedef std::map<uint_t, uint_t>::iterator iterator;
     
-   for(uint_t i=0; i<k; ++i){
+   for(uint_t i=0; i<k_distances.size(); ++i){
         
        uint_t idx = k_distances[i].first;
        uint_t cls = labels[idx];
@@ -297,11 +300,20 @@ public:
      * any computed distances by the object and the majority vote map.
      * It is assumed that the distances vector is not too large
      * and hence this operation can be done serially. Moreover, the distances
-     * are assumed to be sorted
+     * are assumed to be sorted. This is how the results of knn_top_k
+     * are turned into a prediction
      */
     template<typename DataVec>
     void fillin_majority_vote(const DataVec& labels, 
                               std::vector<std::pair<uint_t,real_t> >&& distances);
+
+    /**
+     * @brief Same as above but the distances are copied so that the
+     * caller can reuse their storage for the next query
+     */
+    template<typename DataVec>
+    void fillin_majority_vote(const DataVec& labels,
+                              const std::vector<std::pair<uint_t,real_t> >& distances);
     
     
     /**
@@ -334,6 +346,11 @@ protected:
      * @brief The data handler
      */
     knn_policy_base_data_handler<is_regressor> data_handler_;
+
+    /**
+     * @brief The k closest rows seen by operator(). Reused between calls
+     */
+    KnnTopK top_k_;
     
 };
 
@@ -343,12 +360,9 @@ void
 knn_policy_base<is_regressor>::operator()(const DataMat& data,  const LabelType& labels, const DataVec& point,
                                           const Similarity& sim, const kernel::range1d<uint_t>& range){
     
-    typedef typename knn_policy_base<is_regressor>::Pair Pair;
-     
-    //we will calculating as many distances as
-    //the size of the range
-    std::vector<Pair> distances;
-    distances.reserve(range.size());
+    //only the k smallest distances are kept
+    //so there is no need to sort all of them
+    top_k_.reset(std::min(data_handler_.k, range.size()));
     
     for(uint_t r=range.begin(); r<range.end(); ++r){
         
@@ -359,27 +373,13 @@ knn_policy_base<is_regressor>::operator()(const DataMat& data,  const LabelType&
         //input point
         real_t dis = sim(data_point, point);
 
-        //compute the similarity and append it to distances
-        distances.push_back(std::make_pair(r,dis));  
+        //offer the distance to the candidates
+        top_k_.push(r, dis);
     }
     
-    //sort the computed pairs based on the distances
-    std::sort(distances.begin(),distances.end(),
-             [](const Pair& p1,const Pair& p2){return p1.second < p2.second;});
-    
-    {
-        //empty what has been already computed 
-        std::vector<Pair> empty;
-        data_handler_.k_distances.swap(empty);
-        data_handler_.majority_vote.clear();
-    }
-               
-    data_handler_.k_distances.reserve(data_handler_.k);
-    
-
-    for(uint_t i=0; i<data_handler_.k; ++i){
-       data_handler_.k_distances.push_back(distances[i]);
-    }   
+    //empty what has been already computed
+    data_handler_.majority_vote.clear();
+    top_k_.sorted(data_handler_.k_distances);
     
     //fill in the majority vote
     fillin_majority_vote(labels);
@@ -401,9 +401,22 @@ knn_policy_base<is_regressor>::fillin_majority_vote(const DataVec& labels,
     
     data_handler_.k_distances = std::move(distances);
     distances.clear();
+    data_handler_.majority_vote.clear();
     fillin_majority_vote(labels);   
 }
 
+template<bool is_regressor>
+template<typename DataVec>
+void
+knn_policy_base<is_regressor>::fillin_majority_vote(const DataVec& labels,
+                                                    const std::vector<std::pair<uint_t,real_t> >& distances){
+
+    //assign keeps the capacity of k_distances
+    data_handler_.k_distances.assign(distances.begin(), distances.end());
+    data_handler_.majority_vote.clear();
+    fillin_majority_vote(labels);
+}
+
     
 }
 
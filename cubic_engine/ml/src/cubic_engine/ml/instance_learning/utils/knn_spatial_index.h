@@ -0,0 +1,839 @@
+#ifndef KNN_SPATIAL_INDEX_H
+#define KNN_SPATIAL_INDEX_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_control.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_distance_kernels.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/maths/lp_metric.h"
+#include "kernel/utilities/range_1d.h"
+#include "kernel/parallel/threading/simple_task.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace cengine
+{
+
+/// \brief Tells KnnSpatialIndex how to compute the distances of a
+/// similarity. Only the Lp metrics can be indexed since the pruning
+/// relies on the distance being a sum of per coordinate terms
+template<typename Similarity>
+struct knn_index_metric_trait
+{
+    static const bool is_supported = false;
+    static const int power = 2;
+    static const bool take_root = false;
+
+    /// \brief The contribution of one coordinate difference to the distance
+    static real_t term(real_t diff){return diff*diff;}
+
+    /// \brief The distance the similarity returns for the sum of the terms
+    static real_t to_distance(real_t reduced){return reduced;}
+};
+
+template<int P, bool TakeRoot>
+struct knn_index_metric_trait<kernel::LpMetric<P, TakeRoot>>
+{
+    static const bool is_supported = P > 0;
+    static const int power = P;
+    static const bool take_root = TakeRoot;
+
+    /// \brief The contribution of one coordinate difference to the distance
+    static real_t term(real_t diff){
+
+        if(P == 1){
+            return std::fabs(diff);
+        }
+
+        if(P == 2){
+            return diff*diff;
+        }
+
+        return std::pow(std::fabs(diff), P);
+    }
+
+    /// \brief The distance the similarity returns for the sum of the terms
+    static real_t to_distance(real_t reduced){
+
+        if(!TakeRoot || P == 1){
+            return reduced;
+        }
+
+        return P == 2 ? std::sqrt(reduced) : std::pow(reduced, 1.0/P);
+    }
+};
+
+/// \brief Buffers a query of KnnSpatialIndex uses. Every
+/// thread that queries the index needs its own workspace
+struct KnnIndexWorkspace
+{
+    /// \brief The candidates of the query
+    KnnTopK top_k;
+
+    /// \brief The nodes left to visit with the lower
+    /// bound of their distance from the query
+    std::vector<std::pair<uint_t, real_t>> stack;
+};
+
+namespace detail
+{
+
+/// \brief Task that applies an operation on the part
+/// of the index work identified by the task id
+template<typename OpTp>
+class KnnIndexTask: public kernel::SimpleTaskBase<Null>
+{
+public:
+
+    /// \brief Constructor
+    KnnIndexTask(uint_t id, const OpTp& op)
+        :
+        kernel::SimpleTaskBase<Null>(id),
+        op_(op)
+    {}
+
+protected:
+
+    /// \brief Apply the operation
+    virtual void run()override{op_(this->get_id());}
+
+private:
+
+    const OpTp& op_;
+};
+
+/// \brief Execute op(0), ..., op(n_tasks - 1) with the executor.
+/// Throws std::logic_error if a task did not finish
+template<typename OpTp, typename Executor, typename Options>
+void
+execute_knn_index_tasks(uint_t n_tasks, const OpTp& op, Executor& executor, const Options& options){
+
+    std::vector<std::unique_ptr<KnnIndexTask<OpTp>>> tasks;
+    tasks.reserve(n_tasks);
+
+    for(uint_t t=0; t<n_tasks; ++t){
+        tasks.push_back(std::make_unique<KnnIndexTask<OpTp>>(t, op));
+    }
+
+    // this will block
+    executor.execute(tasks, options);
+
+    for(const auto& task : tasks){
+
+        if(task->get_state() != kernel::TaskBase::TaskState::FINISHED){
+            throw std::logic_error("A KNN index task did not finish");
+        }
+    }
+}
+
+}
+
+/// \brief KD-tree or ball tree over the rows of a dataset. The tree is
+/// built once and answers k nearest neighbor queries by visiting the
+/// nodes closest to the query first and skipping every node that cannot
+/// hold a row closer than the current k-th candidate. The rows are copied
+/// in tree order so that a leaf is scanned from contiguous memory.
+/// The neighbors and distances are the ones the brute force search
+/// returns for the same Similarity, ties included
+template<typename DataSetType, typename Similarity>
+class KnnSpatialIndex
+{
+public:
+
+    /// \brief The type of the pair used for storing row-distance values
+    typedef std::pair<uint_t, real_t> Pair;
+
+    /// \brief Constructor
+    KnnSpatialIndex();
+
+    /// \brief Build the index requested by the control over
+    /// the rows of the dataset. Throws std::logic_error if the control
+    /// asks for BRUTE_FORCE or HNSW, the Similarity cannot be indexed
+    /// or the dataset is empty
+    void build(const DataSetType& data, const KnnControl& control);
+
+    /// \brief Build the index with the executor. The top levels of the
+    /// tree are built serially until there is a subtree for every
+    /// processing element and the subtrees are built in parallel
+    template<typename Executor, typename Options>
+    void build(const DataSetType& data, const KnnControl& control,
+               Executor& executor, const Options& options);
+
+    /// \brief Remove the index
+    void clear();
+
+    /// \brief Returns true if no index is built
+    bool empty()const{return nodes_.empty();}
+
+    /// \brief The type of the index built. It is never AUTO
+    KnnIndexType type()const{return type_;}
+
+    /// \brief The number of nodes of the tree
+    uint_t n_nodes()const{return nodes_.size();}
+
+    /// \brief The number of rows indexed
+    uint_t n_rows()const{return rows_.size();}
+
+    /// \brief The number of columns of the rows indexed
+    uint_t n_columns()const{return n_columns_;}
+
+    /// \brief Find the k rows closest to the point. On output neighbors holds
+    /// the (row index, distance) pairs sorted by increasing distance
+    template<typename DataPoint>
+    void query(const DataPoint& point, uint_t k, std::vector<Pair>& neighbors,
+               KnnIndexWorkspace& workspace)const;
+
+    /// \brief Find the k rows closest to every row of queries
+    template<typename QueryMat>
+    void query(const QueryMat& queries, uint_t k, std::vector<std::vector<Pair>>& neighbors)const;
+
+    /// \brief Find the k rows closest to every row of queries with the
+    /// executor. Every processing element handles a block of queries
+    template<typename QueryMat, typename Executor, typename Options>
+    void query(const QueryMat& queries, uint_t k, std::vector<std::vector<Pair>>& neighbors,
+               Executor& executor, const Options& options)const;
+
+private:
+
+    typedef knn_index_metric_trait<Similarity> metric_t;
+
+    /// \brief A node of the tree holds the rows [begin, end)
+    /// of rows_. A leaf has no children
+    struct Node
+    {
+        uint_t begin;
+        uint_t end;
+        uint_t left;
+        uint_t right;
+
+        /// \brief The radius of the ball of a ball tree node
+        real_t radius;
+
+        bool is_leaf()const{return left == kernel::KernelConsts::invalid_size_type();}
+    };
+
+    /// \brief The nodes of a tree together with the bounding boxes of a KD-tree
+    /// (lower and upper corner per node) or the centers of a ball tree
+    struct Tree
+    {
+        std::vector<Node> nodes;
+        std::vector<real_t> bounds;
+    };
+
+    /// \brief A subtree the serial part of a parallel
+    /// build left for a task to build
+    struct PendingSubtree
+    {
+        uint_t node;
+        uint_t begin;
+        uint_t end;
+    };
+
+    KnnIndexType type_;
+    uint_t n_columns_;
+    uint_t leaf_size_;
+
+    /// \brief The nodes of the tree. The root is the first node
+    std::vector<Node> nodes_;
+
+    /// \brief The KD-tree boxes or ball tree centers of the nodes
+    std::vector<real_t> bounds_;
+
+    /// \brief The row indices in tree order
+    std::vector<uint_t> rows_;
+
+    /// \brief The rows of the dataset in tree order
+    std::vector<real_t> points_;
+
+    /// \brief Check the input and set up the rows
+    /// before the tree is built
+    void prepare(const DataSetType& data, const KnnControl& control);
+
+    /// \brief Copy the rows in tree order
+    void finish(const DataSetType& data);
+
+    /// \brief Add a node for the rows [begin, end) to the tree
+    uint_t make_node(const DataSetType& data, uint_t begin, uint_t end, Tree& tree)const;
+
+    /// \brief Reorder the rows [begin, end) of the node so that the first half
+    /// goes to the left child. Returns where the right child starts
+    uint_t split(const DataSetType& data, const Tree& tree, uint_t node);
+
+    /// \brief Build the subtree of the rows [begin, end) into the tree. When
+    /// depth reaches max_depth the node is left for a task and recorded in pending
+    uint_t build_subtree(const DataSetType& data, uint_t begin, uint_t end, Tree& tree,
+                         uint_t depth, uint_t max_depth, std::vector<PendingSubtree>& pending);
+
+    /// \brief Search the tree for the point whose coordinates are returned by x
+    template<typename Coordinate>
+    void search(const Coordinate& x, uint_t k, std::vector<Pair>& neighbors,
+                KnnIndexWorkspace& workspace)const;
+
+    /// \brief The lower bound of the distance of the point from the rows of the node
+    template<typename Coordinate>
+    real_t node_distance(const Coordinate& x, uint_t node)const;
+
+    /// \brief The contribution of one coordinate difference to the distance
+    static real_t term(real_t diff);
+
+    /// \brief The distance reported to the caller
+    static real_t to_distance(real_t reduced);
+
+    /// \brief The distance as a metric, i.e. with the root
+    static real_t to_metric(real_t reduced);
+
+    /// \brief Inverse of to_metric
+    static real_t from_metric(real_t distance);
+};
+
+template<typename DataSetType, typename Similarity>
+KnnSpatialIndex<DataSetType, Similarity>::KnnSpatialIndex()
+    :
+    type_(KnnIndexType::BRUTE_FORCE),
+    n_columns_(0),
+    leaf_size_(0),
+    nodes_(),
+    bounds_(),
+    rows_(),
+    points_()
+{}
+
+template<typename DataSetType, typename Similarity>
+void
+KnnSpatialIndex<DataSetType, Similarity>::clear(){
+
+    type_ = KnnIndexType::BRUTE_FORCE;
+    n_columns_ = 0;
+    nodes_.clear();
+    bounds_.clear();
+    rows_.clear();
+    points_.clear();
+}
+
+template<typename DataSetType, typename Similarity>
+void
+KnnSpatialIndex<DataSetType, Similarity>::prepare(const DataSetType& data, const KnnControl& control){
+
+    if(control.index == KnnIndexType::BRUTE_FORCE || control.index == KnnIndexType::HNSW){
+        throw std::logic_error("The KNN control does not ask for a KD-tree or a ball tree");
+    }
+
+    if(!metric_t::is_supported){
+        throw std::logic_error("The similarity cannot be used with a KNN index. Use an Lp metric");
+    }
+
+    if(data.rows() == 0 || data.columns() == 0){
+        throw std::logic_error("Cannot build a KNN index for an empty dataset");
+    }
+
+    if(control.leaf_size == 0){
+        throw std::logic_error("The KNN index leaf size should be positive");
+    }
+
+    clear();
+
+    n_columns_ = data.columns();
+    leaf_size_ = control.leaf_size;
+    type_ = control.index;
+
+    if(type_ == KnnIndexType::AUTO){
+        type_ = n_columns_ <= control.kd_tree_max_dim ? KnnIndexType::KD_TREE : KnnIndexType::BALL_TREE;
+    }
+
+    rows_.resize(data.rows());
+    std::iota(rows_.begin(), rows_.end(), 0);
+}
+
+template<typename DataSetType, typename Similarity>
+void
+KnnSpatialIndex<DataSetType, Similarity>::finish(const DataSetType& data){
+
+    points_.resize(rows_.size()*n_columns_);
+
+    for(uint_t i=0; i<rows_.size(); ++i){
+        for(uint_t c=0; c<n_columns_; ++c){
+            points_[i*n_columns_ + c] = data(rows_[i], c);
+        }
+    }
+}
+
+template<typename DataSetType, typename Similarity>
+void
+KnnSpatialIndex<DataSetType, Similarity>::build(const DataSetType& data, const KnnControl& control){
+
+    prepare(data, control);
+
+    Tree tree;
+    std::vector<PendingSubtree> pending;
+    build_subtree(data, 0, rows_.size(), tree, 0, kernel::KernelConsts::invalid_size_type(), pending);
+
+    nodes_ = std::move(tree.nodes);
+    bounds_ = std::move(tree.bounds);
+    finish(data);
+}
+
+template<typename DataSetType, typename Similarity>
+template<typename Executor, typename Options>
+void
+KnnSpatialIndex<DataSetType, Similarity>::build(const DataSetType& data, const KnnControl& control,
+                                                Executor& executor, const Options& options){
+
+    prepare(data, control);
+
+    // enough levels for a subtree per processing element
+    const uint_t n_parts = std::max(executor.n_processing_elements(), static_cast<uint_t>(1));
+    uint_t max_depth = 0;
+    while((static_cast<uint_t>(1) << max_depth) < n_parts){
+        ++max_depth;
+    }
+
+    Tree tree;
+    std::vector<PendingSubtree> pending;
+    build_subtree(data, 0, rows_.size(), tree, 0, max_depth, pending);
+
+    // the subtrees touch disjoint parts of rows_
+    std::vector<Tree> subtrees(pending.size());
+
+    auto build_pending = [&](uint_t p){
+
+        std::vector<PendingSubtree> unused;
+        build_subtree(data, pending[p].begin, pending[p].end, subtrees[p],
+                      0, kernel::KernelConsts::invalid_size_type(), unused);
+    };
+
+    detail::execute_knn_index_tasks(pending.size(), build_pending, executor, options);
+
+    // the root of a subtree replaces its placeholder and
+    // the rest of its nodes are appended to the tree
+    const uint_t n_bounds = type_ == KnnIndexType::KD_TREE ? 2*n_columns_ : n_columns_;
+
+    for(uint_t p=0; p<pending.size(); ++p){
+
+        const uint_t placeholder = pending[p].node;
+        const uint_t offset = tree.nodes.size() - 1;
+        auto map = [placeholder, offset](uint_t n){
+            return n == kernel::KernelConsts::invalid_size_type() ? n : (n == 0 ? placeholder : n + offset);
+        };
+
+        const auto& subtree = subtrees[p];
+
+        for(uint_t n=0; n<subtree.nodes.size(); ++n){
+
+            Node node = subtree.nodes[n];
+            node.left = map(node.left);
+            node.right = map(node.right);
+
+            if(n == 0){
+                tree.nodes[placeholder] = node;
+                std::copy(subtree.bounds.begin(), subtree.bounds.begin() + n_bounds,
+                          tree.bounds.begin() + placeholder*n_bounds);
+            }
+            else{
+                tree.nodes.push_back(node);
+            }
+        }
+
+        tree.bounds.insert(tree.bounds.end(), subtree.bounds.begin() + n_bounds, subtree.bounds.end());
+    }
+
+    nodes_ = std::move(tree.nodes);
+    bounds_ = std::move(tree.bounds);
+    finish(data);
+}
+
+template<typename DataSetType, typename Similarity>
+uint_t
+KnnSpatialIndex<DataSetType, Similarity>::make_node(const DataSetType& data, uint_t begin, uint_t end, Tree& tree)const{
+
+    const uint_t id = tree.nodes.size();
+    tree.nodes.push_back({begin, end, kernel::KernelConsts::invalid_size_type(),
+                          kernel::KernelConsts::invalid_size_type(), 0.0});
+
+    if(type_ == KnnIndexType::KD_TREE){
+
+        const uint_t start = tree.bounds.size();
+        tree.bounds.resize(start + 2*n_columns_);
+
+        for(uint_t c=0; c<n_columns_; ++c){
+            tree.bounds[start + c] = data(rows_[begin], c);
+            tree.bounds[start + n_columns_ + c] = data(rows_[begin], c);
+        }
+
+        for(uint_t i=begin + 1; i<end; ++i){
+            for(uint_t c=0; c<n_columns_; ++c){
+
+                const real_t value = data(rows_[i], c);
+                tree.bounds[start + c] = std::min(tree.bounds[start + c], value);
+                tree.bounds[start + n_columns_ + c] = std::max(tree.bounds[start + n_columns_ + c], value);
+            }
+        }
+    }
+    else{
+
+        // the ball is centered at the centroid of the rows
+        const uint_t start = tree.bounds.size();
+        tree.bounds.resize(start + n_columns_, 0.0);
+
+        for(uint_t i=begin; i<end; ++i){
+            for(uint_t c=0; c<n_columns_; ++c){
+                tree.bounds[start + c] += data(rows_[i], c);
+            }
+        }
+
+        for(uint_t c=0; c<n_columns_; ++c){
+            tree.bounds[start + c] /= static_cast<real_t>(end - begin);
+        }
+
+        real_t radius = 0.0;
+        for(uint_t i=begin; i<end; ++i){
+
+            real_t reduced = 0.0;
+            for(uint_t c=0; c<n_columns_; ++c){
+                reduced += term(data(rows_[i], c) - tree.bounds[start + c]);
+            }
+
+            radius = std::max(radius, to_metric(reduced));
+        }
+
+        tree.nodes[id].radius = radius;
+    }
+
+    return id;
+}
+
+template<typename DataSetType, typename Similarity>
+uint_t
+KnnSpatialIndex<DataSetType, Similarity>::split(const DataSetType& data, const Tree& tree, uint_t node){
+
+    const uint_t begin = tree.nodes[node].begin;
+    const uint_t end = tree.nodes[node].end;
+    const uint_t mid = begin + (end - begin)/2;
+
+    if(type_ == KnnIndexType::KD_TREE){
+
+        // split the widest side of the box at the median
+        const real_t* lower = &tree.bounds[node*2*n_columns_];
+        const real_t* upper = lower + n_columns_;
+
+        uint_t split_column = 0;
+        for(uint_t c=1; c<n_columns_; ++c){
+            if(upper[c] - lower[c] > upper[split_column] - lower[split_column]){
+                split_column = c;
+            }
+        }
+
+        std::nth_element(rows_.begin() + begin, rows_.begin() + mid, rows_.begin() + end,
+                         [&data, split_column](uint_t r1, uint_t r2){
+                            return data(r1, split_column) < data(r2, split_column);});
+
+        return mid;
+    }
+
+    // project the rows on the line through two far apart rows, the row
+    // farthest from the center and the row farthest from that one,
+    // and split at the median of the projections
+    const real_t* center = &tree.bounds[node*n_columns_];
+
+    auto farthest = [&](auto&& coordinate){
+
+        uint_t result = begin;
+        real_t max_reduced = -1.0;
+
+        for(uint_t i=begin; i<end; ++i){
+
+            real_t reduced = 0.0;
+            for(uint_t c=0; c<n_columns_; ++c){
+                reduced += term(data(rows_[i], c) - coordinate(c));
+            }
+
+            if(reduced > max_reduced){
+                max_reduced = reduced;
+                result = i;
+            }
+        }
+
+        return rows_[result];
+    };
+
+    const uint_t first = farthest([center](uint_t c){return center[c];});
+    const uint_t second = farthest([&data, first](uint_t c){return data(first, c);});
+
+    std::vector<std::pair<real_t, uint_t>> projections(end - begin);
+    for(uint_t i=begin; i<end; ++i){
+
+        real_t projection = 0.0;
+        for(uint_t c=0; c<n_columns_; ++c){
+            projection += (data(second, c) - data(first, c))*data(rows_[i], c);
+        }
+
+        projections[i - begin] = std::make_pair(projection, rows_[i]);
+    }
+
+    std::nth_element(projections.begin(), projections.begin() + (mid - begin), projections.end());
+
+    for(uint_t i=begin; i<end; ++i){
+        rows_[i] = projections[i - begin].second;
+    }
+
+    return mid;
+}
+
+template<typename DataSetType, typename Similarity>
+uint_t
+KnnSpatialIndex<DataSetType, Similarity>::build_subtree(const DataSetType& data, uint_t begin, uint_t end, Tree& tree,
+                                                        uint_t depth, uint_t max_depth,
+                                                        std::vector<PendingSubtree>& pending){
+
+    if(depth == max_depth && end - begin > leaf_size_){
+
+        // the node is built by a task
+        const uint_t id = tree.nodes.size();
+        tree.nodes.push_back({begin, end, kernel::KernelConsts::invalid_size_type(),
+                              kernel::KernelConsts::invalid_size_type(), 0.0});
+        tree.bounds.resize(tree.bounds.size() + (type_ == KnnIndexType::KD_TREE ? 2*n_columns_ : n_columns_));
+        pending.push_back({id, begin, end});
+        return id;
+    }
+
+    const uint_t id = make_node(data, begin, end, tree);
+
+    if(end - begin <= leaf_size_){
+        return id;
+    }
+
+    const uint_t mid = split(data, tree, id);
+    const uint_t left = build_subtree(data, begin, mid, tree, depth + 1, max_depth, pending);
+    const uint_t right = build_subtree(data, mid, end, tree, depth + 1, max_depth, pending);
+
+    tree.nodes[id].left = left;
+    tree.nodes[id].right = right;
+    return id;
+}
+
+template<typename DataSetType, typename Similarity>
+real_t
+KnnSpatialIndex<DataSetType, Similarity>::term(real_t diff){
+    return metric_t::term(diff);
+}
+
+template<typename DataSetType, typename Similarity>
+real_t
+KnnSpatialIndex<DataSetType, Similarity>::to_metric(real_t reduced){
+
+    if(metric_t::power == 1){
+        return reduced;
+    }
+
+    if(metric_t::power == 2){
+        return std::sqrt(reduced);
+    }
+
+    return std::pow(reduced, 1.0/metric_t::power);
+}
+
+template<typename DataSetType, typename Similarity>
+real_t
+KnnSpatialIndex<DataSetType, Similarity>::from_metric(real_t distance){
+
+    if(metric_t::power == 1){
+        return distance;
+    }
+
+    if(metric_t::power == 2){
+        return distance*distance;
+    }
+
+    return std::pow(distance, metric_t::power);
+}
+
+template<typename DataSetType, typename Similarity>
+real_t
+KnnSpatialIndex<DataSetType, Similarity>::to_distance(real_t reduced){
+    return metric_t::to_distance(reduced);
+}
+
+template<typename DataSetType, typename Similarity>
+template<typename Coordinate>
+real_t
+KnnSpatialIndex<DataSetType, Similarity>::node_distance(const Coordinate& x, uint_t node)const{
+
+    if(type_ == KnnIndexType::KD_TREE){
+
+        const real_t* lower = &bounds_[node*2*n_columns_];
+        const real_t* upper = lower + n_columns_;
+
+        real_t reduced = 0.0;
+        for(uint_t c=0; c<n_columns_; ++c){
+
+            const real_t value = x(c);
+
+            if(value < lower[c]){
+                reduced += term(lower[c] - value);
+            }
+            else if(value > upper[c]){
+                reduced += term(value - upper[c]);
+            }
+        }
+
+        return reduced;
+    }
+
+    const real_t* center = &bounds_[node*n_columns_];
+
+    real_t reduced = 0.0;
+    for(uint_t c=0; c<n_columns_; ++c){
+        reduced += term(x(c) - center[c]);
+    }
+
+    // the triangle inequality holds for the metric
+    // so the bound is computed with the root
+    const real_t distance = to_metric(reduced) - nodes_[node].radius;
+    return distance > 0.0 ? from_metric(distance) : 0.0;
+}
+
+template<typename DataSetType, typename Similarity>
+template<typename Coordinate>
+void
+KnnSpatialIndex<DataSetType, Similarity>::search(const Coordinate& x, uint_t k, std::vector<Pair>& neighbors,
+                                                 KnnIndexWorkspace& workspace)const{
+
+    if(empty()){
+        throw std::logic_error("The KNN index is not built");
+    }
+
+    auto& top_k = workspace.top_k;
+    auto& stack = workspace.stack;
+
+    top_k.reset(std::min(k, rows_.size()));
+    stack.clear();
+    stack.push_back(std::make_pair(static_cast<uint_t>(0), static_cast<real_t>(0.0)));
+
+    while(!stack.empty()){
+
+        const auto current = stack.back();
+        stack.pop_back();
+
+        // a node at the same distance as the k-th candidate
+        // may hold a row with a smaller index so it is not skipped
+        if(current.second > top_k.worst()){
+            continue;
+        }
+
+        const Node& node = nodes_[current.first];
+
+        if(node.is_leaf()){
+
+            for(uint_t i=node.begin; i<node.end; ++i){
+
+                const real_t* point = &points_[i*n_columns_];
+
+                real_t reduced = 0.0;
+                for(uint_t c=0; c<n_columns_; ++c){
+                    reduced += term(point[c] - x(c));
+                }
+
+                top_k.push(rows_[i], reduced);
+            }
+
+            continue;
+        }
+
+        // visit the closer child first
+        const real_t left = node_distance(x, node.left);
+        const real_t right = node_distance(x, node.right);
+
+        if(left <= right){
+            stack.push_back(std::make_pair(node.right, right));
+            stack.push_back(std::make_pair(node.left, left));
+        }
+        else{
+            stack.push_back(std::make_pair(node.left, left));
+            stack.push_back(std::make_pair(node.right, right));
+        }
+    }
+
+    top_k.sorted(neighbors);
+
+    for(auto& pair : neighbors){
+        pair.second = to_distance(pair.second);
+    }
+}
+
+template<typename DataSetType, typename Similarity>
+template<typename DataPoint>
+void
+KnnSpatialIndex<DataSetType, Similarity>::query(const DataPoint& point, uint_t k, std::vector<Pair>& neighbors,
+                                                KnnIndexWorkspace& workspace)const{
+
+    if(point.size() != n_columns_){
+        throw std::logic_error("Point size: "+std::to_string(point.size())+
+                               " does not match the index columns: "+std::to_string(n_columns_));
+    }
+
+    search([&point](uint_t c){return point[c];}, k, neighbors, workspace);
+}
+
+template<typename DataSetType, typename Similarity>
+template<typename QueryMat>
+void
+KnnSpatialIndex<DataSetType, Similarity>::query(const QueryMat& queries, uint_t k,
+                                                std::vector<std::vector<Pair>>& neighbors)const{
+
+    if(queries.columns() != n_columns_){
+        throw std::logic_error("Query columns: "+std::to_string(queries.columns())+
+                               " do not match the index columns: "+std::to_string(n_columns_));
+    }
+
+    neighbors.resize(queries.rows());
+    KnnIndexWorkspace workspace;
+
+    for(uint_t q=0; q<queries.rows(); ++q){
+        search([&queries, q](uint_t c){return queries(q, c);}, k, neighbors[q], workspace);
+    }
+}
+
+template<typename DataSetType, typename Similarity>
+template<typename QueryMat, typename Executor, typename Options>
+void
+KnnSpatialIndex<DataSetType, Similarity>::query(const QueryMat& queries, uint_t k,
+                                                std::vector<std::vector<Pair>>& neighbors,
+                                                Executor& executor, const Options& options)const{
+
+    if(queries.columns() != n_columns_){
+        throw std::logic_error("Query columns: "+std::to_string(queries.columns())+
+                               " do not match the index columns: "+std::to_string(n_columns_));
+    }
+
+    neighbors.resize(queries.rows());
+
+    if(queries.rows() == 0){
+        return;
+    }
+
+    const uint_t n_parts = std::min(std::max(executor.n_processing_elements(), static_cast<uint_t>(1)),
+                                    static_cast<uint_t>(queries.rows()));
+
+    std::vector<kernel::range1d<uint_t>> partitions;
+    kernel::partition_range(0, queries.rows(), partitions, n_parts);
+
+    auto query_block = [&](uint_t p){
+
+        KnnIndexWorkspace workspace;
+        for(uint_t q=partitions[p].begin(); q<partitions[p].end(); ++q){
+            search([&queries, q](uint_t c){return queries(q, c);}, k, neighbors[q], workspace);
+        }
+    };
+
+    detail::execute_knn_index_tasks(partitions.size(), query_block, executor, options);
+}
+
+}
+
+#endif // KNN_SPATIAL_INDEX_H
@@ -0,0 +1,382 @@
+#ifndef MINI_BATCH_KMEANS_H
+#define MINI_BATCH_KMEANS_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_info.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_control.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/cluster.h"
+
+#include "kernel/base/kernel_consts.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cengine
+{
+	namespace ml
+	{
+
+		///
+		/// \brief Mini-batch implementation of KMeans algorithm.
+		/// The rows are pulled in batches from a data source and every
+		/// centroid moves towards the rows of a batch assigned to it with a
+		/// learning rate of one over the number of rows it has received so far.
+		/// Only the current batch and the centroids are held in memory so the
+		/// data source may be larger than the available memory. The data source
+		/// should provide uint_t next_batch(DynMat<real_t>& batch, uint_t batch_size),
+		/// which returns zero when the source is exhausted, and reset() which
+		/// rewinds it for the next epoch. CSVBatchReader is such a source
+		///
+		template<typename ClusterType>
+		class MiniBatchKMeans
+		{
+
+		public:
+
+			///
+			/// \brief The output type returned upon completion
+			/// of the algorithm
+			///
+			typedef KMeansInfo output_t;
+
+			///
+			/// \brief The input to the algorithm
+			///
+			typedef MiniBatchKMeansConfig config_t;
+
+			///
+			/// \brief The cluster type used
+			///
+			typedef ClusterType cluster_t;
+
+			///
+			/// \brief The centroid type
+			///
+			typedef typename ClusterType::point_t point_t;
+
+			///
+			/// \brief The result after computing
+			///
+			typedef std::vector<cluster_t> result_t;
+
+			///
+			/// \brief Constructor
+			///
+			MiniBatchKMeans(const config_t& config);
+
+			///
+			/// \brief Cluster the rows of the data source. If the centroids are not
+			/// initialized, the initializer is called with the first batch as
+			/// init(batch, k, centroids). Calling it again continues from the
+			/// current centroids so that new data can be streamed in
+			///
+			template<typename SourceType, typename Similarity, typename Initializer>
+			output_t cluster(SourceType& source, const Similarity& similarity, const Initializer& init);
+
+			///
+			/// \brief Initialize the centroids from the given batch
+			///
+			template<typename DataIn, typename Initializer>
+			void initialize(const DataIn& batch, const Initializer& init);
+
+			///
+			/// \brief Move the centroids with the rows of the batch.
+			/// Returns the largest distance a centroid moved
+			///
+			template<typename Similarity>
+			real_t update(const DynMat<real_t>& batch, const Similarity& similarity);
+
+			///
+			/// \brief Returns the id of the closest centroid to the point
+			///
+			template<typename Similarity>
+			uint_t predict(const point_t& point, const Similarity& similarity)const;
+
+			///
+			/// \brief Return the clusters container. The clusters hold
+			/// the centroids only as the rows are not kept
+			///
+			const result_t& get_clusters()const{return clusters_;}
+
+			///
+			/// \brief Return the centroids
+			///
+			const std::vector<point_t>& get_centroids()const{return centroids_;}
+
+			///
+			/// \brief The number of rows every centroid has received
+			///
+			const std::vector<uint_t>& get_counts()const{return counts_;}
+
+		private:
+
+			///
+			/// \brief The algorithm control
+			///
+			config_t control_;
+
+			///
+			/// \brief The clusters
+			///
+			std::vector<cluster_t> clusters_;
+
+			///
+			/// \brief The centroids
+			///
+			std::vector<point_t> centroids_;
+
+			///
+			/// \brief The centroids before the last update
+			///
+			std::vector<point_t> old_centroids_;
+
+			///
+			/// \brief The number of rows every centroid has received
+			///
+			std::vector<uint_t> counts_;
+
+			///
+			/// \brief The cluster of every row of the current batch
+			///
+			std::vector<uint_t> assignments_;
+
+			///
+			/// \brief The batch read from the data source
+			///
+			DynMat<real_t> batch_;
+
+			///
+			/// \brief The row of the batch being assigned
+			///
+			point_t row_;
+
+			///
+			/// \brief The number of point to centroid distances computed
+			///
+			uint_t n_distance_evaluations_;
+
+			///
+			/// \brief Returns the id of the closest centroid to the point
+			///
+			template<typename Similarity>
+			uint_t closest_(const point_t& point, const Similarity& similarity)const;
+		};
+
+		template<typename ClusterType>
+		MiniBatchKMeans<ClusterType>::MiniBatchKMeans(const MiniBatchKMeansConfig& cntrl)
+			:
+		   control_(cntrl),
+		   clusters_(),
+		   centroids_(),
+		   old_centroids_(),
+		   counts_(),
+		   assignments_(),
+		   batch_(),
+		   row_(),
+		   n_distance_evaluations_(0)
+		{}
+
+		template<typename ClusterType>
+		template<typename SourceType, typename Similarity, typename Initializer>
+		typename MiniBatchKMeans<ClusterType>::output_t
+		MiniBatchKMeans<ClusterType>::cluster(SourceType& source, const Similarity& similarity, const Initializer& init){
+
+			if(control_.k == 0){
+				throw std::logic_error("Number of clusters cannot be zero");
+			}
+
+			if(control_.batch_size == 0){
+				throw std::logic_error("The batch size should be positive");
+			}
+
+			output_t info;
+
+			//start timing
+			std::chrono::time_point<std::chrono::system_clock> start, end;
+			start = std::chrono::system_clock::now();
+
+			// every call iterates with a fresh controller so
+			// that more data can be streamed in afterwards
+			config_t control = control_;
+
+			uint_t n_rows = 0;
+			uint_t epoch = 0;
+			const uint_t n_evaluations = n_distance_evaluations_;
+
+			while (control.continue_iterations()) {
+
+				if(control.show_iterations()){
+
+					std::cout<<"\tMini-batch K-means iteration: "<<control.get_current_iteration()<<std::endl;
+				}
+
+				if(source.next_batch(batch_, control.batch_size) == 0){
+
+					if(++epoch >= control.n_epochs){
+						break;
+					}
+
+					source.reset();
+
+					if(source.next_batch(batch_, control.batch_size) == 0){
+						break;
+					}
+				}
+
+				if(centroids_.empty()){
+					initialize(batch_, init);
+				}
+
+				n_rows += batch_.rows();
+
+				auto residual = update(batch_, similarity);
+				control.update_residual(residual);
+
+				if(control.show_iterations()){
+
+				   std::cout<<"\t\t Residual at iteration: "<<residual<<std::endl;
+				}
+			}
+
+			if(centroids_.empty()){
+				throw std::logic_error("The data source has no rows");
+			}
+
+			clusters_.clear();
+			clusters_.resize(centroids_.size());
+			for(uint_t c=0; c<centroids_.size(); ++c){
+				clusters_[c].id = c;
+				clusters_[c].centroid = centroids_[c];
+				clusters_[c].changed = false;
+				clusters_[c].valid_centroid = counts_[c] != 0;
+			}
+
+			auto state = control.get_state();
+			end = std::chrono::system_clock::now();
+
+			info.runtime = end-start;
+			info.nprocs = 1;
+			info.nthreads = 1;
+			info.converged = state.converged;
+			info.residual = state.residual;
+			info.tolerance = state.tolerance;
+			info.niterations = state.num_iterations;
+			info.n_clustering_points = n_rows;
+			info.n_distance_evaluations = n_distance_evaluations_ - n_evaluations;
+
+			for(uint_t c=0; c<counts_.size(); ++c){
+				info.clusters.push_back({c, counts_[c]});
+			}
+
+			return info;
+		}
+
+		template<typename ClusterType>
+		template<typename DataIn, typename Initializer>
+		void
+		MiniBatchKMeans<ClusterType>::initialize(const DataIn& batch, const Initializer& init){
+
+			centroids_.clear();
+			init(batch, control_.k, centroids_);
+
+			if(centroids_.size() != control_.k){
+				throw std::logic_error("Incorrect centroid initialization: "+
+									   std::to_string(centroids_.size()) +
+									   " not equal to: "+
+									   std::to_string(control_.k));
+			}
+
+			counts_.assign(control_.k, 0);
+		}
+
+		template<typename ClusterType>
+		template<typename Similarity>
+		real_t
+		MiniBatchKMeans<ClusterType>::update(const DynMat<real_t>& batch, const Similarity& similarity){
+
+			if(centroids_.empty()){
+				throw std::logic_error("The centroids are not initialized");
+			}
+
+			const uint_t n_columns = batch.columns();
+
+			if(n_columns != centroids_[0].size()){
+				throw std::logic_error("Batch columns: "+std::to_string(n_columns)+
+									   " do not match centroid size: "+std::to_string(centroids_[0].size()));
+			}
+
+			// assign the rows to the centroids the batch started with
+			assignments_.resize(batch.rows());
+			for(uint_t r=0; r<batch.rows(); ++r){
+
+				row_ = blaze::trans(blaze::row(batch, r));
+				assignments_[r] = closest_(row_, similarity);
+			}
+
+			n_distance_evaluations_ += batch.rows()*centroids_.size();
+
+			old_centroids_ = centroids_;
+
+			for(uint_t r=0; r<batch.rows(); ++r){
+
+				const uint_t c = assignments_[r];
+				counts_[c] += 1;
+
+				const real_t rate = 1.0/static_cast<real_t>(counts_[c]);
+				auto& centroid = centroids_[c];
+
+				for(uint_t j=0; j<n_columns; ++j){
+					centroid[j] += rate*(batch(r, j) - centroid[j]);
+				}
+			}
+
+			real_t residual = 0.0;
+			for(uint_t c=0; c<centroids_.size(); ++c){
+				residual = std::max(residual, static_cast<real_t>(similarity(old_centroids_[c], centroids_[c])));
+			}
+
+			return residual;
+		}
+
+		template<typename ClusterType>
+		template<typename Similarity>
+		uint_t
+		MiniBatchKMeans<ClusterType>::predict(const point_t& point, const Similarity& similarity)const{
+
+			if(centroids_.empty()){
+				throw std::logic_error("The centroids are not initialized");
+			}
+
+			return closest_(point, similarity);
+		}
+
+		template<typename ClusterType>
+		template<typename Similarity>
+		uint_t
+		MiniBatchKMeans<ClusterType>::closest_(const point_t& point, const Similarity& similarity)const{
+
+			real_t current_dis = std::numeric_limits<real_t>::max();
+			uint_t cluster_id = 0;
+
+			for(uint_t c=0; c<centroids_.size(); ++c){
+
+				const real_t dis = similarity(point, centroids_[c]);
+
+				if(dis < current_dis){
+					current_dis = dis;
+					cluster_id = c;
+				}
+			}
+
+			return cluster_id;
+		}
+
+	}// ml
+}// cengine
+
+#endif // MINI_BATCH_KMEANS_H
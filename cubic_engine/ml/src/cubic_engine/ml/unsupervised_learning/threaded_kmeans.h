@@ -0,0 +1,834 @@
+#ifndef THREADED_KMEANS_H
+#define THREADED_KMEANS_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_info.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_control.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/cluster.h"
+
+#include "kernel/base/kernel_consts.h"
+#include "kernel/maths/lp_metric.h"
+#include "kernel/maths/matrix_utilities.h"
+#include "kernel/utilities/csv_file_writer.h"
+#include "kernel/utilities/range_1d.h"
+#include "kernel/parallel/threading/simple_task.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cengine
+{
+	namespace ml
+	{
+
+		///
+		/// \brief Tells ThreadedKMeans whether the Similarity satisfies
+		/// the triangle inequality so that the distance bounds are valid
+		///
+		template<typename Similarity>
+		struct kmeans_metric_trait
+		{
+			static const bool is_metric = false;
+		};
+
+		template<int P>
+		struct kmeans_metric_trait<kernel::LpMetric<P, true>>
+		{
+			static const bool is_metric = P >= 1;
+		};
+
+		template<>
+		struct kmeans_metric_trait<kernel::LpMetric<1, false>>
+		{
+			static const bool is_metric = true;
+		};
+
+		namespace detail
+		{
+
+			///
+			/// \brief Task that applies op(id) on the block with the given id
+			///
+			template<typename OpTp>
+			class KMeansBlockTask: public kernel::SimpleTaskBase<Null>
+			{
+			public:
+
+				///
+				/// \brief Constructor
+				///
+				KMeansBlockTask(uint_t id, const OpTp& op)
+					:
+					kernel::SimpleTaskBase<Null>(id),
+					op_(op)
+				{}
+
+			protected:
+
+				///
+				/// \brief Apply the operation
+				///
+				virtual void run()override{op_(this->get_id());}
+
+			private:
+
+				const OpTp& op_;
+			};
+
+			///
+			/// \brief Execute op(0), ..., op(n_blocks - 1) with the executor.
+			/// Throws std::logic_error if a task did not finish
+			///
+			template<typename OpTp, typename Executor, typename Options>
+			void
+			execute_kmeans_blocks(uint_t n_blocks, const OpTp& op, Executor& executor, const Options& options){
+
+				std::vector<std::unique_ptr<KMeansBlockTask<OpTp>>> tasks;
+				tasks.reserve(n_blocks);
+
+				for(uint_t b=0; b<n_blocks; ++b){
+					tasks.push_back(std::make_unique<KMeansBlockTask<OpTp>>(b, op));
+				}
+
+				// this will block
+				executor.execute(tasks, options);
+
+				for(const auto& task : tasks){
+
+					if(task->get_state() != kernel::TaskBase::TaskState::FINISHED){
+						throw std::logic_error("A KMeans task did not finish");
+					}
+				}
+			}
+		}
+
+		///
+		/// \brief Multithreaded implementation of KMeans algorithm.
+		/// The points are split into one block per processing element of the
+		/// executor. Every task assigns the points of its block and accumulates
+		/// partial centroid sums that are reduced once per iteration. When the
+		/// Similarity is a metric, the bounds selected by KMeansConfig::acceleration
+		/// skip the distances that cannot change the assignment of a point.
+		/// The assignments are the ones Lloyd's iteration produces
+		///
+		template<typename ClusterType>
+		class ThreadedKMeans
+		{
+
+		public:
+
+			///
+			/// \brief The output type returned upon completion
+			/// of the algorithm
+			///
+			typedef KMeansInfo output_t;
+
+			///
+			/// \brief The input to the algorithm
+			///
+			typedef KMeansConfig config_t;
+
+			///
+			/// \brief The cluster type used
+			///
+			typedef ClusterType cluster_t;
+
+			///
+			/// \brief The centroid type
+			///
+			typedef typename ClusterType::point_t point_t;
+
+			///
+			/// \brief The result after computing
+			///
+			typedef std::vector<cluster_t> result_t;
+
+			///
+			/// \brief Constructor
+			///
+			ThreadedKMeans(const config_t& config);
+
+			///
+			/// \brief Cluster the given data set using the given executor
+			///
+			template<typename DataIn, typename Similarity, typename Initializer,
+					 typename Executor, typename Options>
+			output_t cluster(const DataIn& data, const Similarity& similarity, const Initializer& init,
+							 Executor& executor, const Options& options);
+
+			///
+			/// \brief Return the clusters container
+			///
+			result_t& get_clusters(){return clusters_;}
+
+			///
+			/// \brief Return the clusters container
+			///
+			const result_t& get_clusters()const{return clusters_;}
+
+			///
+			/// \brief The cluster of every point of the last clustered data set
+			///
+			const std::vector<uint_t>& get_assignments()const{return assignments_;}
+
+			///
+			/// \brief Save the clustering into a csv file
+			///
+			template<typename DataSetType>
+			void save(const std::string& file_name, const DataSetType& data_in)const;
+
+		private:
+
+			///
+			/// \brief The algorithm control
+			///
+			config_t control_;
+
+			///
+			/// \brief The clusters
+			///
+			std::vector<cluster_t> clusters_;
+
+			///
+			/// \brief The rows of the data set
+			///
+			std::vector<point_t> points_;
+
+			///
+			/// \brief The centroids of the current iteration
+			///
+			std::vector<point_t> centroids_;
+
+			///
+			/// \brief The cluster of every point
+			///
+			std::vector<uint_t> assignments_;
+
+			///
+			/// \brief Upper bound of the distance of every point from its centroid
+			///
+			std::vector<real_t> upper_;
+
+			///
+			/// \brief Lower bounds of the distance of every point from the other
+			/// centroids. One per point for HAMERLY and k per point for ELKAN
+			///
+			std::vector<real_t> lower_;
+
+			///
+			/// \brief Flags the points whose upper bound is not a distance
+			///
+			std::vector<char> stale_;
+
+			///
+			/// \brief The centroid to centroid distances
+			///
+			std::vector<real_t> center_distances_;
+
+			///
+			/// \brief Half the distance of every centroid from its closest centroid
+			///
+			std::vector<real_t> half_min_distances_;
+
+			///
+			/// \brief The distance every centroid moved in the last iteration
+			///
+			std::vector<real_t> shifts_;
+
+			///
+			/// \brief The point ranges of the blocks
+			///
+			std::vector<kernel::range1d<uint_t>> blocks_;
+
+			///
+			/// \brief The coordinate sums of every cluster for every block
+			///
+			std::vector<std::vector<real_t>> block_sums_;
+
+			///
+			/// \brief The number of points of every cluster for every block
+			///
+			std::vector<std::vector<uint_t>> block_counts_;
+
+			///
+			/// \brief The number of distances computed by every block
+			///
+			std::vector<uint_t> block_evaluations_;
+
+			///
+			/// \brief Assign every point of the block to its closest
+			/// centroid and set the bounds
+			///
+			template<typename Similarity>
+			void assign_all_(uint_t block, KMeansAcceleration acceleration, const Similarity& sim);
+
+			///
+			/// \brief Reassign the points of the block that
+			/// may have changed cluster according to the bounds
+			///
+			template<typename Similarity>
+			void assign_hamerly_(uint_t block, const Similarity& sim);
+
+			///
+			/// \brief Reassign the points of the block that
+			/// may have changed cluster according to the bounds
+			///
+			template<typename Similarity>
+			void assign_elkan_(uint_t block, const Similarity& sim);
+
+			///
+			/// \brief Accumulate the coordinate sums and
+			/// counts of the points of the block
+			///
+			void accumulate_(uint_t block);
+
+			///
+			/// \brief Compute the centroid to centroid distances
+			///
+			template<typename Similarity>
+			void compute_center_distances_(KMeansAcceleration acceleration, const Similarity& sim);
+
+			///
+			/// \brief Move the bounds of the points of the block
+			/// by the distances the centroids moved
+			///
+			void update_bounds_(uint_t block, KMeansAcceleration acceleration, real_t max_shift, real_t second_max_shift,
+								uint_t max_shift_cluster);
+		};
+
+		template<typename ClusterType>
+		ThreadedKMeans<ClusterType>::ThreadedKMeans(const KMeansConfig& cntrl)
+			:
+		   control_(cntrl),
+		   clusters_(),
+		   points_(),
+		   centroids_(),
+		   assignments_(),
+		   upper_(),
+		   lower_(),
+		   stale_(),
+		   center_distances_(),
+		   half_min_distances_(),
+		   shifts_(),
+		   blocks_(),
+		   block_sums_(),
+		   block_counts_(),
+		   block_evaluations_()
+		{}
+
+		template<typename ClusterType>
+		template<typename DataIn, typename Similarity, typename Initializer,
+				 typename Executor, typename Options>
+		typename ThreadedKMeans<ClusterType>::output_t
+		ThreadedKMeans<ClusterType>::cluster(const DataIn& data, const Similarity& similarity, const Initializer& init,
+											 Executor& executor, const Options& options){
+
+			output_t info;
+			const uint_t k = control_.k;
+			const uint_t rows = data.n_rows();
+
+			if( k == 0){
+				throw std::logic_error("Number of clusters cannot be zero");
+			}
+
+			// more clusters than data does not make
+			// sense
+			if(k > rows){
+				throw std::logic_error("Number of clusters cannot be larger than number of rows");
+			}
+
+			// the bounds are only valid for metrics
+			const KMeansAcceleration acceleration = kmeans_metric_trait<Similarity>::is_metric ?
+														control_.acceleration : KMeansAcceleration::NONE;
+
+			//start timing
+			std::chrono::time_point<std::chrono::system_clock> start, end;
+			start = std::chrono::system_clock::now();
+
+			points_.resize(rows);
+			for(uint_t r=0; r<rows; ++r){
+				points_[r] = data.get_row(r);
+			}
+
+			const uint_t n_columns = points_[0].size();
+
+			const uint_t n_blocks = std::min(std::max(executor.n_processing_elements(), static_cast<uint_t>(1)), rows);
+			blocks_.clear();
+			kernel::partition_range(0, rows, blocks_, n_blocks);
+
+			block_sums_.resize(blocks_.size());
+			block_counts_.resize(blocks_.size());
+			block_evaluations_.assign(blocks_.size(), 0);
+
+			assignments_.assign(rows, 0);
+			upper_.assign(rows, 0.0);
+			stale_.assign(rows, 0);
+			lower_.assign(acceleration == KMeansAcceleration::ELKAN ? rows*k : rows, 0.0);
+			shifts_.assign(k, 0.0);
+
+			bool restart = true;
+
+			while(restart){
+
+				restart = false;
+				std::fill(block_evaluations_.begin(), block_evaluations_.end(), 0);
+
+				//initialize the clusters
+				centroids_.clear();
+				init(data, k, centroids_);
+
+				if(centroids_.size() != k){
+					throw std::logic_error("Incorrect centroid initialization: "+
+										   std::to_string(centroids_.size()) +
+										   " not equal to: "+
+										   std::to_string(k));
+				}
+
+				bool first_pass = true;
+
+				auto assign = [&](uint_t block){
+
+					if(first_pass || acceleration == KMeansAcceleration::NONE){
+						assign_all_(block, acceleration, similarity);
+					}
+					else if(acceleration == KMeansAcceleration::HAMERLY){
+						assign_hamerly_(block, similarity);
+					}
+					else{
+						assign_elkan_(block, similarity);
+					}
+
+					accumulate_(block);
+				};
+
+				real_t max_shift = 0.0;
+				real_t second_max_shift = 0.0;
+				uint_t max_shift_cluster = 0;
+
+				auto update = [&](uint_t block){
+					update_bounds_(block, acceleration, max_shift, second_max_shift, max_shift_cluster);
+				};
+
+				std::vector<uint_t> counts(k);
+				std::vector<real_t> sums(k*n_columns);
+
+				while (control_.continue_iterations()) {
+
+					if(control_.show_iterations()){
+
+						std::cout<<"\tK-means iteration: "<<control_.get_current_iteration()<<std::endl;
+					}
+
+					if(!first_pass){
+						compute_center_distances_(acceleration, similarity);
+					}
+
+					detail::execute_kmeans_blocks(blocks_.size(), assign, executor, options);
+					first_pass = false;
+
+					// reduce the partial sums of the blocks
+					std::fill(counts.begin(), counts.end(), 0);
+					std::fill(sums.begin(), sums.end(), 0.0);
+
+					for(uint_t b=0; b<blocks_.size(); ++b){
+
+						for(uint_t c=0; c<k; ++c){
+							counts[c] += block_counts_[b][c];
+						}
+
+						for(uint_t i=0; i<sums.size(); ++i){
+							sums[i] += block_sums_[b][i];
+						}
+					}
+
+					// check if we have empty clusters
+					const bool empty_cluster = std::find(counts.begin(), counts.end(), 0) != counts.end();
+
+					if(empty_cluster){
+
+						if ( control_.show_iterations()){
+							std::cout<<"\t\tEmpty cluster detected..."<<std::endl;
+						}
+
+						if(!control_.continue_on_empty_cluster && control_.random_restart_on_empty_cluster){
+
+							if(control_.show_iterations()){
+								std::cout<<"\t\tRestarting..."<<std::endl;
+							}
+
+							restart = true;
+							break;
+						}
+						else if(!control_.continue_on_empty_cluster){
+							break;
+						}
+						else if(control_.show_iterations()){
+							std::cout<<"\t\tContinue with empty cluster detected..."<<std::endl;
+						}
+					}
+
+					// calculate new centroids. An empty cluster keeps its centroid
+					real_t residual = 0.0;
+					max_shift = 0.0;
+					second_max_shift = 0.0;
+					max_shift_cluster = 0;
+
+					for(uint_t c=0; c<k; ++c){
+
+						if(counts[c] == 0){
+							shifts_[c] = 0.0;
+							continue;
+						}
+
+						point_t centroid = centroids_[c];
+
+						for(uint_t j=0; j<n_columns; ++j){
+							centroid[j] = sums[c*n_columns + j]/counts[c];
+						}
+
+						shifts_[c] = similarity(centroids_[c], centroid);
+						centroids_[c] = centroid;
+
+						residual = std::max(residual, static_cast<real_t>(shifts_[c]));
+
+						if(shifts_[c] > max_shift){
+							second_max_shift = max_shift;
+							max_shift = shifts_[c];
+							max_shift_cluster = c;
+						}
+						else if(shifts_[c] > second_max_shift){
+							second_max_shift = shifts_[c];
+						}
+					}
+
+					control_.update_residual(residual);
+
+					if(acceleration != KMeansAcceleration::NONE){
+						detail::execute_kmeans_blocks(blocks_.size(), update, executor, options);
+					}
+
+					if(control_.show_iterations()){
+
+					   std::cout<<"\t\t Residual at teration: "<<residual<<std::endl;
+					}
+				}
+			}
+
+			clusters_.clear();
+			clusters_.resize(k);
+			for(uint_t c=0; c<k; ++c){
+				clusters_[c].id = c;
+				clusters_[c].centroid = centroids_[c];
+				clusters_[c].changed = false;
+			}
+
+			for(uint_t r=0; r<rows; ++r){
+				clusters_[assignments_[r]].points.push_back(r);
+			}
+
+			auto state = control_.get_state();
+			end = std::chrono::system_clock::now();
+
+			info.runtime = end-start;
+			info.nprocs = 1;
+			info.nthreads = executor.n_processing_elements();
+			info.converged = state.converged;
+			info.residual = state.residual;
+			info.tolerance = state.tolerance;
+			info.niterations = state.num_iterations;
+			info.n_clustering_points = rows;
+
+			for(uint_t c=0; c<k; ++c){
+				info.clusters.push_back({c, clusters_[c].points.size()});
+			}
+
+			for(uint_t b=0; b<block_evaluations_.size(); ++b){
+				info.n_distance_evaluations += block_evaluations_[b];
+			}
+
+			return info;
+		}
+
+		template<typename ClusterType>
+		template<typename Similarity>
+		void
+		ThreadedKMeans<ClusterType>::assign_all_(uint_t block, KMeansAcceleration acceleration, const Similarity& sim){
+
+			const uint_t k = centroids_.size();
+
+			for(uint_t p=blocks_[block].begin(); p<blocks_[block].end(); ++p){
+
+				real_t best = std::numeric_limits<real_t>::max();
+				real_t second = std::numeric_limits<real_t>::max();
+				uint_t cluster_id = 0;
+
+				for(uint_t c=0; c<k; ++c){
+
+					const real_t dis = sim(points_[p], centroids_[c]);
+
+					if(acceleration == KMeansAcceleration::ELKAN){
+						lower_[p*k + c] = dis;
+					}
+
+					if(dis < best){
+						second = best;
+						best = dis;
+						cluster_id = c;
+					}
+					else if(dis < second){
+						second = dis;
+					}
+				}
+
+				block_evaluations_[block] += k;
+				assignments_[p] = cluster_id;
+				upper_[p] = best;
+				stale_[p] = 0;
+
+				if(acceleration == KMeansAcceleration::HAMERLY){
+					lower_[p] = second;
+				}
+			}
+		}
+
+		template<typename ClusterType>
+		template<typename Similarity>
+		void
+		ThreadedKMeans<ClusterType>::assign_hamerly_(uint_t block, const Similarity& sim){
+
+			const uint_t k = centroids_.size();
+
+			for(uint_t p=blocks_[block].begin(); p<blocks_[block].end(); ++p){
+
+				const uint_t a = assignments_[p];
+				const real_t bound = std::max(half_min_distances_[a], lower_[p]);
+
+				if(upper_[p] <= bound){
+					continue;
+				}
+
+				// tighten the upper bound and try again
+				upper_[p] = sim(points_[p], centroids_[a]);
+				block_evaluations_[block] += 1;
+
+				if(upper_[p] <= bound){
+					continue;
+				}
+
+				real_t best = upper_[p];
+				real_t second = std::numeric_limits<real_t>::max();
+				uint_t cluster_id = a;
+
+				for(uint_t c=0; c<k; ++c){
+
+					if(c == a){
+						continue;
+					}
+
+					const real_t dis = sim(points_[p], centroids_[c]);
+
+					// on ties keep the cluster with the smaller index
+					if(dis < best || (dis == best && c < cluster_id)){
+						second = best;
+						best = dis;
+						cluster_id = c;
+					}
+					else if(dis < second){
+						second = dis;
+					}
+				}
+
+				block_evaluations_[block] += k - 1;
+				assignments_[p] = cluster_id;
+				upper_[p] = best;
+				lower_[p] = second;
+			}
+		}
+
+		template<typename ClusterType>
+		template<typename Similarity>
+		void
+		ThreadedKMeans<ClusterType>::assign_elkan_(uint_t block, const Similarity& sim){
+
+			const uint_t k = centroids_.size();
+
+			for(uint_t p=blocks_[block].begin(); p<blocks_[block].end(); ++p){
+
+				uint_t a = assignments_[p];
+
+				if(upper_[p] <= half_min_distances_[a]){
+					continue;
+				}
+
+				real_t* lower = &lower_[p*k];
+
+				for(uint_t c=0; c<k; ++c){
+
+					if(c == a || upper_[p] <= lower[c] || upper_[p] <= 0.5*center_distances_[a*k + c]){
+						continue;
+					}
+
+					if(stale_[p]){
+
+						upper_[p] = sim(points_[p], centroids_[a]);
+						lower[a] = upper_[p];
+						stale_[p] = 0;
+						block_evaluations_[block] += 1;
+
+						if(upper_[p] <= lower[c] || upper_[p] <= 0.5*center_distances_[a*k + c]){
+							continue;
+						}
+					}
+
+					const real_t dis = sim(points_[p], centroids_[c]);
+					lower[c] = dis;
+					block_evaluations_[block] += 1;
+
+					// on ties keep the cluster with the smaller index
+					if(dis < upper_[p] || (dis == upper_[p] && c < a)){
+						a = c;
+						upper_[p] = dis;
+					}
+				}
+
+				assignments_[p] = a;
+			}
+		}
+
+		template<typename ClusterType>
+		void
+		ThreadedKMeans<ClusterType>::accumulate_(uint_t block){
+
+			const uint_t k = centroids_.size();
+			const uint_t n_columns = centroids_[0].size();
+
+			auto& sums = block_sums_[block];
+			auto& counts = block_counts_[block];
+
+			sums.assign(k*n_columns, 0.0);
+			counts.assign(k, 0);
+
+			for(uint_t p=blocks_[block].begin(); p<blocks_[block].end(); ++p){
+
+				const uint_t c = assignments_[p];
+				counts[c] += 1;
+
+				for(uint_t j=0; j<n_columns; ++j){
+					sums[c*n_columns + j] += points_[p][j];
+				}
+			}
+		}
+
+		template<typename ClusterType>
+		template<typename Similarity>
+		void
+		ThreadedKMeans<ClusterType>::compute_center_distances_(KMeansAcceleration acceleration, const Similarity& sim){
+
+			if(acceleration == KMeansAcceleration::NONE){
+				return;
+			}
+
+			const uint_t k = centroids_.size();
+			center_distances_.assign(k*k, 0.0);
+			half_min_distances_.assign(k, std::numeric_limits<real_t>::max());
+
+			for(uint_t c1=0; c1<k; ++c1){
+				for(uint_t c2=c1+1; c2<k; ++c2){
+
+					const real_t dis = sim(centroids_[c1], centroids_[c2]);
+					center_distances_[c1*k + c2] = dis;
+					center_distances_[c2*k + c1] = dis;
+
+					half_min_distances_[c1] = std::min(half_min_distances_[c1], 0.5*dis);
+					half_min_distances_[c2] = std::min(half_min_distances_[c2], 0.5*dis);
+				}
+			}
+
+			// with a single cluster there is nothing to compare with
+			if(k == 1){
+				half_min_distances_[0] = 0.0;
+			}
+		}
+
+		template<typename ClusterType>
+		void
+		ThreadedKMeans<ClusterType>::update_bounds_(uint_t block, KMeansAcceleration acceleration, real_t max_shift,
+													real_t second_max_shift, uint_t max_shift_cluster){
+
+			const uint_t k = centroids_.size();
+
+			for(uint_t p=blocks_[block].begin(); p<blocks_[block].end(); ++p){
+
+				const uint_t a = assignments_[p];
+				upper_[p] += shifts_[a];
+
+				if(acceleration == KMeansAcceleration::HAMERLY){
+
+					// the centroid of the point does not move the lower bound
+					lower_[p] -= a == max_shift_cluster ? second_max_shift : max_shift;
+				}
+				else{
+
+					for(uint_t c=0; c<k; ++c){
+						lower_[p*k + c] = std::max(lower_[p*k + c] - shifts_[c], static_cast<real_t>(0));
+					}
+
+					stale_[p] = 1;
+				}
+			}
+		}
+
+		template<typename ClusterType>
+		template<typename DataSetType>
+		void
+		ThreadedKMeans<ClusterType>::save(const std::string& file_name, const DataSetType& data)const{
+
+
+			kernel::utilities::CSVWriter writer(file_name, kernel::utilities::CSVWriter::default_delimiter(), true);
+
+			std::vector<std::string> names(data.columns() + 1);
+
+			names[0] = "ClusterId";
+
+			for(uint_t i=1; i<names.size(); ++i){
+				names[i] = "X-"+std::to_string(i);
+			}
+
+			//write the names
+			writer.write_row(names);
+
+			std::vector<real_t> row(names.size());
+
+			for(uint_t c=0; c<clusters_.size(); ++c){
+
+				auto& cluster = clusters_[c];
+
+				for(uint_t p=0; p<cluster.points.size(); ++p){
+
+					uint_t pidx = cluster.points[p];
+					auto point = kernel::get_row(data, pidx);
+					row[0] = cluster.id;
+
+					for(uint_t r=0; r<point.size(); ++r){
+						row[r+1] = point[r];
+					}
+
+				   writer.write_row(row);
+				}
+			}
+
+			//close the file
+			writer.close();
+		}
+
+	}// ml
+}// cengine
+
+#endif // THREADED_KMEANS_H
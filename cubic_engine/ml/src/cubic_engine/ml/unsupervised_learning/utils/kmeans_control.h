@@ -10,6 +10,15 @@ namespace cengine
 {
 
 
+/// \brief How ThreadedKMeans avoids distance computations.
+/// NONE computes the distance of every point from every centroid.
+/// HAMERLY keeps an upper bound to the assigned centroid and one lower
+/// bound to the rest per point. ELKAN keeps a lower bound per point and
+/// centroid, which skips more distances for large k but needs k values
+/// per point. The bounds rely on the triangle inequality so similarities
+/// that are not metrics always use NONE
+enum class KMeansAcceleration{NONE, HAMERLY, ELKAN};
+
 /// \brief Small struct that wraps
 /// configuration parameters for k-means algorithm
 struct KMeansConfig: public kernel::IterativeAlgorithmController
@@ -31,6 +40,11 @@ struct KMeansConfig: public kernel::IterativeAlgorithmController
     /// continue its execution when an empty cluster is detected
 	///
     bool continue_on_empty_cluster;
+
+	///
+    /// \brief The bounds ThreadedKMeans uses to skip distances
+	///
+    KMeansAcceleration acceleration{KMeansAcceleration::HAMERLY};
     
 	///
     /// \brief Constructor
@@ -48,6 +62,39 @@ KMeansConfig::KMeansConfig(uint_t k_, uint_t itrs)
             continue_on_empty_cluster(false)
 {}
 
+/// \brief Small struct that wraps
+/// configuration parameters for mini-batch k-means algorithm
+struct MiniBatchKMeansConfig: public kernel::IterativeAlgorithmController
+{
+	///
+    /// \brief The number of clusters
+	///
+    uint_t k;
+
+	///
+    /// \brief The maximum number of rows of a batch
+	///
+    uint_t batch_size;
+
+	///
+    /// \brief The number of passes over the data source
+	///
+    uint_t n_epochs{1};
+
+	///
+    /// \brief Constructor. Every batch is an iteration
+	///
+    MiniBatchKMeansConfig(uint_t k_, uint_t batch_size_=1024, uint_t itrs=1000);
+};
+
+inline
+MiniBatchKMeansConfig::MiniBatchKMeansConfig(uint_t k_, uint_t batch_size_, uint_t itrs)
+            :
+            kernel::IterativeAlgorithmController(itrs, kernel::KernelConsts::tolerance()),
+            k(k_),
+            batch_size(batch_size_)
+{}
+
 }
 
 
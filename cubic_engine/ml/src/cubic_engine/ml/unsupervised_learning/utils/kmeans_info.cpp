@@ -7,7 +7,10 @@ namespace cengine
     
     KMeansInfo::KMeansInfo()
     :
-    AlgInfo()
+    AlgInfo(),
+    clusters(),
+    n_clustering_points(0),
+    n_distance_evaluations(0)
     {}
     
     
@@ -15,6 +18,7 @@ namespace cengine
     KMeansInfo::print(std::ostream& out)const{ 
 
         this->AlgInfo::print(out);
+        out<<"# distances:..."<<n_distance_evaluations<<std::endl;
         return out;
     }   
 }//parml
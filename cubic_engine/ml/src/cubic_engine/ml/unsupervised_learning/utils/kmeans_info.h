@@ -23,6 +23,9 @@ struct KMeansInfo: public kernel::AlgInfo
     
     /// \brief Number of points for clustering
     uint_t n_clustering_points;
+
+    /// \brief Number of point to centroid distances computed
+    uint_t n_distance_evaluations;
     
     /// \brief Constructor
     KMeansInfo();
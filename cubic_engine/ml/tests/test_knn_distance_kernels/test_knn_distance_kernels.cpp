@@ -0,0 +1,161 @@
+#include "cubic_engine/ml/instance_learning/utils/knn_distance_kernels.h"
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "kernel/maths/lp_metric.h"
+#include "kernel/utilities/range_1d.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace {
+
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::real_t;
+using cengine::uint_t;
+
+typedef std::vector<std::pair<uint_t, real_t>> neighbors_t;
+
+/// \brief Fill the matrix with uniform values in [-1, 1]
+void
+fill_random(DynMat<real_t>& matrix, uint_t seed){
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<real_t> dist(-1.0, 1.0);
+
+    for(uint_t i=0; i<matrix.rows(); ++i){
+        for(uint_t j=0; j<matrix.columns(); ++j){
+            matrix(i, j) = dist(generator);
+        }
+    }
+}
+
+/// \brief Compute all the distances of the query from the rows in the range
+/// with the similarity, sort them and keep the first k
+template<typename Similarity>
+neighbors_t
+brute_force(const DynMat<real_t>& data, const kernel::range1d<uint_t>& range,
+            const DynMat<real_t>& queries, uint_t q, uint_t k){
+
+    Similarity sim;
+    DynVec<real_t> point(queries.columns());
+    DynVec<real_t> row(data.columns());
+
+    for(uint_t j=0; j<queries.columns(); ++j){
+        point[j] = queries(q, j);
+    }
+
+    neighbors_t distances;
+    for(uint_t r=range.begin(); r<range.end(); ++r){
+
+        for(uint_t j=0; j<data.columns(); ++j){
+            row[j] = data(r, j);
+        }
+
+        distances.push_back(std::make_pair(r, sim(row, point)));
+    }
+
+    std::sort(distances.begin(), distances.end(),
+              [](const auto& p1, const auto& p2){return p1.second < p2.second;});
+    distances.resize(std::min(k, distances.size()));
+    return distances;
+}
+
+}
+
+TEST(TestKnnDistanceKernels, TestTopK) {
+
+    /***
+       * Test Scenario:    The application pushes ten candidates with decreasing distances into a KnnTopK of size 3
+       * Expected Output:  The three last candidates are kept sorted by increasing distance
+     **/
+
+    cengine::KnnTopK top_k(3);
+
+    for(uint_t i=0; i<10; ++i){
+        top_k.push(i, static_cast<real_t>(10 - i));
+    }
+
+    std::vector<cengine::KnnTopK::Pair> result;
+    top_k.sorted(result);
+
+    ASSERT_EQ(result.size(), static_cast<uint_t>(3));
+    ASSERT_EQ(result[0].first, static_cast<uint_t>(9));
+    ASSERT_EQ(result[1].first, static_cast<uint_t>(8));
+    ASSERT_EQ(result[2].first, static_cast<uint_t>(7));
+}
+
+TEST(TestKnnDistanceKernels, TestBlockedEuclidean) {
+
+    /***
+       * Test Scenario:    The application computes the nearest rows with blocks that do not
+       *                   divide the number of queries and rows, twice with the same workspace
+       * Expected Output:  The neighbors and the distances match a full sort of all the distances
+     **/
+
+    const uint_t k = 7;
+    DynMat<real_t> data(500, 5);
+    DynMat<real_t> queries(37, 5);
+    fill_random(data, 1);
+    fill_random(queries, 2);
+
+    cengine::KnnBlockOptions options;
+    options.query_block_size = 8;
+    options.data_block_size = 64;
+
+    cengine::KnnDistanceWorkspace workspace;
+    std::vector<neighbors_t> neighbors;
+    kernel::EuclideanMetric sim;
+    kernel::range1d<uint_t> range(0, data.rows());
+
+    for(uint_t pass=0; pass<2; ++pass){
+
+        cengine::knn_top_k(data, range, queries, k, sim, neighbors, workspace, options);
+        ASSERT_EQ(neighbors.size(), queries.rows());
+
+        for(uint_t q=0; q<queries.rows(); ++q){
+
+            const auto expected = brute_force<kernel::EuclideanMetric>(data, range, queries, q, k);
+            ASSERT_EQ(neighbors[q].size(), k);
+
+            for(uint_t n=0; n<k; ++n){
+                ASSERT_EQ(neighbors[q][n].first, expected[n].first);
+                ASSERT_NEAR(neighbors[q][n].second, expected[n].second, 1.0e-10);
+            }
+        }
+    }
+}
+
+TEST(TestKnnDistanceKernels, TestGenericSimilarityOnRange) {
+
+    /***
+       * Test Scenario:    The application computes the nearest rows with the Manhattan metric
+       *                   on a sub-range that has fewer rows than the requested neighbors
+       * Expected Output:  All the rows of the range are returned sorted by their distance
+     **/
+
+    DynMat<real_t> data(20, 3);
+    DynMat<real_t> queries(4, 3);
+    fill_random(data, 3);
+    fill_random(queries, 4);
+
+    cengine::KnnDistanceWorkspace workspace;
+    std::vector<neighbors_t> neighbors;
+    kernel::ManhattanMetric sim;
+    kernel::range1d<uint_t> range(5, 9);
+
+    cengine::knn_top_k(data, range, queries, 6, sim, neighbors, workspace);
+
+    for(uint_t q=0; q<queries.rows(); ++q){
+
+        const auto expected = brute_force<kernel::ManhattanMetric>(data, range, queries, q, 6);
+        ASSERT_EQ(neighbors[q].size(), range.size());
+
+        for(uint_t n=0; n<range.size(); ++n){
+            ASSERT_EQ(neighbors[q][n].first, expected[n].first);
+            ASSERT_NEAR(neighbors[q][n].second, expected[n].second, 1.0e-10);
+        }
+    }
+}
@@ -0,0 +1,211 @@
+#include "cubic_engine/ml/instance_learning/utils/knn_hnsw_index.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_distance_kernels.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_control.h"
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "kernel/maths/lp_metric.h"
+#include "kernel/utilities/range_1d.h"
+#include "kernel/parallel/threading/thread_pool.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace {
+
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::real_t;
+using cengine::uint_t;
+
+typedef std::vector<std::vector<std::pair<uint_t, real_t>>> neighbors_t;
+
+/// \brief Fill the matrix with uniform values in [-1, 1]
+void
+fill_random(DynMat<real_t>& matrix, uint_t seed){
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<real_t> dist(-1.0, 1.0);
+
+    for(uint_t i=0; i<matrix.rows(); ++i){
+        for(uint_t j=0; j<matrix.columns(); ++j){
+            matrix(i, j) = dist(generator);
+        }
+    }
+}
+
+/// \brief The fraction of the exact neighbors that were found
+real_t
+recall(const neighbors_t& exact, const neighbors_t& approximate){
+
+    uint_t found = 0;
+    uint_t total = 0;
+
+    for(uint_t q=0; q<exact.size(); ++q){
+        for(const auto& neighbor : exact[q]){
+
+            ++total;
+            for(const auto& candidate : approximate[q]){
+                if(candidate.first == neighbor.first){
+                    ++found;
+                    break;
+                }
+            }
+        }
+    }
+
+    return static_cast<real_t>(found)/static_cast<real_t>(total);
+}
+
+}
+
+TEST(TestKnnHnswIndex, TestRecall) {
+
+    /***
+       * Test Scenario:    The application builds an HNSW index over 16-dimensional
+       *                   rows and queries it with a small and a large ef_search
+       * Expected Output:  The recall is high and does not drop when ef_search grows
+     **/
+
+    const uint_t k = 10;
+    DynMat<real_t> data(3000, 16);
+    DynMat<real_t> queries(100, 16);
+    fill_random(data, 1);
+    fill_random(queries, 2);
+
+    cengine::KnnDistanceWorkspace workspace;
+    neighbors_t exact;
+    kernel::EuclideanMetric sim;
+    cengine::knn_top_k(data, kernel::range1d<uint_t>(0, data.rows()), queries, k, sim, exact, workspace);
+
+    cengine::HnswOptions options;
+    options.ef_search = 20;
+
+    cengine::KnnHnswIndex<kernel::EuclideanMetric> index(options);
+    index.build(data);
+
+    ASSERT_EQ(index.n_points(), data.rows());
+    ASSERT_EQ(index.n_columns(), data.columns());
+
+    neighbors_t approximate;
+    index.query(queries, k, approximate);
+    const real_t low_recall = recall(exact, approximate);
+
+    index.set_ef_search(200);
+    index.query(queries, k, approximate);
+    const real_t high_recall = recall(exact, approximate);
+
+    ASSERT_TRUE(low_recall > 0.7);
+    ASSERT_TRUE(high_recall > 0.95);
+    ASSERT_TRUE(high_recall >= low_recall);
+
+    // the distances are the ones of the metric
+    for(uint_t q=0; q<queries.rows(); ++q){
+
+        ASSERT_EQ(approximate[q].size(), k);
+
+        for(const auto& neighbor : approximate[q]){
+
+            DynVec<real_t> row(data.columns());
+            DynVec<real_t> point(data.columns());
+
+            for(uint_t c=0; c<data.columns(); ++c){
+                row[c] = data(neighbor.first, c);
+                point[c] = queries(q, c);
+            }
+
+            ASSERT_NEAR(neighbor.second, sim(row, point), 1.0e-10);
+        }
+    }
+}
+
+TEST(TestKnnHnswIndex, TestIncrementalInsertion) {
+
+    /***
+       * Test Scenario:    The application builds the index with half of the rows,
+       *                   inserts the rest and queries every row of the dataset
+       * Expected Output:  Every row is its own closest neighbor at zero distance
+     **/
+
+    DynMat<real_t> data(1000, 8);
+    fill_random(data, 3);
+
+    DynMat<real_t> first_half(500, 8);
+    for(uint_t r=0; r<first_half.rows(); ++r){
+        for(uint_t c=0; c<first_half.columns(); ++c){
+            first_half(r, c) = data(r, c);
+        }
+    }
+
+    cengine::KnnHnswIndex<kernel::SqrEuclidean_metric> index;
+    index.build(first_half);
+    index.insert_rows(data, first_half.rows());
+
+    ASSERT_EQ(index.n_points(), data.rows());
+
+    DynVec<real_t> point(data.columns());
+    for(uint_t c=0; c<data.columns(); ++c){
+        point[c] = 2.0;
+    }
+
+    ASSERT_EQ(index.insert(point), data.rows());
+
+    cengine::KnnHnswWorkspace workspace;
+    std::vector<std::pair<uint_t, real_t>> neighbors;
+    index.query(point, 1, neighbors, workspace);
+
+    ASSERT_EQ(neighbors[0].first, data.rows());
+
+    neighbors_t all;
+    index.query(data, 1, all);
+
+    for(uint_t r=0; r<data.rows(); ++r){
+        ASSERT_EQ(all[r][0].first, r);
+        ASSERT_NEAR(all[r][0].second, 0.0, 1.0e-12);
+    }
+}
+
+TEST(TestKnnHnswIndex, TestParallelQuery) {
+
+    /***
+       * Test Scenario:    The application queries the index with a thread pool of three threads
+       * Expected Output:  The neighbors are the ones of the serial query
+     **/
+
+    DynMat<real_t> data(2000, 12);
+    DynMat<real_t> queries(77, 12);
+    fill_random(data, 4);
+    fill_random(queries, 5);
+
+    cengine::KnnHnswIndex<kernel::ManhattanMetric> index;
+    index.build(data);
+
+    neighbors_t serial;
+    index.query(queries, 5, serial);
+
+    kernel::ThreadPool executor(3);
+    neighbors_t parallel;
+    index.query(queries, 5, parallel, executor, kernel::Null());
+
+    ASSERT_EQ(serial, parallel);
+}
+
+TEST(TestKnnHnswIndex, TestInvalidOptions) {
+
+    /***
+       * Test Scenario:    The application creates an index with one link per point,
+       *                   sets ef_search to zero and queries an empty index
+       * Expected Output:  std::logic_error is thrown every time
+     **/
+
+    cengine::HnswOptions options;
+    options.m = 1;
+    ASSERT_THROW(cengine::KnnHnswIndex<kernel::EuclideanMetric> invalid(options), std::logic_error);
+
+    cengine::KnnHnswIndex<kernel::EuclideanMetric> index;
+    ASSERT_THROW(index.set_ef_search(0), std::logic_error);
+
+    DynMat<real_t> queries(1, 0);
+    neighbors_t neighbors;
+    ASSERT_THROW(index.query(queries, 1, neighbors), std::logic_error);
+}
@@ -0,0 +1,168 @@
+#include "cubic_engine/ml/instance_learning/utils/knn_spatial_index.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_distance_kernels.h"
+#include "cubic_engine/ml/instance_learning/utils/knn_control.h"
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "kernel/maths/lp_metric.h"
+#include "kernel/utilities/range_1d.h"
+#include "kernel/parallel/threading/thread_pool.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace {
+
+using cengine::DynMat;
+using cengine::real_t;
+using cengine::uint_t;
+
+typedef std::vector<std::vector<std::pair<uint_t, real_t>>> neighbors_t;
+
+/// \brief Fill the matrix with uniform values in [-1, 1]
+void
+fill_random(DynMat<real_t>& matrix, uint_t seed){
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<real_t> dist(-1.0, 1.0);
+
+    for(uint_t i=0; i<matrix.rows(); ++i){
+        for(uint_t j=0; j<matrix.columns(); ++j){
+            matrix(i, j) = dist(generator);
+        }
+    }
+}
+
+/// \brief Check that the index neighbors match the brute force ones
+template<typename Similarity>
+void
+check_against_brute_force(const DynMat<real_t>& data, const DynMat<real_t>& queries,
+                          uint_t k, const neighbors_t& neighbors){
+
+    cengine::KnnDistanceWorkspace workspace;
+    neighbors_t expected;
+    Similarity sim;
+    cengine::knn_top_k(data, kernel::range1d<uint_t>(0, data.rows()), queries, k, sim, expected, workspace);
+
+    ASSERT_EQ(neighbors.size(), expected.size());
+
+    for(uint_t q=0; q<expected.size(); ++q){
+
+        ASSERT_EQ(neighbors[q].size(), expected[q].size());
+
+        for(uint_t n=0; n<expected[q].size(); ++n){
+            ASSERT_EQ(neighbors[q][n].first, expected[q][n].first);
+            ASSERT_NEAR(neighbors[q][n].second, expected[q][n].second, 1.0e-10);
+        }
+    }
+}
+
+/// \brief A similarity the index cannot use
+struct Cosine
+{
+    real_t operator()(const cengine::DynVec<real_t>&, const cengine::DynVec<real_t>&)const{return 0.0;}
+};
+
+}
+
+TEST(TestKnnSpatialIndex, TestKdTreeEuclidean) {
+
+    /***
+       * Test Scenario:    The application builds a KD-tree over 3-dimensional rows and queries it
+       * Expected Output:  The neighbors and the distances are the brute force ones
+     **/
+
+    DynMat<real_t> data(2000, 3);
+    DynMat<real_t> queries(50, 3);
+    fill_random(data, 1);
+    fill_random(queries, 2);
+
+    cengine::KnnControl control(5, cengine::KnnIndexType::AUTO);
+    control.leaf_size = 8;
+
+    cengine::KnnSpatialIndex<DynMat<real_t>, kernel::EuclideanMetric> index;
+    index.build(data, control);
+
+    ASSERT_EQ(index.type(), cengine::KnnIndexType::KD_TREE);
+    ASSERT_EQ(index.n_rows(), data.rows());
+    ASSERT_TRUE(index.n_nodes() > 1);
+
+    neighbors_t neighbors;
+    index.query(queries, control.k, neighbors);
+    check_against_brute_force<kernel::EuclideanMetric>(data, queries, control.k, neighbors);
+}
+
+TEST(TestKnnSpatialIndex, TestBallTreeManhattan) {
+
+    /***
+       * Test Scenario:    The application builds a ball tree over 20-dimensional rows
+       *                   with the Manhattan metric and queries it
+       * Expected Output:  The neighbors and the distances are the brute force ones
+     **/
+
+    DynMat<real_t> data(1000, 20);
+    DynMat<real_t> queries(20, 20);
+    fill_random(data, 3);
+    fill_random(queries, 4);
+
+    cengine::KnnControl control(7, cengine::KnnIndexType::AUTO);
+
+    cengine::KnnSpatialIndex<DynMat<real_t>, kernel::ManhattanMetric> index;
+    index.build(data, control);
+
+    ASSERT_EQ(index.type(), cengine::KnnIndexType::BALL_TREE);
+
+    neighbors_t neighbors;
+    index.query(queries, control.k, neighbors);
+    check_against_brute_force<kernel::ManhattanMetric>(data, queries, control.k, neighbors);
+}
+
+TEST(TestKnnSpatialIndex, TestParallelBuildAndQuery) {
+
+    /***
+       * Test Scenario:    The application builds both indices with a thread pool
+       *                   of three threads and queries them in parallel
+       * Expected Output:  The neighbors are the brute force ones
+     **/
+
+    DynMat<real_t> data(3000, 4);
+    DynMat<real_t> queries(101, 4);
+    fill_random(data, 5);
+    fill_random(queries, 6);
+
+    kernel::ThreadPool executor(3);
+
+    for(auto type : {cengine::KnnIndexType::KD_TREE, cengine::KnnIndexType::BALL_TREE}){
+
+        cengine::KnnControl control(4, type);
+        control.leaf_size = 16;
+
+        cengine::KnnSpatialIndex<DynMat<real_t>, kernel::SqrEuclidean_metric> index;
+        index.build(data, control, executor, kernel::Null());
+
+        neighbors_t neighbors;
+        index.query(queries, control.k, neighbors, executor, kernel::Null());
+        check_against_brute_force<kernel::SqrEuclidean_metric>(data, queries, control.k, neighbors);
+    }
+}
+
+TEST(TestKnnSpatialIndex, TestInvalidBuild) {
+
+    /***
+       * Test Scenario:    The application builds an index for brute force, for a
+       *                   similarity that is not an Lp metric and for an empty dataset
+       * Expected Output:  std::logic_error is thrown every time
+     **/
+
+    DynMat<real_t> data(10, 2);
+    fill_random(data, 7);
+
+    cengine::KnnSpatialIndex<DynMat<real_t>, kernel::EuclideanMetric> index;
+    ASSERT_THROW(index.build(data, cengine::KnnControl(2)), std::logic_error);
+
+    cengine::KnnSpatialIndex<DynMat<real_t>, Cosine> cosine_index;
+    ASSERT_THROW(cosine_index.build(data, cengine::KnnControl(2, cengine::KnnIndexType::KD_TREE)), std::logic_error);
+
+    DynMat<real_t> empty(0, 2);
+    ASSERT_THROW(index.build(empty, cengine::KnnControl(2, cengine::KnnIndexType::KD_TREE)), std::logic_error);
+}
@@ -0,0 +1,173 @@
+#include "cubic_engine/ml/unsupervised_learning/mini_batch_kmeans.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_control.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/cluster.h"
+#include "cubic_engine/ml/datasets/csv_batch_reader.h"
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "kernel/maths/lp_metric.h"
+
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace {
+
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::real_t;
+using cengine::uint_t;
+
+typedef cengine::Cluster<DynVec<real_t>> cluster_t;
+
+/// \brief The blob centers used by write_blobs
+const real_t blob_centers[3][2] = {{-10.0, 0.0}, {0.0, 10.0}, {10.0, -5.0}};
+
+/// \brief Write n_points points around every blob center into a CSV
+/// file with a header. The point i belongs to the blob i % 3 and the
+/// last column holds the blob index
+void
+write_blobs(const std::string& file_name, uint_t n_points){
+
+    std::mt19937 generator(13);
+    std::normal_distribution<real_t> noise(0.0, 0.5);
+
+    std::ofstream file(file_name);
+    file<<"X-1,X-2,Blob\n";
+
+    for(uint_t i=0; i<3*n_points; ++i){
+        file<<blob_centers[i % 3][0] + noise(generator)<<","
+            <<blob_centers[i % 3][1] + noise(generator)<<","
+            <<i % 3<<"\n";
+    }
+}
+
+/// \brief Use the first k rows of the batch as the initial centroids
+struct FirstRows
+{
+    void operator()(const DynMat<real_t>& batch, uint_t k, std::vector<DynVec<real_t>>& centroids)const{
+
+        for(uint_t c=0; c<k; ++c){
+
+            DynVec<real_t> row(batch.columns());
+            for(uint_t j=0; j<batch.columns(); ++j){
+                row[j] = batch(c, j);
+            }
+
+            centroids.push_back(row);
+        }
+    }
+};
+
+}
+
+TEST(TestMiniBatchKMeans, TestCSVBatchReader) {
+
+    /***
+       * Test Scenario:   The application reads two columns of a CSV file
+       *                  in batches and then rewinds the reader
+       * Expected Output: The batches hold the rows of the file in order,
+       *                  the last batch holds the remaining rows and the
+       *                  rewound reader starts from the first row
+     **/
+
+    const std::string file_name = "test_csv_batch_reader.csv";
+    write_blobs(file_name, 10);
+
+    cengine::ml::CSVBatchReader reader(file_name, true, {0, 1});
+    DynMat<real_t> batch;
+
+    ASSERT_EQ(reader.next_batch(batch, 12), 12);
+    ASSERT_EQ(batch.rows(), 12);
+    ASSERT_EQ(batch.columns(), 2);
+    const real_t first = batch(0, 0);
+
+    ASSERT_EQ(reader.next_batch(batch, 12), 12);
+    ASSERT_EQ(reader.next_batch(batch, 12), 6);
+    ASSERT_EQ(batch.rows(), 6);
+    ASSERT_EQ(reader.next_batch(batch, 12), 0);
+    ASSERT_TRUE(reader.exhausted());
+    ASSERT_EQ(reader.n_rows_read(), 30);
+
+    reader.reset();
+    ASSERT_EQ(reader.next_batch(batch, 5), 5);
+    ASSERT_EQ(batch(0, 0), first);
+
+    ASSERT_THROW(cengine::ml::CSVBatchReader("missing_file.csv"), std::logic_error);
+}
+
+TEST(TestMiniBatchKMeans, TestClusterStream) {
+
+    /***
+       * Test Scenario:   The application clusters a CSV file streamed in
+       *                  batches that are much smaller than the file
+       * Expected Output: The centroids are close to the blob centers and
+       *                  every row of the file is consumed once per epoch
+     **/
+
+    const std::string file_name = "test_mini_batch_kmeans.csv";
+    write_blobs(file_name, 1000);
+
+    cengine::ml::CSVBatchReader reader(file_name, true, {0, 1});
+
+    cengine::MiniBatchKMeansConfig config(3, 100);
+    config.n_epochs = 2;
+
+    cengine::ml::MiniBatchKMeans<cluster_t> kmeans(config);
+    kernel::LpMetric<2> similarity;
+
+    auto info = kmeans.cluster(reader, similarity, FirstRows());
+
+    ASSERT_EQ(info.n_clustering_points, 6000);
+    ASSERT_EQ(info.n_distance_evaluations, 3*6000);
+    ASSERT_EQ(info.clusters.size(), 3);
+
+    uint_t total = 0;
+    for(uint_t c=0; c<3; ++c){
+
+        total += info.clusters[c].second;
+
+        // the first rows come from the blobs 0, 1 and 2
+        const auto& centroid = kmeans.get_centroids()[c];
+        ASSERT_NEAR(centroid[0], blob_centers[c][0], 0.1);
+        ASSERT_NEAR(centroid[1], blob_centers[c][1], 0.1);
+
+        DynVec<real_t> point(2);
+        point[0] = blob_centers[c][0];
+        point[1] = blob_centers[c][1];
+        ASSERT_EQ(kmeans.predict(point, similarity), c);
+    }
+
+    ASSERT_EQ(total, 6000);
+
+    // more data can be streamed into the trained centroids
+    cengine::ml::CSVBatchReader more(file_name, true, {0, 1});
+    auto more_info = kmeans.cluster(more, similarity, FirstRows());
+
+    ASSERT_EQ(more_info.n_clustering_points, 6000);
+    ASSERT_EQ(kmeans.get_counts()[0] + kmeans.get_counts()[1] + kmeans.get_counts()[2], 12000);
+}
+
+TEST(TestMiniBatchKMeans, TestInvalidInput) {
+
+    /***
+       * Test Scenario:   The application requests zero clusters or updates
+       *                  the centroids before initializing them
+       * Expected Output: std::logic_error is thrown
+     **/
+
+    const std::string file_name = "test_mini_batch_kmeans_invalid.csv";
+    write_blobs(file_name, 2);
+
+    cengine::ml::CSVBatchReader reader(file_name, true, {0, 1});
+    kernel::LpMetric<2> similarity;
+
+    cengine::ml::MiniBatchKMeans<cluster_t> empty_kmeans(cengine::MiniBatchKMeansConfig(0, 10));
+    ASSERT_THROW(empty_kmeans.cluster(reader, similarity, FirstRows()), std::logic_error);
+
+    cengine::ml::MiniBatchKMeans<cluster_t> kmeans(cengine::MiniBatchKMeansConfig(2, 10));
+    DynMat<real_t> batch(2, 2, 0.0);
+    ASSERT_THROW(kmeans.update(batch, similarity), std::logic_error);
+}
@@ -0,0 +1,236 @@
+#include "cubic_engine/ml/unsupervised_learning/threaded_kmeans.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_control.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/cluster.h"
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "kernel/maths/lp_metric.h"
+#include "kernel/parallel/threading/thread_pool.h"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace {
+
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::real_t;
+using cengine::uint_t;
+
+typedef cengine::Cluster<DynVec<real_t>> cluster_t;
+
+/// \brief Minimal data set that exposes the rows of a matrix
+struct DataSet
+{
+    DynMat<real_t> matrix;
+
+    uint_t n_rows()const{return matrix.rows();}
+    uint_t columns()const{return matrix.columns();}
+
+    DynVec<real_t> get_row(uint_t r)const{
+
+        DynVec<real_t> row(matrix.columns());
+        for(uint_t j=0; j<matrix.columns(); ++j){
+            row[j] = matrix(r, j);
+        }
+        return row;
+    }
+};
+
+/// \brief n_blobs Gaussian blobs of n_points points in dim dimensions.
+/// The point i belongs to the blob i % n_blobs
+DataSet
+make_blobs(uint_t n_blobs, uint_t n_points, uint_t dim, uint_t seed){
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<real_t> centers(-10.0, 10.0);
+    std::normal_distribution<real_t> noise(0.0, 1.0);
+
+    DynMat<real_t> blob_centers(n_blobs, dim);
+    for(uint_t b=0; b<n_blobs; ++b){
+        for(uint_t j=0; j<dim; ++j){
+            blob_centers(b, j) = centers(generator);
+        }
+    }
+
+    DataSet data;
+    data.matrix.resize(n_blobs*n_points, dim);
+
+    for(uint_t i=0; i<data.matrix.rows(); ++i){
+        for(uint_t j=0; j<dim; ++j){
+            data.matrix(i, j) = blob_centers(i % n_blobs, j) + noise(generator);
+        }
+    }
+
+    return data;
+}
+
+/// \brief Use the first k rows as the initial centroids
+struct FirstRows
+{
+    void operator()(const DataSet& data, uint_t k, std::vector<DynVec<real_t>>& centroids)const{
+
+        for(uint_t c=0; c<k; ++c){
+            centroids.push_back(data.get_row(c));
+        }
+    }
+};
+
+template<typename Similarity>
+cengine::KMeansInfo
+run(const DataSet& data, uint_t k, cengine::KMeansAcceleration acceleration,
+    std::vector<uint_t>& assignments, std::vector<DynVec<real_t>>& centroids){
+
+    cengine::KMeansConfig config(k, 100);
+    config.acceleration = acceleration;
+
+    cengine::ml::ThreadedKMeans<cluster_t> kmeans(config);
+    kernel::ThreadPool executor(3);
+
+    auto info = kmeans.cluster(data, Similarity(), FirstRows(), executor, kernel::Null());
+
+    assignments = kmeans.get_assignments();
+
+    centroids.clear();
+    for(const auto& cluster : kmeans.get_clusters()){
+        centroids.push_back(cluster.centroid);
+    }
+
+    return info;
+}
+
+}
+
+TEST(TestThreadedKMeans, TestAccelerationsAgree) {
+
+    /***
+       * Test Scenario:   The application clusters Gaussian blobs with
+       *                  Lloyd's iteration, Hamerly's and Elkan's bounds
+       *                  starting from the same centroids
+       * Expected Output: All the runs converge to the same assignments and
+       *                  centroids. The bounds compute fewer distances
+     **/
+
+    auto data = make_blobs(8, 200, 4, 7);
+    const uint_t k = 8;
+
+    std::vector<uint_t> lloyd;
+    std::vector<uint_t> hamerly;
+    std::vector<uint_t> elkan;
+    std::vector<DynVec<real_t>> lloyd_centroids;
+    std::vector<DynVec<real_t>> hamerly_centroids;
+    std::vector<DynVec<real_t>> elkan_centroids;
+
+    typedef kernel::LpMetric<2> metric_t;
+
+    auto lloyd_info = run<metric_t>(data, k, cengine::KMeansAcceleration::NONE, lloyd, lloyd_centroids);
+    auto hamerly_info = run<metric_t>(data, k, cengine::KMeansAcceleration::HAMERLY, hamerly, hamerly_centroids);
+    auto elkan_info = run<metric_t>(data, k, cengine::KMeansAcceleration::ELKAN, elkan, elkan_centroids);
+
+    ASSERT_TRUE(lloyd_info.converged);
+    ASSERT_EQ(lloyd, hamerly);
+    ASSERT_EQ(lloyd, elkan);
+    ASSERT_EQ(lloyd_info.niterations, hamerly_info.niterations);
+    ASSERT_EQ(lloyd_info.niterations, elkan_info.niterations);
+
+    for(uint_t c=0; c<k; ++c){
+        for(uint_t j=0; j<data.columns(); ++j){
+            ASSERT_NEAR(lloyd_centroids[c][j], hamerly_centroids[c][j], 1.0e-10);
+            ASSERT_NEAR(lloyd_centroids[c][j], elkan_centroids[c][j], 1.0e-10);
+        }
+    }
+
+    ASSERT_EQ(lloyd_info.n_distance_evaluations % (k*data.n_rows()), 0);
+    ASSERT_LT(hamerly_info.n_distance_evaluations, lloyd_info.n_distance_evaluations);
+    ASSERT_LT(elkan_info.n_distance_evaluations, lloyd_info.n_distance_evaluations);
+}
+
+TEST(TestThreadedKMeans, TestCentroidsAreMeans) {
+
+    /***
+       * Test Scenario:   The application clusters Gaussian blobs with Manhattan
+       *                  distance and compares the centroids with the means of
+       *                  the points assigned to them
+       * Expected Output: Every centroid is the mean of its points and every
+       *                  point is reported in exactly one cluster
+     **/
+
+    auto data = make_blobs(4, 150, 3, 11);
+    const uint_t k = 4;
+
+    std::vector<uint_t> assignments;
+    std::vector<DynVec<real_t>> centroids;
+    auto info = run<kernel::LpMetric<1>>(data, k, cengine::KMeansAcceleration::ELKAN, assignments, centroids);
+
+    ASSERT_TRUE(info.converged);
+    ASSERT_EQ(info.n_clustering_points, data.n_rows());
+    ASSERT_EQ(info.clusters.size(), k);
+
+    uint_t total = 0;
+    for(uint_t c=0; c<k; ++c){
+
+        std::vector<real_t> mean(data.columns(), 0.0);
+        uint_t count = 0;
+
+        for(uint_t r=0; r<data.n_rows(); ++r){
+            if(assignments[r] == c){
+                ++count;
+                for(uint_t j=0; j<data.columns(); ++j){
+                    mean[j] += data.matrix(r, j);
+                }
+            }
+        }
+
+        ASSERT_EQ(info.clusters[c].second, count);
+        total += count;
+
+        for(uint_t j=0; j<data.columns(); ++j){
+            ASSERT_NEAR(centroids[c][j], mean[j]/count, 1.0e-10);
+        }
+    }
+
+    ASSERT_EQ(total, data.n_rows());
+}
+
+TEST(TestThreadedKMeans, TestNonMetricSimilarity) {
+
+    /***
+       * Test Scenario:   The application requests Hamerly's bounds with the
+       *                  squared Euclidean distance
+       * Expected Output: The bounds are not used and the run computes as
+       *                  many distances as Lloyd's iteration
+     **/
+
+    auto data = make_blobs(3, 100, 2, 5);
+    const uint_t k = 3;
+
+    std::vector<uint_t> lloyd;
+    std::vector<uint_t> hamerly;
+    std::vector<DynVec<real_t>> centroids;
+
+    typedef kernel::LpMetric<2, false> similarity_t;
+
+    auto lloyd_info = run<similarity_t>(data, k, cengine::KMeansAcceleration::NONE, lloyd, centroids);
+    auto hamerly_info = run<similarity_t>(data, k, cengine::KMeansAcceleration::HAMERLY, hamerly, centroids);
+
+    ASSERT_EQ(lloyd, hamerly);
+    ASSERT_EQ(hamerly_info.n_distance_evaluations, lloyd_info.n_distance_evaluations);
+}
+
+TEST(TestThreadedKMeans, TestInvalidNumberOfClusters) {
+
+    /***
+       * Test Scenario:   The application requests zero clusters or more
+       *                  clusters than points
+       * Expected Output: std::logic_error is thrown
+     **/
+
+    auto data = make_blobs(2, 5, 2, 3);
+    std::vector<uint_t> assignments;
+    std::vector<DynVec<real_t>> centroids;
+
+    ASSERT_THROW(run<kernel::LpMetric<2>>(data, 0, cengine::KMeansAcceleration::HAMERLY, assignments, centroids),
+                 std::logic_error);
+    ASSERT_THROW(run<kernel::LpMetric<2>>(data, 11, cengine::KMeansAcceleration::HAMERLY, assignments, centroids),
+                 std::logic_error);
+}
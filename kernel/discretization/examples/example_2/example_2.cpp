@@ -0,0 +1,167 @@
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/compact_mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace example
+{
+using kernel::real_t;
+using kernel::uint_t;
+using kernel::GeomPoint;
+using kernel::KernelConsts;
+using kernel::numerics::Mesh;
+using kernel::numerics::CompactMesh;
+using kernel::numerics::ConstElementMeshIterator;
+using kernel::numerics::Active;
+
+/// \brief Assemble the coefficients of the two point flux
+/// Laplace stencil (diagonal plus one entry per face) using
+/// the pointer based topology. Returns the sum of the diagonal
+/// entries so that the work cannot be optimized away
+real_t assemble(const Mesh<2>& mesh, std::vector<real_t>& values){
+
+    ConstElementMeshIterator<Active, Mesh<2>> filter(mesh);
+
+    auto elem_itr = filter.begin();
+    auto elem_itr_e = filter.end();
+
+    real_t trace = 0.0;
+    for(; elem_itr != elem_itr_e; ++elem_itr){
+
+        auto* elem = *elem_itr;
+        uint_t row = 5*elem->get_id();
+
+        values[row] = 0.0;
+        for(uint_t f=0; f<elem->n_faces(); ++f){
+
+            const auto& face = elem->get_face(f);
+            real_t flux = face.volume()/face.owner_neighbor_distance();
+
+            values[row] += flux;
+            values[row + f + 1] = face.on_boundary() ? 0.0 : -flux;
+        }
+
+        trace += values[row];
+    }
+
+    return trace;
+}
+
+/// \brief Same as above using the CompactMesh
+real_t assemble(const CompactMesh<2>& mesh, std::vector<real_t>& values){
+
+    ConstElementMeshIterator<Active, CompactMesh<2>> filter(mesh);
+
+    auto elem_itr = filter.begin();
+    auto elem_itr_e = filter.end();
+
+    real_t trace = 0.0;
+    for(; elem_itr != elem_itr_e; ++elem_itr){
+
+        auto* elem = *elem_itr;
+        uint_t e = elem->index();
+        uint_t row = 5*e;
+
+        real_t cx = mesh.element_centroid(e, 0);
+        real_t cy = mesh.element_centroid(e, 1);
+
+        values[row] = 0.0;
+        for(uint_t f=0; f<elem->n_faces(); ++f){
+
+            uint_t face = elem->face(f);
+            uint_t neigh = elem->neighbor(f);
+
+            real_t dx = 0.0;
+            real_t dy = 0.0;
+
+            if(neigh != KernelConsts::invalid_size_type()){
+                dx = mesh.element_centroid(neigh, 0) - cx;
+                dy = mesh.element_centroid(neigh, 1) - cy;
+            }
+            else{
+                dx = mesh.face_centroid(face, 0) - cx;
+                dy = mesh.face_centroid(face, 1) - cy;
+            }
+
+            real_t flux = mesh.face_volume(face)/std::sqrt(dx*dx + dy*dy);
+
+            values[row] += flux;
+            values[row + f + 1] = mesh.face_on_boundary(face) ? 0.0 : -flux;
+        }
+
+        trace += values[row];
+    }
+
+    return trace;
+}
+
+template<typename MeshTp>
+real_t time_assembly(const MeshTp& mesh, std::vector<real_t>& values, uint_t n_reps, real_t& trace){
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint_t r=0; r<n_reps; ++r){
+        trace = assemble(mesh, values);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t> elapsed = end - start;
+    return elapsed.count()/n_reps;
+}
+
+}
+
+
+int main(int argc, char** argv){
+
+    using namespace example;
+
+    // the largest mesh is max_n x max_n
+    uint_t max_n = argc > 1 ? std::atoi(argv[1]) : 1024;
+    const uint_t n_reps = 5;
+
+    std::cout<<"n_cells, pointer (s/Mcell), compact (s/Mcell), speedup, compact memory (MB)"<<std::endl;
+
+    for(uint_t n = 128; n <= max_n; n *= 2){
+
+        Mesh<2> mesh;
+        kernel::numerics::build_quad_mesh(mesh, n, n, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+        CompactMesh<2> compact(mesh);
+
+        std::vector<real_t> values(5*mesh.n_elements(), 0.0);
+
+        real_t ptr_trace = 0.0;
+        real_t ptr_time = time_assembly(mesh, values, n_reps, ptr_trace);
+
+        real_t compact_trace = 0.0;
+        real_t compact_time = time_assembly(compact, values, n_reps, compact_trace);
+
+        if(std::fabs(ptr_trace - compact_trace) > 1.0e-8*std::fabs(ptr_trace)){
+            std::cout<<"Assembled traces differ: "<<ptr_trace<<" vs "<<compact_trace<<std::endl;
+            return 1;
+        }
+
+        real_t mcells = static_cast<real_t>(mesh.n_elements())/1.0e6;
+
+        std::cout<<mesh.n_elements()<<", "
+                 <<ptr_time/mcells<<", "
+                 <<compact_time/mcells<<", "
+                 <<ptr_time/compact_time<<", "
+                 <<static_cast<real_t>(compact.memory_consumption())/(1024.0*1024.0)<<std::endl;
+    }
+
+    return 0;
+}
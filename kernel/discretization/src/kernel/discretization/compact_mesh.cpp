@@ -0,0 +1,215 @@
+#include "kernel/discretization/compact_mesh.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/node.h"
+
+#include <unordered_map>
+#include <exception>
+#include <string>
+
+namespace kernel{
+namespace numerics{
+
+template<int dim>
+CompactMesh<dim>::CompactMesh()
+    :
+      coords_(),
+      elem_ids_(),
+      elem_pids_(),
+      elem_active_(),
+      elem_volumes_(),
+      elem_centroids_(),
+      elem_node_offsets_(),
+      elem_nodes_(),
+      elem_face_offsets_(),
+      elem_faces_(),
+      elem_neighbors_(),
+      face_volumes_(),
+      face_centroids_(),
+      face_boundary_(),
+      elements_()
+{}
+
+template<int dim>
+CompactMesh<dim>::CompactMesh(const Mesh<dim>& mesh)
+    :
+     CompactMesh<dim>()
+{
+    build(mesh);
+}
+
+template<int dim>
+void
+CompactMesh<dim>::clear(){
+
+    for(uint_t d=0; d<dim; ++d){
+        std::vector<real_t>().swap(coords_[d]);
+        std::vector<real_t>().swap(elem_centroids_[d]);
+        std::vector<real_t>().swap(face_centroids_[d]);
+    }
+
+    std::vector<uint_t>().swap(elem_ids_);
+    std::vector<uint_t>().swap(elem_pids_);
+    std::vector<char>().swap(elem_active_);
+    std::vector<real_t>().swap(elem_volumes_);
+    std::vector<uint_t>().swap(elem_node_offsets_);
+    std::vector<uint_t>().swap(elem_nodes_);
+    std::vector<uint_t>().swap(elem_face_offsets_);
+    std::vector<uint_t>().swap(elem_faces_);
+    std::vector<uint_t>().swap(elem_neighbors_);
+    std::vector<real_t>().swap(face_volumes_);
+    std::vector<uint_t>().swap(face_boundary_);
+    std::vector<element_t>().swap(elements_);
+}
+
+template<int dim>
+void
+CompactMesh<dim>::build(const Mesh<dim>& mesh){
+
+    clear();
+
+    const uint_t n_nodes = mesh.n_nodes();
+    const uint_t n_elements = mesh.n_elements();
+
+    // nodes are numbered in the order the
+    // topology stores them
+    std::unordered_map<const Node<dim>*, uint_t> node_idx;
+    node_idx.reserve(n_nodes);
+
+    for(uint_t d=0; d<dim; ++d){
+        coords_[d].reserve(n_nodes);
+    }
+
+    auto node_itr = mesh.nodes_begin();
+    auto node_itr_e = mesh.nodes_end();
+
+    for(; node_itr != node_itr_e; ++node_itr){
+
+        const Node<dim>* node = *node_itr;
+        node_idx.emplace(node, node_idx.size());
+
+        for(uint_t d=0; d<dim; ++d){
+            coords_[d].push_back((*node)[d]);
+        }
+    }
+
+    // elements are numbered in the order the
+    // topology stores them
+    std::unordered_map<const Element<dim>*, uint_t> elem_idx;
+    elem_idx.reserve(n_elements);
+
+    auto elem_itr = mesh.elements_begin();
+    auto elem_itr_e = mesh.elements_end();
+
+    for(; elem_itr != elem_itr_e; ++elem_itr){
+        elem_idx.emplace(*elem_itr, elem_idx.size());
+    }
+
+    elem_ids_.reserve(n_elements);
+    elem_pids_.reserve(n_elements);
+    elem_active_.reserve(n_elements);
+    elem_volumes_.reserve(n_elements);
+    elem_node_offsets_.reserve(n_elements + 1);
+    elem_face_offsets_.reserve(n_elements + 1);
+
+    for(uint_t d=0; d<dim; ++d){
+        elem_centroids_[d].reserve(n_elements);
+    }
+
+    elem_node_offsets_.push_back(0);
+    elem_face_offsets_.push_back(0);
+
+    // faces are shared so they are numbered the
+    // first time an element refers to them
+    std::unordered_map<const void*, uint_t> face_idx;
+
+    for(elem_itr = mesh.elements_begin(); elem_itr != elem_itr_e; ++elem_itr){
+
+        Element<dim>* elem = *elem_itr;
+
+        elem_ids_.push_back(elem->get_id());
+        elem_pids_.push_back(elem->get_pid());
+        elem_active_.push_back(elem->is_active());
+        elem_volumes_.push_back(elem->volume());
+
+        auto centroid = elem->centroid();
+        for(uint_t d=0; d<dim; ++d){
+            elem_centroids_[d].push_back(centroid[d]);
+        }
+
+        for(uint_t n=0; n<elem->n_nodes(); ++n){
+
+            auto itr = node_idx.find(elem->get_node(n));
+
+            if(itr == node_idx.end()){
+                throw std::logic_error("Node of element "+std::to_string(elem->get_id())+" is not in the mesh");
+            }
+
+            elem_nodes_.push_back(itr->second);
+        }
+
+        elem_node_offsets_.push_back(elem_nodes_.size());
+
+        for(uint_t f=0; f<elem->n_faces(); ++f){
+
+            const auto& face = static_cast<const Element<dim>*>(elem)->get_face(f);
+            auto result = face_idx.emplace(&face, face_idx.size());
+
+            if(result.second){
+
+                face_volumes_.push_back(face.volume());
+                face_boundary_.push_back(face.boundary_indicator());
+
+                auto fcentroid = face.centroid();
+                for(uint_t d=0; d<dim; ++d){
+                    face_centroids_[d].push_back(fcentroid[d]);
+                }
+            }
+
+            elem_faces_.push_back(result.first->second);
+
+            const Element<dim>* neigh = f < elem->n_neighbors() ? elem->neighbor_ptr(f) : nullptr;
+
+            if(neigh){
+                elem_neighbors_.push_back(elem_idx.at(neigh));
+            }
+            else{
+                elem_neighbors_.push_back(KernelConsts::invalid_size_type());
+            }
+        }
+
+        elem_face_offsets_.push_back(elem_faces_.size());
+    }
+
+    elements_.reserve(n_elements);
+    for(uint_t e=0; e<n_elements; ++e){
+        elements_.emplace_back(*this, e);
+    }
+}
+
+template<int dim>
+uint_t
+CompactMesh<dim>::memory_consumption()const{
+
+    uint_t bytes = 0;
+    for(uint_t d=0; d<dim; ++d){
+        bytes += (coords_[d].capacity() + elem_centroids_[d].capacity() + face_centroids_[d].capacity())*sizeof(real_t);
+    }
+
+    bytes += (elem_volumes_.capacity() + face_volumes_.capacity())*sizeof(real_t);
+    bytes += (elem_ids_.capacity() + elem_pids_.capacity() +
+              elem_node_offsets_.capacity() + elem_nodes_.capacity() +
+              elem_face_offsets_.capacity() + elem_faces_.capacity() +
+              elem_neighbors_.capacity() + face_boundary_.capacity())*sizeof(uint_t);
+    bytes += elem_active_.capacity()*sizeof(char);
+    bytes += elements_.capacity()*sizeof(element_t);
+    return bytes;
+}
+
+template class CompactMesh<1>;
+template class CompactMesh<2>;
+
+}
+
+}
@@ -0,0 +1,263 @@
+#ifndef COMPACT_MESH_H
+#define COMPACT_MESH_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/geometry/geom_point.h"
+
+#include "boost/noncopyable.hpp"
+#include "boost/iterator/transform_iterator.hpp"
+
+#include <array>
+#include <vector>
+
+namespace kernel{
+namespace numerics{
+
+/// forward declarations
+template<int dim> class Mesh;
+template<int dim> class CompactMesh;
+
+/// \brief Lightweight view of the e-th element of a CompactMesh.
+/// It exposes the same query interface the mesh predicates
+/// (Active, ActiveOnProc) use so that a CompactMesh can be iterated
+/// with ElementMeshIterator/ConstElementMeshIterator.
+/// All the connectivity is returned as indices into the
+/// CompactMesh arrays rather than pointers
+template<int dim>
+class CompactElement
+{
+
+public:
+
+    /// \brief Constructor
+    CompactElement(const CompactMesh<dim>& mesh, uint_t idx)
+        :
+        mesh_(&mesh),
+        idx_(idx)
+    {}
+
+    /// \brief The index of the element in the CompactMesh
+    uint_t index()const{return idx_;}
+
+    /// \brief The global id of the element as found in the Mesh
+    uint_t get_id()const{return mesh_->element_id(idx_);}
+
+    /// \brief The processor id of the element
+    uint_t get_pid()const{return mesh_->element_pid(idx_);}
+
+    /// \brief Returns true if the element is active
+    bool is_active()const{return mesh_->element_is_active(idx_);}
+
+    /// \brief Returns the number of nodes of the element
+    uint_t n_nodes()const{return mesh_->element_n_nodes(idx_);}
+
+    /// \brief Returns the index of the n-th node of the element
+    uint_t node(uint_t n)const{return mesh_->element_node(idx_, n);}
+
+    /// \brief Returns the number of faces of the element
+    uint_t n_faces()const{return mesh_->element_n_faces(idx_);}
+
+    /// \brief Returns the index of the f-th face of the element
+    uint_t face(uint_t f)const{return mesh_->element_face(idx_, f);}
+
+    /// \brief Returns the index of the element across the f-th face.
+    /// KernelConsts::invalid_size_type() if the face is on the boundary
+    uint_t neighbor(uint_t f)const{return mesh_->element_neighbor(idx_, f);}
+
+    /// \brief Returns true if the f-th face has a neighbor
+    bool has_neighbor(uint_t f)const{return neighbor(f) != KernelConsts::invalid_size_type();}
+
+    /// \brief Returns the number of neighbors of the element
+    uint_t n_neighbors()const;
+
+    /// \brief Returns the volume of the element
+    real_t volume()const{return mesh_->element_volume(idx_);}
+
+    /// \brief Returns the centroid of the element
+    GeomPoint<dim> centroid()const{return mesh_->element_centroid(idx_);}
+
+private:
+
+    /// \brief The mesh the view refers to
+    const CompactMesh<dim>* mesh_;
+
+    /// \brief The index of the element
+    uint_t idx_;
+};
+
+template<int dim>
+uint_t
+CompactElement<dim>::n_neighbors()const{
+
+    uint_t n = 0;
+    for(uint_t f=0; f<n_faces(); ++f){
+        if(has_neighbor(f)){
+            n++;
+        }
+    }
+
+    return n;
+}
+
+namespace detail{
+
+/// \brief Maps an element view to its address so that
+/// iterating a CompactMesh yields pointers like Mesh does
+template<typename T>
+struct address_of
+{
+    T* operator()(T& t)const{return &t;}
+};
+
+}
+
+/// \brief Flat, index based representation of a Mesh. Coordinates
+/// are stored per dimension in contiguous arrays and the element-to-node,
+/// element-to-face and element-to-neighbor relations are kept as
+/// CSR tables (offsets plus indices). The neighbor table shares the
+/// offsets of the face table; the entry for a boundary face is
+/// KernelConsts::invalid_size_type(). A CompactMesh is a snapshot of
+/// the Mesh it is built from and should be rebuilt if the Mesh changes
+template<int dim>
+class CompactMesh: private boost::noncopyable
+{
+
+public:
+
+    typedef CompactElement<dim> element_t;
+
+    /// \brief Element iteration
+    typedef boost::transform_iterator<detail::address_of<element_t>,
+                                      typename std::vector<element_t>::iterator,
+                                      element_t*, element_t*> element_iterator_impl;
+
+    typedef boost::transform_iterator<detail::address_of<const element_t>,
+                                      typename std::vector<element_t>::const_iterator,
+                                      const element_t*, const element_t*> celement_iterator_impl;
+
+    const static int dimension = dim;
+
+    /// \brief Constructor. Creates an empty CompactMesh
+    CompactMesh();
+
+    /// \brief Constructor. Build the compact representation
+    /// of the given mesh
+    explicit CompactMesh(const Mesh<dim>& mesh);
+
+    /// \brief Build the compact representation of the given mesh.
+    /// Any previous data is discarded
+    void build(const Mesh<dim>& mesh);
+
+    /// \brief Clear the memory
+    void clear();
+
+    /// \brief How many nodes the mesh has
+    uint_t n_nodes()const{return coords_[0].size();}
+
+    /// \brief How many elements the mesh has
+    uint_t n_elements()const{return elem_ids_.size();}
+
+    /// \brief How many faces the mesh has
+    uint_t n_faces()const{return face_volumes_.size();}
+
+    /// \brief Returns the d-th coordinate of the n-th node
+    real_t node_coordinate(uint_t n, uint_t d)const{return coords_[d][n];}
+
+    /// \brief Returns the coordinates of the nodes along
+    /// the d-th direction
+    const std::vector<real_t>& node_coordinates(uint_t d)const{return coords_[d];}
+
+    /// \brief Returns the view of the e-th element
+    const element_t& element(uint_t e)const{return elements_[e];}
+
+    /// \brief Element queries by index
+    uint_t element_id(uint_t e)const{return elem_ids_[e];}
+    uint_t element_pid(uint_t e)const{return elem_pids_[e];}
+    bool element_is_active(uint_t e)const{return elem_active_[e];}
+    real_t element_volume(uint_t e)const{return elem_volumes_[e];}
+    real_t element_centroid(uint_t e, uint_t d)const{return elem_centroids_[d][e];}
+    GeomPoint<dim> element_centroid(uint_t e)const;
+
+    uint_t element_n_nodes(uint_t e)const{return elem_node_offsets_[e + 1] - elem_node_offsets_[e];}
+    uint_t element_node(uint_t e, uint_t n)const{return elem_nodes_[elem_node_offsets_[e] + n];}
+
+    uint_t element_n_faces(uint_t e)const{return elem_face_offsets_[e + 1] - elem_face_offsets_[e];}
+    uint_t element_face(uint_t e, uint_t f)const{return elem_faces_[elem_face_offsets_[e] + f];}
+    uint_t element_neighbor(uint_t e, uint_t f)const{return elem_neighbors_[elem_face_offsets_[e] + f];}
+
+    /// \brief Face queries by index
+    real_t face_volume(uint_t f)const{return face_volumes_[f];}
+    real_t face_centroid(uint_t f, uint_t d)const{return face_centroids_[d][f];}
+    uint_t face_boundary_indicator(uint_t f)const{return face_boundary_[f];}
+    bool face_on_boundary(uint_t f)const{return face_boundary_[f] != KernelConsts::invalid_size_type();}
+
+    /// \brief Raw access to the CSR tables
+    const std::vector<uint_t>& element_node_offsets()const{return elem_node_offsets_;}
+    const std::vector<uint_t>& element_nodes()const{return elem_nodes_;}
+    const std::vector<uint_t>& element_face_offsets()const{return elem_face_offsets_;}
+    const std::vector<uint_t>& element_faces()const{return elem_faces_;}
+    const std::vector<uint_t>& element_neighbors()const{return elem_neighbors_;}
+
+    /// \brief Raw elements iteration
+    element_iterator_impl elements_begin(){return element_iterator_impl(elements_.begin());}
+    element_iterator_impl elements_end(){return element_iterator_impl(elements_.end());}
+
+    /// \brief Raw elements iteration
+    celement_iterator_impl elements_begin()const{return celement_iterator_impl(elements_.cbegin());}
+    celement_iterator_impl elements_end()const{return celement_iterator_impl(elements_.cend());}
+
+    /// \brief Returns an estimate of the memory in bytes
+    /// used by the compact representation
+    uint_t memory_consumption()const;
+
+private:
+
+    /// \brief The node coordinates one array per direction
+    std::array<std::vector<real_t>, dim> coords_;
+
+    /// \brief Per element data
+    std::vector<uint_t> elem_ids_;
+    std::vector<uint_t> elem_pids_;
+    std::vector<char> elem_active_;
+    std::vector<real_t> elem_volumes_;
+    std::array<std::vector<real_t>, dim> elem_centroids_;
+
+    /// \brief Element-to-node CSR table
+    std::vector<uint_t> elem_node_offsets_;
+    std::vector<uint_t> elem_nodes_;
+
+    /// \brief Element-to-face CSR table. The element-to-neighbor
+    /// table uses the same offsets
+    std::vector<uint_t> elem_face_offsets_;
+    std::vector<uint_t> elem_faces_;
+    std::vector<uint_t> elem_neighbors_;
+
+    /// \brief Per face data
+    std::vector<real_t> face_volumes_;
+    std::array<std::vector<real_t>, dim> face_centroids_;
+    std::vector<uint_t> face_boundary_;
+
+    /// \brief The element views handed out by the iterators
+    std::vector<element_t> elements_;
+
+};
+
+template<int dim>
+inline
+GeomPoint<dim>
+CompactMesh<dim>::element_centroid(uint_t e)const{
+
+    std::array<real_t, dim> coords;
+    for(uint_t d=0; d<dim; ++d){
+        coords[d] = elem_centroids_[d][e];
+    }
+
+    return GeomPoint<dim>(coords);
+}
+
+}
+
+}
+
+#endif // COMPACT_MESH_H
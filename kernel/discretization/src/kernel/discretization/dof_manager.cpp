@@ -3,35 +3,74 @@
 #include "kernel/discretization/mesh_predicates.h"
 #include "kernel/discretization/element.h"
 #include "kernel/discretization/mesh.h"
+#include "kernel/base/kernel_consts.h"
+
+#include <algorithm>
+#include <exception>
+#include <string>
 
 namespace kernel{
 namespace numerics {
 
 template<int dim>
-FVDoFManager<dim>::FVDoFManager()
+FVDoFManager<dim>::FVDoFManager(DoFStorageType type)
     :
       n_dofs_(0),
-      var_name_("")
-{}
+      var_name_(""),
+      storage_type_(DoFStorageType::ELEMENT_MAP),
+      dof_ids_()
+{
+    set_storage_type(type);
+}
 
 template<int dim>
 FVDoFManager<dim>::~FVDoFManager()
 {}
 
 
+template<int dim>
+void
+FVDoFManager<dim>::set_storage_type(DoFStorageType type){
+
+    if(type == DoFStorageType::INVALID_TYPE){
+        throw std::logic_error("Invalid DoFStorageType given");
+    }
+
+    storage_type_ = type;
+}
+
 template<int dim>
 void
 FVDoFManager<dim>::invalidate_dofs(Mesh<dim>& mesh){
 
     n_dofs_ = 0;
+
+    if(storage_type_ == DoFStorageType::FLAT_ARRAY){
+
+        // element ids are used as indices into the flat array.
+        // Elements without a DoF keep an invalid index
+        uint_t max_id = 0;
+        auto begin = mesh.elements_begin();
+        auto end = mesh.elements_end();
+
+        for(; begin != end; ++begin){
+            max_id = std::max(max_id, (*begin)->get_id() + 1);
+        }
+
+        dof_ids_.assign(max_id, KernelConsts::invalid_size_type());
+        return;
+    }
+
     ElementMeshIterator<Active, Mesh<dim>> filter(mesh);
     auto begin = filter.begin();
     auto end = filter.end();
 
     for(; begin != end; begin++){
 
+        // remove rather than invalidate so that
+        // the dofs can be distributed again
         auto* elem = *begin;
-        elem->invalidate_dofs(var_name_);
+        elem->remove_dofs(var_name_);
     }
 }
 
@@ -48,7 +87,13 @@ FVDoFManager<dim>::do_distribute_dofs(Mesh<dim>& mesh){
     for(; begin != end; begin++){
 
         auto* elem = *begin;
-        elem->insert_dof({var_name_, next_available_id++, true});
+
+        if(storage_type_ == DoFStorageType::FLAT_ARRAY){
+            dof_ids_[elem->get_id()] = next_available_id++;
+        }
+        else{
+            elem->insert_dof({var_name_, next_available_id++, true});
+        }
     }
 
     // set the dofs distributed
@@ -59,9 +104,153 @@ template<int dim>
 void
 FVDoFManager<dim>::get_dofs(const Element<dim>& elem, std::vector<DoF>& dofs)const{
 
+    if(storage_type_ == DoFStorageType::FLAT_ARRAY){
+        dofs.clear();
+        dofs.push_back(get_dof(elem));
+        return;
+    }
+
     elem.get_dofs(var_name_, dofs);
 }
 
+template<int dim>
+DoF
+FVDoFManager<dim>::get_dof(const Element<dim>& elem)const{
+
+    if(storage_type_ == DoFStorageType::FLAT_ARRAY){
+
+        uint_t id = elem.get_id() < dof_ids_.size() ? dof_ids_[elem.get_id()] : KernelConsts::invalid_size_type();
+        return {var_name_, id, id != KernelConsts::invalid_size_type()};
+    }
+
+    return elem.get_dof(var_name_);
+}
+
+template<int dim>
+void
+FVDoFManager<dim>::get_element_dofs(const Element<dim>& elem, std::vector<DoF>& cell_dofs,
+                                    std::vector<DoF>& neigh_dofs)const{
+
+    cell_dofs.clear();
+    cell_dofs.push_back(get_dof(elem));
+
+    if (cell_dofs[0].id == KernelConsts::invalid_size_type()) {
+        throw std::logic_error("Invalid DoF index");
+    }
+
+    neigh_dofs.clear();
+    neigh_dofs.reserve(elem.n_neighbors());
+
+    // get the dofs off the neighbors
+    for(uint_t neigh=0; neigh<elem.n_neighbors(); ++neigh){
+
+        auto* neigh_elem = elem.neighbor_ptr(neigh);
+
+        if(neigh_elem){
+
+            auto dof = get_dof(*neigh_elem);
+
+            if (dof.id == KernelConsts::invalid_size_type()) {
+                throw std::logic_error("Invalid DoF index");
+            }
+
+            neigh_dofs.push_back(dof);
+        }
+    }
+}
+
+template<int dim>
+uint_t
+FVDoFManager<dim>::get_dof_id(uint_t elem_id)const{
+
+    if(storage_type_ != DoFStorageType::FLAT_ARRAY){
+        throw std::logic_error("get_dof_id requires DoFStorageType::FLAT_ARRAY");
+    }
+
+    if(elem_id >= dof_ids_.size()){
+        throw std::logic_error("Element id " + std::to_string(elem_id) +
+                               " not in [0, " + std::to_string(dof_ids_.size()) + ")");
+    }
+
+    return dof_ids_[elem_id];
+}
+
+template<int dim>
+void
+FVDoFManager<dim>::sparsity_pattern(const Mesh<dim>& mesh, std::vector<uint_t>& row_offsets,
+                                    std::vector<uint_t>& columns)const{
+
+    // the number of neighbors of every row
+    std::vector<uint_t> n_entries(n_dofs_, 0);
+
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    auto elem_itr = filter.begin();
+    auto elem_itr_e = filter.end();
+
+    for(; elem_itr != elem_itr_e; ++elem_itr){
+
+        auto* elem = *elem_itr;
+        auto dof = get_dof(*elem);
+
+        if(dof.id == KernelConsts::invalid_size_type() || dof.id >= n_dofs_){
+            throw std::logic_error("Invalid DoF index for element "+std::to_string(elem->get_id()));
+        }
+
+        n_entries[dof.id] = 1 + elem->n_neighbors();
+    }
+
+    row_offsets.assign(n_dofs_ + 1, 0);
+    for(uint_t r=0; r<n_dofs_; ++r){
+        row_offsets[r + 1] = row_offsets[r] + n_entries[r];
+    }
+
+    columns.assign(row_offsets.back(), KernelConsts::invalid_size_type());
+
+    for(elem_itr = filter.begin(); elem_itr != elem_itr_e; ++elem_itr){
+
+        auto* elem = *elem_itr;
+        const uint_t row = get_dof(*elem).id;
+
+        uint_t pos = row_offsets[row];
+        columns[pos++] = row;
+
+        for(uint_t n=0; n<elem->n_neighbors(); ++n){
+
+            auto* neigh = elem->neighbor_ptr(n);
+
+            if(neigh){
+
+                auto dof = get_dof(*neigh);
+
+                if(dof.id != KernelConsts::invalid_size_type()){
+                    columns[pos++] = dof.id;
+                }
+            }
+        }
+
+        std::sort(columns.begin() + row_offsets[row] + 1, columns.begin() + pos);
+
+        // boundary faces leave unused slots at the end of the row
+        n_entries[row] = pos - row_offsets[row];
+    }
+
+    // compact the rows
+    uint_t pos = 0;
+    for(uint_t r=0; r<n_dofs_; ++r){
+
+        const uint_t start = row_offsets[r];
+        row_offsets[r] = pos;
+
+        for(uint_t c=0; c<n_entries[r]; ++c){
+            columns[pos++] = columns[start + c];
+        }
+    }
+
+    row_offsets[n_dofs_] = pos;
+    columns.resize(pos);
+}
+
 template class FVDoFManager<1>;
 template class FVDoFManager<2>;
 template class FVDoFManager<3>;
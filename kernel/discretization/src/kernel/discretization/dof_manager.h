@@ -2,8 +2,11 @@
 #define DOF_MANAGER_H
 
 #include "kernel/base/types.h"
+#include "kernel/discretization/dof.h"
+#include "kernel/discretization/dof_storage_types.h"
 
 #include <string>
+#include <vector>
 
 namespace kernel{
 namespace numerics {
@@ -11,7 +14,6 @@ namespace numerics {
 template<int dim> class Mesh;
 template<int dim> class Element;
 class ScalarVar;
-class DoF;
 
 template<int dim>
 class FVDoFManager
@@ -19,7 +21,7 @@ class FVDoFManager
 public:
 
     /// \brief Constructor
-    FVDoFManager();
+    FVDoFManager(DoFStorageType type=DoFStorageType::ELEMENT_MAP);
 
     /// \brief Destructor
     virtual ~FVDoFManager();
@@ -31,6 +33,43 @@ public:
     /// \brief Get the dofs on the given elem
     void get_dofs(const Element<dim>& elem, std::vector<DoF>& dofs)const;
 
+    /// \brief Get the dof on the given elem. Unlike get_dofs
+    /// this does not allocate. The returned DoF has an invalid id
+    /// if the element has no dof
+    DoF get_dof(const Element<dim>& elem)const;
+
+    /// \brief Get the dof of the element and the dofs of its face neighbors.
+    /// It throws std::logic_error if any of them has no dof. The vectors are
+    /// cleared but keep their capacity so that callers reusing them across
+    /// elements allocate only for the first element
+    void get_element_dofs(const Element<dim>& elem, std::vector<DoF>& cell_dofs,
+                          std::vector<DoF>& neigh_dofs)const;
+
+    /// \brief Returns the DoF index of the element with the given id.
+    /// Only available with DoFStorageType::FLAT_ARRAY. It throws
+    /// std::logic_error for any other storage type or if the id is
+    /// out of range
+    uint_t get_dof_id(uint_t elem_id)const;
+
+    /// \brief Returns the flat array of DoF indices indexed by the
+    /// element id. Empty unless DoFStorageType::FLAT_ARRAY is used
+    const std::vector<uint_t>& get_dof_ids()const{return dof_ids_;}
+
+    /// \brief Set how the dofs are stored. This should be called
+    /// before distribute_dofs
+    void set_storage_type(DoFStorageType type);
+
+    /// \brief Returns how the dofs are stored
+    DoFStorageType get_storage_type()const{return storage_type_;}
+
+    /// \brief Compute the CSR sparsity pattern of a cell centred
+    /// operator on the given mesh. Row r holds the dof r itself followed
+    /// by the dofs of the face neighbors of its element in increasing order.
+    /// The pattern depends only on the mesh connectivity so it can be reused
+    /// for as long as the mesh and the dofs do not change
+    void sparsity_pattern(const Mesh<dim>& mesh, std::vector<uint_t>& row_offsets,
+                          std::vector<uint_t>& columns)const;
+
     /// returns the number of dofs
     uint_t n_dofs()const{return n_dofs_;}
 
@@ -53,6 +92,13 @@ private:
 
     /// \brief The name of the variable the manager is working on
     std::string_view var_name_;
+
+    /// \brief How the dofs are stored
+    DoFStorageType storage_type_;
+
+    /// \brief The DoF index of every element indexed by the
+    /// element id when DoFStorageType::FLAT_ARRAY is used
+    std::vector<uint_t> dof_ids_;
 };
 
 template<int dim>
@@ -62,6 +108,7 @@ FVDoFManager<dim>::distribute_dofs(Mesh<dim>& mesh, const VarTp& var){
 
     n_dofs_ = 0;
     var_name_ = var.name();
+    dof_ids_.clear();
 
     invalidate_dofs(mesh);
     do_distribute_dofs(mesh);
@@ -48,7 +48,8 @@ DoFObject::get_dof(std::string_view name)const{
         return itr->second;
     }
 
-    return DoF();
+    // no dof for the variable
+    return {name, KernelConsts::invalid_size_type(), false};
 }
 }
 
@@ -34,6 +34,10 @@ public:
     /// with the given name
     void invalidate_dofs(std::string_view name);
 
+    /// \brief Remove the DoF of the variable with the
+    /// given name so that it can be inserted again
+    void remove_dofs(std::string_view name){dofs_.erase(name);}
+
     /// \brief Returns the DoF for the given variable
     DoF get_dof(std::string_view name)const;
 
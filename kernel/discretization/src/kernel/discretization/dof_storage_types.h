@@ -0,0 +1,17 @@
+#ifndef DOF_STORAGE_TYPES_H
+#define DOF_STORAGE_TYPES_H
+
+namespace kernel{
+namespace numerics{
+
+/// \brief How a DoF manager stores the DoF indices it distributes.
+/// ELEMENT_MAP stores them in the DoFObject of every element keyed by
+/// the variable name. FLAT_ARRAY stores them in a single array owned
+/// by the manager and indexed by the element id
+enum class DoFStorageType{ELEMENT_MAP,
+                          FLAT_ARRAY,
+                          INVALID_TYPE};
+}
+}
+
+#endif // DOF_STORAGE_TYPES_H
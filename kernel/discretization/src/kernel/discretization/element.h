@@ -119,6 +119,10 @@ public:
     /// the given variable
     void invalidate_dofs(const std::string_view name);
 
+    /// \brief Remove the dofs associated with
+    /// the given variable
+    void remove_dofs(const std::string_view name){dofs_.remove_dofs(name);}
+
     /// \brief Invalidate the dofs associated with
     /// the given variable
     void insert_dof(DoF&& dof);
@@ -126,6 +130,9 @@ public:
     /// \brief Return the dofs for the given variable
     void get_dofs(std::string_view name, std::vector<DoF>& dofs)const;
 
+    /// \brief Return the dof for the given variable
+    DoF get_dof(std::string_view name)const{return dofs_.get_dof(name);}
+
     /// \brief Returns the local id relevant to the calling object
     /// of the  passed  object
     uint_t which_neighbor_am_i(const Element<dim>& element)const;
@@ -58,6 +58,18 @@ public:
     void reserve_n_edges(uint_t n){topology_.reserve_n_edges(n);}
     void reserve_n_faces(uint_t n){topology_.reserve_n_faces(n);}
 
+    /// \brief Resize the topology of an empty mesh so that it holds
+    /// n null nodes/elements/faces. create_vertex, create_element and
+    /// create_face with a global id in the resized range then only store
+    /// the pointer and may therefore be called concurrently for distinct ids
+    void resize_n_nodes(uint_t n){topology_.resize_n_nodes(n);}
+    void resize_n_elements(uint_t n){topology_.resize_n_elements(n);}
+    void resize_n_faces(uint_t n){topology_.resize_n_faces(n);}
+
+    /// \brief Renumber the elements. The element with id e gets the
+    /// id new_ids[e]. Any DoFs should be distributed again afterwards
+    void renumber_elements(const std::vector<uint_t>& new_ids){topology_.renumber_elements(new_ids);}
+
    /**
      *\detailed create a vertex by passing in the coordinates
      *of the vertex. This will create a Node so optionally we can
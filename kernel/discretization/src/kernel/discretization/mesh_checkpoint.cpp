@@ -0,0 +1,186 @@
+#include "kernel/discretization/mesh_checkpoint.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+#include "kernel/base/kernel_consts.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace kernel{
+namespace numerics{
+
+namespace{
+
+/// \brief The DoF index of every active element
+/// indexed by the element id
+template<int dim>
+std::vector<uint_t>
+dof_map(const Mesh<dim>& mesh, const FVDoFManager<dim>& manager){
+
+    std::vector<uint_t> dofs;
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+
+        auto* element = *itr;
+
+        if(element->get_id() >= dofs.size()){
+            dofs.resize(element->get_id() + 1, KernelConsts::invalid_size_type());
+        }
+
+        dofs[element->get_id()] = manager.get_dof(*element).id;
+    }
+
+    return dofs;
+}
+
+}
+
+std::string
+dof_section_name(const std::string& var_name){
+    return "dofs/" + var_name;
+}
+
+template<int dim>
+void
+add_mesh_sections(CheckpointWriter& checkpoint, const Mesh<dim>& mesh){
+
+    std::vector<real_t> nodes;
+    nodes.reserve(dim*mesh.n_nodes());
+
+    for(uint_t n=0; n<mesh.n_nodes(); ++n){
+
+        auto* node = mesh.node(n);
+        for(int d=0; d<dim; ++d){
+            nodes.push_back((*node)[d]);
+        }
+    }
+
+    std::vector<uint_t> ids;
+    std::vector<uint_t> offsets(1, 0);
+    std::vector<uint_t> connectivity;
+    std::vector<uint_t> pids;
+
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+
+        auto* element = *itr;
+        ids.push_back(element->get_id());
+        pids.push_back(element->get_pid());
+
+        for(uint_t v=0; v<element->n_vertices(); ++v){
+            connectivity.push_back(element->get_node(v)->get_id());
+        }
+
+        offsets.push_back(connectivity.size());
+    }
+
+    checkpoint.add_section("mesh/nodes", std::move(nodes));
+    checkpoint.add_section("mesh/element_ids", std::move(ids));
+    checkpoint.add_section("mesh/element_offsets", std::move(offsets));
+    checkpoint.add_section("mesh/element_nodes", std::move(connectivity));
+    checkpoint.add_section("mesh/element_pids", std::move(pids));
+}
+
+template<int dim>
+void
+add_dof_sections(CheckpointWriter& checkpoint, const Mesh<dim>& mesh,
+                 const FVDoFManager<dim>& manager){
+
+    checkpoint.add_section(dof_section_name(std::string(manager.var_name())), dof_map(mesh, manager));
+}
+
+template<int dim>
+void
+check_mesh_sections(const CheckpointReader& checkpoint, const Mesh<dim>& mesh){
+
+    auto nodes = checkpoint.get_real_section("mesh/nodes");
+
+    if(nodes.size() != dim*mesh.n_nodes()){
+        throw std::logic_error("The checkpoint has "+std::to_string(nodes.size()/dim)+
+                               " nodes but the mesh has "+std::to_string(mesh.n_nodes()));
+    }
+
+    for(uint_t n=0; n<mesh.n_nodes(); ++n){
+
+        auto* node = mesh.node(n);
+        for(int d=0; d<dim; ++d){
+
+            if(nodes[dim*n + d] != (*node)[d]){
+                throw std::logic_error("Node "+std::to_string(n)+" of the checkpoint is not at the mesh node");
+            }
+        }
+    }
+
+    auto ids = checkpoint.get_uint_section("mesh/element_ids");
+    auto offsets = checkpoint.get_uint_section("mesh/element_offsets");
+    auto connectivity = checkpoint.get_uint_section("mesh/element_nodes");
+
+    if(offsets.size() != ids.size() + 1 || offsets[ids.size()] != connectivity.size()){
+        throw std::logic_error("The checkpoint element connectivity is corrupted");
+    }
+
+    uint_t e = 0;
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr, ++e){
+
+        auto* element = *itr;
+
+        if(e >= ids.size() || ids[e] != element->get_id() ||
+           offsets[e + 1] - offsets[e] != element->n_vertices()){
+            throw std::logic_error("Element "+std::to_string(element->get_id())+" does not match the checkpoint");
+        }
+
+        for(uint_t v=0; v<element->n_vertices(); ++v){
+
+            if(connectivity[offsets[e] + v] != element->get_node(v)->get_id()){
+                throw std::logic_error("Element "+std::to_string(element->get_id())+" does not match the checkpoint");
+            }
+        }
+    }
+
+    if(e != ids.size()){
+        throw std::logic_error("The checkpoint has "+std::to_string(ids.size())+
+                               " active elements but the mesh has "+std::to_string(e));
+    }
+}
+
+template<int dim>
+void
+check_dof_sections(const CheckpointReader& checkpoint, const Mesh<dim>& mesh,
+                   const FVDoFManager<dim>& manager){
+
+    auto dofs = checkpoint.get_uint_section(dof_section_name(std::string(manager.var_name())));
+    const auto expected = dof_map(mesh, manager);
+
+    if(dofs.size() != expected.size() || !std::equal(expected.begin(), expected.end(), dofs.begin())){
+        throw std::logic_error("The DoF map of variable "+std::string(manager.var_name())+
+                               " does not match the checkpoint");
+    }
+}
+
+template void add_mesh_sections(CheckpointWriter& checkpoint, const Mesh<1>& mesh);
+template void add_mesh_sections(CheckpointWriter& checkpoint, const Mesh<2>& mesh);
+template void add_mesh_sections(CheckpointWriter& checkpoint, const Mesh<3>& mesh);
+
+template void add_dof_sections(CheckpointWriter& checkpoint, const Mesh<1>& mesh, const FVDoFManager<1>& manager);
+template void add_dof_sections(CheckpointWriter& checkpoint, const Mesh<2>& mesh, const FVDoFManager<2>& manager);
+template void add_dof_sections(CheckpointWriter& checkpoint, const Mesh<3>& mesh, const FVDoFManager<3>& manager);
+
+template void check_mesh_sections(const CheckpointReader& checkpoint, const Mesh<1>& mesh);
+template void check_mesh_sections(const CheckpointReader& checkpoint, const Mesh<2>& mesh);
+template void check_mesh_sections(const CheckpointReader& checkpoint, const Mesh<3>& mesh);
+
+template void check_dof_sections(const CheckpointReader& checkpoint, const Mesh<1>& mesh, const FVDoFManager<1>& manager);
+template void check_dof_sections(const CheckpointReader& checkpoint, const Mesh<2>& mesh, const FVDoFManager<2>& manager);
+template void check_dof_sections(const CheckpointReader& checkpoint, const Mesh<3>& mesh, const FVDoFManager<3>& manager);
+
+}
+}
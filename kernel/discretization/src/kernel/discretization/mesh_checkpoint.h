@@ -0,0 +1,47 @@
+#ifndef MESH_CHECKPOINT_H
+#define MESH_CHECKPOINT_H
+
+#include "kernel/base/types.h"
+#include "kernel/utilities/checkpoint_file.h"
+
+#include <string>
+
+namespace kernel{
+namespace numerics{
+
+/// forward declarations
+template<int dim> class Mesh;
+template<int dim> class FVDoFManager;
+
+/// \brief Add the topology of the mesh to the checkpoint. The sections are
+/// mesh/nodes with dim coordinates per node, mesh/element_ids,
+/// mesh/element_offsets and mesh/element_nodes with the CSR connectivity
+/// and mesh/element_pids for the active elements in iteration order
+template<int dim>
+void add_mesh_sections(CheckpointWriter& checkpoint, const Mesh<dim>& mesh);
+
+/// \brief Add the DoF map of the manager to the checkpoint. The section
+/// dofs/var_name holds the DoF index of every active element indexed
+/// by the element id and KernelConsts::invalid_size_type() otherwise
+template<int dim>
+void add_dof_sections(CheckpointWriter& checkpoint, const Mesh<dim>& mesh,
+                      const FVDoFManager<dim>& manager);
+
+/// \brief Check that the checkpoint was written from a mesh with the same
+/// topology. Throws std::logic_error at the first difference
+template<int dim>
+void check_mesh_sections(const CheckpointReader& checkpoint, const Mesh<dim>& mesh);
+
+/// \brief Check that the checkpoint was written with the same DoF
+/// map as the given manager. Throws std::logic_error otherwise
+template<int dim>
+void check_dof_sections(const CheckpointReader& checkpoint, const Mesh<dim>& mesh,
+                        const FVDoFManager<dim>& manager);
+
+/// \brief The name of the section that holds the DoF map of the variable
+std::string dof_section_name(const std::string& var_name);
+
+}
+}
+
+#endif // MESH_CHECKPOINT_H
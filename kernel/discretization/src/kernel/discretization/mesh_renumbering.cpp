@@ -0,0 +1,491 @@
+#include "kernel/discretization/mesh_renumbering.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/base/kernel_consts.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <utility>
+
+namespace kernel{
+namespace numerics{
+
+namespace{
+
+/// \brief Returns the element with the given id. The element
+/// ids must be the positions of the elements in the mesh
+template<int dim>
+const Element<dim>*
+get_element(const Mesh<dim>& mesh, uint_t id){
+
+    auto* element = *(mesh.elements_begin() + id);
+
+    if(!element){
+        throw std::logic_error("NULL pointer element");
+    }
+
+    if(element->get_id() != id){
+        throw std::logic_error("Element with id " + std::to_string(element->get_id()) +
+                               " is stored at position " + std::to_string(id));
+    }
+
+    return element;
+}
+
+/// \brief Breadth first search from root over the elements that are not
+/// numbered yet. On output reached holds the reached elements ordered by
+/// level and levels the level of each of them. marks and stamp are used
+/// to flag the reached elements without clearing an array every time
+template<int dim>
+void
+level_structure(const Mesh<dim>& mesh, uint_t root, const std::vector<bool>& numbered,
+                std::vector<uint_t>& marks, uint_t stamp,
+                std::vector<uint_t>& reached, std::vector<uint_t>& levels){
+
+    reached.clear();
+    levels.clear();
+
+    reached.push_back(root);
+    levels.push_back(0);
+    marks[root] = stamp;
+
+    for(uint_t pos=0; pos<reached.size(); ++pos){
+
+        auto* element = get_element(mesh, reached[pos]);
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+            auto* neigh = element->neighbor_ptr(n);
+
+            if(neigh && !numbered[neigh->get_id()] && marks[neigh->get_id()] != stamp){
+
+                marks[neigh->get_id()] = stamp;
+                reached.push_back(neigh->get_id());
+                levels.push_back(levels[pos] + 1);
+            }
+        }
+    }
+}
+
+/// \brief Interleave the bits of the given coordinates into a single key.
+/// The most significant bit of the first coordinate comes first
+template<int dim>
+std::uint64_t
+interleave(const std::uint32_t (&x)[dim], uint_t bits){
+
+    std::uint64_t key = 0;
+    for(int b=static_cast<int>(bits) - 1; b>=0; --b){
+        for(int d=0; d<dim; ++d){
+            key = (key << 1) | ((x[d] >> b) & 1u);
+        }
+    }
+
+    return key;
+}
+
+/// \brief Transform the coordinates into the transposed Hilbert index
+/// (J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 2004).
+/// Interleaving the result gives the position along the Hilbert curve
+template<int dim>
+void
+axes_to_transpose(std::uint32_t (&x)[dim], uint_t bits){
+
+    const std::uint32_t m = std::uint32_t(1) << (bits - 1);
+
+    // inverse undo
+    for(std::uint32_t q = m; q > 1; q >>= 1){
+
+        const std::uint32_t p = q - 1;
+        for(int d=0; d<dim; ++d){
+
+            if(x[d] & q){
+                x[0] ^= p;
+            }
+            else{
+                const std::uint32_t t = (x[0] ^ x[d]) & p;
+                x[0] ^= t;
+                x[d] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for(int d=1; d<dim; ++d){
+        x[d] ^= x[d - 1];
+    }
+
+    std::uint32_t t = 0;
+    for(std::uint32_t q = m; q > 1; q >>= 1){
+        if(x[dim - 1] & q){
+            t ^= q - 1;
+        }
+    }
+
+    for(int d=0; d<dim; ++d){
+        x[d] ^= t;
+    }
+}
+
+/// \brief Order the elements by the key of their centroid
+/// on the Hilbert or the Morton curve
+template<int dim>
+void
+space_filling_curve_ordering(const Mesh<dim>& mesh, std::vector<uint_t>& new_ids, bool hilbert){
+
+    const uint_t n_elements = mesh.n_elements();
+
+    // the number of bits per coordinate such that the key fits in 64 bits
+    const uint_t bits = std::min(static_cast<uint_t>(32), static_cast<uint_t>(64/dim));
+
+    std::vector<GeomPoint<dim>> centroids;
+    centroids.reserve(n_elements);
+
+    GeomPoint<dim> lower(std::numeric_limits<real_t>::max());
+    GeomPoint<dim> upper(std::numeric_limits<real_t>::lowest());
+
+    for(uint_t e=0; e<n_elements; ++e){
+
+        centroids.push_back(get_element(mesh, e)->centroid());
+
+        for(int d=0; d<dim; ++d){
+            lower[d] = std::min(lower[d], centroids.back()[d]);
+            upper[d] = std::max(upper[d], centroids.back()[d]);
+        }
+    }
+
+    const real_t max_coordinate = static_cast<real_t>((std::uint64_t(1) << bits) - 1);
+
+    std::vector<std::uint64_t> keys(n_elements, 0);
+
+    for(uint_t e=0; e<n_elements; ++e){
+
+        std::uint32_t x[dim];
+
+        for(int d=0; d<dim; ++d){
+
+            const real_t length = upper[d] - lower[d];
+            const real_t scaled = length > 0.0 ? (centroids[e][d] - lower[d])/length : 0.0;
+            x[d] = static_cast<std::uint32_t>(scaled*max_coordinate);
+        }
+
+        // in 1D both curves are the coordinate order
+        if(hilbert && dim > 1){
+            axes_to_transpose<dim>(x, bits);
+        }
+
+        keys[e] = interleave<dim>(x, bits);
+    }
+
+    std::vector<uint_t> order(n_elements);
+    std::iota(order.begin(), order.end(), 0);
+
+    std::stable_sort(order.begin(), order.end(),
+                     [&keys](uint_t e1, uint_t e2){return keys[e1] < keys[e2];});
+
+    new_ids.resize(n_elements);
+    for(uint_t pos=0; pos<n_elements; ++pos){
+        new_ids[order[pos]] = pos;
+    }
+}
+
+/// \brief Compute the bandwidth and the profile of the element
+/// adjacency with the rows numbered by row_of
+template<int dim, typename RowOp>
+std::pair<uint_t, uint_t>
+bandwidth_and_profile(const Mesh<dim>& mesh, const RowOp& row_of){
+
+    uint_t bandwidth = 0;
+    uint_t profile = 0;
+
+    auto begin = mesh.elements_begin();
+    auto end = mesh.elements_end();
+
+    for(; begin != end; ++begin){
+
+        auto* element = *begin;
+
+        if(!element){
+            continue;
+        }
+
+        const uint_t row = row_of(*element);
+
+        if(row == KernelConsts::invalid_size_type()){
+            continue;
+        }
+
+        uint_t first_column = row;
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+            auto* neigh = element->neighbor_ptr(n);
+
+            if(!neigh){
+                continue;
+            }
+
+            const uint_t column = row_of(*neigh);
+
+            if(column == KernelConsts::invalid_size_type()){
+                continue;
+            }
+
+            bandwidth = std::max(bandwidth, row > column ? row - column : column - row);
+            first_column = std::min(first_column, column);
+        }
+
+        profile += row - first_column;
+    }
+
+    return {bandwidth, profile};
+}
+
+}
+
+std::string
+element_ordering_to_string(ElementOrderingType type){
+
+    switch(type){
+
+        case ElementOrderingType::RCM:
+            return "RCM";
+        case ElementOrderingType::HILBERT:
+            return "HILBERT";
+        case ElementOrderingType::MORTON:
+            return "MORTON";
+        default:
+            break;
+    }
+
+    return "INVALID_TYPE";
+}
+
+template<int dim>
+void
+rcm_ordering(const Mesh<dim>& mesh, std::vector<uint_t>& new_ids){
+
+    const uint_t n_elements = mesh.n_elements();
+
+    std::vector<uint_t> degrees(n_elements, 0);
+
+    for(uint_t e=0; e<n_elements; ++e){
+
+        auto* element = get_element(mesh, e);
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+            if(element->neighbor_ptr(n)){
+                degrees[e]++;
+            }
+        }
+    }
+
+    // the elements in Cuthill-McKee order
+    std::vector<uint_t> order;
+    order.reserve(n_elements);
+
+    std::vector<bool> numbered(n_elements, false);
+    std::vector<uint_t> marks(n_elements, KernelConsts::invalid_size_type());
+    uint_t stamp = 0;
+
+    std::vector<uint_t> reached;
+    std::vector<uint_t> levels;
+    std::vector<uint_t> candidate_reached;
+    std::vector<uint_t> candidate_levels;
+    std::vector<uint_t> neighbors;
+
+    // elements sorted by degree so that every component
+    // starts the search from an element of minimum degree
+    std::vector<uint_t> by_degree(n_elements);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    std::stable_sort(by_degree.begin(), by_degree.end(),
+                     [&degrees](uint_t e1, uint_t e2){return degrees[e1] < degrees[e2];});
+
+    for(auto start : by_degree){
+
+        if(numbered[start]){
+            continue;
+        }
+
+        // find a pseudo-peripheral root with the George-Liu algorithm:
+        // restart from the element of minimum degree in the last level
+        // for as long as the number of levels increases
+        uint_t root = start;
+        level_structure(mesh, root, numbered, marks, stamp++, reached, levels);
+
+        while(true){
+
+            const uint_t last_level = levels.back();
+            uint_t candidate = root;
+            uint_t candidate_degree = std::numeric_limits<uint_t>::max();
+
+            for(uint_t pos=reached.size(); pos-- > 0 && levels[pos] == last_level;){
+
+                if(degrees[reached[pos]] < candidate_degree){
+                    candidate = reached[pos];
+                    candidate_degree = degrees[reached[pos]];
+                }
+            }
+
+            level_structure(mesh, candidate, numbered, marks, stamp++, candidate_reached, candidate_levels);
+
+            if(candidate_levels.back() <= last_level){
+                break;
+            }
+
+            root = candidate;
+            reached.swap(candidate_reached);
+            levels.swap(candidate_levels);
+        }
+
+        // Cuthill-McKee from the root. The neighbors are
+        // visited in increasing degree
+        const uint_t component_begin = order.size();
+        order.push_back(root);
+        numbered[root] = true;
+
+        for(uint_t pos=component_begin; pos<order.size(); ++pos){
+
+            auto* element = get_element(mesh, order[pos]);
+
+            neighbors.clear();
+            for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+                auto* neigh = element->neighbor_ptr(n);
+
+                if(neigh && !numbered[neigh->get_id()]){
+                    numbered[neigh->get_id()] = true;
+                    neighbors.push_back(neigh->get_id());
+                }
+            }
+
+            std::sort(neighbors.begin(), neighbors.end(),
+                      [&degrees](uint_t e1, uint_t e2){
+                          return degrees[e1] != degrees[e2] ? degrees[e1] < degrees[e2] : e1 < e2;});
+
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+
+    // reverse the order
+    new_ids.resize(n_elements);
+    for(uint_t pos=0; pos<n_elements; ++pos){
+        new_ids[order[pos]] = n_elements - 1 - pos;
+    }
+}
+
+template<int dim>
+void
+hilbert_ordering(const Mesh<dim>& mesh, std::vector<uint_t>& new_ids){
+    space_filling_curve_ordering(mesh, new_ids, true);
+}
+
+template<int dim>
+void
+morton_ordering(const Mesh<dim>& mesh, std::vector<uint_t>& new_ids){
+    space_filling_curve_ordering(mesh, new_ids, false);
+}
+
+template<int dim>
+uint_t
+element_bandwidth(const Mesh<dim>& mesh){
+
+    auto row_of = [](const Element<dim>& element){return element.get_id();};
+    return bandwidth_and_profile(mesh, row_of).first;
+}
+
+template<int dim>
+uint_t
+element_profile(const Mesh<dim>& mesh){
+
+    auto row_of = [](const Element<dim>& element){return element.get_id();};
+    return bandwidth_and_profile(mesh, row_of).second;
+}
+
+template<int dim>
+uint_t
+dof_bandwidth(const Mesh<dim>& mesh, const FVDoFManager<dim>& dof_manager){
+
+    auto row_of = [&dof_manager](const Element<dim>& element){return dof_manager.get_dof(element).id;};
+    return bandwidth_and_profile(mesh, row_of).first;
+}
+
+template<int dim>
+uint_t
+dof_profile(const Mesh<dim>& mesh, const FVDoFManager<dim>& dof_manager){
+
+    auto row_of = [&dof_manager](const Element<dim>& element){return dof_manager.get_dof(element).id;};
+    return bandwidth_and_profile(mesh, row_of).second;
+}
+
+template<int dim>
+RenumberingReport
+renumber_elements(Mesh<dim>& mesh, ElementOrderingType type){
+
+    std::vector<uint_t> new_ids;
+
+    switch(type){
+
+        case ElementOrderingType::RCM:
+            rcm_ordering(mesh, new_ids);
+            break;
+        case ElementOrderingType::HILBERT:
+            hilbert_ordering(mesh, new_ids);
+            break;
+        case ElementOrderingType::MORTON:
+            morton_ordering(mesh, new_ids);
+            break;
+        default:
+            throw std::logic_error("Invalid element ordering type: " + element_ordering_to_string(type));
+    }
+
+    RenumberingReport report;
+    report.bandwidth_before = element_bandwidth(mesh);
+    report.profile_before = element_profile(mesh);
+
+    mesh.renumber_elements(new_ids);
+
+    report.bandwidth_after = element_bandwidth(mesh);
+    report.profile_after = element_profile(mesh);
+    return report;
+}
+
+template void rcm_ordering(const Mesh<1>& mesh, std::vector<uint_t>& new_ids);
+template void rcm_ordering(const Mesh<2>& mesh, std::vector<uint_t>& new_ids);
+template void rcm_ordering(const Mesh<3>& mesh, std::vector<uint_t>& new_ids);
+
+template void hilbert_ordering(const Mesh<1>& mesh, std::vector<uint_t>& new_ids);
+template void hilbert_ordering(const Mesh<2>& mesh, std::vector<uint_t>& new_ids);
+template void hilbert_ordering(const Mesh<3>& mesh, std::vector<uint_t>& new_ids);
+
+template void morton_ordering(const Mesh<1>& mesh, std::vector<uint_t>& new_ids);
+template void morton_ordering(const Mesh<2>& mesh, std::vector<uint_t>& new_ids);
+template void morton_ordering(const Mesh<3>& mesh, std::vector<uint_t>& new_ids);
+
+template uint_t element_bandwidth(const Mesh<1>& mesh);
+template uint_t element_bandwidth(const Mesh<2>& mesh);
+template uint_t element_bandwidth(const Mesh<3>& mesh);
+
+template uint_t element_profile(const Mesh<1>& mesh);
+template uint_t element_profile(const Mesh<2>& mesh);
+template uint_t element_profile(const Mesh<3>& mesh);
+
+template uint_t dof_bandwidth(const Mesh<1>& mesh, const FVDoFManager<1>& dof_manager);
+template uint_t dof_bandwidth(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager);
+template uint_t dof_bandwidth(const Mesh<3>& mesh, const FVDoFManager<3>& dof_manager);
+
+template uint_t dof_profile(const Mesh<1>& mesh, const FVDoFManager<1>& dof_manager);
+template uint_t dof_profile(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager);
+template uint_t dof_profile(const Mesh<3>& mesh, const FVDoFManager<3>& dof_manager);
+
+template RenumberingReport renumber_elements(Mesh<1>& mesh, ElementOrderingType type);
+template RenumberingReport renumber_elements(Mesh<2>& mesh, ElementOrderingType type);
+template RenumberingReport renumber_elements(Mesh<3>& mesh, ElementOrderingType type);
+
+}
+}
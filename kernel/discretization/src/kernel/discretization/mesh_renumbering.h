@@ -0,0 +1,111 @@
+#ifndef MESH_RENUMBERING_H
+#define MESH_RENUMBERING_H
+
+#include "kernel/base/types.h"
+#include "kernel/discretization/dof_manager.h"
+
+#include <string>
+#include <vector>
+
+namespace kernel{
+namespace numerics{
+
+/// forward declarations
+template<int dim> class Mesh;
+
+/// \brief The orderings renumber_elements supports. RCM is the reverse
+/// Cuthill-McKee ordering of the element adjacency graph and minimizes the
+/// bandwidth. HILBERT and MORTON sort the elements along the corresponding
+/// space filling curve through their centroids and improve the cache reuse
+enum class ElementOrderingType{RCM,
+                               HILBERT,
+                               MORTON,
+                               INVALID_TYPE};
+
+/// \brief Returns the name of the ordering
+std::string element_ordering_to_string(ElementOrderingType type);
+
+/// \brief The bandwidth and profile of a cell centred operator
+/// before and after a renumbering. The bandwidth is the largest
+/// |row - column| of a nonzero. The profile is the sum over the rows
+/// of the distance between the diagonal and the first nonzero of the row
+struct RenumberingReport
+{
+    uint_t bandwidth_before;
+    uint_t bandwidth_after;
+    uint_t profile_before;
+    uint_t profile_after;
+};
+
+/// \brief Compute the reverse Cuthill-McKee ordering of the elements.
+/// On output new_ids[e] is the new id of the element with id e.
+/// Every connected component starts from a pseudo-peripheral element
+template<int dim>
+void rcm_ordering(const Mesh<dim>& mesh, std::vector<uint_t>& new_ids);
+
+/// \brief Compute the ordering of the elements along the Hilbert curve
+/// through their centroids. On output new_ids[e] is the new id of
+/// the element with id e
+template<int dim>
+void hilbert_ordering(const Mesh<dim>& mesh, std::vector<uint_t>& new_ids);
+
+/// \brief Compute the ordering of the elements along the Morton (Z) curve
+/// through their centroids. On output new_ids[e] is the new id of
+/// the element with id e
+template<int dim>
+void morton_ordering(const Mesh<dim>& mesh, std::vector<uint_t>& new_ids);
+
+/// \brief The bandwidth of the element adjacency matrix. This is the
+/// bandwidth of a cell centred operator with DoFs in element order
+template<int dim>
+uint_t element_bandwidth(const Mesh<dim>& mesh);
+
+/// \brief The profile of the element adjacency matrix
+template<int dim>
+uint_t element_profile(const Mesh<dim>& mesh);
+
+/// \brief The bandwidth of the cell centred operator
+/// with the DoFs of the given manager
+template<int dim>
+uint_t dof_bandwidth(const Mesh<dim>& mesh, const FVDoFManager<dim>& dof_manager);
+
+/// \brief The profile of the cell centred operator
+/// with the DoFs of the given manager
+template<int dim>
+uint_t dof_profile(const Mesh<dim>& mesh, const FVDoFManager<dim>& dof_manager);
+
+/// \brief Renumber the elements of the mesh with the given ordering
+/// and report the bandwidth of the element adjacency before and after.
+/// Anything indexed by the element id, i.e. the DoFs, a CompactMesh or
+/// a FVFaceGeometryCache, should be built after the renumbering
+template<int dim>
+RenumberingReport renumber_elements(Mesh<dim>& mesh, ElementOrderingType type);
+
+/// \brief Renumber the elements of the mesh and distribute the DoFs of
+/// the given variable again so that they follow the new element order.
+/// The report holds the DoF bandwidth before and after. If no DoFs
+/// were distributed before, the element bandwidth is reported instead
+template<int dim, typename VarTp>
+RenumberingReport
+renumber_elements(Mesh<dim>& mesh, FVDoFManager<dim>& dof_manager,
+                  const VarTp& var, ElementOrderingType type){
+
+    const bool has_dofs = dof_manager.n_dofs() != 0;
+
+    const uint_t bandwidth_before = has_dofs ? dof_bandwidth(mesh, dof_manager) : element_bandwidth(mesh);
+    const uint_t profile_before = has_dofs ? dof_profile(mesh, dof_manager) : element_profile(mesh);
+
+    RenumberingReport report = renumber_elements(mesh, type);
+    dof_manager.distribute_dofs(mesh, var);
+
+    report.bandwidth_before = bandwidth_before;
+    report.profile_before = profile_before;
+    report.bandwidth_after = dof_bandwidth(mesh, dof_manager);
+    report.profile_after = dof_profile(mesh, dof_manager);
+    return report;
+}
+
+}
+}
+
+#endif // MESH_RENUMBERING_H
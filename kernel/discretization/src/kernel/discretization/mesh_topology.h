@@ -87,6 +87,30 @@ public:
        */
      void reserve_n_faces(uint_t n);
 
+     /**
+       *\detailed resize the node container of an empty topology to n
+       *null entries. Adding a node with an id in [0, n) then only stores
+       *the pointer so nodes with distinct ids can be added concurrently
+       */
+     void resize_n_nodes(uint_t n){nodes_.resize(n, nullptr);}
+
+     /**
+       *\detailed same as resize_n_nodes for the elements
+       */
+     void resize_n_elements(uint_t n){elements_.resize(n, nullptr);}
+
+     /**
+       *\detailed same as resize_n_nodes for the faces
+       */
+     void resize_n_faces(uint_t n);
+
+     /**
+       *\detailed renumber the elements. The element with id e gets the
+       *id new_ids[e] and is moved to that position in the container.
+       *new_ids must be a permutation of [0, n_elements())
+       */
+     void renumber_elements(const std::vector<uint_t>& new_ids);
+
     /**
       *\detailed add a new node to the mesh and get back the pointer
       */
@@ -357,42 +381,42 @@ template<int spacedim>
 inline
 typename MeshTopology<spacedim>::face_iterator 
 MeshTopology<spacedim>::faces_end(){
-  faces_.end();
+  return faces_.end();
 }
 
 template<>
 inline
 MeshTopology<2>::face_iterator 
 MeshTopology<2>::faces_end(){
-  edges_.end();
+  return edges_.end();
 }
   
 template<int spacedim>
 inline
 typename MeshTopology<spacedim>::const_face_iterator 
 MeshTopology<spacedim>::faces_begin()const{
-  faces_.begin();
+  return faces_.begin();
 }
 
 template<>
 inline
 MeshTopology<2>::const_face_iterator 
 MeshTopology<2>::faces_begin()const{
-  edges_.begin();
+  return edges_.begin();
 }
   
 template<int spacedim>
 inline
 typename MeshTopology<spacedim>::const_face_iterator 
 MeshTopology<spacedim>::faces_end()const{
-  faces_.end();
+  return faces_.end();
 }
 
 template<>
 inline
 MeshTopology<2>::const_face_iterator 
 MeshTopology<2>::faces_end()const{
-  edges_.end();
+  return edges_.end();
 }
 
 template<int spacedim>
@@ -410,6 +434,68 @@ MeshTopology<2>::reserve_n_faces(uint_t n){
   edges_.reserve(n);
 }
 
+template<int spacedim>
+inline
+void
+MeshTopology<spacedim>::resize_n_faces(uint_t n){
+  faces_.resize(n, nullptr);
+}
+
+
+template<>
+inline
+void
+MeshTopology<2>::resize_n_faces(uint_t n){
+  edges_.resize(n, nullptr);
+}
+
+template<int spacedim>
+inline
+void
+MeshTopology<spacedim>::renumber_elements(const std::vector<uint_t>& new_ids){
+
+  if(new_ids.size() != elements_.size()){
+      throw std::logic_error("Invalid number of element ids: " +
+                             std::to_string(new_ids.size()) +
+                             " not equal to " +
+                             std::to_string(elements_.size()));
+  }
+
+  // validate the whole permutation before touching
+  // any element so that on error the mesh is unchanged
+  std::vector<bool> taken(new_ids.size(), false);
+
+  for(uint_t e=0; e<new_ids.size(); ++e){
+
+      const uint_t id = new_ids[e];
+
+      if(id >= new_ids.size()){
+          throw std::logic_error("Element id " + std::to_string(id) +
+                                 " not in [0, " + std::to_string(new_ids.size()) + ")");
+      }
+
+      if(taken[id]){
+          throw std::logic_error("Element ids are not a permutation. Duplicate id: " + std::to_string(id));
+      }
+
+      taken[id] = true;
+  }
+
+  std::vector<Element<spacedim>* > elements(elements_.size(), nullptr);
+
+  for(uint_t e=0; e<elements_.size(); ++e){
+
+      const uint_t id = new_ids[e];
+      elements[id] = elements_[e];
+
+      if(elements[id]){
+          elements[id]->set_id(id);
+      }
+  }
+
+  elements_.swap(elements);
+}
+
 template<int spacedim>
 inline
 uint_t
@@ -0,0 +1,462 @@
+#include "kernel/discretization/vtu_mesh_file_writer.h"
+#include "kernel/utilities/file_formats.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/mesh_predicates.h"
+#include "kernel/base/kernel_consts.h"
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <fstream>
+#include <string>
+
+namespace kernel{
+namespace numerics{
+
+namespace{
+
+/// \brief The size of the blocks the data is compressed in
+const uint_t COMPRESSION_BLOCK_SIZE = 32768;
+
+/// \brief Append the base64 encoding of the given bytes
+void
+base64_encode(const unsigned char* data, uint_t n_bytes, std::string& out){
+
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    out.reserve(out.size() + 4*((n_bytes + 2)/3));
+
+    uint_t i = 0;
+    for(; i + 2 < n_bytes; i += 3){
+
+        const std::uint32_t chunk = (std::uint32_t(data[i]) << 16) | (std::uint32_t(data[i + 1]) << 8) | data[i + 2];
+        out.push_back(table[(chunk >> 18) & 0x3F]);
+        out.push_back(table[(chunk >> 12) & 0x3F]);
+        out.push_back(table[(chunk >> 6) & 0x3F]);
+        out.push_back(table[chunk & 0x3F]);
+    }
+
+    if(i < n_bytes){
+
+        std::uint32_t chunk = std::uint32_t(data[i]) << 16;
+        if(i + 1 < n_bytes){
+            chunk |= std::uint32_t(data[i + 1]) << 8;
+        }
+
+        out.push_back(table[(chunk >> 18) & 0x3F]);
+        out.push_back(table[(chunk >> 12) & 0x3F]);
+        out.push_back(i + 1 < n_bytes ? table[(chunk >> 6) & 0x3F] : '=');
+        out.push_back('=');
+    }
+}
+
+/// \brief Returns the byte order of the machine as VTK names it
+const char*
+byte_order(){
+
+    const std::uint16_t one = 1;
+    unsigned char first;
+    std::memcpy(&first, &one, 1);
+    return first == 1 ? "LittleEndian" : "BigEndian";
+}
+
+/// \brief Returns the VTK cell type of an element of the given
+/// dimension with the given number of vertices
+std::uint8_t
+vtk_cell_type(int dim, uint_t n_vertices){
+
+    if(dim == 1 && n_vertices == 2){
+        return 3;  // VTK_LINE
+    }
+
+    if(dim == 2 && n_vertices == 3){
+        return 5;  // VTK_TRIANGLE
+    }
+
+    if(dim == 2 && n_vertices == 4){
+        return 9;  // VTK_QUAD
+    }
+
+    if(dim == 3 && n_vertices == 4){
+        return 10; // VTK_TETRA
+    }
+
+    if(dim == 3 && n_vertices == 8){
+        return 12; // VTK_HEXAHEDRON
+    }
+
+    throw std::logic_error("No VTK cell type for an element of dimension " + std::to_string(dim) +
+                           " with " + std::to_string(n_vertices) + " vertices");
+}
+
+/// \brief Write the attributes of the VTKFile element
+void
+write_file_attributes(std::ostream& out, const std::string& type, bool compress){
+
+    out<<"<VTKFile type=\""<<type<<"\" version=\"1.0\" byte_order=\""<<byte_order()<<"\" header_type=\"UInt64\"";
+
+    if(compress){
+        out<<" compressor=\"vtkZLibDataCompressor\"";
+    }
+
+    out<<">\n";
+}
+
+/// \brief Remove the directory from the given path
+std::string
+file_name_only(const std::string& path){
+
+    const auto pos = path.find_last_of("/\\");
+    return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+}
+
+template<int dim>
+VtuMeshFileWriter<dim>::VtuMeshFileWriter(const std::string& filename, VtuDataEncoding encoding, bool compress)
+    :
+    FileWriterBase(filename, FileFormats::Type::VTU, false),
+    base_name_(filename),
+    encoding_(encoding),
+    compress_(false)
+{
+    const std::string suffix = "." + FileFormats::type_to_string(FileFormats::Type::VTU);
+
+    if(base_name_.size() > suffix.size() &&
+       base_name_.compare(base_name_.size() - suffix.size(), suffix.size(), suffix) == 0){
+        base_name_.erase(base_name_.size() - suffix.size());
+    }
+
+    this->file_name_ = base_name_ + suffix;
+    set_compression(compress);
+}
+
+template<int dim>
+void
+VtuMeshFileWriter<dim>::set_compression(bool compress){
+
+#ifndef USE_ZLIB
+    if(compress){
+        throw std::logic_error("VTU compression requires zlib. Reconfigure kernellib with USE_ZLIB");
+    }
+#endif
+
+    compress_ = compress;
+}
+
+template<int dim>
+void
+VtuMeshFileWriter<dim>::write_header(){
+
+    //if the file is not open
+    if(!is_open()){
+        throw std::logic_error("File "+this->file_name_+" is not open");
+    }
+
+    this->file_<<"<?xml version=\"1.0\"?>\n";
+}
+
+template<int dim>
+std::string
+VtuMeshFileWriter<dim>::piece_file_name(uint_t pid)const{
+    return base_name_ + "_" + std::to_string(pid) + ".vtu";
+}
+
+template<int dim>
+void
+VtuMeshFileWriter<dim>::write_mesh(const Mesh<dim>& mesh){
+
+    if(!is_open()){
+        this->file_.open(this->file_name_, std::ios_base::out | std::ios_base::binary);
+    }
+
+    write_header();
+    write_vtu(this->file_, mesh, KernelConsts::invalid_size_type(), nullptr, "");
+    this->file_.flush();
+}
+
+template<int dim>
+void
+VtuMeshFileWriter<dim>::write_mesh(const Mesh<dim>& mesh, const std::vector<real_t>& cell_values,
+                                   const std::string& name){
+
+    if(!is_open()){
+        this->file_.open(this->file_name_, std::ios_base::out | std::ios_base::binary);
+    }
+
+    write_header();
+    write_vtu(this->file_, mesh, KernelConsts::invalid_size_type(), &cell_values, name);
+    this->file_.flush();
+}
+
+template<int dim>
+void
+VtuMeshFileWriter<dim>::write_piece(const Mesh<dim>& mesh, uint_t pid)const{
+
+    std::ofstream out(piece_file_name(pid), std::ios_base::out | std::ios_base::binary);
+
+    if(!out.is_open()){
+        throw std::logic_error("File "+piece_file_name(pid)+" is not open");
+    }
+
+    out<<"<?xml version=\"1.0\"?>\n";
+    write_vtu(out, mesh, pid, nullptr, "");
+}
+
+template<int dim>
+void
+VtuMeshFileWriter<dim>::write_piece(const Mesh<dim>& mesh, uint_t pid, const std::vector<real_t>& cell_values,
+                                    const std::string& name)const{
+
+    std::ofstream out(piece_file_name(pid), std::ios_base::out | std::ios_base::binary);
+
+    if(!out.is_open()){
+        throw std::logic_error("File "+piece_file_name(pid)+" is not open");
+    }
+
+    out<<"<?xml version=\"1.0\"?>\n";
+    write_vtu(out, mesh, pid, &cell_values, name);
+}
+
+template<int dim>
+void
+VtuMeshFileWriter<dim>::write_pvtu(uint_t n_pieces, const std::string& name)const{
+
+    std::ofstream out(pvtu_file_name());
+
+    if(!out.is_open()){
+        throw std::logic_error("File "+pvtu_file_name()+" is not open");
+    }
+
+    out<<"<?xml version=\"1.0\"?>\n";
+    write_file_attributes(out, "PUnstructuredGrid", compress_);
+    out<<"  <PUnstructuredGrid GhostLevel=\"0\">\n";
+    out<<"    <PPoints>\n";
+    out<<"      <PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n";
+    out<<"    </PPoints>\n";
+
+    if(!name.empty()){
+        out<<"    <PCellData Scalars=\""<<name<<"\">\n";
+        out<<"      <PDataArray type=\"Float64\" Name=\""<<name<<"\"/>\n";
+        out<<"    </PCellData>\n";
+    }
+
+    // the pieces are next to the .pvtu file
+    for(uint_t p=0; p<n_pieces; ++p){
+        out<<"    <Piece Source=\""<<file_name_only(piece_file_name(p))<<"\"/>\n";
+    }
+
+    out<<"  </PUnstructuredGrid>\n";
+    out<<"</VTKFile>\n";
+}
+
+template<int dim>
+uint_t
+VtuMeshFileWriter<dim>::append_block(const char* data, uint_t n_bytes, std::string& appended)const{
+
+    const uint_t offset = appended.size();
+
+    if(!compress_){
+
+        // the header holds the number of bytes
+        const std::uint64_t header = n_bytes;
+
+        if(encoding_ == VtuDataEncoding::RAW){
+            appended.append(reinterpret_cast<const char*>(&header), sizeof(header));
+            appended.append(data, n_bytes);
+        }
+        else{
+
+            // header and data are encoded as one stream
+            std::string bytes(reinterpret_cast<const char*>(&header), sizeof(header));
+            bytes.append(data, n_bytes);
+            base64_encode(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size(), appended);
+        }
+
+        return offset;
+    }
+
+#ifdef USE_ZLIB
+
+    // the header holds the number of blocks, the size of a block,
+    // the size of the last block and the compressed size of every block
+    const uint_t n_blocks = (n_bytes + COMPRESSION_BLOCK_SIZE - 1)/COMPRESSION_BLOCK_SIZE;
+    std::vector<std::uint64_t> header(3 + n_blocks, 0);
+    header[0] = n_blocks;
+    header[1] = COMPRESSION_BLOCK_SIZE;
+    header[2] = n_blocks == 0 ? 0 : n_bytes - (n_blocks - 1)*COMPRESSION_BLOCK_SIZE;
+
+    std::string compressed;
+    std::vector<Bytef> buffer(compressBound(COMPRESSION_BLOCK_SIZE));
+
+    for(uint_t b=0; b<n_blocks; ++b){
+
+        const uint_t block_size = b + 1 == n_blocks ? header[2] : COMPRESSION_BLOCK_SIZE;
+        uLongf compressed_size = buffer.size();
+
+        if(compress2(buffer.data(), &compressed_size,
+                     reinterpret_cast<const Bytef*>(data + b*COMPRESSION_BLOCK_SIZE),
+                     block_size, Z_DEFAULT_COMPRESSION) != Z_OK){
+            throw std::logic_error("zlib failed to compress a block of " + std::to_string(block_size) + " bytes");
+        }
+
+        header[3 + b] = compressed_size;
+        compressed.append(reinterpret_cast<const char*>(buffer.data()), compressed_size);
+    }
+
+    const char* header_bytes = reinterpret_cast<const char*>(header.data());
+    const uint_t header_size = header.size()*sizeof(std::uint64_t);
+
+    if(encoding_ == VtuDataEncoding::RAW){
+        appended.append(header_bytes, header_size);
+        appended.append(compressed);
+    }
+    else{
+
+        // the header is encoded separately from the compressed data
+        base64_encode(reinterpret_cast<const unsigned char*>(header_bytes), header_size, appended);
+        base64_encode(reinterpret_cast<const unsigned char*>(compressed.data()), compressed.size(), appended);
+    }
+
+#endif
+
+    return offset;
+}
+
+template<int dim>
+void
+VtuMeshFileWriter<dim>::write_vtu(std::ostream& out, const Mesh<dim>& mesh, uint_t pid,
+                                  const std::vector<real_t>* cell_values, const std::string& name)const{
+
+    const uint_t invalid = KernelConsts::invalid_size_type();
+
+    // the elements of the piece and the nodes they use
+    std::vector<Element<dim>*> elements;
+    std::vector<uint_t> local_nodes;
+
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+
+        auto* element = *itr;
+
+        if(pid != invalid && element->get_pid() != pid){
+            continue;
+        }
+
+        elements.push_back(element);
+
+        for(uint_t v=0; v<element->n_vertices(); ++v){
+
+            const uint_t node_id = element->get_node(v)->get_id();
+
+            if(node_id >= local_nodes.size()){
+                local_nodes.resize(node_id + 1, invalid);
+            }
+
+            local_nodes[node_id] = 0;
+        }
+    }
+
+    // number the used nodes in increasing id
+    std::vector<double> points;
+    uint_t n_points = 0;
+
+    for(uint_t n=0; n<local_nodes.size(); ++n){
+
+        if(local_nodes[n] == invalid){
+            continue;
+        }
+
+        local_nodes[n] = n_points++;
+
+        auto* node = mesh.node(n);
+        for(int d=0; d<3; ++d){
+            points.push_back(d < dim ? static_cast<double>((*node)[d]) : 0.0);
+        }
+    }
+
+    std::vector<std::int64_t> connectivity;
+    std::vector<std::int64_t> offsets;
+    std::vector<std::uint8_t> types;
+    std::vector<double> values;
+
+    offsets.reserve(elements.size());
+    types.reserve(elements.size());
+
+    for(auto* element : elements){
+
+        for(uint_t v=0; v<element->n_vertices(); ++v){
+            connectivity.push_back(static_cast<std::int64_t>(local_nodes[element->get_node(v)->get_id()]));
+        }
+
+        offsets.push_back(static_cast<std::int64_t>(connectivity.size()));
+        types.push_back(vtk_cell_type(dim, element->n_vertices()));
+
+        if(cell_values){
+
+            if(element->get_id() >= cell_values->size()){
+                throw std::logic_error("No cell value for element " + std::to_string(element->get_id()));
+            }
+
+            values.push_back(static_cast<double>((*cell_values)[element->get_id()]));
+        }
+    }
+
+    std::string appended;
+    const uint_t points_offset = append_block(reinterpret_cast<const char*>(points.data()),
+                                              points.size()*sizeof(double), appended);
+    const uint_t connectivity_offset = append_block(reinterpret_cast<const char*>(connectivity.data()),
+                                                    connectivity.size()*sizeof(std::int64_t), appended);
+    const uint_t offsets_offset = append_block(reinterpret_cast<const char*>(offsets.data()),
+                                               offsets.size()*sizeof(std::int64_t), appended);
+    const uint_t types_offset = append_block(reinterpret_cast<const char*>(types.data()),
+                                             types.size()*sizeof(std::uint8_t), appended);
+    const uint_t values_offset = cell_values ? append_block(reinterpret_cast<const char*>(values.data()),
+                                                            values.size()*sizeof(double), appended) : 0;
+
+    write_file_attributes(out, "UnstructuredGrid", compress_);
+    out<<"  <UnstructuredGrid>\n";
+    out<<"    <Piece NumberOfPoints=\""<<n_points<<"\" NumberOfCells=\""<<elements.size()<<"\">\n";
+    out<<"      <Points>\n";
+    out<<"        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\""<<points_offset<<"\"/>\n";
+    out<<"      </Points>\n";
+    out<<"      <Cells>\n";
+    out<<"        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\""<<connectivity_offset<<"\"/>\n";
+    out<<"        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\""<<offsets_offset<<"\"/>\n";
+    out<<"        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\""<<types_offset<<"\"/>\n";
+    out<<"      </Cells>\n";
+
+    if(cell_values){
+        out<<"      <CellData Scalars=\""<<name<<"\">\n";
+        out<<"        <DataArray type=\"Float64\" Name=\""<<name<<"\" format=\"appended\" offset=\""<<values_offset<<"\"/>\n";
+        out<<"      </CellData>\n";
+    }
+
+    out<<"    </Piece>\n";
+    out<<"  </UnstructuredGrid>\n";
+    out<<"  <AppendedData encoding=\""<<(encoding_ == VtuDataEncoding::RAW ? "raw" : "base64")<<"\">\n";
+    out<<"   _";
+    out.write(appended.data(), appended.size());
+    out<<"\n  </AppendedData>\n";
+    out<<"</VTKFile>\n";
+
+    if(!out.good()){
+        throw std::logic_error("Failed to write the VTU data");
+    }
+}
+
+template class VtuMeshFileWriter<1>;
+template class VtuMeshFileWriter<2>;
+template class VtuMeshFileWriter<3>;
+
+}
+}
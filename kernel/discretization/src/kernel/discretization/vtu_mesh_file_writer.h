@@ -0,0 +1,114 @@
+#ifndef VTU_MESH_FILE_WRITER_H
+#define VTU_MESH_FILE_WRITER_H
+
+#include "kernel/base/config.h"
+#include "kernel/base/types.h"
+#include "kernel/utilities/file_writer_base.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace kernel{
+namespace numerics{
+
+template<int dim> class Mesh;
+
+/// \brief How VtuMeshFileWriter encodes the appended data.
+/// RAW writes the bytes as they are in memory. BASE64 encodes
+/// them so that the file is plain text
+enum class VtuDataEncoding{RAW, BASE64};
+
+/// \brief Writes a Mesh in the VTK XML unstructured grid format (.vtu).
+/// All arrays are written in binary in the AppendedData section and can
+/// optionally be compressed with zlib. Unlike VtkMeshFileWriter it supports
+/// meshes of any dimension. The cell type follows from the number of
+/// vertices of the element: lines in 1D, triangles and quads in 2D,
+/// tetrahedra and hexahedra in 3D.
+/// With write_piece every processor id of the mesh is written into its own
+/// .vtu file and write_pvtu writes the .pvtu file that collects the pieces.
+/// write_piece and write_pvtu do not touch the file of the writer so the
+/// pieces can be written concurrently (see write_partitioned_vtu)
+template<int dim>
+class VtuMeshFileWriter: public FileWriterBase
+{
+
+public:
+
+    /// \brief Constructor. The suffix .vtu is appended to filename
+    /// if it is missing. The pieces are named filename_pid.vtu
+    VtuMeshFileWriter(const std::string& filename,
+                      VtuDataEncoding encoding=VtuDataEncoding::RAW,
+                      bool compress=false);
+
+    /// \brief Set the encoding of the appended data
+    void set_encoding(VtuDataEncoding encoding){encoding_ = encoding;}
+
+    /// \brief Returns the encoding of the appended data
+    VtuDataEncoding get_encoding()const{return encoding_;}
+
+    /// \brief Compress the data with zlib. Throws std::logic_error
+    /// if compression is requested without USE_ZLIB
+    void set_compression(bool compress);
+
+    /// \brief Returns true if the data is compressed
+    bool is_compressed()const{return compress_;}
+
+    /// \brief Write the active elements of the mesh into the
+    /// file specified in the constructor of this class
+    void write_mesh(const Mesh<dim>& mesh);
+
+    /// \brief Write the active elements of the mesh and the given cell
+    /// values into the file specified in the constructor of this class.
+    /// The values are indexed by the element id
+    void write_mesh(const Mesh<dim>& mesh, const std::vector<real_t>& cell_values,
+                    const std::string& name);
+
+    /// \brief Write the active elements with processor id pid
+    /// into piece_file_name(pid)
+    void write_piece(const Mesh<dim>& mesh, uint_t pid)const;
+
+    /// \brief Write the active elements with processor id pid and
+    /// their cell values into piece_file_name(pid)
+    void write_piece(const Mesh<dim>& mesh, uint_t pid, const std::vector<real_t>& cell_values,
+                     const std::string& name)const;
+
+    /// \brief Write the .pvtu file that collects the given number of
+    /// pieces. name is the name of the cell values of the pieces if any
+    void write_pvtu(uint_t n_pieces, const std::string& name="")const;
+
+    /// \brief The name of the file of the given piece
+    std::string piece_file_name(uint_t pid)const;
+
+    /// \brief The name of the .pvtu file
+    std::string pvtu_file_name()const{return base_name_ + ".pvtu";}
+
+    /// \brief Write the XML declaration
+    virtual void write_header()override;
+
+private:
+
+    /// \brief The file name without the suffix
+    std::string base_name_;
+
+    /// \brief The encoding of the appended data
+    VtuDataEncoding encoding_;
+
+    /// \brief Flag indicating whether the data is compressed
+    bool compress_;
+
+    /// \brief Write the elements with the given processor id or all the
+    /// active elements if pid is invalid. cell_values may be null
+    void write_vtu(std::ostream& out, const Mesh<dim>& mesh, uint_t pid,
+                   const std::vector<real_t>* cell_values, const std::string& name)const;
+
+    /// \brief Append the given bytes as one block of the appended data
+    /// and return the offset of the block
+    uint_t append_block(const char* data, uint_t n_bytes, std::string& appended)const;
+
+};
+
+}
+}
+
+#endif // VTU_MESH_FILE_WRITER_H
@@ -0,0 +1,134 @@
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/compact_mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+}
+
+TEST(TestCompactMesh, TestDefaultConstuction) {
+
+    /***
+       * Test Scenario:    The application attempts to instantiate an empty CompactMesh
+       * Expected Output:  CompactMesh instance with no entities should be generated
+     **/
+
+    using kernel::uint_t;
+    using kernel::numerics::CompactMesh;
+
+    CompactMesh<2> mesh;
+    ASSERT_EQ(mesh.n_nodes(), static_cast<uint_t>(0));
+    ASSERT_EQ(mesh.n_elements(), static_cast<uint_t>(0));
+    ASSERT_EQ(mesh.n_faces(), static_cast<uint_t>(0));
+    ASSERT_TRUE(mesh.elements_begin() == mesh.elements_end());
+}
+
+TEST(TestCompactMesh, TestBuildFromQuadMesh) {
+
+    /***
+       * Test Scenario:    The application builds a CompactMesh from a quad mesh
+       * Expected Output:  The CSR tables reproduce the nodes, faces and neighbors
+       *                   of the pointer based topology
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::KernelConsts;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::CompactMesh;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 4, 3, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    CompactMesh<2> compact(mesh);
+
+    ASSERT_EQ(compact.n_nodes(), mesh.n_nodes());
+    ASSERT_EQ(compact.n_elements(), mesh.n_elements());
+    ASSERT_EQ(compact.n_faces(), mesh.n_faces());
+    ASSERT_EQ(compact.element_node_offsets().size(), mesh.n_elements() + 1);
+    ASSERT_EQ(compact.element_node_offsets().back(), static_cast<uint_t>(4*mesh.n_elements()));
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        auto* elem = mesh.element(e);
+        const auto& view = compact.element(e);
+
+        ASSERT_EQ(view.get_id(), elem->get_id());
+        ASSERT_EQ(view.n_nodes(), elem->n_nodes());
+        ASSERT_EQ(view.n_faces(), elem->n_faces());
+        ASSERT_DOUBLE_EQ(view.volume(), elem->volume());
+        ASSERT_DOUBLE_EQ(view.centroid()[0], elem->centroid()[0]);
+        ASSERT_DOUBLE_EQ(view.centroid()[1], elem->centroid()[1]);
+
+        for(uint_t n=0; n<elem->n_nodes(); ++n){
+
+            auto* node = elem->get_node(n);
+            ASSERT_DOUBLE_EQ(compact.node_coordinate(view.node(n), 0), (*node)[0]);
+            ASSERT_DOUBLE_EQ(compact.node_coordinate(view.node(n), 1), (*node)[1]);
+        }
+
+        for(uint_t f=0; f<elem->n_faces(); ++f){
+
+            const auto& face = elem->get_face(f);
+            ASSERT_EQ(compact.face_on_boundary(view.face(f)), face.on_boundary());
+            ASSERT_DOUBLE_EQ(compact.face_volume(view.face(f)), face.volume());
+
+            auto* neigh = elem->neighbor_ptr(f);
+            if(neigh){
+                ASSERT_EQ(compact.element(view.neighbor(f)).get_id(), neigh->get_id());
+            }
+            else{
+                ASSERT_EQ(view.neighbor(f), KernelConsts::invalid_size_type());
+            }
+        }
+    }
+}
+
+TEST(TestCompactMesh, TestElementMeshIterator) {
+
+    /***
+       * Test Scenario:    The application iterates over a CompactMesh using ConstElementMeshIterator
+       * Expected Output:  Only the elements that were active when the CompactMesh was built are visited
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::CompactMesh;
+    using kernel::numerics::ConstElementMeshIterator;
+    using kernel::numerics::Active;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 5, 5, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    mesh.element(3)->set_active_flag(false);
+    mesh.element(7)->set_active_flag(false);
+
+    CompactMesh<2> compact(mesh);
+    ConstElementMeshIterator<Active, CompactMesh<2>> filter(compact);
+
+    uint_t n_active = 0;
+    auto itr = filter.begin();
+    auto itr_e = filter.end();
+
+    for(; itr != itr_e; ++itr){
+
+        auto* elem = *itr;
+        ASSERT_TRUE(elem->get_id() != static_cast<uint_t>(3));
+        ASSERT_TRUE(elem->get_id() != static_cast<uint_t>(7));
+        n_active++;
+    }
+
+    ASSERT_EQ(n_active, mesh.n_elements() - 2);
+}
@@ -0,0 +1,172 @@
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/discretization/dof_storage_types.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <exception>
+#include <gtest/gtest.h>
+
+namespace{
+
+struct Variable
+{
+    const std::string& name()const{return name_;}
+    std::string name_{"U"};
+};
+
+}
+
+TEST(TestDoFStorage, TestInvalidStorageType) {
+
+    /***
+       * Test Scenario:    The application attempts to use DoFStorageType::INVALID_TYPE
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    using kernel::numerics::FVDoFManager;
+    using kernel::numerics::DoFStorageType;
+
+    FVDoFManager<2> manager;
+    ASSERT_EQ(manager.get_storage_type(), DoFStorageType::ELEMENT_MAP);
+    ASSERT_THROW(manager.set_storage_type(DoFStorageType::INVALID_TYPE), std::logic_error);
+}
+
+TEST(TestDoFStorage, TestFlatArrayMatchesElementMap) {
+
+    /***
+       * Test Scenario:    The application distributes the dofs on the same mesh
+       *                   using ELEMENT_MAP and FLAT_ARRAY storage
+       * Expected Output:  Both storages give every active element the same DoF index
+       *                   and inactive elements get an invalid index
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::KernelConsts;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVDoFManager;
+    using kernel::numerics::DoFStorageType;
+    using kernel::numerics::DoF;
+
+    Mesh<2> map_mesh;
+    kernel::numerics::build_quad_mesh(map_mesh, 6, 4, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+    map_mesh.element(5)->set_active_flag(false);
+
+    Mesh<2> flat_mesh;
+    kernel::numerics::build_quad_mesh(flat_mesh, 6, 4, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+    flat_mesh.element(5)->set_active_flag(false);
+
+    Variable var;
+
+    FVDoFManager<2> map_manager;
+    map_manager.distribute_dofs(map_mesh, var);
+
+    FVDoFManager<2> flat_manager(DoFStorageType::FLAT_ARRAY);
+    flat_manager.distribute_dofs(flat_mesh, var);
+
+    ASSERT_EQ(flat_manager.n_dofs(), map_manager.n_dofs());
+    ASSERT_EQ(flat_manager.n_dofs(), flat_mesh.n_elements() - 1);
+    ASSERT_EQ(flat_manager.get_dof_ids().size(), flat_mesh.n_elements());
+
+    std::vector<DoF> dofs;
+    for(uint_t e=0; e<flat_mesh.n_elements(); ++e){
+
+        auto* elem = flat_mesh.element(e);
+
+        if(!elem->is_active()){
+            ASSERT_EQ(flat_manager.get_dof(*elem).id, KernelConsts::invalid_size_type());
+            ASSERT_EQ(flat_manager.get_dof_id(elem->get_id()), KernelConsts::invalid_size_type());
+            continue;
+        }
+
+        auto expected = map_manager.get_dof(*map_mesh.element(e)).id;
+        ASSERT_EQ(flat_manager.get_dof(*elem).id, expected);
+        ASSERT_EQ(flat_manager.get_dof_id(elem->get_id()), expected);
+
+        flat_manager.get_dofs(*elem, dofs);
+        ASSERT_EQ(dofs.size(), static_cast<uint_t>(1));
+        ASSERT_EQ(dofs[0].id, expected);
+
+        // the flat storage does not touch the element
+        ASSERT_FALSE(elem->get_dof("U").active);
+    }
+
+    ASSERT_THROW(flat_manager.get_dof_id(flat_mesh.n_elements()), std::logic_error);
+    ASSERT_THROW(map_manager.get_dof_id(0), std::logic_error);
+}
+
+TEST(TestDoFStorage, TestSparsityPattern) {
+
+    /***
+       * Test Scenario:    The application computes the sparsity pattern of a quad mesh
+       *                   using ELEMENT_MAP and FLAT_ARRAY storage
+       * Expected Output:  Every row starts with the diagonal followed by the sorted
+       *                   dofs of the face neighbors and both storages agree
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVDoFManager;
+    using kernel::numerics::DoFStorageType;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 5, 4, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    Variable var;
+
+    FVDoFManager<2> flat_manager(DoFStorageType::FLAT_ARRAY);
+    flat_manager.distribute_dofs(mesh, var);
+
+    std::vector<uint_t> flat_offsets;
+    std::vector<uint_t> flat_columns;
+    flat_manager.sparsity_pattern(mesh, flat_offsets, flat_columns);
+
+    ASSERT_EQ(flat_offsets.size(), flat_manager.n_dofs() + 1);
+
+    // one diagonal per row and two entries per interior face
+    ASSERT_EQ(flat_columns.size(), static_cast<uint_t>(20 + 2*(4*4 + 5*3)));
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        auto* elem = mesh.element(e);
+        const uint_t row = flat_manager.get_dof(*elem).id;
+
+        std::vector<uint_t> expected;
+        for(uint_t n=0; n<elem->n_neighbors(); ++n){
+            if(elem->neighbor_ptr(n)){
+                expected.push_back(flat_manager.get_dof(*elem->neighbor_ptr(n)).id);
+            }
+        }
+
+        std::sort(expected.begin(), expected.end());
+        expected.insert(expected.begin(), row);
+
+        ASSERT_EQ(flat_offsets[row + 1] - flat_offsets[row], expected.size());
+
+        for(uint_t c=0; c<expected.size(); ++c){
+            ASSERT_EQ(flat_columns[flat_offsets[row] + c], expected[c]);
+        }
+    }
+
+    Mesh<2> map_mesh;
+    kernel::numerics::build_quad_mesh(map_mesh, 5, 4, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    FVDoFManager<2> map_manager;
+    map_manager.distribute_dofs(map_mesh, var);
+
+    std::vector<uint_t> map_offsets;
+    std::vector<uint_t> map_columns;
+    map_manager.sparsity_pattern(map_mesh, map_offsets, map_columns);
+
+    ASSERT_EQ(map_offsets, flat_offsets);
+    ASSERT_EQ(map_columns, flat_columns);
+}
@@ -0,0 +1,92 @@
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/parallel/utilities/element_coloring.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace{
+
+}
+
+TEST(TestElementColoring, TestInvalidDistance) {
+
+    /***
+       * Test Scenario:    The application attempts to colour a mesh with distance 3
+       * Expected Output:  std::invalid_argument is thrown
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::ElementColoring;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 2, 2, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    ElementColoring<2> coloring;
+    ASSERT_THROW(coloring.color(mesh, 3), std::invalid_argument);
+}
+
+TEST(TestElementColoring, TestDistanceOneAndTwo) {
+
+    /***
+       * Test Scenario:    The application colours a quad mesh with distance 1 and 2
+       * Expected Output:  Every element gets exactly one colour, no element shares its colour with
+       *                   a neighbour and, for distance 2, with a neighbour of a neighbour
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::ElementColoring;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 13, 7, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    for(uint_t distance : {1, 2}){
+
+        ElementColoring<2> coloring(mesh, distance);
+
+        ASSERT_EQ(coloring.n_elements(), mesh.n_elements());
+
+        // a structured quad mesh needs 2 colours
+        // for distance 1 and at most 9 for distance 2
+        if(distance == 1){
+            ASSERT_EQ(coloring.n_colors(), static_cast<uint_t>(2));
+        }
+        else{
+            ASSERT_LE(coloring.n_colors(), static_cast<uint_t>(9));
+        }
+
+        for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+            auto* element = mesh.element(e);
+            const uint_t c = coloring.color_of(element->get_id());
+
+            for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+                auto* neigh = element->neighbor_ptr(n);
+                if(!neigh){
+                    continue;
+                }
+
+                ASSERT_NE(c, coloring.color_of(neigh->get_id()));
+
+                if(distance == 2){
+                    for(uint_t nn=0; nn<neigh->n_neighbors(); ++nn){
+
+                        auto* neigh_neigh = neigh->neighbor_ptr(nn);
+                        if(neigh_neigh && neigh_neigh != element){
+                            ASSERT_NE(c, coloring.color_of(neigh_neigh->get_id()));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
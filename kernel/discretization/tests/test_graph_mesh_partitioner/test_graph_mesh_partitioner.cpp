@@ -0,0 +1,175 @@
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/parallel/utilities/graph_mesh_partitioner.h"
+#include "kernel/parallel/utilities/graph_partitioner.h"
+#include "kernel/parallel/utilities/linear_mesh_partitioner.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace{
+
+/// \brief Build the CSR graph of an n x n grid with
+/// every vertex connected to its four neighbours
+void build_grid_graph(kernel::uint_t n, std::vector<kernel::uint_t>& offsets,
+                      std::vector<kernel::uint_t>& adjacency){
+
+    using kernel::uint_t;
+
+    offsets.assign(1, 0);
+    adjacency.clear();
+
+    for(uint_t j=0; j<n; ++j){
+        for(uint_t i=0; i<n; ++i){
+
+            const uint_t v = j*n + i;
+
+            if(i > 0){adjacency.push_back(v - 1);}
+            if(i + 1 < n){adjacency.push_back(v + 1);}
+            if(j > 0){adjacency.push_back(v - n);}
+            if(j + 1 < n){adjacency.push_back(v + n);}
+
+            offsets.push_back(adjacency.size());
+        }
+    }
+}
+
+}
+
+TEST(TestGraphMeshPartitioner, TestInvalidInput) {
+
+    /***
+       * Test Scenario:    The application attempts to partition into zero parts and an invalid CSR graph
+       * Expected Output:  std::invalid_argument is thrown
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 2, 2, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    ASSERT_THROW(kernel::numerics::graph_mesh_partition(mesh, 0), std::invalid_argument);
+
+    std::vector<uint_t> parts;
+    std::vector<uint_t> offsets = {0, 1, 2};
+    std::vector<uint_t> adjacency = {1};
+    ASSERT_THROW(kernel::graph_partition(offsets, adjacency, 2, parts), std::invalid_argument);
+}
+
+TEST(TestGraphMeshPartitioner, TestTwoDisconnectedCliques) {
+
+    /***
+       * Test Scenario:    The application bisects a graph made of two disconnected triangles
+       * Expected Output:  Every triangle goes to its own part and the edge cut is zero
+     **/
+
+    using kernel::uint_t;
+
+    // vertices 0, 2, 4 and 1, 3, 5 form the two triangles
+    std::vector<uint_t> offsets = {0, 2, 4, 6, 8, 10, 12};
+    std::vector<uint_t> adjacency = {2, 4, 3, 5, 0, 4, 1, 5, 0, 2, 1, 3};
+
+    std::vector<uint_t> parts;
+    ASSERT_EQ(kernel::graph_partition(offsets, adjacency, 2, parts), static_cast<uint_t>(0));
+
+    ASSERT_EQ(parts[0], parts[2]);
+    ASSERT_EQ(parts[0], parts[4]);
+    ASSERT_EQ(parts[1], parts[3]);
+    ASSERT_EQ(parts[1], parts[5]);
+    ASSERT_NE(parts[0], parts[1]);
+}
+
+TEST(TestGraphMeshPartitioner, TestBalanceAndEdgeCut) {
+
+    /***
+       * Test Scenario:    The application partitions a square quad mesh into 1, 2, 3, 4 and 8 parts
+       * Expected Output:  Every part gets its share of the elements within the tolerance
+       *                   and for four or more parts the edge cut is smaller than the
+       *                   one of linear_mesh_partition
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+
+    const uint_t n = 40;
+
+    for(uint_t n_parts : {1, 2, 3, 4, 8}){
+
+        Mesh<2> mesh;
+        kernel::numerics::build_quad_mesh(mesh, n, n, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+        kernel::numerics::linear_mesh_partition(mesh, n_parts);
+        const uint_t linear_cut = kernel::numerics::mesh_partition_edge_cut(mesh);
+
+        const uint_t cut = kernel::numerics::graph_mesh_partition(mesh, n_parts);
+        ASSERT_EQ(cut, kernel::numerics::mesh_partition_edge_cut(mesh));
+
+        std::vector<uint_t> counts(n_parts, 0);
+        for(uint_t e=0; e<mesh.n_elements(); ++e){
+            ASSERT_LT(mesh.element(e)->get_pid(), n_parts);
+            counts[mesh.element(e)->get_pid()]++;
+        }
+
+        const uint_t max_count = *std::max_element(counts.begin(), counts.end());
+        ASSERT_LE(max_count, static_cast<uint_t>(1.05*n*n/n_parts) + 1);
+
+        if(n_parts == 1){
+            ASSERT_EQ(cut, static_cast<uint_t>(0));
+        }
+        else if(n_parts < 4){
+            // on a square the strips of linear_mesh_partition
+            // are close to optimal for few parts
+            ASSERT_LE(cut, linear_cut + n/4);
+        }
+        else{
+            ASSERT_LT(cut, linear_cut);
+        }
+    }
+}
+
+TEST(TestGraphMeshPartitioner, TestToleranceOverRecursionLevels) {
+
+    /***
+       * Test Scenario:    The application partitions a grid graph into 8 parts which
+       *                   takes three levels of recursive bisection
+       * Expected Output:  The heaviest part does not exceed the average part weight
+       *                   by more than the requested tolerance
+     **/
+
+    using kernel::uint_t;
+    using kernel::real_t;
+
+    const uint_t n = 64;
+
+    std::vector<uint_t> offsets;
+    std::vector<uint_t> adjacency;
+    build_grid_graph(n, offsets, adjacency);
+
+    for(real_t tolerance : {0.03, 0.1}){
+
+        kernel::GraphPartitionOptions options;
+        options.imbalance_tolerance = tolerance;
+
+        const uint_t n_parts = 8;
+        std::vector<uint_t> parts;
+        kernel::graph_partition(offsets, adjacency, n_parts, parts, options);
+
+        std::vector<uint_t> counts(n_parts, 0);
+        for(auto p : parts){
+            ASSERT_LT(p, n_parts);
+            counts[p]++;
+        }
+
+        const real_t average = static_cast<real_t>(n*n)/static_cast<real_t>(n_parts);
+        const uint_t max_count = *std::max_element(counts.begin(), counts.end());
+        ASSERT_LE(static_cast<real_t>(max_count), (1.0 + tolerance)*average);
+    }
+}
@@ -0,0 +1,88 @@
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/discretization/mesh_checkpoint.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/utilities/checkpoint_file.h"
+
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace{
+
+struct Variable
+{
+    const std::string& name()const{return name_;}
+    std::string name_{"U"};
+};
+
+}
+
+TEST(TestMeshCheckpoint, TestMatchingMesh) {
+
+    /***
+       * Test Scenario:    The application writes the topology and the DoF map of a quad mesh
+       *                   and checks them against the same mesh
+       * Expected Output:  No exception is thrown and the DoF map holds every element
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::CheckpointWriter;
+    using kernel::CheckpointReader;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVDoFManager;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 5, 4, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    Variable var;
+    FVDoFManager<2> manager;
+    manager.distribute_dofs(mesh, var);
+
+    CheckpointWriter writer;
+    kernel::numerics::add_mesh_sections(writer, mesh);
+    kernel::numerics::add_dof_sections(writer, mesh, manager);
+    writer.write("test_mesh_checkpoint.ckpt");
+
+    CheckpointReader reader("test_mesh_checkpoint.ckpt");
+    ASSERT_NO_THROW(kernel::numerics::check_mesh_sections(reader, mesh));
+    ASSERT_NO_THROW(kernel::numerics::check_dof_sections(reader, mesh, manager));
+
+    auto dofs = reader.get_uint_section(kernel::numerics::dof_section_name("U"));
+    ASSERT_EQ(dofs.size(), mesh.n_elements());
+    ASSERT_EQ(reader.get_real_section("mesh/nodes").size(), 2*mesh.n_nodes());
+}
+
+TEST(TestMeshCheckpoint, TestDifferentMesh) {
+
+    /***
+       * Test Scenario:    The application checks a checkpoint against a mesh with a different
+       *                   number of elements and against a mesh with moved nodes
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    using kernel::GeomPoint;
+    using kernel::CheckpointWriter;
+    using kernel::CheckpointReader;
+    using kernel::numerics::Mesh;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 5, 4, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    CheckpointWriter writer;
+    kernel::numerics::add_mesh_sections(writer, mesh);
+    writer.write("test_mesh_checkpoint_different.ckpt");
+
+    CheckpointReader reader("test_mesh_checkpoint_different.ckpt");
+
+    Mesh<2> finer;
+    kernel::numerics::build_quad_mesh(finer, 6, 4, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+    ASSERT_THROW(kernel::numerics::check_mesh_sections(reader, finer), std::logic_error);
+
+    Mesh<2> larger;
+    kernel::numerics::build_quad_mesh(larger, 5, 4, GeomPoint<2>(0.0), GeomPoint<2>(2.0));
+    ASSERT_THROW(kernel::numerics::check_mesh_sections(reader, larger), std::logic_error);
+}
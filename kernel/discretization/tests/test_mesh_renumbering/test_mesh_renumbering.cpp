@@ -0,0 +1,180 @@
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh_renumbering.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace{
+
+struct Variable
+{
+    const std::string& name()const{return name_;}
+    std::string name_{"U"};
+};
+
+}
+
+TEST(TestMeshRenumbering, TestInvalidType) {
+
+    /***
+       * Test Scenario:    The application renumbers a mesh with an invalid ordering type
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::ElementOrderingType;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 2, 2, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    ASSERT_THROW(kernel::numerics::renumber_elements(mesh, ElementOrderingType::INVALID_TYPE), std::logic_error);
+}
+
+TEST(TestMeshRenumbering, TestInvalidPermutationKeepsIds) {
+
+    /***
+       * Test Scenario:    The application renumbers a mesh with ids that are out of range
+       *                   or duplicated after a valid prefix
+       * Expected Output:  std::logic_error is thrown and the element ids are unchanged
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 2, 2, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    std::vector<uint_t> out_of_range = {3, 2, 1, 4};
+    ASSERT_THROW(mesh.renumber_elements(out_of_range), std::logic_error);
+
+    std::vector<uint_t> duplicate = {3, 2, 1, 1};
+    ASSERT_THROW(mesh.renumber_elements(duplicate), std::logic_error);
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+        ASSERT_EQ(mesh.element(e)->get_id(), e);
+    }
+}
+
+TEST(TestMeshRenumbering, TestRCMReducesBandwidth) {
+
+    /***
+       * Test Scenario:    The application renumbers a long quad mesh with RCM
+       * Expected Output:  The ids are a permutation, the neighbours are unchanged
+       *                   and the bandwidth drops from nx to about ny
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::ElementOrderingType;
+
+    const uint_t nx = 30;
+    const uint_t ny = 4;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, nx, ny, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    // the centroids of the neighbours of every element before the renumbering
+    std::vector<std::vector<GeomPoint<2>>> neighbor_centroids(mesh.n_elements());
+    std::vector<GeomPoint<2>> centroids;
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        auto* element = mesh.element(e);
+        centroids.push_back(element->centroid());
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+            if(element->neighbor_ptr(n)){
+                neighbor_centroids[e].push_back(element->neighbor_ptr(n)->centroid());
+            }
+        }
+    }
+
+    ASSERT_EQ(kernel::numerics::element_bandwidth(mesh), nx);
+
+    auto report = kernel::numerics::renumber_elements(mesh, ElementOrderingType::RCM);
+
+    ASSERT_EQ(report.bandwidth_before, nx);
+    ASSERT_LE(report.bandwidth_after, ny + 1);
+    ASSERT_LT(report.profile_after, report.profile_before);
+    ASSERT_EQ(kernel::numerics::element_bandwidth(mesh), report.bandwidth_after);
+
+    std::vector<bool> found(mesh.n_elements(), false);
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        auto* element = mesh.element(e);
+        ASSERT_EQ(element->get_id(), e);
+
+        // find the element before the renumbering
+        auto itr = std::find_if(centroids.begin(), centroids.end(),
+                                [element](const GeomPoint<2>& c){return c.distance(element->centroid()) < 1.0e-12;});
+
+        ASSERT_TRUE(itr != centroids.end());
+
+        const uint_t old_id = itr - centroids.begin();
+        ASSERT_FALSE(found[old_id]);
+        found[old_id] = true;
+
+        uint_t n_neighbors = 0;
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+            if(element->neighbor_ptr(n)){
+                ASSERT_NEAR(element->neighbor_ptr(n)->centroid().distance(neighbor_centroids[old_id][n_neighbors++]), 0.0, 1.0e-12);
+            }
+        }
+
+        ASSERT_EQ(n_neighbors, neighbor_centroids[old_id].size());
+    }
+}
+
+TEST(TestMeshRenumbering, TestSpaceFillingCurvesAndDoFs) {
+
+    /***
+       * Test Scenario:    The application renumbers a distributed mesh along the Hilbert and Morton curves
+       * Expected Output:  The DoFs follow the new element order and the reported
+       *                   DoF bandwidth matches the one of the distributed DoFs
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVDoFManager;
+    using kernel::numerics::ElementOrderingType;
+
+    for(auto type : {ElementOrderingType::HILBERT, ElementOrderingType::MORTON}){
+
+        Mesh<2> mesh;
+        kernel::numerics::build_quad_mesh(mesh, 16, 16, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+        Variable var;
+        FVDoFManager<2> manager;
+        manager.distribute_dofs(mesh, var);
+
+        const uint_t bandwidth = kernel::numerics::dof_bandwidth(mesh, manager);
+        auto report = kernel::numerics::renumber_elements(mesh, manager, var, type);
+
+        ASSERT_EQ(report.bandwidth_before, bandwidth);
+        ASSERT_EQ(report.bandwidth_after, kernel::numerics::dof_bandwidth(mesh, manager));
+        ASSERT_EQ(manager.n_dofs(), mesh.n_elements());
+
+        // the first two elements along either curve
+        // share the lower left corner of the domain
+        ASSERT_LT(mesh.element(0)->centroid()[0], 0.125);
+        ASSERT_LT(mesh.element(0)->centroid()[1], 0.125);
+
+        for(uint_t e=0; e<mesh.n_elements(); ++e){
+            ASSERT_EQ(manager.get_dof(*mesh.element(e)).id, e);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/parallel/utilities/parallel_quad_mesh_generation.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace{
+
+}
+
+TEST(TestParallelQuadMeshGeneration, TestEmptyDirection) {
+
+    /***
+       * Test Scenario:    The application attempts to build a mesh with zero elements in x
+       * Expected Output:  std::invalid_argument is thrown
+     **/
+
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+
+    kernel::ThreadPool pool(2);
+
+    Mesh<2> mesh;
+    ASSERT_THROW(kernel::numerics::build_quad_mesh(mesh, 0, 3, GeomPoint<2>(0.0), GeomPoint<2>(1.0), pool, kernel::Null()),
+                 std::invalid_argument);
+}
+
+TEST(TestParallelQuadMeshGeneration, TestMatchesSerial) {
+
+    /***
+       * Test Scenario:    The application builds the same quad mesh serially and with a thread pool
+       * Expected Output:  Nodes, elements, neighbours, faces, face owners and
+       *                   boundary indicators are identical
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+
+    const uint_t nx = 13;
+    const uint_t ny = 7;
+
+    Mesh<2> serial;
+    kernel::numerics::build_quad_mesh(serial, nx, ny, GeomPoint<2>(0.0), GeomPoint<2>(2.0));
+
+    kernel::ThreadPool pool(3);
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, nx, ny, GeomPoint<2>(0.0), GeomPoint<2>(2.0), pool, kernel::Null());
+
+    ASSERT_EQ(mesh.n_nodes(), serial.n_nodes());
+    ASSERT_EQ(mesh.n_elements(), serial.n_elements());
+    ASSERT_EQ(mesh.n_faces(), serial.n_faces());
+    ASSERT_EQ(mesh.n_faces(), static_cast<uint_t>(2*nx*ny + nx + ny));
+    ASSERT_EQ(mesh.n_boundaries(), static_cast<uint_t>(4));
+
+    for(uint_t n=0; n<mesh.n_nodes(); ++n){
+
+        ASSERT_EQ(mesh.node(n)->get_id(), n);
+        ASSERT_DOUBLE_EQ((*mesh.node(n))[0], (*serial.node(n))[0]);
+        ASSERT_DOUBLE_EQ((*mesh.node(n))[1], (*serial.node(n))[1]);
+    }
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        auto* element = mesh.element(e);
+        auto* expected = serial.element(e);
+
+        ASSERT_EQ(element->get_id(), e);
+
+        for(uint_t v=0; v<element->n_nodes(); ++v){
+            ASSERT_EQ(element->get_node(v)->get_id(), expected->get_node(v)->get_id());
+        }
+
+        for(uint_t f=0; f<element->n_faces(); ++f){
+
+            if(expected->neighbor_ptr(f)){
+                ASSERT_TRUE(element->neighbor_ptr(f) != nullptr);
+                ASSERT_EQ(element->neighbor_ptr(f)->get_id(), expected->neighbor_ptr(f)->get_id());
+            }
+            else{
+                ASSERT_TRUE(element->neighbor_ptr(f) == nullptr);
+            }
+
+            ASSERT_EQ(element->get_face(f).get_id(), expected->get_face(f).get_id());
+        }
+    }
+
+    for(uint_t f=0; f<mesh.n_faces(); ++f){
+
+        auto* face = *(mesh.faces_begin() + f);
+        auto* expected = *(serial.faces_begin() + f);
+
+        ASSERT_EQ(face->get_id(), f);
+        ASSERT_EQ(face->get_vertices_ids(), expected->get_vertices_ids());
+        ASSERT_EQ(face->owner()->get_id(), expected->owner()->get_id());
+        ASSERT_EQ(face->on_boundary(), expected->on_boundary());
+
+        if(expected->on_boundary()){
+            ASSERT_EQ(face->boundary_indicator(), expected->boundary_indicator());
+        }
+        else{
+            ASSERT_EQ(face->neighbor()->get_id(), expected->neighbor()->get_id());
+        }
+    }
+}
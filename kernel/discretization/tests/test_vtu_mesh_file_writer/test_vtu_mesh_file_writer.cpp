@@ -0,0 +1,191 @@
+#include "kernel/base/types.h"
+#include "kernel/base/config.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/vtu_mesh_file_writer.h"
+#include "kernel/parallel/utilities/linear_mesh_partitioner.h"
+#include "kernel/parallel/utilities/parallel_vtu_writer.h"
+#include "kernel/parallel/threading/thread_pool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+std::string
+read_file(const std::string& filename){
+
+    std::ifstream in(filename, std::ios_base::in | std::ios_base::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+kernel::uint_t
+read_attribute(const std::string& contents, const std::string& name, std::size_t start=0){
+
+    const std::size_t pos = contents.find(name + "=\"", start);
+    return std::stoul(contents.substr(pos + name.size() + 2));
+}
+
+}
+
+TEST(TestVtuMeshFileWriter, TestRawEncoding) {
+
+    /***
+       * Test Scenario:    The application writes a quad mesh with cell values using the raw encoding
+       * Expected Output:  The file holds all the points and cells and the appended
+       *                   connectivity block decodes to the element nodes
+     **/
+
+    using kernel::uint_t;
+    using kernel::real_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::VtuMeshFileWriter;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 3, 2, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    std::vector<real_t> values(mesh.n_elements(), 1.0);
+
+    VtuMeshFileWriter<2> writer("test_vtu_raw");
+    ASSERT_EQ(writer.get_filename(), std::string("test_vtu_raw.vtu"));
+
+    writer.write_mesh(mesh, values, "u");
+    writer.close();
+
+    const std::string contents = read_file("test_vtu_raw.vtu");
+    ASSERT_EQ(read_attribute(contents, "NumberOfPoints"), static_cast<uint_t>(12));
+    ASSERT_EQ(read_attribute(contents, "NumberOfCells"), static_cast<uint_t>(6));
+    ASSERT_NE(contents.find("<CellData Scalars=\"u\">"), std::string::npos);
+
+    const std::size_t connectivity = contents.find("Name=\"connectivity\"");
+    const uint_t offset = read_attribute(contents, "offset", connectivity);
+    const std::size_t data = contents.find("_", contents.find("<AppendedData")) + 1 + offset;
+
+    std::uint64_t n_bytes = 0;
+    std::memcpy(&n_bytes, contents.data() + data, sizeof(n_bytes));
+    ASSERT_EQ(n_bytes, static_cast<std::uint64_t>(6*4*sizeof(std::int64_t)));
+
+    std::vector<std::int64_t> nodes(6*4);
+    std::memcpy(nodes.data(), contents.data() + data + sizeof(n_bytes), n_bytes);
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+        for(uint_t v=0; v<4; ++v){
+            ASSERT_EQ(static_cast<uint_t>(nodes[4*e + v]), mesh.element(e)->get_node(v)->get_id());
+        }
+    }
+}
+
+TEST(TestVtuMeshFileWriter, TestBase64Encoding) {
+
+    /***
+       * Test Scenario:    The application writes a quad mesh using the base64 encoding
+       * Expected Output:  The appended data holds only base64 characters
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::VtuMeshFileWriter;
+    using kernel::numerics::VtuDataEncoding;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 4, 4, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    VtuMeshFileWriter<2> writer("test_vtu_base64.vtu", VtuDataEncoding::BASE64);
+    writer.write_mesh(mesh);
+    writer.close();
+
+    const std::string contents = read_file("test_vtu_base64.vtu");
+    ASSERT_EQ(read_attribute(contents, "NumberOfCells"), static_cast<uint_t>(16));
+
+    const std::size_t begin = contents.find("_", contents.find("<AppendedData encoding=\"base64\">")) + 1;
+    const std::size_t end = contents.find("\n", begin);
+    const std::string data = contents.substr(begin, end - begin);
+
+    ASSERT_FALSE(data.empty());
+    ASSERT_EQ(data.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/="),
+              std::string::npos);
+}
+
+TEST(TestVtuMeshFileWriter, TestCompression) {
+
+    /***
+       * Test Scenario:    The application requests zlib compression
+       * Expected Output:  Without USE_ZLIB std::logic_error is thrown. Otherwise
+       *                   the file names the zlib compressor
+     **/
+
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::VtuMeshFileWriter;
+
+    VtuMeshFileWriter<2> writer("test_vtu_zlib");
+
+#ifdef USE_ZLIB
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 20, 20, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    writer.set_compression(true);
+    writer.write_mesh(mesh);
+    writer.close();
+
+    const std::string contents = read_file("test_vtu_zlib.vtu");
+    ASSERT_NE(contents.find("compressor=\"vtkZLibDataCompressor\""), std::string::npos);
+#else
+    ASSERT_THROW(writer.set_compression(true), std::logic_error);
+#endif
+}
+
+TEST(TestVtuMeshFileWriter, TestPartitionedWrite) {
+
+    /***
+       * Test Scenario:    The application writes a partitioned quad mesh with a thread pool
+       * Expected Output:  One piece per part is written and the pieces hold all the
+       *                   elements. The .pvtu file references every piece
+     **/
+
+    using kernel::uint_t;
+    using kernel::real_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::VtuMeshFileWriter;
+    using kernel::numerics::VtuDataEncoding;
+
+    const uint_t n_parts = 4;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 10, 10, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+    kernel::numerics::linear_mesh_partition(mesh, n_parts);
+
+    std::vector<real_t> values(mesh.n_elements(), 2.0);
+
+    kernel::ThreadPool pool(n_parts);
+    VtuMeshFileWriter<2> writer("test_vtu_partitioned", VtuDataEncoding::BASE64);
+    kernel::numerics::write_partitioned_vtu(writer, mesh, n_parts, values, "u", pool, kernel::Null());
+
+    uint_t n_cells = 0;
+    for(uint_t p=0; p<n_parts; ++p){
+
+        const std::string piece = read_file(writer.piece_file_name(p));
+        ASSERT_FALSE(piece.empty());
+        n_cells += read_attribute(piece, "NumberOfCells");
+    }
+
+    ASSERT_EQ(n_cells, mesh.n_elements());
+
+    const std::string pvtu = read_file(writer.pvtu_file_name());
+    for(uint_t p=0; p<n_parts; ++p){
+        ASSERT_NE(pvtu.find("Source=\"test_vtu_partitioned_" + std::to_string(p) + ".vtu\""), std::string::npos);
+    }
+}
@@ -0,0 +1,75 @@
+#include "kernel/parallel/data_structs/lockable_queue.h"
+#include "kernel/parallel/data_structs/lock_free_queue.h"
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::LockableQueue;
+using kernel::LockFreeQueue;
+
+// how many push/pop pairs each thread performs
+const uint_t N_OPS_PER_THREAD = 200000;
+
+// Every thread pushes an item and then pops one. Returns the
+// throughput in millions of push/pop pairs per second
+template<typename QueueTp>
+real_t
+run_benchmark(QueueTp& queue, uint_t n_threads){
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint_t t=0; t<n_threads; ++t){
+
+        threads.emplace_back([&queue](){
+
+            uint_t item = 0;
+            for(uint_t i=0; i<N_OPS_PER_THREAD; ++i){
+                queue.push_item(i);
+                queue.pop_wait(item);
+            }
+        });
+    }
+
+    for(auto& thread : threads){
+        thread.join();
+    }
+
+    std::chrono::duration<real_t> dur = std::chrono::steady_clock::now() - start;
+    return static_cast<real_t>(n_threads*N_OPS_PER_THREAD)/dur.count()/1.0e6;
+}
+
+}
+
+int main(){
+
+    std::cout<<"Push/pop throughput (millions of pairs per second)"<<std::endl;
+    std::cout<<std::setw(10)<<"threads"<<std::setw(15)<<"LockableQueue"<<std::setw(15)<<"LockFreeQueue"<<std::endl;
+
+    for(uint_t n_threads : {1, 2, 4, 8, 16, 32, 64}){
+
+        LockableQueue<uint_t> locked;
+        auto locked_throughput = run_benchmark(locked, n_threads);
+
+        // every thread has at most one item
+        // in the queue at any time
+        LockFreeQueue<uint_t> lock_free(2*n_threads);
+        auto lock_free_throughput = run_benchmark(lock_free, n_threads);
+
+        std::cout<<std::setw(10)<<n_threads
+                 <<std::setw(15)<<locked_throughput
+                 <<std::setw(15)<<lock_free_throughput<<std::endl;
+    }
+
+    return 0;
+}
@@ -28,14 +28,14 @@ LpMetric<P,TTakeRoot>::evaluate(const DynVec<real_t>& v1, const DynVec<real_t>&
 
 // L1-metric specializations; the root doesn't matter.
 template<>
-real_t
+inline real_t
 LpMetric<1, true>::evaluate(const DynVec<real_t>& v1, const DynVec<real_t>& v2)
 {
   return blaze::l1Norm(v1 - v2);
 }
 
 template<>
-real_t
+inline real_t
 LpMetric<1, false>::evaluate(const DynVec<real_t>& v1, const DynVec<real_t>& v2)
 {
   return blaze::l1Norm(v1 - v2);
@@ -43,32 +43,32 @@ LpMetric<1, false>::evaluate(const DynVec<real_t>& v1, const DynVec<real_t>& v2)
 
 // L2-metric specializations.
 template<>
-real_t
+inline real_t
 LpMetric<2, true>::evaluate(const DynVec<real_t>& v1, const DynVec<real_t>& v2)
 {
   return std::sqrt(blaze::sqrNorm(v1 - v2));
 }
 
 template<>
-real_t
+inline real_t
 LpMetric<2, false>::evaluate(const DynVec<real_t>& v1, const DynVec<real_t>& v2)
 {
-  return std::sqrt(blaze::sqrNorm(v1 - v2));
+  return blaze::sqrNorm(v1 - v2);
 }
 
 // L3-metric specialization (not very likely to be used, but just in case).
 template<>
-real_t
+inline real_t
 LpMetric<3, true>::evaluate(const DynVec<real_t>& v1, const DynVec<real_t>& v2)
 {
   return std::pow(blaze::reduce(blaze::pow(blaze::abs(v1 - v2), 3.0), blaze::Add()), 1.0 / 3.0);
 }
 
 template<>
-real_t
+inline real_t
 LpMetric<3, false>::evaluate(const DynVec<real_t>& v1, const DynVec<real_t>& v2)
 {
-  return std::pow(blaze::reduce(blaze::pow(blaze::abs(v1 - v2), 3.0), blaze::Add()), 1.0 / 3.0);
+  return blaze::reduce(blaze::pow(blaze::abs(v1 - v2), 3.0), blaze::Add());
 }
 
 
@@ -132,7 +132,8 @@ template<int dim>
 real_t
 LpMetric<2, false>::evaluate(const GeomPoint<dim>& v1, const GeomPoint<dim>& v2)
 {
-  return v1.distance(v2);
+  const real_t distance = v1.distance(v2);
+  return distance*distance;
 }
 
 // L3-metric specialization (not very likely to be used, but just in case).
@@ -153,7 +154,7 @@ LpMetric<3, false>::evaluate(const GeomPoint<dim>& v1, const GeomPoint<dim>& v2)
 {
     DynVec<real_t> vec1(v1.coordinates());
     DynVec<real_t> vec2(v2.coordinates());
-    return std::pow(blaze::reduce(blaze::pow(blaze::abs(vec1 - vec2), 3.0), blaze::Add()), 1.0 / 3.0);
+    return blaze::reduce(blaze::pow(blaze::abs(vec1 - vec2), 3.0), blaze::Add());
 }
 
 
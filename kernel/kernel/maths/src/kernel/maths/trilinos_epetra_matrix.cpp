@@ -7,6 +7,7 @@
 #include <exception>
 #include <algorithm>
 #include <iostream>
+#include <string>
 
 namespace kernel{
 namespace numerics{
@@ -299,13 +300,26 @@ TrilinosEpetraMatrix::add_entry(uint_t i, uint_t j, real_t val){
     trilinos_int_t epetra_j = static_cast<trilinos_int_t>(j);
 
     real_t epetra_value = val;
+    trilinos_int_t success = 0;
+
+    //the pattern of a filled matrix is fixed
+    //so the entry must exist
+    if(mat_->Filled()){
+
+        success = mat_->SumIntoGlobalValues(epetra_i, 1, &epetra_value, &epetra_j);
+
+        if(success != 0){
+            throw std::logic_error("An error occured whilst adding the matrix entry");
+        }
+
+        return;
+    }
 
     //we need to determine if the (epetra_i,epetra_j) index exists
     //if it doesn't we need to call InsertGlobalValues
 
     const Epetra_CrsGraph& graph = mat_->Graph();
 
-    trilinos_int_t success = 0;
     trilinos_int_t numIndices=0;
     trilinos_int_t* indices = nullptr;
 
@@ -462,6 +476,47 @@ TrilinosEpetraMatrix::init(const Epetra_CrsGraph& graph)
 
 }
 
+void
+TrilinosEpetraMatrix::init(const std::vector<uint_t>& row_offsets, const std::vector<uint_t>& columns){
+
+    if(row_offsets.empty() || row_offsets.back() != columns.size()){
+        throw std::logic_error("Invalid CSR sparsity pattern");
+    }
+
+    const uint_t m = row_offsets.size() - 1;
+    auto NumGlobalElements = static_cast<trilinos_int_t>(m);
+
+    //zero based (C-style) indexing
+    auto index_start = 0;
+    epetra_map_.reset(new Epetra_Map(NumGlobalElements, NumGlobalElements,  index_start, comm_));
+
+    std::vector<trilinos_int_t> nnz_per_row(m);
+    for(uint_t r=0; r<m; ++r){
+        nnz_per_row[r] = static_cast<trilinos_int_t>(row_offsets[r + 1] - row_offsets[r]);
+    }
+
+    // with a static profile the graph allocates
+    // exactly the given number of entries per row
+    Epetra_CrsGraph graph(Copy, *epetra_map_.get(), nnz_per_row.data(), true);
+
+    row_indices_t indices;
+    for(uint_t r=0; r<m; ++r){
+
+        indices.assign(columns.begin() + row_offsets[r], columns.begin() + row_offsets[r + 1]);
+
+        trilinos_int_t success = graph.InsertGlobalIndices(static_cast<trilinos_int_t>(r), nnz_per_row[r], indices.data());
+
+        if(success < 0){
+            throw std::logic_error("An error occured whilst inserting the graph indices. Error code is: " + std::to_string(success));
+        }
+    }
+
+    graph.FillComplete();
+
+    //the matrix copies the structure of the filled graph
+    mat_.reset(new Epetra_CrsMatrix(Copy, graph));
+}
+
 void
 TrilinosEpetraMatrix::zero(){
 
@@ -121,6 +121,16 @@ public:
     ///
     void init(const Epetra_CrsGraph& graph);
 
+    ///
+    /// \brief Initialize with the CSR sparsity pattern given by
+    /// the row offsets and the column indices. The pattern is fixed
+    /// i.e. the matrix is filled and subsequent set_entry/add_entry
+    /// calls only overwrite or sum into the values of existing entries.
+    /// zero() keeps the pattern so the matrix can be reassembled without
+    /// inserting the entries again
+    ///
+    void init(const std::vector<uint_t>& row_offsets, const std::vector<uint_t>& columns);
+
     ///
     /// \brief Zero the entries of the matrix
     ///
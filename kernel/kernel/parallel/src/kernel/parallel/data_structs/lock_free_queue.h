@@ -0,0 +1,253 @@
+#ifndef LOCK_FREE_QUEUE_H
+#define LOCK_FREE_QUEUE_H
+
+#include "kernel/base/types.h"
+#include "kernel/parallel/threading/task_uitilities.h"
+#include <boost/core/noncopyable.hpp>
+
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
+
+namespace kernel
+{
+
+/***
+ * A bounded multi-producer/multi-consumer queue that does not use locks.
+ * The implementation follows the array based queue of D. Vyukov:
+ * every slot carries a sequence number that tells producers and
+ * consumers whether the slot is ready for them. The capacity is rounded
+ * up to a power of two. It exposes the same interface as LockableQueue
+ * so that it can be used as a drop in replacement when the
+ * lock becomes the bottleneck
+ **/
+
+template<typename T>
+class LockFreeQueue: private boost::noncopyable
+{
+
+ public:
+
+    typedef T value_t;
+
+    /// \brief Constructor. Construct an empty queue that
+    /// can hold at least capacity elements
+    explicit LockFreeQueue(uint_t capacity=1024);
+
+    /// \brief Destructor
+    ~LockFreeQueue()
+    {}
+
+    //pop an element from the queue. The thread
+    //that calls this waits until the queue has
+    //at least one element
+    value_t pop_wait();
+
+    //pop an element from the queue. Same as above
+    bool pop_wait(value_t& element);
+
+    //pop an element from the queue. If the queue is empty
+    //then return false. This function does not cause the
+    //calling thread to wait
+    bool pop(value_t& element);
+
+    //push an element to the queue. If the queue is full
+    //then return false. This function does not cause the
+    //calling thread to wait
+    bool try_push(const value_t& element);
+
+    //push an element to the queue. The thread that
+    //calls this waits until there is space in the queue
+    void push_item(const value_t& element);
+
+    template<typename Iterator>
+    void push_items(Iterator begin,Iterator end);
+
+    //get the size of the queue. This is only a glimpse
+    //as other threads may modify the queue concurrently
+    uint_t size()const;
+
+    //is the queue empty
+    bool empty()const{return size() == 0;}
+
+    //the maximum number of elements the queue can hold
+    uint_t capacity()const{return mask_ + 1;}
+
+ private:
+
+    struct Cell
+    {
+        std::atomic<uint_t> sequence_;
+        value_t value_;
+    };
+
+    // keep the producer and consumer counters
+    // on different cache lines
+    static constexpr uint_t cache_line_size_ = 64;
+
+    std::unique_ptr<Cell[]> buffer_;
+    uint_t mask_;
+
+    alignas(cache_line_size_) std::atomic<uint_t> enqueue_pos_;
+    alignas(cache_line_size_) std::atomic<uint_t> dequeue_pos_;
+};
+
+template<typename T>
+LockFreeQueue<T>::LockFreeQueue(uint_t capacity)
+:
+buffer_(),
+mask_(0),
+enqueue_pos_(0),
+dequeue_pos_(0)
+{
+    if(capacity < 2){
+        throw std::invalid_argument("LockFreeQueue capacity should be at least 2");
+    }
+
+    uint_t size = 2;
+    while(size < capacity){
+        size <<= 1;
+    }
+
+    buffer_ = std::make_unique<Cell[]>(size);
+    mask_ = size - 1;
+
+    for(uint_t c=0; c<size; ++c){
+        buffer_[c].sequence_.store(c, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+inline
+uint_t
+LockFreeQueue<T>::size()const{
+
+    auto enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+    auto dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+template<typename T>
+inline
+bool
+LockFreeQueue<T>::try_push(const T& element){
+
+    Cell* cell = nullptr;
+    uint_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+    while(true){
+
+        cell = &buffer_[pos & mask_];
+        uint_t seq = cell->sequence_.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+        if(diff == 0){
+
+            // the slot is free claim it
+            if(enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        else if(diff < 0){
+
+            // the consumers have not yet released
+            // the slot so the queue is full
+            return false;
+        }
+        else{
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->value_ = element;
+    cell->sequence_.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+inline
+bool
+LockFreeQueue<T>::pop(T& ele){
+
+    Cell* cell = nullptr;
+    uint_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+    while(true){
+
+        cell = &buffer_[pos & mask_];
+        uint_t seq = cell->sequence_.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+        if(diff == 0){
+
+            if(dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        else if(diff < 0){
+
+            // nothing has been published
+            // in this slot yet
+            return false;
+        }
+        else{
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    ele = cell->value_;
+
+    // make the slot available to the producers
+    // of the next round
+    cell->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+inline
+T
+LockFreeQueue<T>::pop_wait(){
+
+    T ele;
+    pop_wait(ele);
+    return ele;
+}
+
+template<typename T>
+inline
+bool
+LockFreeQueue<T>::pop_wait(T& ele){
+
+    taskutils::wait_until([this, &ele]{return pop(ele);});
+    return true;
+}
+
+template<typename T>
+inline
+void
+LockFreeQueue<T>::push_item(const T& element){
+
+    if(try_push(element)){
+        return;
+    }
+
+    taskutils::wait_until([this, &element]{return try_push(element);});
+}
+
+template<typename T>
+template<typename Iterator>
+void
+LockFreeQueue<T>::push_items(Iterator begin,Iterator end){
+
+    while(begin != end){
+
+      push_item(*begin);
+      begin++;
+    }
+}
+
+}//kernel
+#endif
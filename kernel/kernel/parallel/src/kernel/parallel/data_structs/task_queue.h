@@ -5,7 +5,7 @@
 #include <boost/core/noncopyable.hpp>
 
 #include <iostream>
-#include <queue>
+#include <vector>
 #include <mutex>
 #include <condition_variable>
 
@@ -15,7 +15,10 @@ namespace kernel
 /***
  * A simple implementation of a thread safe queue.
  * The implementation uses simple lock mechanism.
- * The type of the task held is specified by the template argument
+ * The type of the task held is specified by the template argument.
+ * The tasks are held in a ring buffer that only grows when it is full
+ * and keeps its storage when tasks are popped. Thus once the queue has
+ * held as many tasks as a batch has, pushing the batch again does not allocate
  * TODO: Think about copy operations. Do we really want to diable them?
  * TODO: We need to rethink the internal implementation
  **/
@@ -76,6 +79,12 @@ class TaskQueue: private boost::noncopyable
     //is the queue empty
     bool empty()const;
 
+    //steal an element from the back of the queue. If the queue
+    //is empty then return false. This is meant to be called by
+    //threads other than the owner of the queue so that the owner
+    //and the thief work on opposite ends of the queue
+    bool steal(value_type*& element);
+
  private:
 
     struct Node
@@ -121,30 +130,101 @@ class TaskQueue: private boost::noncopyable
         }
      };
 
-     std::queue<Node> task_queue_;
+     //the ring buffer. The queue occupies the size_
+     //slots starting at head_ and wrapping around
+     std::vector<Node> task_queue_;
+     uint_t head_;
+     uint_t size_;
+
      mutable std::mutex mutex_;
      std::condition_variable cond_;
 
+     //append an element. The lock should be held
+     void push_back_(const Node& n);
+
+     //remove the first element. The lock should be held
+     //and the queue should not be empty
+     Node pop_front_();
+
+     //remove the last element. The lock should be held
+     //and the queue should not be empty
+     Node pop_back_();
+
+     //double the capacity of the ring buffer keeping the
+     //order of the elements. The lock should be held
+     void grow_();
+
 };
 
 template<typename T>
 TaskQueue<T>::TaskQueue()
 :
-task_queue_()
+task_queue_(),
+head_(0),
+size_(0)
 {}
 
 template<typename T>
 inline
 uint_t
 TaskQueue<T>::size()const{
-    return static_cast<uint_t>(task_queue_.size());
+    std::lock_guard<std::mutex> lk(mutex_);
+    return size_;
 }
 
 template<typename T>
 inline
 bool
 TaskQueue<T>::empty()const{
-    return task_queue_.empty();
+    return size() == 0;
+}
+
+template<typename T>
+void
+TaskQueue<T>::grow_(){
+
+    const uint_t capacity = task_queue_.empty() ? 16 : 2*task_queue_.size();
+    std::vector<Node> buffer(capacity);
+
+    for(uint_t i=0; i<size_; ++i){
+        buffer[i] = task_queue_[(head_ + i) % task_queue_.size()];
+    }
+
+    task_queue_.swap(buffer);
+    head_ = 0;
+}
+
+template<typename T>
+inline
+void
+TaskQueue<T>::push_back_(const Node& n){
+
+    if(size_ == task_queue_.size()){
+        grow_();
+    }
+
+    task_queue_[(head_ + size_) % task_queue_.size()] = n;
+    size_++;
+}
+
+template<typename T>
+inline
+typename TaskQueue<T>::Node
+TaskQueue<T>::pop_front_(){
+
+    Node n = task_queue_[head_];
+    head_ = (head_ + 1) % task_queue_.size();
+    size_--;
+    return n;
+}
+
+template<typename T>
+inline
+typename TaskQueue<T>::Node
+TaskQueue<T>::pop_back_(){
+
+    size_--;
+    return task_queue_[(head_ + size_) % task_queue_.size()];
 }
 
 template<typename T>
@@ -156,10 +236,9 @@ TaskQueue<T>::pop_wait(){
     std::unique_lock<std::mutex> lk(mutex_);
 
     //tell the thread to wait until the queue has at least one element
-    cond_.wait(lk,[this]{ return !task_queue_.empty();});
+    cond_.wait(lk,[this]{ return size_ != 0;});
 
-    node n = task_queue_.front();
-    task_queue_.pop();
+    node n = pop_front_();
     return n.task_;
 }
 
@@ -172,10 +251,9 @@ TaskQueue<T>::pop_wait(T*& ele){
     std::unique_lock<std::mutex> lk(mutex_);
 
     //tell the thread to wait until the queue has at least one element
-    cond_.wait(lk,[this]{ return !task_queue_.empty();});
+    cond_.wait(lk,[this]{ return size_ != 0;});
 
-    node n = task_queue_.front();
-    task_queue_.pop();
+    node n = pop_front_();
     ele = n.task_;
     return true;
 }
@@ -188,10 +266,9 @@ TaskQueue<T>::pop(){
     typedef typename TaskQueue<T>::Node node;
     std::lock_guard<std::mutex> lk(mutex_);
 
-    if(task_queue_.empty()) return nullptr;
+    if(size_ == 0) return nullptr;
 
-    node n = task_queue_.front();
-    task_queue_.pop();
+    node n = pop_front_();
     return n.task_;
 }
 
@@ -203,10 +280,24 @@ TaskQueue<T>::pop(T*& ele){
     typedef typename TaskQueue<T>::Node node;
     std::lock_guard<std::mutex> lk(mutex_);
 
-    if(task_queue_.empty()) return false;
+    if(size_ == 0) return false;
+
+    node n = pop_front_();
+    ele = n.task_;
+    return true;
+}
+
+template<typename T>
+inline
+bool
+TaskQueue<T>::steal(T*& ele){
+
+    typedef typename TaskQueue<T>::Node node;
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    if(size_ == 0) return false;
 
-    node n = task_queue_.front();
-    task_queue_.pop();
+    node n = pop_back_();
     ele = n.task_;
     return true;
 }
@@ -219,7 +310,7 @@ TaskQueue<T>::push_task(T& element){
     typedef typename TaskQueue<T>::Node node;
     std::lock_guard<std::mutex> lk(mutex_);
 
-    task_queue_.push(node(&element));
+    push_back_(node(&element));
     cond_.notify_one();
 }
 
@@ -233,7 +324,7 @@ TaskQueue<T>::push_task(T* element){
 
     //node n(element);
 
-    task_queue_.push(node(element));
+    push_back_(node(element));
     cond_.notify_one();
 }
 
@@ -256,7 +347,7 @@ TaskQueue<T>::push_tasks(const C& tasks){
 
     while(b!=e){
 
-      task_queue_.push(node((*b)));
+      push_back_(node((*b)));
       b++;
     }
 
@@ -278,7 +369,7 @@ TaskQueue<T>::push_tasks(Iterator begin,Iterator end){
 
     while(begin != end){
 
-      task_queue_.push(node((*begin)));
+      push_back_(node((*begin)));
       begin++;
     }
 
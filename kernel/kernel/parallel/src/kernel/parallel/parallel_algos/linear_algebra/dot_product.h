@@ -63,8 +63,8 @@ public:
     /// \brief Returns the result
     const result_type& get()const{return result_;}
 
-    /// \brief Attempt to get the result only if it is valid. Perfroms busy
-    /// wait is the result is not valid
+    /// \brief Attempt to get the result only if it is valid. The calling
+    /// thread yields and then sleeps as long as the result is not valid
     const result_type& get_or_wait()const;
 
 private:
@@ -196,20 +196,25 @@ DotProduct<VectorTp, ResultTp>::execute(ExecutorTp& executor, const Options& opt
        std::this_thread::yield();
     }*/
 
-    //validate the result
-    result_.validate_result();
+    // join the partial sums before the result is validated
+    // as get_or_wait returns as soon as it becomes valid
+    bool finished = true;
 
     for(uint_t t=0; t < tasks_.size(); ++t){
 
         // if we reached here but for some reason the
-        // task has not finished properly invalidate the result
+        // task has not finished properly the result stays invalid
        if(tasks_[t]->get_state() != kernel::TaskBase::TaskState::FINISHED){
-           result_.invalidate_result(false);
+           finished = false;
        }
        else{
            result_.join(static_cast<task_type*>(tasks_[t].get())->get_result().get_resource());
        }
     }
+
+    if(finished){
+        result_.validate_result();
+    }
 }
 
 template<typename VectorTp, typename ResultTp>
@@ -245,20 +250,25 @@ DotProduct<VectorTp, ResultTp>::reexecute(ExecutorTp& executor, const Options& o
            std::this_thread::yield();
         }*/
 
-        //validate the result
-        result_.validate_result();
+        // join the partial sums before the result is validated
+        // as get_or_wait returns as soon as it becomes valid
+        bool finished = true;
 
         for(uint_t t=0; t < tasks_.size(); ++t){
 
             // if we reached here but for some reason the
-            // task has not finished properly invalidate the result
+            // task has not finished properly the result stays invalid
            if(tasks_[t]->get_state() != kernel::TaskBase::TaskState::FINISHED){
-               result_.invalidate_result(false);
+               finished = false;
            }
            else{
                result_.join(static_cast<task_type*>(tasks_[t].get())->get_result().get_resource());
            }
         }
+
+        if(finished){
+            result_.validate_result();
+        }
     }
 }
 
@@ -266,10 +276,7 @@ template<typename VectorTp, typename ResultTp>
 const typename DotProduct<VectorTp, ResultTp>::result_type&
 DotProduct<VectorTp, ResultTp>::get_or_wait()const{
 
-    while(!result_.is_result_valid()){
-        std::this_thread::yield();
-    }
-
+    result_.get_or_wait();
     return result_;
 }
 
@@ -305,7 +312,10 @@ DotProduct<VectorTp, ResultTp>::dot_product::run(){
     auto begin = parts.begin();
     auto end   = parts.end();
 
+    // the task is rescheduled by reexecute so
+    // the partial sum of the last run is discarded
     ResultTp& result = this->result_.get_resource();
+    result = ResultTp();
 
     for(uint_t r  = begin; r < end; ++r){
         result += (*v1_ptr)[r]*(*v2_ptr)[r];
@@ -49,12 +49,12 @@ public:
     /// \brief Get a copy of the held result
     void get_copy(result_type& copy)const;
 
-    /// \brief Attempt to get the result only if it is valid. It yields the calling thread
-    /// as long as  the result is not valid
+    /// \brief Attempt to get the result only if it is valid. The calling thread
+    /// yields and then sleeps as long as the result is not valid
     const result_type& get_or_wait()const;
 
-    /// \brief Attempt to get the result only if it is valid. It yields the calling thread
-    /// as long as  the result is not valid
+    /// \brief Attempt to get the result only if it is valid. The calling thread
+    /// yields and then sleeps as long as the result is not valid
     void get_or_wait_copy(result_type& copy)const;
 
     /// \brief Attempt to get the result. If the result is not valid is waits for the
@@ -11,9 +11,15 @@
 #include "kernel/parallel/threading/iterate_task.h"
 #include "kernel/parallel/threading/task_uitilities.h"
 #include "kernel/parallel/utilities/result_holder.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
 
 #include "boost/noncopyable.hpp"
 
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <memory>
+
 namespace kernel
 {
 
@@ -175,6 +181,74 @@ parallel_for<RangeTp, BodyTp, OMPExecutor>::execute(OMPExecutor& executor, const
 
 #endif
 
+/// \brief Task used by the over-decomposed parallel_for. Rather than
+/// owning a fixed partition, every task repeatedly claims the next
+/// unprocessed chunk from a shared counter until all chunks are consumed.
+/// Thus threads that finish early pick up the remaining work
+template<typename RangeTp, typename BodyTp>
+class chunked_iterate_task: public TaskBase
+{
+public:
+
+    typedef RangeTp range_type;
+    typedef BodyTp  body_type;
+
+    /// \brief Constructor
+    chunked_iterate_task(uint_t id, const std::vector<range1d<uint_t>>& chunks,
+                         std::atomic<uint_t>& next_chunk, const body_type& body, range_type& values);
+
+protected:
+
+    /// \brief Process chunks until none is left
+    virtual void run()override;
+
+private:
+
+    /// \brief The chunks shared by all the tasks
+    const std::vector<range1d<uint_t>>& chunks_;
+
+    /// \brief The index of the next chunk to claim
+    std::atomic<uint_t>& next_chunk_;
+
+    /// \brief The operation to apply on the elements
+    body_type op_;
+
+    /// \brief The values container to apply the Body
+    range_type& values_;
+};
+
+template<typename RangeTp, typename BodyTp>
+chunked_iterate_task<RangeTp, BodyTp>::chunked_iterate_task(uint_t id, const std::vector<range1d<uint_t>>& chunks,
+                                                            std::atomic<uint_t>& next_chunk, const body_type& body,
+                                                            range_type& values)
+    :
+   TaskBase(id),
+   chunks_(chunks),
+   next_chunk_(next_chunk),
+   op_(body),
+   values_(values)
+{}
+
+template<typename RangeTp, typename BodyTp>
+void
+chunked_iterate_task<RangeTp, BodyTp>::run(){
+
+    uint_t c = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+
+    while(c < chunks_.size()){
+
+        auto begin = chunks_[c].begin();
+        auto end   = chunks_[c].end();
+
+        while(begin != end){
+            op_(values_[begin]);
+            begin++;
+        }
+
+        c = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
 }
 
 /// \brief Apply Body on the elements of Range
@@ -199,6 +273,59 @@ parallel_for(Range& range, const Body& op, Executor& executor, const Options& op
     return result;
 }
 
+/// \brief Apply Body on the elements of Range using over-decomposition.
+/// The range [0, range.size()) is split by partition_range_by_grain into chunks
+/// of grain_size elements and the chunks are handed out dynamically to the
+/// processing elements of the executor. Any partitions already set on the
+/// range are ignored. If grain_size is zero, a grain that yields
+/// roughly eight chunks per processing element is used
+template<typename Range, typename Body, typename Executor, typename Options>
+ResultHolder<void>
+parallel_for(Range& range, const Body& op, Executor& executor, const Options& options, uint_t grain_size){
+
+    const uint_t n_elements = range.size();
+
+    if(n_elements == 0){
+        return ResultHolder<void>(true);
+    }
+
+    const uint_t n_workers = std::max(executor.n_processing_elements(), static_cast<uint_t>(1));
+
+    if(grain_size == 0){
+        grain_size = std::max(n_elements/(8*n_workers), static_cast<uint_t>(1));
+    }
+
+    std::vector<range1d<uint_t>> chunks;
+    partition_range_by_grain(0, n_elements, chunks, grain_size);
+
+    typedef detail::chunked_iterate_task<Range, Body> task_type;
+
+    std::atomic<uint_t> next_chunk(0);
+    std::vector<std::unique_ptr<task_type>> tasks;
+
+    const uint_t n_tasks = std::min(n_workers, static_cast<uint_t>(chunks.size()));
+    tasks.reserve(n_tasks);
+
+    for(uint_t t = 0; t < n_tasks; ++t){
+        tasks.push_back(std::make_unique<task_type>(t, chunks, next_chunk, op, range));
+    }
+
+    // this will block
+    executor.execute(tasks, options);
+
+    ResultHolder<void> result(true);
+    for(const auto& task : tasks){
+
+        // if we reached here but for some reason the
+        // task has not finished properly invalidate the result
+       if(task->get_state() != TaskBase::TaskState::FINISHED){
+           result.invalidate_result();
+       }
+    }
+
+    return result;
+}
+
 }
 
 #endif // PARALLEL_FOR_H
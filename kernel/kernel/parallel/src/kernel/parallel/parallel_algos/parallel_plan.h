@@ -0,0 +1,201 @@
+#ifndef PARALLEL_PLAN_H
+#define PARALLEL_PLAN_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/exceptions.h"
+#include "kernel/utilities/range_1d.h"
+#include "kernel/parallel/threading/iterate_task.h"
+#include "kernel/parallel/threading/task_uitilities.h"
+#include "kernel/parallel/parallel_algos/parallel_reduce.h"
+#include "kernel/parallel/utilities/result_holder.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <vector>
+#include <memory>
+#include <string>
+
+namespace kernel
+{
+
+/// \brief A reusable parallel_for. The plan creates one task per
+/// partition of the range when it is constructed. Every call to execute()
+/// reschedules these tasks and hands them to the executor so that
+/// repeated calls, for example within the iterations of a solver, do not
+/// allocate tasks. With a ThreadPool the worker queues keep their storage
+/// so after the first call the submission does not allocate either.
+/// The partitions of the range are copied upon construction.
+/// If they change, a new plan should be created
+template<typename RangeTp, typename BodyTp, typename ExecutorTp>
+class ParallelForPlan: private boost::noncopyable
+{
+public:
+
+    typedef RangeTp range_type;
+    typedef BodyTp  body_type;
+    typedef ExecutorTp executor_type;
+    typedef IterateTask<typename range_type::partition_type, body_type, range_type> task_type;
+
+    /// \brief Constructor. Throws InvalidPartitionedObject if the range
+    /// is not partitioned in as many partitions as the executor has processing elements
+    ParallelForPlan(range_type& range, const body_type& body, executor_type& executor);
+
+    /// \brief Execute the plan with the given options. This blocks
+    /// until all the tasks have been executed
+    template<typename Options>
+    ResultHolder<void> execute(const Options& options);
+
+    /// \brief Returns the number of tasks the plan owns
+    uint_t n_tasks()const{return tasks_.size();}
+
+    /// \brief Returns true if the spawned tasks have finished
+    bool tasks_finished()const{return kernel::taskutils::tasks_finished(tasks_);}
+
+private:
+
+    /// \brief The executor that runs the tasks
+    executor_type& executor_;
+
+    /// \brief The tasks to be submitted to the executor
+    std::vector<std::unique_ptr<task_type>> tasks_;
+};
+
+template<typename RangeTp, typename BodyTp, typename ExecutorTp>
+ParallelForPlan<RangeTp, BodyTp, ExecutorTp>::ParallelForPlan(range_type& range, const body_type& body,
+                                                              executor_type& executor)
+    :
+executor_(executor),
+tasks_()
+{
+    if(!range.has_partitions()){
+        throw InvalidPartitionedObject("The given range does not have partitions");
+    }
+
+    if(range.n_partitions() != executor.n_processing_elements()){
+        throw InvalidPartitionedObject("Invalid number of partitions: "+
+                                       std::to_string(range.n_partitions())+" should be: "+
+                                       std::to_string(executor.n_processing_elements()));
+    }
+
+    tasks_.reserve(range.n_partitions());
+
+    for(uint_t t = 0; t < range.n_partitions(); ++t){
+        tasks_.push_back(std::make_unique<task_type>(t, range.get_partition(t), body, range));
+    }
+}
+
+template<typename RangeTp, typename BodyTp, typename ExecutorTp>
+template<typename Options>
+ResultHolder<void>
+ParallelForPlan<RangeTp, BodyTp, ExecutorTp>::execute(const Options& options){
+
+    for(auto& task : tasks_){
+        task->reschedule();
+    }
+
+    // this will block
+    executor_.execute(tasks_, options);
+
+    ResultHolder<void> result(true);
+    for(const auto& task : tasks_){
+
+        // if we reached here but for some reason the
+        // task has not finished properly invalidate the result
+       if(task->get_state() != TaskBase::TaskState::FINISHED){
+           result.invalidate_result();
+       }
+    }
+
+    return result;
+}
+
+
+/// \brief A reusable reduction over the given partitions. Similar
+/// to ParallelForPlan the tasks are created once upon construction and
+/// every call to execute() reuses them
+template<typename IteratorTp, typename ReductionOpTp, typename ExecutorTp>
+class ReducePlan: private boost::noncopyable
+{
+public:
+
+    typedef ExecutorTp executor_type;
+    typedef detail::reduce_1d_task<IteratorTp, ReductionOpTp> task_type;
+
+    /// \brief Constructor. Throws InvalidPartitionedObject if the number of
+    /// partitions is not equal to the number of processing elements of the executor
+    ReducePlan(const std::vector<range1d<IteratorTp>>& partitions, executor_type& executor);
+
+    /// \brief Execute the plan and join the partial results
+    /// into op. This blocks until all the tasks have been executed
+    template<typename Options>
+    void execute(ReductionOpTp& op, const Options& options);
+
+    /// \brief Returns the number of tasks the plan owns
+    uint_t n_tasks()const{return tasks_.size();}
+
+    /// \brief Returns true if the spawned tasks have finished
+    bool tasks_finished()const{return kernel::taskutils::tasks_finished(tasks_);}
+
+private:
+
+    /// \brief The executor that runs the tasks
+    executor_type& executor_;
+
+    /// \brief The tasks to be submitted to the executor
+    std::vector<std::unique_ptr<task_type>> tasks_;
+};
+
+template<typename IteratorTp, typename ReductionOpTp, typename ExecutorTp>
+ReducePlan<IteratorTp, ReductionOpTp, ExecutorTp>::ReducePlan(const std::vector<range1d<IteratorTp>>& partitions,
+                                                              executor_type& executor)
+    :
+executor_(executor),
+tasks_()
+{
+    if(partitions.size() != executor.n_processing_elements()){
+        throw InvalidPartitionedObject("Invalid number of partitions: "+
+                                       std::to_string(partitions.size())+" should be: "+
+                                       std::to_string(executor.n_processing_elements()));
+    }
+
+    tasks_.reserve(partitions.size());
+
+    for(uint_t t = 0; t < partitions.size(); ++t){
+        tasks_.push_back(std::make_unique<task_type>(partitions[t]));
+    }
+}
+
+template<typename IteratorTp, typename ReductionOpTp, typename ExecutorTp>
+template<typename Options>
+void
+ReducePlan<IteratorTp, ReductionOpTp, ExecutorTp>::execute(ReductionOpTp& op, const Options& options){
+
+    for(auto& task : tasks_){
+        task->reschedule();
+    }
+
+    // this will block
+    executor_.execute(tasks_, options);
+
+    op.validate_result();
+
+    for(const auto& task : tasks_){
+
+        // if we reached here but for some reason the
+        // task has not finished properly invalidate the result
+       if(task->get_state() != TaskBase::TaskState::FINISHED){
+           op.invalidate_result(false);
+       }
+       else{
+
+           // use the const overload so
+           // that the result is not copied
+           const task_type& reduce_task = *task;
+           op.join(reduce_task.get_result().get_resource());
+       }
+    }
+}
+
+}
+
+#endif // PARALLEL_PLAN_H
@@ -10,10 +10,13 @@
 #include "kernel/parallel/threading/task_uitilities.h"
 #include "kernel/parallel/utilities/result_holder.h"
 
+#include <boost/noncopyable.hpp>
 
 #include <vector>
 #include <memory>
 #include <thread>
+#include <atomic>
+#include <string>
 
 namespace kernel
 {
@@ -21,6 +24,54 @@ namespace kernel
 namespace detail
 {
 
+/// \brief Task that reduces the elements of a range1d
+/// into its result using ReductionOpTp::local_join
+template<typename IteratorTp, typename ReductionOpTp>
+struct reduce_1d_task: public SimpleTaskBase<typename ReductionOpTp::value_type>
+{
+
+    /// \brief Constructor
+    reduce_1d_task(const range1d<IteratorTp>& range);
+
+    /// \brief Reschedule the task. It also resets the
+    /// result so that the task can be executed again
+    virtual void reschedule()override;
+
+protected:
+
+    /// \brief Override base class run method
+    virtual void run()override final;
+
+    /// \brief The range over which the task is working
+    range1d<IteratorTp> range_;
+};
+
+template<typename IteratorTp, typename ReductionOpTp>
+reduce_1d_task<IteratorTp,ReductionOpTp>::reduce_1d_task(const range1d<IteratorTp>& range)
+    :
+  SimpleTaskBase<typename ReductionOpTp::value_type>(),
+  range_(range)
+{}
+
+template<typename IteratorTp, typename ReductionOpTp>
+void
+reduce_1d_task<IteratorTp, ReductionOpTp>::reschedule(){
+
+    this->result_.invalidate_result(true);
+    this->set_state(TaskBase::TaskState::PENDING);
+}
+
+template<typename IteratorTp, typename ReductionOpTp>
+void
+reduce_1d_task<IteratorTp, ReductionOpTp>::run(){
+
+    for(const auto& item : range_){
+
+        ReductionOpTp::local_join(iterator_value_accessor<IteratorTp>::get(item),
+                                  this->result_.get_resource());
+    }
+}
+
 template<typename IteratorTp, typename ReductionOpTp>
 class reduce_1d_array
 {
@@ -38,47 +89,14 @@ public:
 
 private:
 
-     /// \brief Struct describing the reduction task
-     struct reduce_task: public SimpleTaskBase<typename ReductionOpTp::value_type>
-     {
-         //typedef typename ReductionOpTp::value_type result_type;
-
-         /// \brief Constructor
-         reduce_task(const range1d<IteratorTp>& range);
-
-
-     protected:
-
-         /// \brief Override base class run method
-         virtual void run()override final;
-
-         /// \brief The range over which the task is working
-         range1d<IteratorTp> range_;
-     };
+     /// \brief The reduction task
+     typedef reduce_1d_task<IteratorTp, ReductionOpTp> reduce_task;
 
      /// \brief The tasks to be scheduled
      std::vector<std::unique_ptr<reduce_task>> tasks_;
 
 };
 
- template<typename IteratorTp, typename ReductionOpTp>
- reduce_1d_array<IteratorTp,ReductionOpTp>::reduce_task::reduce_task(const range1d<IteratorTp>& range)
-     :
-   SimpleTaskBase<typename ReductionOpTp::value_type>(),
-   range_(range)
- {}
-
- template<typename IteratorTp, typename ReductionOpTp>
- void
- reduce_1d_array<IteratorTp, ReductionOpTp>::reduce_task::run(){
-
-     for(const auto& item : range_){
-
-         ReductionOpTp::local_join(iterator_value_accessor<IteratorTp>::get(item),
-                                   this->result_.get_resource());
-     }
- }
-
 template<typename IteratorTp, typename ReductionOpTp>
 template<typename ExecutorTp, typename Options>
 void
@@ -118,6 +136,163 @@ reduce_1d_array<IteratorTp, ReductionOpTp>::execute(const std::vector<range1d<It
        }
     }
 }
+
+/// \brief Reduction over a partitioned range. Every task reduces one
+/// partition and then the partial results are combined pairwise
+/// along a binary tree. The task that completes second at a tree node
+/// joins the partial result of its sibling and moves one level up
+/// whilst the other task simply returns. Thus no task waits and the
+/// combine step takes log2(n_partitions) joins on the critical path.
+/// The final result is held by the task of the first partition
+template<typename RangeTp, typename ReduceOpTp>
+class parallel_reduce: private boost::noncopyable
+{
+public:
+
+    typedef RangeTp range_type;
+    typedef typename ReduceOpTp::value_type value_type;
+
+    /// \brief Constructor
+    parallel_reduce(const range_type& range);
+
+    /// \brief Execute the reduction using the given executor
+    template<typename ExecutorTp, typename Options>
+    ResultHolder<value_type> execute(ExecutorTp& executor, const Options& options);
+
+    /// \brief Returns true if the spawned tasks have finished
+    bool tasks_finished()const{return kernel::taskutils::tasks_finished(tasks_);}
+
+private:
+
+    /// \brief The task that reduces a partition
+    struct reduce_task: public SimpleTaskBase<value_type>
+    {
+        /// \brief Constructor
+        reduce_task(uint_t id, parallel_reduce<RangeTp, ReduceOpTp>& algo);
+
+        /// \brief Access the partial result
+        value_type& partial(){return this->result_.get_resource();}
+
+    protected:
+
+        /// \brief Override base class run method
+        virtual void run()override final;
+
+        /// \brief The algorithm the task belongs to
+        parallel_reduce<RangeTp, ReduceOpTp>& algo_;
+    };
+
+    /// \brief The range over which the algorithm works
+    const range_type& range_;
+
+    /// \brief The tasks to be submitted to the executor
+    std::vector<std::unique_ptr<reduce_task>> tasks_;
+
+    /// \brief How many tasks have arrived at each tree node.
+    /// The node at level l with left child t combines the partial
+    /// results of the tasks t and t + 2^l. Every task but the first is
+    /// the right child of exactly one node so the node is indexed by it
+    std::unique_ptr<std::atomic<uint_t>[]> arrivals_;
+
+    /// \brief Combine the partial result of task t with
+    /// its siblings for as long as it completes second
+    void combine_(uint_t t);
+};
+
+template<typename RangeTp, typename ReduceOpTp>
+parallel_reduce<RangeTp, ReduceOpTp>::parallel_reduce(const range_type& range)
+    :
+range_(range),
+tasks_(),
+arrivals_()
+{}
+
+template<typename RangeTp, typename ReduceOpTp>
+parallel_reduce<RangeTp, ReduceOpTp>::reduce_task::reduce_task(uint_t id, parallel_reduce<RangeTp, ReduceOpTp>& algo)
+    :
+SimpleTaskBase<value_type>(id),
+algo_(algo)
+{}
+
+template<typename RangeTp, typename ReduceOpTp>
+void
+parallel_reduce<RangeTp, ReduceOpTp>::reduce_task::run(){
+
+    const auto partition = algo_.range_.get_partition(this->get_id());
+    value_type& result = partial();
+
+    for(uint_t i=partition.begin(); i<partition.end(); ++i){
+        ReduceOpTp::local_join(algo_.range_[i], result);
+    }
+
+    algo_.combine_(this->get_id());
+}
+
+template<typename RangeTp, typename ReduceOpTp>
+void
+parallel_reduce<RangeTp, ReduceOpTp>::combine_(uint_t t){
+
+    const uint_t n_tasks = tasks_.size();
+
+    for(uint_t stride = 1; stride < n_tasks; stride *= 2){
+
+        // the left child of the node
+        // holds the result of the node
+        const uint_t left = t - t % (2*stride);
+        const uint_t right = left + stride;
+
+        // no sibling at this level
+        if(right >= n_tasks){
+            continue;
+        }
+
+        // the first to arrive leaves the work to the other
+        if(arrivals_[right].fetch_add(1, std::memory_order_acq_rel) == 0){
+            return;
+        }
+
+        ReduceOpTp::local_join(tasks_[right]->partial(), tasks_[left]->partial());
+        t = left;
+    }
+}
+
+template<typename RangeTp, typename ReduceOpTp>
+template<typename ExecutorTp, typename Options>
+ResultHolder<typename ReduceOpTp::value_type>
+parallel_reduce<RangeTp, ReduceOpTp>::execute(ExecutorTp& executor, const Options& options){
+
+    const uint_t n_tasks = range_.n_partitions();
+
+    tasks_.clear();
+    tasks_.reserve(n_tasks);
+
+    for(uint_t t = 0; t < n_tasks; ++t){
+        tasks_.push_back(std::make_unique<reduce_task>(t, *this));
+    }
+
+    arrivals_ = std::make_unique<std::atomic<uint_t>[]>(n_tasks);
+    for(uint_t t = 0; t < n_tasks; ++t){
+        arrivals_[t].store(0, std::memory_order_relaxed);
+    }
+
+    // this will block
+    executor.execute(tasks_, options);
+
+    ResultHolder<value_type> result(true);
+    for(uint_t t=0; t < tasks_.size(); ++t){
+
+        // if we reached here but for some reason the
+        // task has not finished properly invalidate the result
+       if(tasks_[t]->get_state() != TaskBase::TaskState::FINISHED){
+           result.invalidate_result(false);
+           return result;
+       }
+    }
+
+    ReduceOpTp::local_join(tasks_[0]->partial(), result.get_resource());
+    return result;
+}
+
 }
 
 template<typename IteratorTp, typename ReductionOpTp, typename ExecutorTp>
@@ -127,9 +302,12 @@ void reduce_array(const std::vector<range1d<IteratorTp>>& partitions, ReductionO
     reduce.execute(partitions, op, executor, Null());
 }
 
-template<typename RangeTp, typename ReduceOpTp, typename ExecutorTp>
-ResultHolder<typename ReduceOpTp::result_type>
-parallel_reduce(const RangeTp& range, const ReduceOpTp& reduction_op, ExecutorTp& executor){
+/// \brief Reduce the elements of the given partitioned range using
+/// ReduceOpTp::local_join. The partial results of the partitions are
+/// combined pairwise in parallel. Blocks until the reduction finishes
+template<typename RangeTp, typename ReduceOpTp, typename ExecutorTp, typename Options>
+ResultHolder<typename ReduceOpTp::value_type>
+parallel_reduce(const RangeTp& range, const ReduceOpTp& /*reduction_op*/, ExecutorTp& executor, const Options& options){
 
     if(!range.has_partitions()){
         throw InvalidPartitionedObject("The given range does not have partitions");
@@ -140,6 +318,17 @@ parallel_reduce(const RangeTp& range, const ReduceOpTp& reduction_op, ExecutorTp
                                        std::to_string(range.n_partitions())+" should be: "+
                                        std::to_string(executor.n_processing_elements()));
     }
+
+    detail::parallel_reduce<RangeTp, ReduceOpTp> algo(range);
+    return algo.execute(executor, options);
+}
+
+/// \brief Reduce the elements of the given partitioned range using
+/// the default options of the executor
+template<typename RangeTp, typename ReduceOpTp, typename ExecutorTp>
+ResultHolder<typename ReduceOpTp::value_type>
+parallel_reduce(const RangeTp& range, const ReduceOpTp& reduction_op, ExecutorTp& executor){
+    return parallel_reduce(range, reduction_op, executor, typename ExecutorTp::default_options_t());
 }
 
 
@@ -0,0 +1,46 @@
+#include "kernel/parallel/threading/count_down_latch.h"
+
+#include <thread>
+
+namespace kernel
+{
+
+CountDownLatch::CountDownLatch(uint_t count)
+    :
+    count_(count),
+    m_(),
+    cvar_()
+{}
+
+void
+CountDownLatch::count_down(){
+
+    // the count is modified under the lock so that a waiting
+    // thread that leaves the spin phase cannot destroy the latch
+    // whilst we are still notifying
+    std::lock_guard<std::mutex> lck(m_);
+
+    if(count_.load(std::memory_order_relaxed) == 0){
+        return;
+    }
+
+    if(count_.fetch_sub(1, std::memory_order_acq_rel) == 1){
+        cvar_.notify_all();
+    }
+}
+
+void
+CountDownLatch::wait(uint_t n_spins){
+
+    for(uint_t s=0; s<n_spins && !is_released(); ++s){
+        std::this_thread::yield();
+    }
+
+    // even if the count reached zero whilst spinning we
+    // acquire the lock so that we synchronize with the
+    // thread that did the last count down
+    std::unique_lock<std::mutex> lck(m_);
+    cvar_.wait(lck, [this]{return is_released();});
+}
+
+}
@@ -0,0 +1,56 @@
+#ifndef COUNT_DOWN_LATCH_H
+#define COUNT_DOWN_LATCH_H
+
+#include "kernel/base/types.h"
+#include <boost/core/noncopyable.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+namespace kernel
+{
+
+/**
+ * @brief The CountDownLatch class. A single use barrier that
+ * lets one or more threads sleep until a number of operations, typically
+ * the tasks of a batch, have completed. Waiting threads may spin
+ * for a number of iterations before they park on the
+ * underlying condition variable
+ */
+class CountDownLatch: private boost::noncopyable
+{
+
+public:
+
+    /// \brief Constructor. Initialize the latch with the
+    /// number of count_down() calls to wait for
+    explicit CountDownLatch(uint_t count);
+
+    /// \brief Decrease the count by one. When the count
+    /// reaches zero all waiting threads are released
+    void count_down();
+
+    /// \brief Block the calling thread until the count reaches zero.
+    /// The thread first polls the count n_spins times yielding in between
+    /// and then sleeps until it is notified
+    void wait(uint_t n_spins=0);
+
+    /// \brief Returns true if the count has reached zero
+    bool is_released()const{return count_.load(std::memory_order_acquire) == 0;}
+
+    /// \brief Returns the current count
+    uint_t count()const{return count_.load(std::memory_order_acquire);}
+
+private:
+
+    /// \brief The number of operations still pending
+    std::atomic<uint_t> count_;
+
+    std::mutex m_;
+    std::condition_variable cvar_;
+};
+
+}
+
+#endif // COUNT_DOWN_LATCH_H
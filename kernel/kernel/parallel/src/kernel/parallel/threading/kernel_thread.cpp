@@ -1,5 +1,7 @@
 #include "kernel/parallel/threading/kernel_thread.h"
 #include "kernel/parallel/threading/task_base.h"
+#include "kernel/parallel/threading/count_down_latch.h"
+#include "kernel/parallel/threading/thread_affinity.h"
 
 namespace kernel
 {
@@ -7,38 +9,71 @@ namespace kernel
 namespace detail
 {
 
-kernel_thread::kernel_thread(uint_t id)
+kernel_thread::kernel_thread(uint_t id, uint_t lock_free_capacity)
     :
       working_(false),
       started_(false),
       stop_(false),
       id_(id),
       t_(),
-      tasks_()
- {}
+      tasks_(),
+      bound_tasks_(),
+      lock_free_tasks_(),
+      victims_(),
+      dispatcher_(),
+      runnable_(),
+      cpu_(0),
+      pinned_(false),
+      is_pinned_(false)
+ {
+    if(lock_free_capacity != 0){
+        lock_free_tasks_ = std::make_unique<LockFreeQueue<task_type_ptr>>(lock_free_capacity);
+    }
+ }
 
 void
-kernel_thread::do_work_(){
+kernel_thread::do_work_(std::promise<void>* ready){
 
   typedef kernel_thread::task_type_ptr task_type_ptr;
 
+  // pin before any task is popped so that
+  // no task runs on the wrong CPU
+  if(pinned_){
+      is_pinned_ = pin_current_thread(cpu_);
+  }
+
+  ready->set_value();
+
   //if the thread has not been told to stop
   //the try to get some work to do
   while(!stop_){
 
       task_type_ptr task = nullptr;
 
-      if(tasks_.pop(task)){
+      // first look into our own queue and if
+      // this is empty try to steal from the others
+      if(pop_task_(task) || steal_(task)){
 
               working_ = true;
-
-              //the task may have children
-              //in order to respect locality of data
-              //execute the returned child
-              //while(task != nullptr){
-              //    task = task->execute();
-              //}
               (*task)();
+
+              // the task may be part of a graph with tasks
+              // that wait for it. This must happen before the
+              // latch is released
+              if(task->get_completion_callback()){
+                  release_children_(*task);
+              }
+
+              // release the latch after we are done with the
+              // task as the submitter may destroy it once the
+              // latch is released
+              CountDownLatch* latch = task->get_latch();
+              task->set_latch(nullptr);
+
+              if(latch){
+                  latch->count_down();
+              }
+
               working_ = false;
       }
       else{
@@ -50,6 +85,88 @@ kernel_thread::do_work_(){
 }
 
 
+void
+kernel_thread::release_children_(task_type& task){
+
+    runnable_.clear();
+    task.get_completion_callback()(task, runnable_);
+
+    for(uint_t c=0; c<runnable_.size(); ++c){
+
+        // in order to respect locality of data
+        // the first runnable child stays with us
+        if(c == 0 || !dispatcher_){
+            push_task(*runnable_[c]);
+        }
+        else{
+            dispatcher_(*runnable_[c]);
+        }
+    }
+}
+
+bool
+kernel_thread::pop_task_(kernel_thread::task_type_ptr& task){
+
+    if(bound_tasks_.pop(task)){
+        return true;
+    }
+
+    if(lock_free_tasks_ && lock_free_tasks_->pop(task)){
+        return true;
+    }
+
+    return tasks_.pop(task);
+}
+
+bool
+kernel_thread::steal_task(kernel_thread::task_type_ptr& task){
+
+    // the lock-free queue is safe to pop from any thread
+    if(lock_free_tasks_ && lock_free_tasks_->pop(task)){
+        return true;
+    }
+
+    return tasks_.steal(task);
+}
+
+uint_t
+kernel_thread::n_tasks()const{
+
+    uint_t n = tasks_.size() + bound_tasks_.size();
+
+    if(lock_free_tasks_){
+        n += lock_free_tasks_->size();
+    }
+
+    return n;
+}
+
+bool
+kernel_thread::steal_(kernel_thread::task_type_ptr& task){
+
+    if(victims_.empty()){
+        return false;
+    }
+
+    // start from the neighbour so that idle
+    // threads do not all hit the same victim
+    for(uint_t v=0; v<victims_.size(); ++v){
+
+        auto* victim = victims_[(id_ + v + 1) % victims_.size()];
+
+        if(victim == this){
+            continue;
+        }
+
+        if(victim->steal_task(task)){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
 void
 kernel_thread::start(){
 
@@ -59,7 +176,14 @@ kernel_thread::start(){
         return;
      }
 
-     t_ = std::thread(&kernel_thread::do_work_,this);
+     std::promise<void> ready;
+     std::future<void> pinned = ready.get_future();
+
+     t_ = std::thread(&kernel_thread::do_work_, this, &ready);
+
+     // wait until the thread has pinned itself
+     pinned.wait();
+
      started_ = true;
 }
 
@@ -82,9 +206,21 @@ kernel_thread::stop(){
 
 void
 kernel_thread::push_task(kernel_thread::task_type& task){
+
+    // fall back to the locked queue
+    // if the lock-free one is full
+    if(lock_free_tasks_ && lock_free_tasks_->try_push(&task)){
+        return;
+    }
+
     tasks_.push_task(&task);
 }
 
+void
+kernel_thread::push_bound_task(kernel_thread::task_type& task){
+    bound_tasks_.push_task(&task);
+}
+
 void
 kernel_thread::join(){
 
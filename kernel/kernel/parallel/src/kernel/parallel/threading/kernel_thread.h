@@ -3,12 +3,15 @@
 
 #include "kernel/base/types.h"
 #include "kernel/parallel/data_structs/task_queue.h"
+#include "kernel/parallel/data_structs/lock_free_queue.h"
 #include <boost/core/noncopyable.hpp>
 
 #include <vector>
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <functional>
+#include <future>
 
 namespace kernel
 {
@@ -41,9 +44,12 @@ public:
     typedef task_type* task_type_ptr;
 
     /**
-     * ctor construct by passing the id of the thread
+     * ctor construct by passing the id of the thread.
+     * If lock_free_capacity is not zero the thread queues
+     * tasks in a lock-free queue of the given capacity and uses
+     * the locked queue only when the former is full
      */
-    explicit kernel_thread(uint_t id);
+    explicit kernel_thread(uint_t id, uint_t lock_free_capacity=0);
 
     /**
      * dtor wait until the thread finishes
@@ -79,11 +85,50 @@ public:
      */
     void push_task(task_type& t);
 
+    /**
+     * add a task that only this thread may execute.
+     * Such tasks are never stolen by other threads
+     */
+    void push_bound_task(task_type& t);
+
     /**
      * how many tasks the thread has. This is just a glimpse
      * of the tasks that the current thread has
      */
-    uint_t n_tasks()const{return tasks_.size();}
+    uint_t n_tasks()const;
+
+    /**
+     * steal a task from the back of the queue of this
+     * thread. Returns false if there is nothing to steal
+     */
+    bool steal_task(task_type_ptr& task);
+
+    /**
+     * set the threads this thread is allowed to steal
+     * work from when its own queue is empty. By default
+     * the thread does not steal
+     */
+    void set_victims(const std::vector<kernel_thread*>& victims){victims_ = victims;}
+
+    /**
+     * set the function used to hand out the children of an
+     * executed task that became runnable. If not set, the children
+     * are queued on this thread
+     */
+    void set_dispatcher(const std::function<void(task_type&)>& dispatcher){dispatcher_ = dispatcher;}
+
+    /**
+     * pin the thread on the given CPU when it is started. The thread
+     * pins itself before it looks for work and start() returns only
+     * after the attempt. It has no effect on a thread that is already running
+     */
+    void set_cpu(uint_t cpu){cpu_ = cpu; pinned_ = true;}
+
+    /**
+     * returns true if the thread was successfully pinned
+     * on the CPU given with set_cpu()
+     */
+    bool is_pinned()const noexcept{return is_pinned_;}
 
 private:
 
@@ -113,8 +158,47 @@ private:
     /// \brief The queue of thread tasks
     TaskQueue<task_type> tasks_;
 
-    /// \brief the function that actually does the work
-    void do_work_();
+    /// \brief The queue of tasks bound to this thread
+    TaskQueue<task_type> bound_tasks_;
+
+    /// \brief The lock-free queue of thread tasks. This
+    /// is null unless a lock-free capacity is given
+    std::unique_ptr<LockFreeQueue<task_type_ptr>> lock_free_tasks_;
+
+    /// \brief The threads to steal from when idle
+    std::vector<kernel_thread*> victims_;
+
+    /// \brief Hands out the children that became runnable
+    std::function<void(task_type&)> dispatcher_;
+
+    /// \brief The tasks that became runnable after
+    /// the execution of the last task
+    std::vector<task_type_ptr> runnable_;
+
+    /// \brief The CPU to pin the thread on
+    uint_t cpu_;
+
+    /// \brief flag indicating whether the thread should be pinned
+    bool pinned_;
+
+    /// \brief flag indicating whether pinning succeeded
+    bool is_pinned_;
+
+    /// \brief the function that actually does the work. The
+    /// promise is set once the thread has been pinned
+    void do_work_(std::promise<void>* ready);
+
+    /// \brief pop a task from the queues of this thread
+    bool pop_task_(task_type_ptr& task);
+
+    /// \brief call the completion callback of the given executed task. The
+    /// first task that becomes runnable is queued on this thread so that
+    /// it can reuse the data of its parent, the rest are dispatched
+    void release_children_(task_type& task);
+
+    /// \brief attempt to steal a task from one of the victims.
+    /// Returns true if a task was stolen
+    bool steal_(task_type_ptr& task);
 };
 
 }//detail
@@ -16,6 +16,46 @@ OMPExecutor::get_n_threads()const{
 
     return n_threads;
 }
+
+namespace detail
+{
+
+omp_schedule_guard::omp_schedule_guard(OMPOptions::ScheduleType type, uint_t chunk_size)
+    :
+    previous_kind_(),
+    previous_chunk_size_()
+{
+    omp_get_schedule(&previous_kind_, &previous_chunk_size_);
+
+    // a chunk size less than one
+    // means use the default
+    const int chunk = static_cast<int>(chunk_size);
+
+    switch(type){
+
+        case OMPOptions::ScheduleType::STATIC:
+            omp_set_schedule(omp_sched_static, chunk);
+            break;
+        case OMPOptions::ScheduleType::DYNAMIC:
+            omp_set_schedule(omp_sched_dynamic, chunk);
+            break;
+        case OMPOptions::ScheduleType::GUIDED:
+            omp_set_schedule(omp_sched_guided, chunk);
+            break;
+        case OMPOptions::ScheduleType::AUTO:
+            omp_set_schedule(omp_sched_auto, 0);
+            break;
+        case OMPOptions::ScheduleType::RUNTIME:
+        case OMPOptions::ScheduleType::DEFAULT:
+            break;
+    }
+}
+
+omp_schedule_guard::~omp_schedule_guard(){
+    omp_set_schedule(previous_kind_, previous_chunk_size_);
+}
+
+}
 }
 
 #endif
@@ -25,13 +25,45 @@ struct OMPOptions
 
     ScheduleType schedule;
 
+    /// \brief The chunk size used with the STATIC, DYNAMIC and GUIDED
+    /// schedules. Zero lets the OpenMP implementation choose. It has no
+    /// effect with AUTO, RUNTIME and DEFAULT
+    uint_t chunk_size;
 
-    OMPOptions(ScheduleType schedule_=ScheduleType::DEFAULT)
+    OMPOptions(ScheduleType schedule_=ScheduleType::DEFAULT, uint_t chunk_size_=0)
         :
-          schedule(schedule_)
+          schedule(schedule_),
+          chunk_size(chunk_size_)
     {}
 };
 
+namespace detail
+{
+
+/**
+ * @brief The omp_schedule_guard class. Sets the OpenMP run-sched-var to
+ * the given schedule so that loops with schedule(runtime) use it and
+ * restores the previous value upon destruction. With ScheduleType::RUNTIME
+ * the run-sched-var is left untouched i.e. OMP_SCHEDULE is respected
+ */
+class omp_schedule_guard: private boost::noncopyable
+{
+public:
+
+    /// \brief Constructor
+    omp_schedule_guard(OMPOptions::ScheduleType type, uint_t chunk_size);
+
+    /// \brief Destructor. Restore the previous schedule
+    ~omp_schedule_guard();
+
+private:
+
+    omp_sched_t previous_kind_;
+    int previous_chunk_size_;
+};
+
+}
+
 /**
  * @brief The OMPExecutor class. Executes task using OpenMP threading
  */
@@ -70,10 +102,12 @@ public:
 
     /// \brief Execute the given task list in parallel but do not wait
     template<typename TaskTypePtr>
-    void parallel_for_nowait(const std::vector<TaskTypePtr>& tasks, OMPOptions::ScheduleType type=OMPOptions::ScheduleType::DEFAULT)const;
+    void parallel_for_nowait(const std::vector<TaskTypePtr>& tasks, OMPOptions::ScheduleType type=OMPOptions::ScheduleType::DEFAULT,
+                             uint_t chunk_size=0)const;
 
     template<typename TaskType, typename OpType>
-    void parallel_for_reduce(uint_t iterations, OpType& operation, OMPOptions::ScheduleType type=OMPOptions::ScheduleType::DEFAULT)const;
+    void parallel_for_reduce(uint_t iterations, OpType& operation, OMPOptions::ScheduleType type=OMPOptions::ScheduleType::DEFAULT,
+                             uint_t chunk_size=0)const;
 
     /// \brief Has dynamic teams enabled or not
     bool has_dynamic_teams()const{return has_disabled_dyn_teams_;}
@@ -117,14 +151,20 @@ OMPExecutor::execute(const std::vector<TaskTypePtr>& tasks, const Options& optio
         }
     }
     else{
-        throw std::invalid_argument("Invalid scheduling type");
+
+        detail::omp_schedule_guard guard(options.schedule, options.chunk_size);
+
+        #pragma omp parallel for shared(tasks) schedule(runtime)
+            for(uint_t t=0; t<tasks.size(); ++t){
+                    tasks[t]->execute();
+            }
     }
 }
 
 
 template<typename TaskTypePtr>
 void
-OMPExecutor::parallel_for_nowait(const std::vector<TaskTypePtr>& tasks, OMPOptions::ScheduleType type)const{
+OMPExecutor::parallel_for_nowait(const std::vector<TaskTypePtr>& tasks, OMPOptions::ScheduleType type, uint_t chunk_size)const{
 
     if(type == OMPOptions::ScheduleType::DEFAULT){
 
@@ -133,16 +173,23 @@ OMPExecutor::parallel_for_nowait(const std::vector<TaskTypePtr>& tasks, OMPOptio
                 for(uint_t t=0; t<tasks.size(); ++t){
                     tasks[t]->execute();
                 }
-        }
+    }
     else{
-        throw std::invalid_argument("Invalid scheduling type");
+
+        detail::omp_schedule_guard guard(type, chunk_size);
+
+        #pragma omp parallel shared(tasks)
+            #pragma omp for schedule(runtime) nowait
+                for(uint_t t=0; t<tasks.size(); ++t){
+                    tasks[t]->execute();
+                }
     }
 }
 
 
 template<typename TaskType, typename OpType>
 void
-OMPExecutor::parallel_for_reduce(uint_t iterations, OpType& operation, OMPOptions::ScheduleType type)const{
+OMPExecutor::parallel_for_reduce(uint_t iterations, OpType& operation, OMPOptions::ScheduleType type, uint_t chunk_size)const{
 
     if(type == OMPOptions::ScheduleType::DEFAULT){
 
@@ -166,13 +213,30 @@ OMPExecutor::parallel_for_reduce(uint_t iterations, OpType& operation, OMPOption
                      #pragma omp critical
                         operation.join(task.get_result());
         }
-
-        operation.validate_result();
     }
     else{
-        throw std::invalid_argument("Invalid scheduling type");
+
+        detail::omp_schedule_guard guard(type, chunk_size);
+
+        #pragma omp parallel default(none) shared(operation, iterations)
+        {
+                    // a task for each thread in the region
+                    TaskType task;
+
+                    #pragma omp for schedule(runtime) nowait
+                        for(uint_t t=0; t<iterations; ++t){
+
+                            task.execute();
+                            task.reschedule();
+                        }
+
+                     // once the thread is finished join the results
+                     #pragma omp critical
+                        operation.join(task.get_result());
+        }
     }
 
+    operation.validate_result();
 }
 
 
@@ -2,6 +2,8 @@
 
 #include "kernel/base/config.h"
 
+#include <stdexcept>
+
 #ifdef USE_LOG
 #include "kernel/utilities/logger.h"
 #include <sstream>
@@ -14,7 +16,9 @@ TaskBase::TaskBase(uint_t id)
     :
     state_(TaskBase::TaskState::PENDING),
     id_(id),
-    name_(KernelConsts::dummy_string())
+    name_(KernelConsts::dummy_string()),
+    latch_(nullptr),
+    on_completion_()
 {}
 
 TaskBase::~TaskBase()
@@ -72,15 +76,10 @@ TaskBase::operator()(){
 bool
 TaskBase::finished()const{
 
-    if(!has_children()){
-
       return (state_ != TaskBase::TaskState::PENDING &&
               state_ != TaskBase::TaskState::STARTED /*&&
               state_ != TaskBase::TaskState::INTERRUPTED &&
               state_ != TaskBase::TaskState::INTERRUPTED_BY_EXCEPTION*/ );
-    }
-
-    return false;
 }
 
 }
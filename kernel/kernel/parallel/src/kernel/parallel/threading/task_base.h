@@ -5,11 +5,16 @@
 #include "kernel/base/kernel_consts.h"
 
 #include <boost/noncopyable.hpp>
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace kernel
 {
 
+/// forward declarations
+class CountDownLatch;
+
 /// \brief Base class for task execution. A task cannot be
 /// copied not copy assigned. It can only be moved
 class TaskBase: boost::noncopyable
@@ -47,6 +52,17 @@ public:
     /// \brief Returns true if the taks has children
     bool has_children()const{return false;}
 
+    /// \brief The function the worker calls once the task has been executed.
+    /// It appends the tasks that became runnable to the given list
+    typedef std::function<void(TaskBase&, std::vector<TaskBase*>&)> completion_callback_t;
+
+    /// \brief Set the function to call once the task has been executed.
+    /// TaskGraph uses this to release the tasks that depend on this task
+    void set_completion_callback(const completion_callback_t& callback){on_completion_ = callback;}
+
+    /// \brief Returns the function to call once the task has been executed
+    const completion_callback_t& get_completion_callback()const{return on_completion_;}
+
     /// \brief Id of task
     uint_t get_id()const{return id_;}
 
@@ -59,6 +75,14 @@ public:
     /// \brief Set the name of the task
     void set_name(const std::string& name){name_ = name;}
 
+    /// \brief Set the latch the worker that executes the
+    /// task counts down once the task has been executed
+    void set_latch(CountDownLatch* latch){latch_ = latch;}
+
+    /// \brief Returns the latch associated with the task. This
+    /// is nullptr if no latch has been set
+    CountDownLatch* get_latch()const{return latch_;}
+
 protected:
 
     /// \brief Constructor
@@ -79,6 +103,12 @@ protected:
     /// for the task
     std::string name_;
 
+    /// \brief The latch to count down upon execution
+    CountDownLatch* latch_;
+
+    /// \brief The function to call upon execution
+    completion_callback_t on_completion_;
+
 };
 
 inline
@@ -0,0 +1,208 @@
+#include "kernel/parallel/threading/task_graph.h"
+#include "kernel/parallel/threading/task_base.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/threading/count_down_latch.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace kernel
+{
+
+TaskGraph::TaskGraph()
+    :
+      tasks_(),
+      children_(),
+      n_parents_(),
+      n_pending_parents_(),
+      parent_failed_()
+{}
+
+void
+TaskGraph::add_task(TaskBase& task){
+
+    if(has_task(task)){
+        return;
+    }
+
+    tasks_.push_back(&task);
+    children_.emplace_back();
+    n_parents_.push_back(0);
+}
+
+bool
+TaskGraph::has_task(const TaskBase& task)const{
+    return std::find(tasks_.begin(), tasks_.end(), &task) != tasks_.end();
+}
+
+uint_t
+TaskGraph::index_of_(const TaskBase& task)const{
+
+    auto itr = std::find(tasks_.begin(), tasks_.end(), &task);
+
+    if(itr == tasks_.end()){
+        throw std::invalid_argument("Task is not in the graph");
+    }
+
+    return static_cast<uint_t>(itr - tasks_.begin());
+}
+
+uint_t
+TaskGraph::n_parents(const TaskBase& task)const{
+    return n_parents_[index_of_(task)];
+}
+
+void
+TaskGraph::add_dependency(TaskBase& predecessor, TaskBase& successor){
+
+    if(!has_task(predecessor) || !has_task(successor)){
+        throw std::invalid_argument("Both tasks of a dependency should be added to the graph");
+    }
+
+    if(&predecessor == &successor){
+        throw std::invalid_argument("A task cannot depend on itself");
+    }
+
+    const uint_t parent = index_of_(predecessor);
+    const uint_t child = index_of_(successor);
+
+    // adding the same dependency twice has no effect
+    auto& children = children_[parent];
+    if(std::find(children.begin(), children.end(), child) != children.end()){
+        return;
+    }
+
+    children.push_back(child);
+    n_parents_[child]++;
+}
+
+std::vector<TaskBase*>
+TaskGraph::get_roots()const{
+
+    std::vector<TaskBase*> roots;
+
+    for(uint_t t=0; t<tasks_.size(); ++t){
+        if(n_parents_[t] == 0){
+            roots.push_back(tasks_[t]);
+        }
+    }
+
+    return roots;
+}
+
+void
+TaskGraph::check_acyclic_()const{
+
+    // Kahn's algorithm
+    std::vector<uint_t> n_parents(n_parents_);
+
+    std::vector<uint_t> ready;
+    for(uint_t t=0; t<tasks_.size(); ++t){
+        if(n_parents[t] == 0){
+            ready.push_back(t);
+        }
+    }
+
+    uint_t n_visited = 0;
+    while(!ready.empty()){
+
+        const uint_t t = ready.back();
+        ready.pop_back();
+        n_visited++;
+
+        for(auto child : children_[t]){
+            if(--n_parents[child] == 0){
+                ready.push_back(child);
+            }
+        }
+    }
+
+    if(n_visited != tasks_.size()){
+        throw std::logic_error("Task graph has a cycle");
+    }
+}
+
+void
+TaskGraph::release_children_(uint_t t, std::vector<TaskBase*>& runnable){
+
+    const bool finished = tasks_[t]->get_state() == TaskBase::TaskState::FINISHED;
+
+    for(auto child : children_[t]){
+
+        if(!finished){
+            parent_failed_[child].store(true, std::memory_order_relaxed);
+        }
+
+        // the last parent makes the task runnable. acq_rel so that
+        // whatever the parents wrote is visible to the worker that runs it
+        if(n_pending_parents_[child].fetch_sub(1, std::memory_order_acq_rel) == 1){
+
+            // a task whose parents did not finish is not run
+            // but it is still queued so that it releases its own children
+            if(parent_failed_[child].load(std::memory_order_relaxed)){
+                tasks_[child]->set_state(TaskBase::TaskState::STOPPED);
+            }
+
+            runnable.push_back(tasks_[child]);
+        }
+    }
+}
+
+void
+TaskGraph::execute(ThreadPool& pool){
+
+    if(tasks_.empty()){
+        return;
+    }
+
+    if(!pool.is_started()){
+      throw std::logic_error("Thread pool is not started");
+    }
+
+    check_acyclic_();
+
+    n_pending_parents_ = std::make_unique<std::atomic<uint_t>[]>(tasks_.size());
+    parent_failed_ = std::make_unique<std::atomic<bool>[]>(tasks_.size());
+
+    CountDownLatch latch(tasks_.size());
+
+    // arm every task before any of them is
+    // submitted as a worker may release a child
+    // as soon as the first root is queued
+    for(uint_t t=0; t<tasks_.size(); ++t){
+
+        n_pending_parents_[t].store(n_parents_[t], std::memory_order_relaxed);
+        parent_failed_[t].store(false, std::memory_order_relaxed);
+
+        tasks_[t]->set_latch(&latch);
+        tasks_[t]->set_completion_callback([this, t](TaskBase&, std::vector<TaskBase*>& runnable){
+            release_children_(t, runnable);
+        });
+    }
+
+    for(auto* task : get_roots()){
+        pool.add_task(*task);
+    }
+
+    latch.wait();
+
+    // the tasks may be executed on their
+    // own or by another graph afterwards
+    for(auto* task : tasks_){
+        task->set_completion_callback(nullptr);
+    }
+}
+
+bool
+TaskGraph::tasks_finished()const{
+
+    for(auto* task : tasks_){
+        if(!task->finished()){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
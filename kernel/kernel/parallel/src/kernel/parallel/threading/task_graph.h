@@ -0,0 +1,101 @@
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include "kernel/base/types.h"
+#include <boost/core/noncopyable.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace kernel
+{
+
+/// forward declarations
+class TaskBase;
+class ThreadPool;
+
+/**
+ * @brief The TaskGraph class. A directed acyclic graph of tasks.
+ * Every task declares the tasks it depends on via add_dependency() and
+ * becomes runnable as soon as all of them have been executed. The worker
+ * that executes the last parent queues the task, so independent
+ * branches of the graph overlap and no barrier is needed between the
+ * stages of a pipeline. If a task does not finish successfully its
+ * descendants are not run and their state is set to TaskState::STOPPED.
+ * The graph does not own the tasks. The dependencies are kept by the graph
+ * so a task may belong to several graphs or be executed on its own
+ */
+class TaskGraph: private boost::noncopyable
+{
+
+public:
+
+    /// \brief Constructor
+    TaskGraph();
+
+    /// \brief Add a task to the graph. Adding the same task twice has no effect
+    void add_task(TaskBase& task);
+
+    /// \brief Declare that successor runs only after predecessor has
+    /// been executed. Both tasks should have been added to the graph
+    /// otherwise std::invalid_argument is thrown
+    void add_dependency(TaskBase& predecessor, TaskBase& successor);
+
+    /// \brief Returns the number of tasks in the graph
+    uint_t n_tasks()const{return tasks_.size();}
+
+    /// \brief Returns true if the given task is in the graph
+    bool has_task(const TaskBase& task)const;
+
+    /// \brief Returns the number of tasks the given task depends on.
+    /// Throws std::invalid_argument if the task is not in the graph
+    uint_t n_parents(const TaskBase& task)const;
+
+    /// \brief Returns the tasks that have no parents
+    std::vector<TaskBase*> get_roots()const;
+
+    /// \brief Execute the graph using the given pool. The calling
+    /// thread sleeps until every task has been processed. Throws
+    /// std::logic_error if the pool is not started or if the graph has a cycle.
+    /// As with ThreadPool::execute, tasks that are not in the PENDING state
+    /// are not run so tasks should be rescheduled before executing the graph again
+    void execute(ThreadPool& pool);
+
+    /// \brief Returns true if all the tasks have finished
+    bool tasks_finished()const;
+
+private:
+
+    /// \brief Throws std::logic_error if the graph has a cycle
+    void check_acyclic_()const;
+
+    /// \brief Returns the index of the task in the graph.
+    /// Throws std::invalid_argument if the task is not in the graph
+    uint_t index_of_(const TaskBase& task)const;
+
+    /// \brief Called by the worker that executed the t-th task.
+    /// Appends the children that became runnable to the given list
+    void release_children_(uint_t t, std::vector<TaskBase*>& runnable);
+
+    /// \brief The tasks of the graph
+    std::vector<TaskBase*> tasks_;
+
+    /// \brief The indices of the tasks that depend on every task
+    std::vector<std::vector<uint_t>> children_;
+
+    /// \brief The number of tasks every task depends on
+    std::vector<uint_t> n_parents_;
+
+    /// \brief The number of parents of every task that have
+    /// not been executed yet in the current execution
+    std::unique_ptr<std::atomic<uint_t>[]> n_pending_parents_;
+
+    /// \brief Flag for every task indicating that one of its
+    /// parents did not finish in the current execution
+    std::unique_ptr<std::atomic<bool>[]> parent_failed_;
+};
+
+}
+
+#endif // TASK_GRAPH_H
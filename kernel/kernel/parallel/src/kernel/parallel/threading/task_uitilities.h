@@ -1,7 +1,12 @@
 #ifndef TASK_UITILITIES_H
 #define TASK_UITILITIES_H
 
+#include "kernel/base/types.h"
+
 #include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
 
 namespace kernel
 {
@@ -22,6 +27,29 @@ namespace kernel
 
             return true;
         }
+
+        /// \brief Block the calling thread until pred() returns true.
+        /// The thread yields for the first n_spins polls and then sleeps
+        /// for doubling intervals that are capped at max_sleep_us microseconds.
+        /// Use this when there is no latch to wait on
+        template<typename PredTp>
+        void wait_until(const PredTp& pred, uint_t n_spins=64, uint_t max_sleep_us=1000){
+
+            for(uint_t s=0; s<n_spins; ++s){
+
+                if(pred()){
+                    return;
+                }
+
+                std::this_thread::yield();
+            }
+
+            uint_t sleep_us = 1;
+            while(!pred()){
+                std::this_thread::sleep_for(std::chrono::microseconds(sleep_us));
+                sleep_us = std::min(2*sleep_us, max_sleep_us);
+            }
+        }
     }
 }
 
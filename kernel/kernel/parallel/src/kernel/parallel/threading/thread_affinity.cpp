@@ -0,0 +1,169 @@
+#include "kernel/parallel/threading/thread_affinity.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace kernel
+{
+
+namespace detail
+{
+
+uint_t
+cpu_socket_id(uint_t cpu){
+
+    std::ifstream file("/sys/devices/system/cpu/cpu"+std::to_string(cpu)+"/topology/physical_package_id");
+
+    int socket = 0;
+    if(file.is_open() && (file>>socket) && socket >= 0){
+        return static_cast<uint_t>(socket);
+    }
+
+    return 0;
+}
+
+std::vector<uint_t>
+available_cpus(){
+
+    std::vector<uint_t> cpus;
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if(sched_getaffinity(0, sizeof(set), &set) == 0){
+
+        for(int cpu=0; cpu<CPU_SETSIZE; ++cpu){
+            if(CPU_ISSET(cpu, &set)){
+                cpus.push_back(static_cast<uint_t>(cpu));
+            }
+        }
+    }
+#endif
+
+    if(cpus.empty()){
+
+        const uint_t n_cpus = std::max(std::thread::hardware_concurrency(), 1u);
+        for(uint_t cpu=0; cpu<n_cpus; ++cpu){
+            cpus.push_back(cpu);
+        }
+    }
+
+    // stable so that within a socket
+    // the CPUs remain ordered by id
+    std::stable_sort(cpus.begin(), cpus.end(),
+                     [](uint_t c1, uint_t c2){return cpu_socket_id(c1) < cpu_socket_id(c2);});
+
+    return cpus;
+}
+
+std::vector<uint_t>
+compute_cpu_assignment(AffinityType type, uint_t n_threads, const std::vector<uint_t>& cpu_list){
+
+    std::vector<uint_t> assignment;
+
+    if(type == AffinityType::NONE || n_threads == 0){
+        return assignment;
+    }
+
+    assignment.reserve(n_threads);
+
+    if(type == AffinityType::EXPLICIT){
+
+        if(cpu_list.empty()){
+            throw std::invalid_argument("Explicit thread affinity requires a non empty CPU list");
+        }
+
+        for(uint_t t=0; t<n_threads; ++t){
+            assignment.push_back(cpu_list[t % cpu_list.size()]);
+        }
+
+        return assignment;
+    }
+
+    const std::vector<uint_t> cpus = available_cpus();
+
+    if(type == AffinityType::COMPACT){
+
+        for(uint_t t=0; t<n_threads; ++t){
+            assignment.push_back(cpus[t % cpus.size()]);
+        }
+
+        return assignment;
+    }
+
+    // SCATTER: group the CPUs per socket and
+    // visit the sockets in turn
+    std::map<uint_t, std::vector<uint_t>> sockets;
+    for(auto cpu : cpus){
+        sockets[cpu_socket_id(cpu)].push_back(cpu);
+    }
+
+    std::vector<uint_t> order;
+    order.reserve(cpus.size());
+
+    for(uint_t slot=0; order.size() < cpus.size(); ++slot){
+        for(const auto& socket : sockets){
+            if(slot < socket.second.size()){
+                order.push_back(socket.second[slot]);
+            }
+        }
+    }
+
+    for(uint_t t=0; t<n_threads; ++t){
+        assignment.push_back(order[t % order.size()]);
+    }
+
+    return assignment;
+}
+
+bool
+pin_thread(std::thread& thread, uint_t cpu){
+
+#ifdef __linux__
+    if(cpu >= CPU_SETSIZE){
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)thread;
+    (void)cpu;
+    return false;
+#endif
+}
+
+bool
+pin_current_thread(uint_t cpu){
+
+#ifdef __linux__
+    if(cpu >= CPU_SETSIZE){
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef THREAD_AFFINITY_H
+#define THREAD_AFFINITY_H
+
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <thread>
+
+namespace kernel
+{
+
+/// \brief An enumeration describing how the threads of a pool are
+/// placed on the CPUs. NONE leaves placement to the operating system.
+/// COMPACT fills the CPUs of a socket before moving to the next one.
+/// SCATTER distributes consecutive threads over the sockets in turn.
+/// EXPLICIT uses a user given list of CPU ids
+enum class AffinityType{NONE, COMPACT, SCATTER, EXPLICIT};
+
+namespace detail
+{
+
+/// \brief Returns the ids of the CPUs the calling process is allowed to
+/// run on sorted by socket and then by id. On platforms where this
+/// cannot be queried it returns 0,...,hardware_concurrency()-1
+std::vector<uint_t> available_cpus();
+
+/// \brief Returns the socket (physical package) id of the given CPU
+/// or zero if the information is not available
+uint_t cpu_socket_id(uint_t cpu);
+
+/// \brief Compute the CPU every one of the n_threads should be pinned to
+/// according to the given policy. Returns an empty vector for AffinityType::NONE.
+/// Throws std::invalid_argument if the policy is AffinityType::EXPLICIT and cpu_list
+/// is empty. If there are more threads than CPUs the CPUs are reused cyclically
+std::vector<uint_t> compute_cpu_assignment(AffinityType type, uint_t n_threads,
+                                           const std::vector<uint_t>& cpu_list);
+
+/// \brief Pin the given thread on the given CPU. Returns true on success.
+/// On platforms without thread affinity support this does nothing and returns false
+bool pin_thread(std::thread& thread, uint_t cpu);
+
+/// \brief Pin the calling thread on the given CPU. Returns true on success.
+/// On platforms without thread affinity support this does nothing and returns false
+bool pin_current_thread(uint_t cpu);
+
+}
+
+}
+
+#endif // THREAD_AFFINITY_H
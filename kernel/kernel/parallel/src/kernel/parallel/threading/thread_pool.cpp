@@ -11,10 +11,14 @@ ThreadPool::ThreadPool(uint_t n_threads, bool start_)
     :
 pool_(),
 n_threads_(n_threads),
-next_thread_available_ (kernel::KernelConsts::invalid_size_type()),
+next_thread_available_ (0),
+options_(),
+cpu_assignment_(),
 is_started_(false),
 is_closed_(true)
 {
+    options_.n_threads = n_threads;
+
     // TODO: perhaps we could request the system
     // using std::thread::hardware_concurrency()
     // or having a default number of threads?
@@ -30,9 +34,10 @@ is_closed_(true)
 ThreadPool::ThreadPool(const ThreadPoolOptions& options)
     :
 pool_(),
-n_threads_(),
-next_thread_available_ (kernel::KernelConsts::invalid_size_type()),
+n_threads_(options.n_threads),
+next_thread_available_ (0),
 options_(options),
+cpu_assignment_(),
 is_started_(false),
 is_closed_(true)
  {
@@ -61,9 +66,46 @@ ThreadPool::start(){
         throw std::logic_error("Pool is already running. You need to stop is first");
     }
 
+    // this throws if the affinity options are invalid
+    // so compute it before any thread is created
+    cpu_assignment_ = detail::compute_cpu_assignment(options_.affinity, options_.n_threads, options_.cpu_list);
+
+    pool_.clear();
     pool_.reserve(options_.n_threads);
+    uint_t lock_free_capacity = 0;
+    if(options_.queue == ThreadPoolOptions::QueueType::LOCK_FREE){
+        lock_free_capacity = options_.lock_free_queue_capacity;
+    }
+
     for(uint_t t=0; t < options_.n_threads; ++t){
-        pool_.push_back( std::make_unique<detail::kernel_thread>(t) );
+        pool_.push_back( std::make_unique<detail::kernel_thread>(t, lock_free_capacity) );
+    }
+
+    // every worker should know about the rest
+    // before it starts looking for work
+    if(options_.schedule == ThreadPoolOptions::ScheduleType::WORK_STEALING){
+
+        std::vector<detail::kernel_thread*> victims;
+        victims.reserve(pool_.size());
+
+        for(auto& thread : pool_){
+            victims.push_back(thread.get());
+        }
+
+        for(auto& thread : pool_){
+            thread->set_victims(victims);
+        }
+    }
+
+    for(auto& thread : pool_){
+        thread->set_dispatcher([this](TaskBase& task){dispatch_(task);});
+    }
+
+    for(uint_t t=0; t < cpu_assignment_.size(); ++t){
+        pool_[t]->set_cpu(cpu_assignment_[t]);
+    }
+
+    for(uint_t t=0; t < pool_.size(); ++t){
         pool_[t]->start();
     }
 
@@ -75,6 +117,46 @@ ThreadPool::start(){
 
 }
 
+void
+ThreadPool::dispatch_(TaskBase& task){
+
+    const uint_t t = next_thread_available_.fetch_add(1, std::memory_order_relaxed) % pool_.size();
+    pool_[t]->push_task(task);
+}
+
+void
+ThreadPool::submit_(TaskBase& task, uint_t t, bool bound){
+
+    auto& worker = pool_[t % pool_.size()];
+
+    if(bound){
+        worker->push_bound_task(task);
+    }
+    else{
+        worker->push_task(task);
+    }
+
+    if(options_.msg_when_adding_tasks){
+        std::cout<<"MESSAGE:  Added task: "<<task.get_name()<<std::endl;
+    }
+}
+
+bool
+ThreadPool::is_pinned()const{
+
+    if(cpu_assignment_.empty() || pool_.empty()){
+        return false;
+    }
+
+    for(const auto& thread : pool_){
+        if(!thread->is_pinned()){
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void
 ThreadPool::add_task(TaskBase& task){
 
@@ -83,14 +165,8 @@ ThreadPool::add_task(TaskBase& task){
       throw std::logic_error("Thread pool is not started");
     }
 
-    if(next_thread_available_ == kernel::KernelConsts::invalid_size_type() ||
-       next_thread_available_ >= pool_.size()){
-        next_thread_available_=0;
-    }
-
     // pass the task
-    pool_[next_thread_available_]->push_task(task);
-    next_thread_available_++;
+    dispatch_(task);
 
     if(options_.msg_when_adding_tasks){
         std::cout<<"MESSAGE:  Added task: "<<task.get_name()<<std::endl;
@@ -4,12 +4,15 @@
 #include "kernel/base/types.h"
 #include "kernel/base/kernel_consts.h"
 #include "kernel/parallel/threading/task_uitilities.h"
+#include "kernel/parallel/threading/count_down_latch.h"
+#include "kernel/parallel/threading/thread_affinity.h"
 
 #include <boost/core/noncopyable.hpp>
 
 #include <memory>
 #include <vector>
 #include <thread>
+#include <atomic>
 #include <exception>
 
 namespace kernel
@@ -25,7 +28,33 @@ class kernel_thread;
 
 struct ThreadPoolOptions
 {
+   /// \brief An enumeration describing how tasks are dispatched
+   /// to the workers. ROUND_ROBIN assigns every task to the next worker
+   /// in turn. WORK_STEALING does the same but idle workers steal
+   /// tasks from the back of the queues of busy workers
+   enum class ScheduleType{ROUND_ROBIN, WORK_STEALING};
+
+   /// \brief An enumeration describing the task queue every worker
+   /// uses. LOCKED uses TaskQueue. LOCK_FREE uses a bounded LockFreeQueue
+   /// of lock_free_queue_capacity elements and falls back to TaskQueue when it is full
+   enum class QueueType{LOCKED, LOCK_FREE};
+
    uint_t n_threads{1};
+   ScheduleType schedule{ScheduleType::ROUND_ROBIN};
+   QueueType queue{QueueType::LOCKED};
+   uint_t lock_free_queue_capacity{1024};
+
+   /// \brief How the worker threads are pinned on the CPUs.
+   /// The t-th worker is pinned when the pool starts. cpu_list is
+   /// only used with AffinityType::EXPLICIT
+   AffinityType affinity{AffinityType::NONE};
+   std::vector<uint_t> cpu_list;
+
+   /// \brief How many times ThreadPool::execute polls for
+   /// completion before the calling thread goes to sleep. Zero means
+   /// sleep immediately. Use a small positive value for short batches
+   /// where the wake up latency matters
+   uint_t n_spins_before_sleep{0};
    bool start_on_construction{true};
    bool msg_when_adding_tasks{false};
    bool msg_on_start_up{false};
@@ -67,11 +96,20 @@ public:
     /// \brief Allocate the given tasks for execution
     void add_tasks(const std::vector<std::unique_ptr<TaskBase>>& tasks);
 
-    /// \brief Execute the tasks with the given options
+    /// \brief Execute the tasks with the given options. The calling
+    /// thread sleeps until all the tasks have been executed.
+    /// The t-th task is queued on the worker t % n_threads so that
+    /// repeated batches of the same size use the same workers.
+    /// With WORK_STEALING an idle worker may still steal a task.
     /// Options aregument currently has no effect
     template<typename TaskTypePtr, typename Options>
     void execute(const std::vector<std::unique_ptr<TaskTypePtr>>& tasks, const Options& options = Null() );
 
+    /// \brief Same as execute() but the t-th task is executed by the
+    /// worker t % n_threads even when the pool uses WORK_STEALING
+    template<typename TaskTypePtr, typename Options>
+    void execute_bound(const std::vector<std::unique_ptr<TaskTypePtr>>& tasks, const Options& options = Null() );
+
     /// \brief Returns the number of threads the pool is using
     uint_t get_n_threads()const{return pool_.size();}
 
@@ -84,6 +122,16 @@ public:
     /// \brief query the pool about the stop state
     bool is_closed()const{return is_closed_;}
 
+    /// \brief Returns the scheduling the pool is using
+    ThreadPoolOptions::ScheduleType schedule_type()const{return options_.schedule;}
+
+    /// \brief Returns the CPU every worker was asked to be pinned on.
+    /// This is empty if the pool uses AffinityType::NONE
+    const std::vector<uint_t>& cpu_assignment()const{return cpu_assignment_;}
+
+    /// \brief Returns true if every worker was successfully pinned
+    bool is_pinned()const;
+
 private:
 
     typedef detail::kernel_thread thread_type;
@@ -92,41 +140,84 @@ private:
     /// \brief The pool of workers
     pool_t pool_;
     uint_t n_threads_;
-    uint_t next_thread_available_ {kernel::KernelConsts::invalid_size_type()};
+
+    /// \brief Counter used to pick the next worker in
+    /// turn. Workers also use it to hand out released
+    /// children hence it is atomic
+    std::atomic<uint_t> next_thread_available_ {0};
 
     /// \brief The options used
     ThreadPoolOptions options_;
 
+    /// \brief The CPU of every worker
+    std::vector<uint_t> cpu_assignment_;
+
     /// \brief flag indicating if the pool is started
     bool is_started_;
 
     /// \brief flag indicating if the pool is closed
     bool is_closed_;
+
+    /// \brief Queue the task on the next worker in turn
+    void dispatch_(TaskBase& task);
+
+    /// \brief Queue the task on the worker t % n_threads. If bound
+    /// is true the other workers do not steal the task
+    void submit_(TaskBase& task, uint_t t, bool bound);
+
+    /// \brief Submit the tasks of a batch and wait for them
+    template<typename TaskTypePtr>
+    void execute_batch_(const std::vector<std::unique_ptr<TaskTypePtr>>& tasks, bool bound);
 };
 
 
 template<typename TaskTypePtr, typename Options>
 void
 ThreadPool::execute(const std::vector<std::unique_ptr<TaskTypePtr>>& tasks, const Options& /*options*/ ){
+    execute_batch_(tasks, false);
+}
+
+template<typename TaskTypePtr, typename Options>
+void
+ThreadPool::execute_bound(const std::vector<std::unique_ptr<TaskTypePtr>>& tasks, const Options& /*options*/ ){
+    execute_batch_(tasks, true);
+}
+
+template<typename TaskTypePtr>
+void
+ThreadPool::execute_batch_(const std::vector<std::unique_ptr<TaskTypePtr>>& tasks, bool bound){
 
     if(tasks.empty()){
         return;
     }
 
+    if(!is_started_){
+      throw std::logic_error("Thread pool is not started");
+    }
+
+    // check everything before submitting so that
+    // no worker is left with a dangling latch
     for(uint_t t=0; t<tasks.size(); ++t){
 
         if(!tasks[t]){
             throw std::invalid_argument("Null Task Pointer in ThreadPool");
         }
+    }
+
+    CountDownLatch latch(tasks.size());
+
+    for(uint_t t=0; t<tasks.size(); ++t){
+
+        tasks[t]->set_latch(&latch);
 
-        add_task(*(tasks[t].get()));
+        // the batch does not depend on the tasks
+        // dispatched before it
+        submit_(*(tasks[t].get()), t, bound);
     }
 
     // if the tasks have not finished yet
     // then the calling thread waits here
-    while(!taskutils::tasks_finished(tasks)){
-       std::this_thread::yield();
-    }
+    latch.wait(options_.n_spins_before_sleep);
 }
 
 }
@@ -63,4 +63,34 @@ void partition_range(uint_t begin, uint_t end,
 
 }
 
+
+void partition_range_by_grain(uint_t begin, uint_t end,
+                              std::vector<range1d<uint_t>>& partitions, uint_t grain_size){
+
+    if(grain_size == 0){
+        throw std::invalid_argument("Cannot partition range with zero grain size");
+    }
+
+    if(end <= begin){
+        throw std::invalid_argument("Cannot partition a range with equal start and end points");
+    }
+
+    //clear the partitions
+    {
+       std::vector<range1d<uint_t>> empty;
+       partitions.swap(empty);
+    }
+
+    const uint_t total_work = end - begin;
+    partitions.reserve(total_work/grain_size + 1);
+
+    uint_t start = begin;
+    while(start < end){
+
+        uint_t finish = (end - start > grain_size) ? start + grain_size : end;
+        partitions.push_back(range1d<uint_t>(start, finish));
+        start = finish;
+    }
+}
+
 }
@@ -76,6 +76,13 @@ void partition_range(IteratorTp begin, const IteratorTp end,
 void partition_range(uint_t begin, uint_t end,
                      std::vector<range1d<uint_t>>& partitions, uint_t n_parts  );
 
+/// \brief Partition the range [begin, end) into consecutive chunks
+/// of grain_size elements. The last chunk holds the remaining elements
+/// and therefore it may be smaller. Throws std::invalid_argument if grain_size
+/// is zero or if begin == end
+void partition_range_by_grain(uint_t begin, uint_t end,
+                              std::vector<range1d<uint_t>>& partitions, uint_t grain_size);
+
 
 
 
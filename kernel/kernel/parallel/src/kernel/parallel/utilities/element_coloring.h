@@ -0,0 +1,198 @@
+#ifndef ELEMENT_COLORING_H
+#define ELEMENT_COLORING_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/config.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+
+#ifdef USE_LOG
+#include "kernel/utilities/logger.h"
+#include <chrono>
+#include <sstream>
+#endif
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace kernel{
+namespace numerics {
+
+/// \brief The ElementColoring class. Groups the active elements of a
+/// Mesh into colours such that no two elements of the same colour conflict.
+/// With distance 1, elements of the same colour are never neighbours. With
+/// distance 2, which is the default, they also never share a neighbour. A FV
+/// assembly that writes the rows of an element and of its neighbours can
+/// therefore process the elements of one colour concurrently without locks.
+/// The colouring is greedy and visits the elements in mesh order. It assumes
+/// that element ids are dense i.e. in [0, n_elements())
+template<int dim>
+class ElementColoring
+{
+public:
+
+    typedef const Element<dim>* element_ptr_t;
+
+    /// \brief Constructor. Creates an empty colouring
+    ElementColoring();
+
+    /// \brief Constructor. Colour the given mesh
+    explicit ElementColoring(const Mesh<dim>& mesh, uint_t distance=2);
+
+    /// \brief Colour the active elements of the given mesh. Throws
+    /// std::invalid_argument if distance is not 1 or 2
+    void color(const Mesh<dim>& mesh, uint_t distance=2);
+
+    /// \brief Returns the number of colours
+    uint_t n_colors()const{return colors_.size();}
+
+    /// \brief Returns the elements with the given colour
+    const std::vector<element_ptr_t>& get_color(uint_t c)const{return colors_[c];}
+
+    /// \brief Returns the colour of the element with the given id
+    uint_t color_of(uint_t element_id)const{return element_colors_[element_id];}
+
+    /// \brief Returns the number of coloured elements
+    uint_t n_elements()const;
+
+    /// \brief Returns the distance used for the colouring
+    uint_t distance()const{return distance_;}
+
+private:
+
+    /// \brief The elements of every colour
+    std::vector<std::vector<element_ptr_t>> colors_;
+
+    /// \brief The colour of every element indexed by element id
+    std::vector<uint_t> element_colors_;
+
+    /// \brief The distance used
+    uint_t distance_;
+};
+
+template<int dim>
+ElementColoring<dim>::ElementColoring()
+    :
+    colors_(),
+    element_colors_(),
+    distance_(2)
+{}
+
+template<int dim>
+ElementColoring<dim>::ElementColoring(const Mesh<dim>& mesh, uint_t distance)
+    :
+    colors_(),
+    element_colors_(),
+    distance_(distance)
+{
+    color(mesh, distance);
+}
+
+template<int dim>
+uint_t
+ElementColoring<dim>::n_elements()const{
+
+    uint_t n = 0;
+    for(const auto& c : colors_){
+        n += c.size();
+    }
+
+    return n;
+}
+
+template<int dim>
+void
+ElementColoring<dim>::color(const Mesh<dim>& mesh, uint_t distance){
+
+    if(distance != 1 && distance != 2){
+        throw std::invalid_argument("Element colouring distance should be 1 or 2 but is "+std::to_string(distance));
+    }
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> start_timing = std::chrono::system_clock::now();
+#endif
+
+    distance_ = distance;
+    colors_.clear();
+
+    const uint_t uncolored = KernelConsts::invalid_size_type();
+    element_colors_.assign(mesh.n_elements(), uncolored);
+
+    // forbidden[c] == e means that colour c is
+    // used by an element in the stencil of element e
+    std::vector<uint_t> forbidden;
+
+    auto forbid = [&](const Element<dim>* element, uint_t e){
+
+        const uint_t c = element_colors_[element->get_id()];
+        if(c != uncolored){
+            forbidden[c] = e;
+        }
+    };
+
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+    auto element_begin = filter.begin();
+    auto element_end = filter.end();
+
+    for(; element_begin != element_end; ++element_begin){
+
+        const auto* element = *element_begin;
+        const uint_t e = element->get_id();
+
+        if(e >= element_colors_.size()){
+            throw std::logic_error("Element id "+std::to_string(e)+" is not in [0, "+
+                                   std::to_string(element_colors_.size())+")");
+        }
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+            const auto* neigh = element->neighbor_ptr(n);
+
+            if(!neigh){
+                continue;
+            }
+
+            forbid(neigh, e);
+
+            if(distance_ == 2){
+                for(uint_t nn=0; nn<neigh->n_neighbors(); ++nn){
+
+                    const auto* neigh_neigh = neigh->neighbor_ptr(nn);
+                    if(neigh_neigh && neigh_neigh != element){
+                        forbid(neigh_neigh, e);
+                    }
+                }
+            }
+        }
+
+        // the first colour not used in the stencil
+        uint_t c = 0;
+        while(c < forbidden.size() && forbidden[c] == e){
+            ++c;
+        }
+
+        if(c == colors_.size()){
+            colors_.emplace_back();
+            forbidden.push_back(uncolored);
+        }
+
+        colors_[c].push_back(element);
+        element_colors_[e] = c;
+    }
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> end_timing = std::chrono::system_clock::now();
+    std::chrono::duration<real_t> dur = end_timing-start_timing;
+    std::ostringstream message;
+    message<<"ElementColoring::color run time: "<<dur.count()<<" number of colours: "<<colors_.size();
+    Logger::log_info(message.str());
+#endif
+}
+
+}
+}
+
+#endif // ELEMENT_COLORING_H
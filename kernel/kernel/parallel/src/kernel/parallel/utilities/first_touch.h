@@ -0,0 +1,136 @@
+#ifndef FIRST_TOUCH_H
+#define FIRST_TOUCH_H
+
+#include "kernel/base/types.h"
+#include "kernel/parallel/utilities/partitioned_type.h"
+#include "kernel/parallel/utilities/result_holder.h"
+#include "kernel/parallel/parallel_algos/parallel_for.h"
+#include "kernel/parallel/threading/iterate_task.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/base/exceptions.h"
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <vector>
+
+namespace kernel
+{
+
+/// \brief An allocator that default-initializes rather than
+/// value-initializes elements. For trivial types such as real_t this means
+/// that std::vector<T, default_init_allocator<T>> v(n) does not write
+/// to the allocated memory. The pages are then mapped on the NUMA node
+/// of the thread that first writes them, see first_touch()
+template<typename T, typename AllocatorTp=std::allocator<T>>
+class default_init_allocator: public AllocatorTp
+{
+    typedef std::allocator_traits<AllocatorTp> traits_type;
+
+public:
+
+    template<typename U>
+    struct rebind
+    {
+        typedef default_init_allocator<U, typename traits_type::template rebind_alloc<U>> other;
+    };
+
+    using AllocatorTp::AllocatorTp;
+
+    /// \brief Default-initialize the object at ptr
+    template<typename U>
+    void construct(U* ptr)noexcept(std::is_nothrow_default_constructible<U>::value){
+        ::new(static_cast<void*>(ptr)) U;
+    }
+
+    /// \brief Construct the object at ptr using the given arguments
+    template<typename U, typename... Args>
+    void construct(U* ptr, Args&&... args){
+        traits_type::construct(static_cast<AllocatorTp&>(*this), ptr, std::forward<Args>(args)...);
+    }
+};
+
+namespace detail
+{
+
+/// \brief Execute the tasks so that the t-th task runs on the t-th
+/// processing element. Executors other than ThreadPool do not
+/// support binding and execute the tasks as usual
+template<typename TaskTp, typename ExecutorTp, typename Options>
+void
+execute_on_owners(const std::vector<std::unique_ptr<TaskTp>>& tasks, ExecutorTp& executor, const Options& options){
+    executor.execute(tasks, options);
+}
+
+template<typename TaskTp, typename Options>
+void
+execute_on_owners(const std::vector<std::unique_ptr<TaskTp>>& tasks, ThreadPool& executor, const Options& options){
+    executor.execute_bound(tasks, options);
+}
+
+}
+
+/// \brief Apply body on every element of data using the partitions of data.
+/// The t-th partition is written by the t-th worker of the executor, which
+/// is also the worker ThreadPool::execute queues the t-th task of a
+/// parallel_for on. Under the first-touch policy of the operating system, memory
+/// that has not been written before is therefore placed on the NUMA node of that
+/// worker. Use it on freshly allocated data, e.g. a std::vector with
+/// default_init_allocator, together with a pinned ThreadPool. Subsequent
+/// parallel_for calls with the same partitions then find their partition in
+/// local memory, unless the pool uses WORK_STEALING and a task is stolen
+template<typename Type, typename BodyTp, typename ExecutorTp, typename Options,
+         typename = std::enable_if_t<!std::is_convertible<BodyTp, typename Type::value_type>::value>>
+ResultHolder<void>
+first_touch(PartitionedType<Type>& data, const BodyTp& body, ExecutorTp& executor, const Options& options){
+
+    if(!data.has_partitions()){
+        throw InvalidPartitionedObject("The given range does not have partitions");
+    }
+
+    if(data.n_partitions() != executor.n_processing_elements()){
+        throw InvalidPartitionedObject("Invalid number of partitions: "+
+                                       std::to_string(data.n_partitions())+" should be: "+
+                                       std::to_string(executor.n_processing_elements()));
+    }
+
+    typedef PartitionedType<Type> range_type;
+    typedef IterateTask<typename range_type::partition_type, BodyTp, range_type> task_type;
+
+    std::vector<std::unique_ptr<task_type>> tasks;
+    tasks.reserve(data.n_partitions());
+
+    for(uint_t t=0; t<data.n_partitions(); ++t){
+        tasks.push_back(std::make_unique<task_type>(t, data.get_partition(t), body, data));
+    }
+
+    // this will block
+    detail::execute_on_owners(tasks, executor, options);
+
+    ResultHolder<void> result(true);
+    for(const auto& task : tasks){
+
+        // if we reached here but for some reason the
+        // task has not finished properly invalidate the result
+        if(task->get_state() != TaskBase::TaskState::FINISHED){
+            result.invalidate_result();
+        }
+    }
+
+    return result;
+}
+
+/// \brief Assign value to every element of data using the partitions of data.
+/// See the overload above for where the partitions are placed
+template<typename Type, typename ExecutorTp, typename Options>
+ResultHolder<void>
+first_touch(PartitionedType<Type>& data, const typename Type::value_type& value,
+            ExecutorTp& executor, const Options& options){
+
+    auto body = [value](typename Type::value_type& item){item = value;};
+    return first_touch(data, body, executor, options);
+}
+}
+
+#endif // FIRST_TOUCH_H
@@ -0,0 +1,134 @@
+#ifndef GRAPH_MESH_PARTITIONER_H
+#define GRAPH_MESH_PARTITIONER_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/config.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+#include "kernel/discretization/mesh_tools.h"
+#include "kernel/parallel/utilities/graph_partitioner.h"
+
+#ifdef USE_LOG
+#include "kernel/utilities/logger.h"
+#include <chrono>
+#include <sstream>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace kernel{
+namespace numerics {
+
+template<int dim> class Mesh;
+
+/// \brief Assigns the processor id for every active element of the
+/// given Mesh by partitioning the element adjacency graph with
+/// graph_partition. Unlike linear_mesh_partition the parts are compact
+/// so that the number of faces shared between processors is small.
+/// Returns the number of such faces
+template<int dim>
+uint_t graph_mesh_partition(Mesh<dim>& mesh, uint_t n_parts,
+                            const GraphPartitionOptions& options = GraphPartitionOptions()){
+
+    uint_t total_work = n_active_elements(mesh);
+
+    if(n_parts == 0){
+        throw std::invalid_argument("Cannot partition a mesh into zero parts");
+    }
+
+    if(total_work == 0){
+        throw std::invalid_argument("Cannot partition a mesh without active elements");
+    }
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> start_timing = std::chrono::system_clock::now();
+#endif
+
+    ElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    // the graph vertex of every active element indexed by the element id
+    uint_t max_id = 0;
+    for(auto begin = filter.begin(); begin != filter.end(); ++begin){
+        max_id = std::max(max_id, (*begin)->get_id() + 1);
+    }
+
+    std::vector<uint_t> vertex(max_id, KernelConsts::invalid_size_type());
+    std::vector<Element<dim>*> elements;
+    elements.reserve(total_work);
+
+    for(auto begin = filter.begin(); begin != filter.end(); ++begin){
+        vertex[(*begin)->get_id()] = elements.size();
+        elements.push_back(*begin);
+    }
+
+    std::vector<uint_t> offsets(1, 0);
+    std::vector<uint_t> adjacency;
+    offsets.reserve(total_work + 1);
+
+    for(auto* element : elements){
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+            auto* neigh = element->neighbor_ptr(n);
+
+            if(neigh && neigh->is_active() && neigh->get_id() < max_id &&
+               vertex[neigh->get_id()] != KernelConsts::invalid_size_type()){
+                adjacency.push_back(vertex[neigh->get_id()]);
+            }
+        }
+
+        offsets.push_back(adjacency.size());
+    }
+
+    std::vector<uint_t> parts;
+    const uint_t edge_cut = graph_partition(offsets, adjacency, n_parts, parts, options);
+
+    for(uint_t v=0; v<elements.size(); ++v){
+        elements[v]->set_pid(parts[v]);
+    }
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> end_timing = std::chrono::system_clock::now();
+    std::chrono::duration<real_t> dur = end_timing-start_timing;
+    std::ostringstream message;
+    message<<"graph_mesh_partition run time: "<<dur.count()<<" edge cut: "<<edge_cut;
+    Logger::log_info(message.str());
+#endif
+
+    return edge_cut;
+}
+
+/// \brief Returns the number of faces shared by active
+/// elements with different processor ids
+template<int dim>
+uint_t mesh_partition_edge_cut(const Mesh<dim>& mesh){
+
+    uint_t cut = 0;
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    for(auto begin = filter.begin(); begin != filter.end(); ++begin){
+
+        auto* element = *begin;
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+            auto* neigh = element->neighbor_ptr(n);
+
+            if(neigh && neigh->is_active() && neigh->get_pid() != element->get_pid()){
+                cut++;
+            }
+        }
+    }
+
+    return cut/2;
+}
+
+}
+}
+
+#endif // GRAPH_MESH_PARTITIONER_H
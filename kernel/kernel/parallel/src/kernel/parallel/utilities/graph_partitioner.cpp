@@ -0,0 +1,691 @@
+#include "kernel/parallel/utilities/graph_partitioner.h"
+#include "kernel/base/kernel_consts.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace kernel
+{
+
+namespace{
+
+/// \brief Undirected graph in CSR format with vertex and edge weights
+struct WeightedGraph
+{
+    std::vector<uint_t> offsets;
+    std::vector<uint_t> adjacency;
+    std::vector<uint_t> edge_weights;
+    std::vector<uint_t> vertex_weights;
+
+    uint_t n_vertices()const{return vertex_weights.size();}
+};
+
+typedef long long gain_t;
+
+/// \brief Coarsen the graph by collapsing a heavy edge matching.
+/// On output map[v] is the coarse vertex of the fine vertex v
+void
+coarsen(const WeightedGraph& graph, WeightedGraph& coarse,
+        std::vector<uint_t>& map, std::mt19937& generator){
+
+    const uint_t n = graph.n_vertices();
+    const uint_t invalid = KernelConsts::invalid_size_type();
+
+    std::vector<uint_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), generator);
+
+    // match every vertex with the unmatched neighbor
+    // sharing the heaviest edge
+    std::vector<uint_t> match(n, invalid);
+
+    for(auto v : order){
+
+        if(match[v] != invalid){
+            continue;
+        }
+
+        uint_t best = invalid;
+        uint_t best_weight = 0;
+
+        for(uint_t e=graph.offsets[v]; e<graph.offsets[v + 1]; ++e){
+
+            const uint_t u = graph.adjacency[e];
+
+            if(u == v || match[u] != invalid){
+                continue;
+            }
+
+            if(graph.edge_weights[e] > best_weight ||
+               (graph.edge_weights[e] == best_weight && graph.vertex_weights[u] < graph.vertex_weights[best])){
+                best = u;
+                best_weight = graph.edge_weights[e];
+            }
+        }
+
+        if(best == invalid){
+            match[v] = v;
+        }
+        else{
+            match[v] = best;
+            match[best] = v;
+        }
+    }
+
+    // number the coarse vertices
+    map.assign(n, invalid);
+    std::vector<uint_t> first;
+    std::vector<uint_t> second;
+    first.reserve(n);
+    second.reserve(n);
+
+    for(uint_t v=0; v<n; ++v){
+
+        if(map[v] != invalid){
+            continue;
+        }
+
+        map[v] = first.size();
+        map[match[v]] = first.size();
+        first.push_back(v);
+        second.push_back(match[v]);
+    }
+
+    const uint_t n_coarse = first.size();
+
+    coarse.offsets.assign(1, 0);
+    coarse.offsets.reserve(n_coarse + 1);
+    coarse.adjacency.clear();
+    coarse.edge_weights.clear();
+    coarse.vertex_weights.assign(n_coarse, 0);
+
+    // the position of every coarse neighbor in the current row
+    std::vector<uint_t> position(n_coarse, invalid);
+
+    for(uint_t c=0; c<n_coarse; ++c){
+
+        const uint_t row_begin = coarse.adjacency.size();
+        const uint_t members[] = {first[c], second[c]};
+
+        for(uint_t m=0; m<2; ++m){
+
+            const uint_t v = members[m];
+
+            if(m == 1 && v == members[0]){
+                break;
+            }
+
+            coarse.vertex_weights[c] += graph.vertex_weights[v];
+
+            for(uint_t e=graph.offsets[v]; e<graph.offsets[v + 1]; ++e){
+
+                const uint_t cu = map[graph.adjacency[e]];
+
+                if(cu == c){
+                    continue;
+                }
+
+                if(position[cu] == invalid){
+                    position[cu] = coarse.adjacency.size();
+                    coarse.adjacency.push_back(cu);
+                    coarse.edge_weights.push_back(graph.edge_weights[e]);
+                }
+                else{
+                    coarse.edge_weights[position[cu]] += graph.edge_weights[e];
+                }
+            }
+        }
+
+        for(uint_t e=row_begin; e<coarse.adjacency.size(); ++e){
+            position[coarse.adjacency[e]] = invalid;
+        }
+
+        coarse.offsets.push_back(coarse.adjacency.size());
+    }
+}
+
+/// \brief The weight of the edges between the two sides
+uint_t
+bisection_cut(const WeightedGraph& graph, const std::vector<uint_t>& side){
+
+    uint_t cut = 0;
+    for(uint_t v=0; v<graph.n_vertices(); ++v){
+        for(uint_t e=graph.offsets[v]; e<graph.offsets[v + 1]; ++e){
+            if(side[v] != side[graph.adjacency[e]]){
+                cut += graph.edge_weights[e];
+            }
+        }
+    }
+
+    return cut/2;
+}
+
+/// \brief Bisection state used to compare two bisections. A feasible
+/// bisection is better than an infeasible one. Then the smaller cut wins
+/// and then the smaller deviation from the target weight
+struct BisectionQuality
+{
+    bool feasible;
+    uint_t cut;
+    uint_t deviation;
+
+    bool better_than(const BisectionQuality& other)const{
+
+        if(feasible != other.feasible){
+            return feasible;
+        }
+
+        if(cut != other.cut){
+            return cut < other.cut;
+        }
+
+        return deviation < other.deviation;
+    }
+};
+
+/// \brief Improve the bisection with Fiduccia-Mattheyses passes.
+/// Every pass moves the unlocked vertex with the highest gain that keeps the
+/// balance, possibly with a negative gain, and at the end rolls back to the
+/// best bisection seen during the pass
+void
+fm_refine(const WeightedGraph& graph, std::vector<uint_t>& side, const uint_t (&max_weights)[2],
+          uint_t target0, uint_t n_passes){
+
+    const uint_t n = graph.n_vertices();
+
+    // stop a pass after this many moves without improvement
+    const uint_t max_moves_without_improvement = std::max(static_cast<uint_t>(32), n/100);
+
+    uint_t weights[2] = {0, 0};
+    for(uint_t v=0; v<n; ++v){
+        weights[side[v]] += graph.vertex_weights[v];
+    }
+
+    auto quality = [&](uint_t cut){
+        const bool feasible = weights[0] <= max_weights[0] && weights[1] <= max_weights[1];
+        const uint_t deviation = weights[0] > target0 ? weights[0] - target0 : target0 - weights[0];
+        return BisectionQuality{feasible, cut, deviation};
+    };
+
+    uint_t cut = bisection_cut(graph, side);
+
+    std::vector<gain_t> gains(n, 0);
+    std::vector<bool> locked(n, false);
+    std::vector<uint_t> moves;
+
+    typedef std::pair<gain_t, uint_t> entry_t;
+
+    for(uint_t pass=0; pass<n_passes; ++pass){
+
+        std::priority_queue<entry_t> heaps[2];
+
+        for(uint_t v=0; v<n; ++v){
+
+            gain_t external = 0;
+            gain_t internal = 0;
+            for(uint_t e=graph.offsets[v]; e<graph.offsets[v + 1]; ++e){
+
+                if(side[graph.adjacency[e]] != side[v]){
+                    external += graph.edge_weights[e];
+                }
+                else{
+                    internal += graph.edge_weights[e];
+                }
+            }
+
+            gains[v] = external - internal;
+            locked[v] = false;
+
+            // only boundary vertices are candidates unless
+            // the balance has to be restored
+            if(external > 0 || weights[side[v]] > max_weights[side[v]]){
+                heaps[side[v]].push({gains[v], v});
+            }
+        }
+
+        moves.clear();
+
+        BisectionQuality best = quality(cut);
+        uint_t best_n_moves = 0;
+
+        while(moves.size() - best_n_moves < max_moves_without_improvement){
+
+            // the valid top of every heap that can move
+            uint_t candidates[2] = {KernelConsts::invalid_size_type(), KernelConsts::invalid_size_type()};
+
+            for(uint_t s=0; s<2; ++s){
+
+                while(!heaps[s].empty()){
+
+                    const entry_t top = heaps[s].top();
+                    const uint_t v = top.second;
+
+                    // discard stale entries
+                    if(locked[v] || side[v] != s || gains[v] != top.first){
+                        heaps[s].pop();
+                        continue;
+                    }
+
+                    // a move must not overload the other side
+                    // unless this side is overloaded
+                    if(weights[1 - s] + graph.vertex_weights[v] > max_weights[1 - s] &&
+                       weights[s] <= max_weights[s]){
+                        heaps[s].pop();
+                        continue;
+                    }
+
+                    candidates[s] = v;
+                    break;
+                }
+            }
+
+            uint_t from = KernelConsts::invalid_size_type();
+
+            // restore the balance first
+            if(weights[0] > max_weights[0] && candidates[0] != KernelConsts::invalid_size_type()){
+                from = 0;
+            }
+            else if(weights[1] > max_weights[1] && candidates[1] != KernelConsts::invalid_size_type()){
+                from = 1;
+            }
+            else if(candidates[0] != KernelConsts::invalid_size_type() &&
+                    (candidates[1] == KernelConsts::invalid_size_type() || gains[candidates[0]] >= gains[candidates[1]])){
+                from = 0;
+            }
+            else if(candidates[1] != KernelConsts::invalid_size_type()){
+                from = 1;
+            }
+
+            if(from == KernelConsts::invalid_size_type()){
+                break;
+            }
+
+            const uint_t v = candidates[from];
+            heaps[from].pop();
+
+            const uint_t to = 1 - from;
+            cut = static_cast<uint_t>(static_cast<gain_t>(cut) - gains[v]);
+            side[v] = to;
+            weights[from] -= graph.vertex_weights[v];
+            weights[to] += graph.vertex_weights[v];
+            locked[v] = true;
+            moves.push_back(v);
+
+            for(uint_t e=graph.offsets[v]; e<graph.offsets[v + 1]; ++e){
+
+                const uint_t u = graph.adjacency[e];
+
+                if(locked[u]){
+                    continue;
+                }
+
+                const gain_t w = static_cast<gain_t>(graph.edge_weights[e]);
+                gains[u] += side[u] == to ? -2*w : 2*w;
+                heaps[side[u]].push({gains[u], u});
+            }
+
+            const BisectionQuality current = quality(cut);
+            if(current.better_than(best)){
+                best = current;
+                best_n_moves = moves.size();
+            }
+        }
+
+        // roll back the moves after the best bisection
+        while(moves.size() > best_n_moves){
+
+            const uint_t v = moves.back();
+            moves.pop_back();
+
+            weights[side[v]] -= graph.vertex_weights[v];
+            side[v] = 1 - side[v];
+            weights[side[v]] += graph.vertex_weights[v];
+        }
+
+        cut = best.cut;
+
+        if(best_n_moves == 0){
+            break;
+        }
+    }
+}
+
+/// \brief Grow side 0 from the seed in breadth first order until it
+/// reaches the target weight. Disconnected graphs restart from the next
+/// vertex that is not on side 0
+void
+grow_bisection(const WeightedGraph& graph, uint_t seed, uint_t target0, std::vector<uint_t>& side){
+
+    const uint_t n = graph.n_vertices();
+    side.assign(n, 1);
+
+    std::vector<bool> visited(n, false);
+    std::queue<uint_t> queue;
+
+    uint_t weight0 = 0;
+    uint_t next_root = 0;
+
+    queue.push(seed);
+    visited[seed] = true;
+
+    while(weight0 < target0){
+
+        if(queue.empty()){
+
+            while(next_root < n && visited[next_root]){
+                next_root++;
+            }
+
+            if(next_root == n){
+                break;
+            }
+
+            queue.push(next_root);
+            visited[next_root] = true;
+        }
+
+        const uint_t v = queue.front();
+        queue.pop();
+
+        side[v] = 0;
+        weight0 += graph.vertex_weights[v];
+
+        for(uint_t e=graph.offsets[v]; e<graph.offsets[v + 1]; ++e){
+
+            const uint_t u = graph.adjacency[e];
+            if(!visited[u]){
+                visited[u] = true;
+                queue.push(u);
+            }
+        }
+    }
+}
+
+/// \brief The last vertex reached by a breadth first search from root
+uint_t
+farthest_vertex(const WeightedGraph& graph, uint_t root){
+
+    std::vector<bool> visited(graph.n_vertices(), false);
+    std::queue<uint_t> queue;
+    queue.push(root);
+    visited[root] = true;
+
+    uint_t last = root;
+    while(!queue.empty()){
+
+        last = queue.front();
+        queue.pop();
+
+        for(uint_t e=graph.offsets[last]; e<graph.offsets[last + 1]; ++e){
+
+            const uint_t u = graph.adjacency[e];
+            if(!visited[u]){
+                visited[u] = true;
+                queue.push(u);
+            }
+        }
+    }
+
+    return last;
+}
+
+/// \brief The maximum weight of the sides such that no side
+/// exceeds its target by more than the tolerance. A side may always
+/// exceed its target by the heaviest vertex of the graph
+void
+side_limits(const WeightedGraph& graph, uint_t target0, uint_t total, real_t tolerance, uint_t (&max_weights)[2]){
+
+    const uint_t max_vertex_weight = *std::max_element(graph.vertex_weights.begin(), graph.vertex_weights.end());
+    const uint_t targets[2] = {target0, total - target0};
+
+    for(uint_t s=0; s<2; ++s){
+        max_weights[s] = std::max(static_cast<uint_t>(std::floor(targets[s]*(1.0 + tolerance))),
+                                  targets[s] + max_vertex_weight);
+    }
+}
+
+/// \brief Multilevel bisection of the graph such that side 0
+/// gets a fraction fraction0 of the total vertex weight
+void
+multilevel_bisection(const WeightedGraph& graph, real_t fraction0, const GraphPartitionOptions& options,
+                     std::mt19937& generator, std::vector<uint_t>& side){
+
+    const uint_t total = std::accumulate(graph.vertex_weights.begin(), graph.vertex_weights.end(), static_cast<uint_t>(0));
+    const uint_t target0 = static_cast<uint_t>(std::round(fraction0*total));
+
+    // coarsen until the graph is small or the matching stalls
+    std::vector<WeightedGraph> graphs;
+    std::vector<std::vector<uint_t>> maps;
+    graphs.push_back(graph);
+
+    while(graphs.back().n_vertices() > options.coarsest_size){
+
+        WeightedGraph coarse;
+        std::vector<uint_t> map;
+        coarsen(graphs.back(), coarse, map, generator);
+
+        if(coarse.n_vertices() > 0.95*graphs.back().n_vertices()){
+            break;
+        }
+
+        graphs.push_back(std::move(coarse));
+        maps.push_back(std::move(map));
+    }
+
+    // bisect the coarsest graph from a few seeds
+    // and keep the best refined bisection
+    const WeightedGraph& coarsest = graphs.back();
+    uint_t max_weights[2];
+    side_limits(coarsest, target0, total, options.imbalance_tolerance, max_weights);
+
+    std::uniform_int_distribution<uint_t> distribution(0, coarsest.n_vertices() - 1);
+    std::vector<uint_t> trial;
+    bool has_best = false;
+    BisectionQuality best{false, 0, 0};
+
+    for(uint_t t=0; t<std::max(options.n_initial_tries, static_cast<uint_t>(1)); ++t){
+
+        // the first try starts from a peripheral vertex
+        const uint_t seed = t == 0 ? farthest_vertex(coarsest, 0) : distribution(generator);
+
+        grow_bisection(coarsest, seed, target0, trial);
+        fm_refine(coarsest, trial, max_weights, target0, options.n_refinement_passes);
+
+        uint_t weight0 = 0;
+        for(uint_t v=0; v<coarsest.n_vertices(); ++v){
+            weight0 += trial[v] == 0 ? coarsest.vertex_weights[v] : 0;
+        }
+
+        const BisectionQuality current{weight0 <= max_weights[0] && total - weight0 <= max_weights[1],
+                                       bisection_cut(coarsest, trial),
+                                       weight0 > target0 ? weight0 - target0 : target0 - weight0};
+
+        if(!has_best || current.better_than(best)){
+            best = current;
+            side = trial;
+            has_best = true;
+        }
+    }
+
+    // project back and refine on every level
+    for(uint_t level=maps.size(); level-- > 0;){
+
+        const WeightedGraph& fine = graphs[level];
+        const std::vector<uint_t>& map = maps[level];
+
+        std::vector<uint_t> fine_side(fine.n_vertices());
+        for(uint_t v=0; v<fine.n_vertices(); ++v){
+            fine_side[v] = side[map[v]];
+        }
+
+        side.swap(fine_side);
+        side_limits(fine, target0, total, options.imbalance_tolerance, max_weights);
+        fm_refine(fine, side, max_weights, target0, options.n_refinement_passes);
+    }
+}
+
+/// \brief Extract the subgraph of the vertices on the given side.
+/// On output ids[v] is the vertex of graph the subgraph vertex v is
+void
+extract_subgraph(const WeightedGraph& graph, const std::vector<uint_t>& side, uint_t s,
+                 WeightedGraph& subgraph, std::vector<uint_t>& ids){
+
+    const uint_t invalid = KernelConsts::invalid_size_type();
+    std::vector<uint_t> local(graph.n_vertices(), invalid);
+
+    ids.clear();
+    for(uint_t v=0; v<graph.n_vertices(); ++v){
+        if(side[v] == s){
+            local[v] = ids.size();
+            ids.push_back(v);
+        }
+    }
+
+    subgraph.offsets.assign(1, 0);
+    subgraph.adjacency.clear();
+    subgraph.edge_weights.clear();
+    subgraph.vertex_weights.clear();
+
+    for(auto v : ids){
+
+        subgraph.vertex_weights.push_back(graph.vertex_weights[v]);
+
+        for(uint_t e=graph.offsets[v]; e<graph.offsets[v + 1]; ++e){
+
+            if(local[graph.adjacency[e]] != invalid){
+                subgraph.adjacency.push_back(local[graph.adjacency[e]]);
+                subgraph.edge_weights.push_back(graph.edge_weights[e]);
+            }
+        }
+
+        subgraph.offsets.push_back(subgraph.adjacency.size());
+    }
+}
+
+/// \brief Split the graph into n_parts parts numbered from first_part
+/// by recursive bisection. ids maps the vertices to the original graph.
+/// The imbalance tolerance of options applies to every single bisection
+void
+recursive_bisection(const WeightedGraph& graph, const std::vector<uint_t>& ids,
+                    uint_t n_parts, uint_t first_part, const GraphPartitionOptions& options,
+                    std::mt19937& generator, std::vector<uint_t>& parts){
+
+    if(graph.n_vertices() == 0){
+        return;
+    }
+
+    if(n_parts == 1){
+        for(auto id : ids){
+            parts[id] = first_part;
+        }
+        return;
+    }
+
+    const uint_t n_parts0 = n_parts/2;
+
+    std::vector<uint_t> side;
+    multilevel_bisection(graph, static_cast<real_t>(n_parts0)/static_cast<real_t>(n_parts),
+                         options, generator, side);
+
+    for(uint_t s=0; s<2; ++s){
+
+        WeightedGraph subgraph;
+        std::vector<uint_t> local_ids;
+        extract_subgraph(graph, side, s, subgraph, local_ids);
+
+        for(auto& id : local_ids){
+            id = ids[id];
+        }
+
+        recursive_bisection(subgraph, local_ids, s == 0 ? n_parts0 : n_parts - n_parts0,
+                            s == 0 ? first_part : first_part + n_parts0, options, generator, parts);
+    }
+}
+
+}
+
+uint_t
+graph_partition(const std::vector<uint_t>& offsets, const std::vector<uint_t>& adjacency,
+                uint_t n_parts, std::vector<uint_t>& parts, const GraphPartitionOptions& options){
+
+    if(n_parts == 0){
+        throw std::invalid_argument("Cannot partition a graph into zero parts");
+    }
+
+    if(offsets.empty() || offsets.back() != adjacency.size()){
+        throw std::invalid_argument("Invalid CSR offsets for a graph with " +
+                                    std::to_string(adjacency.size()) + " adjacency entries");
+    }
+
+    const uint_t n = offsets.size() - 1;
+
+    parts.assign(n, 0);
+
+    if(n == 0 || n_parts == 1){
+        return 0;
+    }
+
+    WeightedGraph graph;
+    graph.offsets.assign(1, 0);
+    graph.offsets.reserve(n + 1);
+    graph.adjacency.reserve(adjacency.size());
+    graph.vertex_weights.assign(n, 1);
+
+    // drop self loops
+    for(uint_t v=0; v<n; ++v){
+
+        for(uint_t e=offsets[v]; e<offsets[v + 1]; ++e){
+
+            if(adjacency[e] >= n){
+                throw std::invalid_argument("Invalid vertex " + std::to_string(adjacency[e]) +
+                                            " not in [0, " + std::to_string(n) + ")");
+            }
+
+            if(adjacency[e] != v){
+                graph.adjacency.push_back(adjacency[e]);
+            }
+        }
+
+        graph.offsets.push_back(graph.adjacency.size());
+    }
+
+    graph.edge_weights.assign(graph.adjacency.size(), 1);
+
+    std::vector<uint_t> ids(n);
+    std::iota(ids.begin(), ids.end(), 0);
+
+    // the imbalance of every bisection multiplies over the levels of
+    // the recursion so every level gets the same share of the tolerance
+    const real_t n_levels = std::ceil(std::log2(static_cast<real_t>(n_parts)));
+    GraphPartitionOptions bisection_options = options;
+    bisection_options.imbalance_tolerance = std::pow(1.0 + options.imbalance_tolerance, 1.0/n_levels) - 1.0;
+
+    std::mt19937 generator(options.seed);
+    recursive_bisection(graph, ids, n_parts, 0, bisection_options, generator, parts);
+
+    return graph_edge_cut(offsets, adjacency, parts);
+}
+
+uint_t
+graph_edge_cut(const std::vector<uint_t>& offsets, const std::vector<uint_t>& adjacency,
+               const std::vector<uint_t>& parts){
+
+    uint_t cut = 0;
+    for(uint_t v=0; v + 1<offsets.size(); ++v){
+        for(uint_t e=offsets[v]; e<offsets[v + 1]; ++e){
+            if(parts[v] != parts[adjacency[e]]){
+                cut++;
+            }
+        }
+    }
+
+    return cut/2;
+}
+
+}
@@ -0,0 +1,52 @@
+#ifndef GRAPH_PARTITIONER_H
+#define GRAPH_PARTITIONER_H
+
+#include "kernel/base/types.h"
+
+#include <vector>
+
+namespace kernel
+{
+
+/// \brief Options for graph_partition
+struct GraphPartitionOptions
+{
+    /// \brief The relative amount by which the weight of
+    /// a part may exceed its target weight
+    real_t imbalance_tolerance{0.03};
+
+    /// \brief Coarsening stops when the graph has
+    /// at most this number of vertices
+    uint_t coarsest_size{64};
+
+    /// \brief The maximum number of refinement passes on every level
+    uint_t n_refinement_passes{4};
+
+    /// \brief How many initial bisections of the coarsest graph are tried
+    uint_t n_initial_tries{8};
+
+    /// \brief The seed of the random number generator
+    /// used for the matching and the initial bisections
+    uint_t seed{42};
+};
+
+/// \brief Partition the undirected graph given in CSR format into n_parts
+/// parts of (almost) equal size while minimizing the edge cut. The adjacency
+/// of vertex v is adjacency[offsets[v]] ... adjacency[offsets[v+1]-1] and every
+/// edge must be listed by both of its vertices. The graph is split by recursive
+/// multilevel bisection: it is coarsened with heavy edge matching, the coarsest
+/// graph is bisected by greedy graph growing and the bisection is projected back
+/// and refined with Fiduccia-Mattheyses passes on every level. On output parts[v]
+/// is the part of vertex v. Returns the edge cut
+uint_t graph_partition(const std::vector<uint_t>& offsets, const std::vector<uint_t>& adjacency,
+                       uint_t n_parts, std::vector<uint_t>& parts,
+                       const GraphPartitionOptions& options = GraphPartitionOptions());
+
+/// \brief Returns the number of edges of the graph
+/// whose vertices are in different parts
+uint_t graph_edge_cut(const std::vector<uint_t>& offsets, const std::vector<uint_t>& adjacency,
+                      const std::vector<uint_t>& parts);
+
+}
+
+#endif // GRAPH_PARTITIONER_H
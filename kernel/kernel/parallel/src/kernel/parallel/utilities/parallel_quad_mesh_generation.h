@@ -0,0 +1,244 @@
+#ifndef PARALLEL_QUAD_MESH_GENERATION_H
+#define PARALLEL_QUAD_MESH_GENERATION_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/config.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/element_type.h"
+#include "kernel/parallel/threading/simple_task.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+
+#ifdef USE_LOG
+#include "kernel/utilities/logger.h"
+#include <chrono>
+#include <sstream>
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace kernel{
+namespace numerics {
+
+namespace detail{
+
+/// \brief Task that applies an operation on every row of
+/// a structured grid in the range [begin, end)
+template<typename OpTp>
+class QuadMeshRowsTask: public SimpleTaskBase<Null>
+{
+public:
+
+    /// \brief Constructor
+    QuadMeshRowsTask(uint_t id, uint_t begin, uint_t end, const OpTp& op)
+        :
+        SimpleTaskBase<Null>(id),
+        begin_(begin),
+        end_(end),
+        op_(op)
+    {}
+
+protected:
+
+    /// \brief Apply the operation on the rows
+    virtual void run()override{
+
+        for(uint_t j=begin_; j<end_; ++j){
+            op_(j);
+        }
+    }
+
+private:
+
+    uint_t begin_;
+    uint_t end_;
+    const OpTp& op_;
+};
+
+/// \brief Split the rows [0, n_rows) into one contiguous block per
+/// processing element of the executor and apply op on every row.
+/// Throws std::logic_error if a task did not finish
+template<typename OpTp, typename Executor, typename Options>
+void
+execute_quad_mesh_rows(uint_t n_rows, const OpTp& op, Executor& executor, const Options& options){
+
+    const uint_t n_parts = std::min(std::max(executor.n_processing_elements(), static_cast<uint_t>(1)), n_rows);
+
+    std::vector<range1d<uint_t>> partitions;
+    partition_range(0, n_rows, partitions, n_parts);
+
+    std::vector<std::unique_ptr<QuadMeshRowsTask<OpTp>>> tasks;
+    tasks.reserve(partitions.size());
+
+    for(uint_t t=0; t<partitions.size(); ++t){
+        tasks.push_back(std::make_unique<QuadMeshRowsTask<OpTp>>(t, partitions[t].begin(), partitions[t].end(), op));
+    }
+
+    // this will block
+    executor.execute(tasks, options);
+
+    for(const auto& task : tasks){
+
+        if(task->get_state() != TaskBase::TaskState::FINISHED){
+            throw std::logic_error("A quad mesh generation task did not finish");
+        }
+    }
+}
+
+}
+
+/// \brief Build a cartesian mesh with quad elements using the given executor.
+/// The result is identical to the serial build_quad_mesh: the node, element
+/// and face ids, the element-to-face numbering, the face ownership and the
+/// boundary indicators are the same. Unlike the serial version, all the counts
+/// are known up front. The topology is resized once and the nodes, elements and
+/// faces are created row by row in parallel. The neighbors are computed from the
+/// (i, j) index of the element rather than searched through the node connectivity.
+/// The mesh should be empty. The options are passed to the executor
+template<typename Executor, typename Options>
+void
+build_quad_mesh(Mesh<2>& mesh, uint_t nx, uint_t ny,
+                const GeomPoint<2, real_t>& lower_point,
+                const GeomPoint<2, real_t>& upper_point,
+                Executor& executor, const Options& options){
+
+    if(nx == 0 || ny == 0){
+        throw std::invalid_argument("Cannot build a quad mesh with zero elements in one direction");
+    }
+
+    if(mesh.n_nodes() != 0 || mesh.n_elements() != 0){
+        throw std::logic_error("The mesh should be empty");
+    }
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> start_timing = std::chrono::system_clock::now();
+#endif
+
+    const real_t dx = (upper_point[0] - lower_point[0])/static_cast<real_t>(nx);
+    const real_t dy = (upper_point[1] - lower_point[1])/static_cast<real_t>(ny);
+
+    // the faces are numbered as the serial generator does: every element
+    // creates its right and top faces plus its bottom face on the
+    // first row and its left face on the first column
+    const uint_t n_faces = 2*nx*ny + nx + ny;
+
+    mesh.resize_n_nodes((nx + 1)*(ny + 1));
+    mesh.resize_n_elements(nx*ny);
+    mesh.resize_n_faces(n_faces);
+
+    auto node_id = [nx](uint_t i, uint_t j){return i + j*(nx + 1);};
+
+    auto face_offset = [nx](uint_t i, uint_t j){
+        const uint_t e = i + j*nx;
+        return 2*e + j + (i > 0 ? 1 : 0) + (j > 0 ? nx : i);
+    };
+
+    auto build_nodes = [&](uint_t j){
+
+        for(uint_t i=0; i<=nx; ++i){
+            real_t data[] = {lower_point[0] + i*dx, lower_point[1] + j*dy};
+            mesh.create_vertex(GeomPoint<2>(data), node_id(i, j));
+        }
+    };
+
+    detail::execute_quad_mesh_rows(ny + 1, build_nodes, executor, options);
+
+    auto build_elements = [&](uint_t j){
+
+        for(uint_t i=0; i<nx; ++i){
+
+            auto* element = mesh.create_element(ElementType::sub_type::QUAD4, i + j*nx, 0);
+
+            if(!element){
+                throw std::logic_error("NULL pointer element");
+            }
+
+            element->resize_nodes();
+            element->set_node(0, mesh.node(node_id(i, j)));
+            element->set_node(1, mesh.node(node_id(i + 1, j)));
+            element->set_node(2, mesh.node(node_id(i + 1, j + 1)));
+            element->set_node(3, mesh.node(node_id(i, j + 1)));
+
+            element->resize_neighbors();
+            element->resize_faces();
+        }
+    };
+
+    detail::execute_quad_mesh_rows(ny, build_elements, executor, options);
+
+    // face f of a QUAD4 joins the nodes f and f+1 and
+    // lies on the bottom, right, top and left side respectively
+    auto build_faces = [&](uint_t j){
+
+        for(uint_t i=0; i<nx; ++i){
+
+            Element<2>* element = mesh.element(i + j*nx);
+
+            const uint_t nodes[] = {node_id(i, j), node_id(i + 1, j), node_id(i + 1, j + 1), node_id(i, j + 1)};
+
+            Element<2>* neighbors[] = {j > 0 ? mesh.element(i + (j - 1)*nx) : nullptr,
+                                       i + 1 < nx ? mesh.element(i + 1 + j*nx) : nullptr,
+                                       j + 1 < ny ? mesh.element(i + (j + 1)*nx) : nullptr,
+                                       i > 0 ? mesh.element(i - 1 + j*nx) : nullptr};
+
+            // bottom, right, top, left
+            const uint_t boundary_indicators[] = {0, 1, 2, 3};
+
+            uint_t face_id = face_offset(i, j);
+
+            for(uint_t f=0; f<4; ++f){
+
+                element->set_neighbor(f, neighbors[f]);
+
+                // the face is created by the element with the smaller id
+                if(neighbors[f] && neighbors[f]->get_id() < element->get_id()){
+                    continue;
+                }
+
+                auto* face = mesh.create_face(ElementType::sub_type::EDGE2, face_id++);
+
+                face->set_owner_element(element);
+                face->resize_nodes();
+                face->set_node(0, mesh.node(nodes[f]));
+                face->set_node(1, mesh.node(nodes[(f + 1) % 4]));
+
+                element->set_face(f, face);
+
+                if(!neighbors[f]){
+                    face->set_boundary_indicator(boundary_indicators[f]);
+                }
+                else{
+
+                    // the neighbor sees the face from the opposite side.
+                    // Only this task writes this slot of the neighbor
+                    face->set_shared_element(neighbors[f]);
+                    neighbors[f]->set_face((f + 2) % 4, face);
+                }
+            }
+        }
+    };
+
+    detail::execute_quad_mesh_rows(ny, build_faces, executor, options);
+
+    mesh.set_n_boundaries(4);
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> end_timing = std::chrono::system_clock::now();
+    std::chrono::duration<real_t> dur = end_timing - start_timing;
+    std::ostringstream message;
+    message<<"parallel build_quad_mesh run time: "<<dur.count();
+    Logger::log_info(message.str());
+#endif
+}
+
+}
+}
+
+#endif // PARALLEL_QUAD_MESH_GENERATION_H
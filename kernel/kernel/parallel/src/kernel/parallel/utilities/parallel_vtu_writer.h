@@ -0,0 +1,137 @@
+#ifndef PARALLEL_VTU_WRITER_H
+#define PARALLEL_VTU_WRITER_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/config.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/vtu_mesh_file_writer.h"
+#include "kernel/parallel/threading/simple_task.h"
+
+#ifdef USE_LOG
+#include "kernel/utilities/logger.h"
+#include <chrono>
+#include <sstream>
+#endif
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace kernel{
+namespace numerics {
+
+namespace detail{
+
+/// \brief Task that writes the piece of one processor id
+template<int dim>
+class VtuPieceTask: public SimpleTaskBase<Null>
+{
+public:
+
+    /// \brief Constructor. cell_values may be null
+    VtuPieceTask(uint_t pid, const VtuMeshFileWriter<dim>& writer, const Mesh<dim>& mesh,
+                 const std::vector<real_t>* cell_values, const std::string& name)
+        :
+        SimpleTaskBase<Null>(pid),
+        writer_(writer),
+        mesh_(mesh),
+        cell_values_(cell_values),
+        name_(name)
+    {}
+
+protected:
+
+    /// \brief Write the piece
+    virtual void run()override{
+
+        if(cell_values_){
+            writer_.write_piece(mesh_, this->get_id(), *cell_values_, name_);
+        }
+        else{
+            writer_.write_piece(mesh_, this->get_id());
+        }
+    }
+
+private:
+
+    const VtuMeshFileWriter<dim>& writer_;
+    const Mesh<dim>& mesh_;
+    const std::vector<real_t>* cell_values_;
+    const std::string& name_;
+};
+
+/// \brief Write one piece per processor id with the given executor
+/// and then the .pvtu file. Throws std::logic_error if a task did not finish
+template<int dim, typename Executor, typename Options>
+void
+execute_vtu_pieces(const VtuMeshFileWriter<dim>& writer, const Mesh<dim>& mesh, uint_t n_parts,
+                   const std::vector<real_t>* cell_values, const std::string& name,
+                   Executor& executor, const Options& options){
+
+    if(n_parts == 0){
+        throw std::invalid_argument("Cannot write a partitioned mesh with zero parts");
+    }
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> start_timing = std::chrono::system_clock::now();
+#endif
+
+    std::vector<std::unique_ptr<VtuPieceTask<dim>>> tasks;
+    tasks.reserve(n_parts);
+
+    for(uint_t p=0; p<n_parts; ++p){
+        tasks.push_back(std::make_unique<VtuPieceTask<dim>>(p, writer, mesh, cell_values, name));
+    }
+
+    // this will block
+    executor.execute(tasks, options);
+
+    for(const auto& task : tasks){
+
+        if(task->get_state() != TaskBase::TaskState::FINISHED){
+            throw std::logic_error("Writing the VTU piece " + std::to_string(task->get_id()) + " did not finish");
+        }
+    }
+
+    writer.write_pvtu(n_parts, cell_values ? name : std::string());
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> end_timing = std::chrono::system_clock::now();
+    std::chrono::duration<real_t> dur = end_timing-start_timing;
+    std::ostringstream message;
+    message<<"write_partitioned_vtu run time: "<<dur.count()<<" pieces: "<<n_parts;
+    Logger::log_info(message.str());
+#endif
+}
+
+}
+
+/// \brief Write the mesh partitioned by processor id as a .pvtu file and one
+/// .vtu piece per part. Every piece is written by its own task of the executor
+/// into its own file so that no synchronization is needed. The processor ids
+/// of the active elements should be in [0, n_parts), e.g. as set by
+/// graph_mesh_partition. The options are passed to the executor
+template<int dim, typename Executor, typename Options>
+void
+write_partitioned_vtu(const VtuMeshFileWriter<dim>& writer, const Mesh<dim>& mesh, uint_t n_parts,
+                      Executor& executor, const Options& options){
+
+    detail::execute_vtu_pieces(writer, mesh, n_parts, nullptr, std::string(), executor, options);
+}
+
+/// \brief Write the mesh partitioned by processor id together with the
+/// given cell values. The values are indexed by the element id
+template<int dim, typename Executor, typename Options>
+void
+write_partitioned_vtu(const VtuMeshFileWriter<dim>& writer, const Mesh<dim>& mesh, uint_t n_parts,
+                      const std::vector<real_t>& cell_values, const std::string& name,
+                      Executor& executor, const Options& options){
+
+    detail::execute_vtu_pieces(writer, mesh, n_parts, &cell_values, name, executor, options);
+}
+
+}
+}
+
+#endif // PARALLEL_VTU_WRITER_H
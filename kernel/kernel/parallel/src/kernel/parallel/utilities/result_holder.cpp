@@ -5,42 +5,83 @@ namespace kernel{
 ResultHolder<void>::ResultHolder(bool valid)
     :
    item_(nullptr),
-   valid_result_(valid)
+   valid_result_(valid),
+   m_(),
+   cvar_()
 {}
 
 
+ResultHolder<void>::ResultHolder(const ResultHolder<void>& other)
+    :
+   item_(other.item_),
+   valid_result_(other.is_result_valid()),
+   m_(),
+   cvar_()
+{}
+
+
+ResultHolder<void>&
+ResultHolder<void>::operator=(const ResultHolder<void>& other){
+
+    if(this == &other){
+        return *this;
+    }
+
+    item_ = other.item_;
+    set_validity_(other.is_result_valid());
+    return *this;
+}
+
+
 void
 ResultHolder<void>::get_copy(ResultHolder<void>& other)const{
-    other.valid_result_ = valid_result_;
     other.item_ = item_;
+    other.set_validity_(is_result_valid());
 }
 
 
 ResultHolder<void>::result_type
 ResultHolder<void>::get()const{
-    return std::make_pair(&(const_cast<ResultHolder<void>&>(*this).item_), valid_result_);
+    return std::make_pair(&(const_cast<ResultHolder<void>&>(*this).item_), is_result_valid());
 }
 
 
 ResultHolder<void>::result_type
-ResultHolder<void>::get_or_wait()const{
+ResultHolder<void>::get_or_wait(uint_t n_spins)const{
 
-    while(!valid_result_){
+    for(uint_t s=0; s<n_spins && !is_result_valid(); ++s){
         std::this_thread::yield();
     }
 
-    return std::make_pair(&(const_cast<ResultHolder<void>&>(*this).item_), valid_result_);
+    // acquire the lock even if the result became valid whilst
+    // spinning so that we synchronize with the validating thread
+    std::unique_lock<std::mutex> lck(m_);
+    cvar_.wait(lck, [this]{return is_result_valid();});
+
+    return std::make_pair(&(const_cast<ResultHolder<void>&>(*this).item_), true);
 }
 
 
 ResultHolder<void>::result_type
 ResultHolder<void>::get_or_wait_for(uint_t mills)const{
 
-    if(!valid_result_){
-        std::this_thread::sleep_for(std::chrono::milliseconds(mills));
-    }
+    std::unique_lock<std::mutex> lck(m_);
+    const bool valid = cvar_.wait_for(lck, std::chrono::milliseconds(mills),
+                                      [this]{return is_result_valid();});
+
+    return std::make_pair(&(const_cast<ResultHolder<void>&>(*this).item_), valid);
+}
+
 
-    return std::make_pair(&(const_cast<ResultHolder<void>&>(*this).item_), valid_result_);
+void
+ResultHolder<void>::set_validity_(bool valid){
+
+    std::lock_guard<std::mutex> lck(m_);
+    valid_result_.store(valid, std::memory_order_release);
+
+    if(valid){
+        cvar_.notify_all();
+    }
 }
 
 }
@@ -11,6 +11,10 @@
 #include "kernel/base/types.h"
 #include <boost/noncopyable.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <utility>
 
@@ -77,10 +81,11 @@ public:
     ResultHolder<T>& operator /= (const ResultHolder<T>& other);
 
     /// \brief Query whether the held result is valid
-    bool is_result_valid()const{return valid_result_;}
+    bool is_result_valid()const{return valid_result_.load(std::memory_order_acquire);}
 
-    /// \brief Validate the result
-    void validate_result(){valid_result_ = true;}
+    /// \brief Validate the result. Threads blocked
+    /// in get_or_wait() are woken up
+    void validate_result(){set_validity_(true);}
 
     /// \brief Invalidate the result. If reinit is true
     /// the underlying item is reinitialized using the default constructor
@@ -93,12 +98,14 @@ public:
     /// result becomes valid
     result_type get()const;
 
-    /// \brief Attempt to get the result only if it is valid. It yields the calling thread
-    /// as long as  the result is not valid
-    result_type get_or_wait()const;
+    /// \brief Attempt to get the result only if it is valid. The calling thread
+    /// polls the result n_spins times yielding in between and then sleeps
+    /// until validate_result() is called
+    result_type get_or_wait(uint_t n_spins=0)const;
 
-    /// \brief Attempt to get the result. If the result is not valid is waits for the
-    /// specified time in milliseconds. It then returns the result regardless of its validity
+    /// \brief Attempt to get the result. If the result is not valid it waits at most
+    /// the specified time in milliseconds for validate_result() to be called.
+    /// It then returns the result regardless of its validity
     result_type get_or_wait_for(uint_t milliseconds)const;
 
     /// \brief Raw access to the resource
@@ -113,28 +120,43 @@ private:
     value_type item_;
 
     /// \brief flag indicating whether the result is valid
-    bool valid_result_;
+    std::atomic<bool> valid_result_;
+
+    /// \brief Waiting threads sleep on the condition
+    /// variable until the result is validated
+    mutable std::mutex m_;
+    mutable std::condition_variable cvar_;
+
+    /// \brief Set the validity flag under the lock and
+    /// notify the waiting threads if the result is valid
+    void set_validity_(bool valid);
 };
 
 template<typename T >
 ResultHolder<T>::ResultHolder(bool valid)
     :
    item_(),
-   valid_result_(valid)
+   valid_result_(valid),
+   m_(),
+   cvar_()
 {}
 
 template<typename T>
 ResultHolder<T>::ResultHolder(T&& init, bool valid)
     :
    item_(init),
-   valid_result_(valid)
+   valid_result_(valid),
+   m_(),
+   cvar_()
 {}
 
 template<typename T>
 ResultHolder<T>::ResultHolder(const ResultHolder<T>& other)
     :
       item_(other.item_),
-      valid_result_(other.valid_result_)
+      valid_result_(other.is_result_valid()),
+      m_(),
+      cvar_()
 {}
 
 template<typename T>
@@ -146,7 +168,7 @@ ResultHolder<T>::operator=(const ResultHolder<T>& other){
     }
 
     item_ = other.item_;
-    valid_result_ = other.valid_result_;
+    set_validity_(other.is_result_valid());
     other.invalidate_result(true);
     return *this;
 }
@@ -155,7 +177,9 @@ template<typename T>
 ResultHolder<T>::ResultHolder(ResultHolder<T>&& other)noexcept
     :
       item_(other.item_),
-      valid_result_(other.valid_result_)
+      valid_result_(other.is_result_valid()),
+      m_(),
+      cvar_()
 {
     other.invalidate_result(true);
 }
@@ -169,7 +193,7 @@ ResultHolder<T>::operator=(ResultHolder<T>&& other)noexcept{
     }
 
     item_ = other.item_;
-    valid_result_ = other.valid_result_;
+    set_validity_(other.is_result_valid());
     other.invalidate_result(true);
     return *this;
 }
@@ -264,25 +288,29 @@ void
 ResultHolder<T>::get_copy(ResultHolder<T>& other)const
 {
 
-    other.valid_result_ = valid_result_;
     other.item_ = item_;
+    other.set_validity_(is_result_valid());
 }
 
 template<typename T>
 typename ResultHolder<T>::result_type
 ResultHolder<T>::get()const{
-    return std::make_pair(&(const_cast<ResultHolder<T>&>(*this).item_), valid_result_);
+    return std::make_pair(&(const_cast<ResultHolder<T>&>(*this).item_), is_result_valid());
 }
 
 template<typename T>
 typename ResultHolder<T>::result_type
-ResultHolder<T>::get_or_wait()const{
+ResultHolder<T>::get_or_wait(uint_t n_spins)const{
 
-    while(!valid_result_){
+    for(uint_t s=0; s<n_spins && !is_result_valid(); ++s){
         std::this_thread::yield();
     }
 
-    return std::make_pair(&(const_cast<ResultHolder<T>&>(*this).item_), valid_result_);
+    // acquire the lock even if the result became valid whilst
+    // spinning so that we synchronize with the validating thread
+    std::unique_lock<std::mutex> lck(m_);
+    cvar_.wait(lck, [this]{return is_result_valid();});
+    return std::make_pair(&(const_cast<ResultHolder<T>&>(*this).item_), true);
 }
 
 
@@ -290,11 +318,11 @@ template<typename T>
 typename ResultHolder<T>::result_type
 ResultHolder<T>::get_or_wait_for(uint_t mills)const{
 
-    if(!valid_result_){
-        std::this_thread::sleep_for(std::chrono::milliseconds(mills));
-    }
+    std::unique_lock<std::mutex> lck(m_);
+    const bool valid = cvar_.wait_for(lck, std::chrono::milliseconds(mills),
+                                      [this]{return is_result_valid();});
 
-    return std::make_pair(&(const_cast<ResultHolder<T>&>(*this).item_), valid_result_);
+    return std::make_pair(&(const_cast<ResultHolder<T>&>(*this).item_), valid);
 }
 
 template<typename T>
@@ -305,7 +333,19 @@ ResultHolder<T>::invalidate_result(bool reinit){
        item_ = typename ResultHolder<T>::value_type();
     }
 
-    valid_result_ = false;
+    set_validity_(false);
+}
+
+template<typename T>
+void
+ResultHolder<T>::set_validity_(bool valid){
+
+    std::lock_guard<std::mutex> lck(m_);
+    valid_result_.store(valid, std::memory_order_release);
+
+    if(valid){
+        cvar_.notify_all();
+    }
 }
 
 
@@ -324,15 +364,21 @@ public:
     /// \brief Constructor
     explicit ResultHolder(bool valid=false);
 
+    /// \brief Copy constructor
+    ResultHolder(const ResultHolder<void>& other);
+
+    /// \brief Copy assignement
+    ResultHolder<void>& operator=(const ResultHolder<void>& other);
+
     /// \brief Query whether the held result is valid
-    bool is_result_valid()const{return valid_result_;}
+    bool is_result_valid()const{return valid_result_.load(std::memory_order_acquire);}
 
-    /// \brief Validate the result
-    void validate_result(){valid_result_ = true;}
+    /// \brief Validate the result. Threads blocked
+    /// in get_or_wait() are woken up
+    void validate_result(){set_validity_(true);}
 
-    /// \brief Invalidate the result. If reinit is true
-    /// the underlying item is reinitialized using the default constructor
-    void invalidate_result(){valid_result_ = false;}
+    /// \brief Invalidate the result
+    void invalidate_result(){set_validity_(false);}
 
     /// \brief Get a copy of the internals
     void get_copy(ResultHolder<void>& other)const;
@@ -341,12 +387,14 @@ public:
     /// result becomes valid
     result_type get()const;
 
-    /// \brief Attempt to get the result only if it is valid. It yields the calling thread
-    /// as long as  the result is not valid
-    result_type get_or_wait()const;
+    /// \brief Attempt to get the result only if it is valid. The calling thread
+    /// polls the result n_spins times yielding in between and then sleeps
+    /// until validate_result() is called
+    result_type get_or_wait(uint_t n_spins=0)const;
 
-    /// \brief Attempt to get the result. If the result is not valid is waits for the
-    /// specified time in milliseconds. It then returns the result regardless of its validity
+    /// \brief Attempt to get the result. If the result is not valid it waits at most
+    /// the specified time in milliseconds for validate_result() to be called.
+    /// It then returns the result regardless of its validity
     result_type get_or_wait_for(uint_t milliseconds)const;
 
 private:
@@ -355,7 +403,16 @@ private:
     void* item_;
 
     /// \brief flag indicating whether the result is valid
-    bool valid_result_;
+    std::atomic<bool> valid_result_;
+
+    /// \brief Waiting threads sleep on the condition
+    /// variable until the result is validated
+    mutable std::mutex m_;
+    mutable std::condition_variable cvar_;
+
+    /// \brief Set the validity flag under the lock and
+    /// notify the waiting threads if the result is valid
+    void set_validity_(bool valid);
 };
 
 
@@ -0,0 +1,167 @@
+#include "kernel/base/types.h"
+#include "kernel/utilities/checkpoint_file.h"
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+}
+
+TEST(TestCheckpointFile, TestRoundTrip) {
+
+    /***
+       * Test Scenario:    The application writes real and integer sections and reads them back
+       * Expected Output:  The sections have the written types and values and the data is 64-byte aligned
+     **/
+
+    using kernel::uint_t;
+    using kernel::real_t;
+    using kernel::CheckpointWriter;
+    using kernel::CheckpointReader;
+    using kernel::CheckpointDataType;
+
+    std::vector<real_t> solution(1000);
+    for(uint_t i=0; i<solution.size(); ++i){
+        solution[i] = 0.5*static_cast<real_t>(i);
+    }
+
+    std::vector<uint_t> ids = {3, 1, 2};
+
+    CheckpointWriter writer;
+    writer.add_section("solution", solution);
+    writer.add_section("ids", ids);
+    writer.add_value("time", 1.5);
+    writer.add_section("empty", std::vector<real_t>());
+    writer.write("test_checkpoint_round_trip.ckpt");
+
+    CheckpointReader reader("test_checkpoint_round_trip.ckpt");
+    ASSERT_EQ(reader.n_sections(), static_cast<uint_t>(4));
+    ASSERT_EQ(reader.section_type("ids"), CheckpointDataType::UINT);
+    ASSERT_EQ(reader.get_value("time"), 1.5);
+    ASSERT_TRUE(reader.get_real_section("empty").empty());
+
+    auto values = reader.get_real_section("solution");
+    ASSERT_EQ(values.size(), solution.size());
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % 64, static_cast<std::uintptr_t>(0));
+
+    for(uint_t i=0; i<solution.size(); ++i){
+        ASSERT_EQ(values[i], solution[i]);
+    }
+
+    auto read_ids = reader.get_uint_section("ids");
+    ASSERT_EQ(std::vector<uint_t>(read_ids.begin(), read_ids.end()), ids);
+}
+
+TEST(TestCheckpointFile, TestInvalidAccess) {
+
+    /***
+       * Test Scenario:    The application adds a duplicate section, reads a missing section,
+       *                   reads a section with the wrong type and opens a file that is not a checkpoint
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    using kernel::real_t;
+    using kernel::uint_t;
+    using kernel::CheckpointWriter;
+    using kernel::CheckpointReader;
+
+    CheckpointWriter writer;
+    writer.add_section("ids", std::vector<uint_t>(3, 1));
+    ASSERT_THROW(writer.add_section("ids", std::vector<real_t>(3, 1.0)), std::logic_error);
+    ASSERT_THROW(writer.add_value(std::string(CheckpointWriter::max_name_size() + 1, 'a'), 1.0), std::logic_error);
+    writer.write("test_checkpoint_invalid.ckpt");
+
+    CheckpointReader reader("test_checkpoint_invalid.ckpt");
+    ASSERT_THROW(reader.get_real_section("ids"), std::logic_error);
+    ASSERT_THROW(reader.get_uint_section("solution"), std::logic_error);
+
+    {
+        std::ofstream out("test_checkpoint_not_a_checkpoint.ckpt");
+        out<<"This is not a checkpoint file at all";
+    }
+
+    ASSERT_THROW(CheckpointReader("test_checkpoint_not_a_checkpoint.ckpt"), std::logic_error);
+    ASSERT_THROW(CheckpointReader("test_checkpoint_missing.ckpt"), std::logic_error);
+}
+
+TEST(TestCheckpointFile, TestCorruptSectionCount) {
+
+    /***
+       * Test Scenario:    The application opens a checkpoint whose section count is so large
+       *                   that the size of the section in bytes overflows
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    using kernel::real_t;
+    using kernel::CheckpointWriter;
+    using kernel::CheckpointReader;
+
+    CheckpointWriter writer;
+    writer.add_section("solution", std::vector<real_t>(8, 1.0));
+    writer.write("test_checkpoint_corrupt.ckpt");
+
+    {
+        // the count of the first section follows the 32 byte header,
+        // the 40 byte name, the type, the element size and the offset
+        const std::uint64_t count = (std::uint64_t(1) << 61) + 1;
+        std::fstream file("test_checkpoint_corrupt.ckpt", std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(32 + 40 + 4 + 4 + 8);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    ASSERT_THROW(CheckpointReader("test_checkpoint_corrupt.ckpt"), std::logic_error);
+}
+
+TEST(TestCheckpointFile, TestAsyncWriter) {
+
+    /***
+       * Test Scenario:    The application writes a sequence of checkpoints in the background
+       *                   and modifies the data after every write is started
+       * Expected Output:  Every file holds the data at the time its write was started
+     **/
+
+    using kernel::uint_t;
+    using kernel::real_t;
+    using kernel::CheckpointWriter;
+    using kernel::CheckpointReader;
+    using kernel::AsyncCheckpointWriter;
+
+    const uint_t n_steps = 4;
+    std::vector<real_t> solution(100000, 0.0);
+
+    {
+        AsyncCheckpointWriter async_writer;
+
+        for(uint_t step=0; step<n_steps; ++step){
+
+            CheckpointWriter checkpoint;
+            checkpoint.add_section("solution", solution);
+            checkpoint.add_value("step", static_cast<real_t>(step));
+            async_writer.write(std::move(checkpoint), "test_checkpoint_async_" + std::to_string(step) + ".ckpt");
+
+            // the next step changes the solution while the write is in flight
+            for(auto& value : solution){
+                value += 1.0;
+            }
+        }
+
+        async_writer.wait();
+        ASSERT_FALSE(async_writer.is_busy());
+    }
+
+    for(uint_t step=0; step<n_steps; ++step){
+
+        CheckpointReader reader("test_checkpoint_async_" + std::to_string(step) + ".ckpt");
+        ASSERT_EQ(reader.get_value("step"), static_cast<real_t>(step));
+
+        auto values = reader.get_real_section("solution");
+        ASSERT_EQ(values.size(), solution.size());
+        ASSERT_EQ(values[0], static_cast<real_t>(step));
+        ASSERT_EQ(values[values.size() - 1], static_cast<real_t>(step));
+    }
+}
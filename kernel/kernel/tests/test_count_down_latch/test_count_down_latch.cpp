@@ -0,0 +1,69 @@
+#include "kernel/parallel/threading/count_down_latch.h"
+#include "kernel/base/types.h"
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::CountDownLatch;
+
+}
+
+TEST(TestCountDownLatch, WaitWithZeroCount) {
+
+    /***
+     * Test Scenario:   The application creates a latch with zero count and waits on it
+     * Expected Output:	wait() returns immediately
+     **/
+
+    CountDownLatch latch(0);
+    latch.wait();
+    ASSERT_TRUE(latch.is_released());
+}
+
+TEST(TestCountDownLatch, CountDownBelowZero) {
+
+    /***
+     * Test Scenario:   The application calls count_down() more times than the initial count
+     * Expected Output:	The count stays at zero
+     **/
+
+    CountDownLatch latch(1);
+    latch.count_down();
+    latch.count_down();
+    ASSERT_EQ(latch.count(), static_cast<uint_t>(0));
+}
+
+TEST(TestCountDownLatch, WaitForThreads) {
+
+    /***
+     * Test Scenario:   The application waits on a latch whilst four threads count it down
+     * Expected Output:	wait() returns after all threads have done their work
+     **/
+
+    for(uint_t n_spins : {static_cast<uint_t>(0), static_cast<uint_t>(1000)}){
+
+        const uint_t n_threads = 4;
+        CountDownLatch latch(n_threads);
+        std::atomic<uint_t> counter(0);
+
+        std::vector<std::thread> threads;
+        for(uint_t t=0; t<n_threads; ++t){
+            threads.emplace_back([&latch, &counter](){
+                counter++;
+                latch.count_down();
+            });
+        }
+
+        latch.wait(n_spins);
+        ASSERT_EQ(counter.load(), n_threads);
+
+        for(auto& thread : threads){
+            thread.join();
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#include "kernel/parallel/parallel_algos/linear_algebra/dot_product.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/utilities/partitioned_type.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+#include "kernel/utilities/range_1d.h"
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using Vector = kernel::PartitionedType<kernel::DynVec<real_t>>;
+
+}
+
+TEST(TestDotProduct, ReexecuteRecomputesResult) {
+
+    /***
+     * Test Scenario:   The application executes a dot product and then reexecutes it
+     *                  after the vector values have changed
+     * Expected Output:	get_or_wait() returns the dot product of the current values every time
+     **/
+
+    const uint_t n = 1000;
+
+    kernel::ThreadPool pool(4);
+
+    std::vector<kernel::range1d<uint_t>> partitions;
+    kernel::partition_range(uint_t(0), n, partitions, pool.get_n_threads());
+
+    Vector v(n, 1.0);
+    v.set_partitions(partitions);
+
+    kernel::DotProduct<Vector, real_t> dot_product(v);
+    dot_product.execute(pool, kernel::Null());
+
+    auto result = dot_product.get_or_wait().get();
+    ASSERT_TRUE(result.second);
+    ASSERT_DOUBLE_EQ(*result.first, static_cast<real_t>(n));
+
+    for(uint_t itr=1; itr<5; ++itr){
+
+        for(uint_t i=0; i<n; ++i){
+            v[i] = static_cast<real_t>(itr + 1);
+        }
+
+        dot_product.reexecute(pool, kernel::Null());
+
+        result = dot_product.get_or_wait().get();
+        ASSERT_TRUE(result.second);
+        ASSERT_DOUBLE_EQ(*result.first, static_cast<real_t>(n*(itr + 1)*(itr + 1)));
+    }
+}
@@ -0,0 +1,89 @@
+#include "kernel/parallel/data_structs/lock_free_queue.h"
+#include "kernel/base/types.h"
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::LockFreeQueue;
+
+}
+
+TEST(TestLockFreeQueue, InvalidCapacity) {
+
+    /***
+     * Test Scenario:   The application creates a queue with capacity less than 2
+     * Expected Output:	std::invalid_argument is thrown
+     **/
+
+    ASSERT_THROW(LockFreeQueue<uint_t> queue(1), std::invalid_argument);
+}
+
+TEST(TestLockFreeQueue, FifoAndFull) {
+
+    /***
+     * Test Scenario:   The application fills a queue with capacity 4 and then empties it
+     * Expected Output:	Pushing to the full queue fails and items are popped in FIFO order
+     **/
+
+    LockFreeQueue<uint_t> queue(3);
+    ASSERT_EQ(queue.capacity(), static_cast<uint_t>(4));
+
+    for(uint_t i=0; i<queue.capacity(); ++i){
+        ASSERT_TRUE(queue.try_push(i));
+    }
+
+    ASSERT_FALSE(queue.try_push(10));
+    ASSERT_EQ(queue.size(), static_cast<uint_t>(4));
+
+    for(uint_t i=0; i<4; ++i){
+        uint_t item = 100;
+        ASSERT_TRUE(queue.pop(item));
+        ASSERT_EQ(item, i);
+    }
+
+    uint_t item = 100;
+    ASSERT_FALSE(queue.pop(item));
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(TestLockFreeQueue, MultipleProducersConsumers) {
+
+    /***
+     * Test Scenario:   Four producers push 10000 items each whilst four consumers pop them
+     * Expected Output:	Every item is popped exactly once
+     **/
+
+    const uint_t n_threads = 4;
+    const uint_t n_items = 10000;
+
+    LockFreeQueue<uint_t> queue(64);
+    std::atomic<uint_t> sum(0);
+
+    std::vector<std::thread> threads;
+    for(uint_t t=0; t<n_threads; ++t){
+
+        threads.emplace_back([&queue](){
+            for(uint_t i=1; i<=n_items; ++i){
+                queue.push_item(i);
+            }
+        });
+
+        threads.emplace_back([&queue, &sum](){
+            for(uint_t i=0; i<n_items; ++i){
+                sum += queue.pop_wait();
+            }
+        });
+    }
+
+    for(auto& thread : threads){
+        thread.join();
+    }
+
+    ASSERT_EQ(sum.load(), n_threads*n_items*(n_items + 1)/2);
+    ASSERT_TRUE(queue.empty());
+}
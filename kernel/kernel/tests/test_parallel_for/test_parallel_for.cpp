@@ -1,15 +1,18 @@
 #include "kernel/base/config.h"
 #include "kernel/parallel/parallel_algos/parallel_for.h"
+#include "kernel/parallel/parallel_algos/parallel_plan.h"
 #include "kernel/parallel/threading/thread_pool.h"
 #include "kernel/utilities/range_1d.h"
 #include "kernel/parallel/utilities/partitioned_type.h"
 #include "kernel/parallel/utilities/array_partitioner.h"
 #include "kernel/parallel/utilities/result_holder.h"
+#include "kernel/parallel/utilities/first_touch.h"
 #include "kernel/base/types.h"
 #include "kernel/base/exceptions.h"
 
 
 
+#include <thread>
 #include <vector>
 #include <gtest/gtest.h>
 
@@ -147,3 +150,169 @@ TEST(TestParallelFor, RunWithIdentityBody) {
 
 
 
+/***
+ * Test Scenario:   The application creates a ParallelForPlan and executes it three times
+ * Expected Output:	The plan reuses its tasks and the body is applied three times on every item
+ **/
+
+TEST(TestParallelFor, ReuseParallelForPlan) {
+
+    using kernel::uint_t;
+    using kernel::ThreadPool;
+    using kernel::range1d;
+    using kernel::PartitionedType;
+    using kernel::ResultHolder;
+
+    ThreadPool pool(4);
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_range(0, 100, partitions, pool.get_n_threads());
+
+    PartitionedType<std::vector<uint_t>> vector(100, 0);
+    vector.set_partitions(partitions);
+
+    auto body = [](uint_t& item){item += 1;};
+    kernel::ParallelForPlan<PartitionedType<std::vector<uint_t>>, decltype(body), ThreadPool> plan(vector, body, pool);
+
+    ASSERT_EQ(plan.n_tasks(), pool.get_n_threads());
+
+    for(uint_t itr=0; itr<3; ++itr){
+        ResultHolder<void> result = plan.execute(kernel::Null());
+        ASSERT_TRUE(result.is_result_valid());
+    }
+
+    for(auto item : vector){
+        ASSERT_EQ(item, static_cast<uint_t>(3));
+    }
+}
+
+
+/***
+ * Test Scenario:   The application executes parallel_for with a grain size. The range has no partitions
+ *                  and its size is not a multiple of the grain size
+ * Expected Output:	The range is split automatically and the body is applied exactly once on every item
+ **/
+
+TEST(TestParallelFor, RunWithGrainSize) {
+
+    using kernel::uint_t;
+    using kernel::ThreadPool;
+    using kernel::PartitionedType;
+    using kernel::ResultHolder;
+
+    ThreadPool pool(4);
+
+    PartitionedType<std::vector<uint_t>> vector(1003, 0);
+
+    auto body = [](uint_t& item){item += 1;};
+
+    // explicit grain size and automatic grain size
+    for(uint_t grain : {uint_t(10), uint_t(0)}){
+
+        ResultHolder<void> result = kernel::parallel_for(vector, body, pool, kernel::Null(), grain);
+        ASSERT_TRUE(result.is_result_valid());
+    }
+
+    for(auto item : vector){
+        ASSERT_EQ(item, static_cast<uint_t>(2));
+    }
+}
+
+
+/***
+ * Test Scenario:   The application allocates a vector with default_init_allocator and
+ *                  initializes it with first_touch using a pinned pool
+ * Expected Output:	Every element is set to the given value
+ **/
+
+TEST(TestParallelFor, FirstTouchInitialization) {
+
+    using kernel::uint_t;
+    using kernel::real_t;
+    using kernel::ThreadPool;
+    using kernel::range1d;
+    using kernel::PartitionedType;
+    using kernel::ResultHolder;
+
+    kernel::ThreadPoolOptions options;
+    options.n_threads = 4;
+    options.affinity = kernel::AffinityType::COMPACT;
+
+    ThreadPool pool(options);
+
+    PartitionedType<std::vector<real_t, kernel::default_init_allocator<real_t>>> vector(1000);
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_range(0, vector.size(), partitions, pool.get_n_threads());
+    vector.set_partitions(partitions);
+
+    ResultHolder<void> result = kernel::first_touch(vector, 2.0, pool, kernel::Null());
+    ASSERT_TRUE(result.is_result_valid());
+
+    for(auto item : vector){
+        ASSERT_EQ(item, 2.0);
+    }
+}
+
+
+/***
+ * Test Scenario:   The application records the thread that writes every element in
+ *                  first_touch and again in a later parallel_for with the same partitions.
+ *                  Batches of other sizes are executed before and in between
+ * Expected Output:	Every element is written by the same thread both times and every
+ *                  partition is written by a single thread
+ **/
+
+TEST(TestParallelFor, FirstTouchOwnerMatchesParallelFor) {
+
+    using kernel::uint_t;
+    using kernel::ThreadPool;
+    using kernel::range1d;
+    using kernel::PartitionedType;
+    using kernel::ResultHolder;
+
+    kernel::ThreadPoolOptions options;
+    options.n_threads = 4;
+    options.affinity = kernel::AffinityType::COMPACT;
+
+    ThreadPool pool(options);
+
+    // batches with fewer tasks than workers
+    PartitionedType<std::vector<uint_t>> other(3, 0);
+    auto increment = [](uint_t& item){item += 1;};
+
+    ASSERT_TRUE(kernel::parallel_for(other, increment, pool, kernel::Null(), 1).is_result_valid());
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_range(0, 1000, partitions, pool.get_n_threads());
+
+    PartitionedType<std::vector<std::thread::id>> first(1000);
+    first.set_partitions(partitions);
+
+    PartitionedType<std::vector<std::thread::id>> later(1000);
+    later.set_partitions(partitions);
+
+    auto record = [](std::thread::id& item){item = std::this_thread::get_id();};
+
+    ResultHolder<void> result = kernel::first_touch(first, record, pool, kernel::Null());
+    ASSERT_TRUE(result.is_result_valid());
+
+    ASSERT_TRUE(kernel::parallel_for(other, increment, pool, kernel::Null(), 1).is_result_valid());
+
+    result = kernel::parallel_for(later, record, pool, kernel::Null());
+    ASSERT_TRUE(result.is_result_valid());
+
+    for(uint_t i=0; i<first.size(); ++i){
+        ASSERT_EQ(first[i], later[i]);
+    }
+
+    for(uint_t p=0; p<partitions.size(); ++p){
+        for(uint_t i=partitions[p].begin(); i<partitions[p].end(); ++i){
+            ASSERT_EQ(first[i], first[partitions[p].begin()]);
+        }
+
+        for(uint_t q=0; q<p; ++q){
+            ASSERT_NE(first[partitions[p].begin()], first[partitions[q].begin()]);
+        }
+    }
+}
@@ -13,6 +13,7 @@
 #include "kernel/base/exceptions.h"
 
 #include <vector>
+#include <memory>
 #include <gtest/gtest.h>
 
 namespace{
@@ -163,6 +164,79 @@ TEST(TestParallelFor, RunWithIdentityBody) {
 }
 
 
+/***
+ * Test Scenario:   The application executes a list of tasks with every OMPOptions::ScheduleType
+ *                  and a non-zero chunk size
+ * Expected Output:	All tasks are executed and the runtime schedule is restored afterwards
+ **/
+
+TEST(TestParallelFor, ExecuteWithAllScheduleTypes) {
+
+    using kernel::uint_t;
+    using kernel::OMPExecutor;
+    using kernel::OMPOptions;
+
+    OMPExecutor pool(4);
+
+    omp_sched_t kind_before;
+    int chunk_before;
+    omp_get_schedule(&kind_before, &chunk_before);
+
+    std::vector<OMPOptions::ScheduleType> types = {OMPOptions::ScheduleType::STATIC,
+                                                   OMPOptions::ScheduleType::DYNAMIC,
+                                                   OMPOptions::ScheduleType::GUIDED,
+                                                   OMPOptions::ScheduleType::AUTO,
+                                                   OMPOptions::ScheduleType::RUNTIME,
+                                                   OMPOptions::ScheduleType::DEFAULT};
+
+    for(auto type : types){
+
+        std::vector<std::unique_ptr<DummyTestTask>> tasks;
+        for(uint_t t=0; t<50; ++t){
+            tasks.push_back(std::make_unique<DummyTestTask>());
+        }
+
+        pool.execute(tasks, OMPOptions(type, 3));
+
+        for(const auto& task : tasks){
+            ASSERT_TRUE(task->finished());
+        }
+
+        omp_sched_t kind_after;
+        int chunk_after;
+        omp_get_schedule(&kind_after, &chunk_after);
+        ASSERT_EQ(kind_before, kind_after);
+        ASSERT_EQ(chunk_before, chunk_after);
+    }
+}
+
+
+/***
+ * Test Scenario:   The application executes parallel_for with a grain size on an OMPExecutor
+ * Expected Output:	The body is applied exactly once on every item
+ **/
+
+TEST(TestParallelFor, RunWithGrainSize) {
+
+    using kernel::uint_t;
+    using kernel::OMPExecutor;
+    using kernel::PartitionedType;
+    using kernel::ResultHolder;
+
+    OMPExecutor pool(4);
+
+    PartitionedType<std::vector<uint_t>> vector(1003, 0);
+
+    auto body = [](uint_t& item){item += 1;};
+    ResultHolder<void> result = kernel::parallel_for(vector, body, pool, kernel::OMPOptions(), 7);
+    ASSERT_TRUE(result.is_result_valid());
+
+    for(auto item : vector){
+        ASSERT_EQ(item, static_cast<uint_t>(1));
+    }
+}
+
+
 #endif
 
 
@@ -1,13 +1,20 @@
 #include "kernel/parallel/parallel_algos/parallel_reduce.h"
+#include "kernel/parallel/parallel_algos/parallel_plan.h"
 #include "kernel/parallel/threading/thread_pool.h"
 #include "kernel/parallel/utilities/partitioned_type.h"
 #include "kernel/parallel/utilities/array_partitioner.h"
 #include "kernel/parallel/utilities/result_holder.h"
 #include "kernel/parallel/utilities/identity_reduction.h"
+#include "kernel/parallel/utilities/reduction_operations.h"
 #include "kernel/utilities/range_1d.h"
 #include "kernel/base/types.h"
+#include "kernel/base/config.h"
 #include "kernel/base/exceptions.h"
 
+#ifdef USE_OPENMP
+#include "kernel/parallel/threading/openmp_executor.h"
+#endif
+
 #include <vector>
 #include <gtest/gtest.h>
 
@@ -93,45 +100,83 @@ TEST(TestParallelReduce, RunWithInvalidNumPartitions) {
 }
 
 /***
- * Test Scenario:   The application attempts to execute parallel_for with a  Range and a Body
- * Expected Output:	parallel_for should execute corrctly
+ * Test Scenario:   The application executes parallel_reduce with a Sum reduction on a partitioned array
+ * Expected Output:	parallel_reduce returns a valid result equal to the sum of the array for any number of threads
  **/
 
+TEST(TestParallelReduce, RunWithSumReduction) {
 
-TEST(TestParallelReduce, RunWithIdentityBody) {
-
-
-    /// TODO: Is there a better way to do this?
-    try{
+    for(uint_t n_threads=1; n_threads<=9; ++n_threads){
 
         // this is the executor
-        ThreadPool pool(4);
+        ThreadPool pool(n_threads);
 
         std::vector<range1d<uint_t>> partitions;
         kernel::partition_range(0, 100, partitions, pool.get_n_threads());
 
-        // a dummy partitoned ranges
         PartitionedType<std::vector<uint_t>> vector(100, 0);
+        for(uint_t i=0; i<vector.size(); ++i){
+            vector[i] = i;
+        }
+
         vector.set_partitions(partitions);
 
-        // dummy body
-        auto body = [](uint_t item){return item;};
-       /*ResultHolder<void> result = kernel::parallel_reduce(vector, body, pool);
-        ASSERT_TRUE(result.get().second);*/
+        kernel::Sum<uint_t> sum;
+        auto result = kernel::parallel_reduce(vector, sum, pool);
 
+        ASSERT_TRUE(result.is_result_valid());
+        ASSERT_EQ(result.get_resource(), static_cast<uint_t>(4950));
     }
-    catch(kernel::InvalidPartitionedObject& e){
-        std::string msg = e.what();
-        ASSERT_EQ(msg, "The given range does not have partitions");
-    }
-    catch(...){
+}
 
-        ASSERT_FALSE("A non expected exception was thrown");
-    }
+#ifdef USE_OPENMP
+
+/***
+ * Test Scenario:   The application executes parallel_reduce with a Sum reduction using OMPExecutor
+ * Expected Output:	parallel_reduce returns a valid result equal to the sum of the array
+ **/
+
+TEST(TestParallelReduce, RunWithSumReductionOMP) {
+
+    kernel::OMPExecutor executor(4);
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_range(0, 100, partitions, executor.get_n_threads());
+
+    PartitionedType<std::vector<uint_t>> vector(100, 1);
+    vector.set_partitions(partitions);
+
+    kernel::Sum<uint_t> sum;
+    auto result = kernel::parallel_reduce(vector, sum, executor);
+
+    ASSERT_TRUE(result.is_result_valid());
+    ASSERT_EQ(result.get_resource(), static_cast<uint_t>(100));
 }
 
+#endif
 
+/***
+ * Test Scenario:   The application creates a ReducePlan and executes it twice
+ * Expected Output:	Every execution computes the sum of the array
+ **/
+
+TEST(TestParallelReduce, ReuseReducePlan) {
+
+    ThreadPool pool(4);
 
+    std::vector<uint_t> values(100, 1);
 
+    std::vector<range1d<std::vector<uint_t>::const_iterator>> partitions;
+    kernel::partition_range(values.cbegin(), values.cend(), partitions, pool.get_n_threads());
 
+    kernel::ReducePlan<std::vector<uint_t>::const_iterator, kernel::Sum<uint_t>, ThreadPool> plan(partitions, pool);
 
+    for(uint_t itr=0; itr<2; ++itr){
+
+        kernel::Sum<uint_t> sum(0, false);
+        plan.execute(sum, kernel::Null());
+
+        ASSERT_TRUE(sum.is_result_valid());
+        ASSERT_EQ(sum.get_resource(), static_cast<uint_t>(100));
+    }
+}
@@ -0,0 +1,82 @@
+#include "kernel/parallel/utilities/result_holder.h"
+#include "kernel/base/types.h"
+
+#include <thread>
+#include <chrono>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::ResultHolder;
+
+}
+
+TEST(TestResultHolder, GetOrWaitOnValidResult) {
+
+    /***
+     * Test Scenario:   The application calls get_or_wait() on a result that is already valid
+     * Expected Output:	get_or_wait() returns immediately with the held value
+     **/
+
+    ResultHolder<real_t> result(2.0, true);
+    auto value = result.get_or_wait();
+
+    ASSERT_TRUE(value.second);
+    ASSERT_DOUBLE_EQ(*value.first, 2.0);
+}
+
+TEST(TestResultHolder, GetOrWaitWakesOnValidate) {
+
+    /***
+     * Test Scenario:   A thread blocks in get_or_wait() with and without a spin phase
+     *                  whilst another thread computes and validates the result
+     * Expected Output:	The waiting thread is woken up and sees the computed value
+     **/
+
+    for(uint_t n_spins : {0, 64}){
+
+        ResultHolder<real_t> result;
+
+        std::thread worker([&result]{
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            result.get_resource() = 5.0;
+            result.validate_result();
+        });
+
+        auto value = result.get_or_wait(n_spins);
+        worker.join();
+
+        ASSERT_TRUE(value.second);
+        ASSERT_DOUBLE_EQ(*value.first, 5.0);
+    }
+}
+
+TEST(TestResultHolder, GetOrWaitForReturnsOnValidate) {
+
+    /***
+     * Test Scenario:   A thread waits with a long timeout whilst another thread validates
+     *                  the result. The result is then invalidated and waited on with a short timeout
+     * Expected Output:	The first wait returns a valid result before the timeout.
+     *                  The second wait times out and returns an invalid result
+     **/
+
+    ResultHolder<void> result;
+
+    std::thread worker([&result]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        result.validate_result();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    auto value = result.get_or_wait_for(10000);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    worker.join();
+
+    ASSERT_TRUE(value.second);
+    ASSERT_LT(elapsed, std::chrono::seconds(5));
+
+    result.invalidate_result();
+    ASSERT_FALSE(result.get_or_wait_for(10).second);
+}
@@ -0,0 +1,241 @@
+#include "kernel/parallel/threading/task_graph.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/threading/simple_task.h"
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+
+/// Task that records the order in which it was executed
+class OrderTask: public kernel::SimpleTaskBase<kernel::Null>
+{
+public:
+
+    OrderTask(std::atomic<uint_t>& counter, bool fail=false)
+        :
+        kernel::SimpleTaskBase<kernel::Null>(),
+        counter_(counter),
+        fail_(fail),
+        order_(0)
+    {}
+
+    uint_t order()const{return order_;}
+
+protected:
+
+    virtual void run()override final{
+
+        order_ = counter_.fetch_add(1) + 1;
+
+        if(fail_){
+            throw std::runtime_error("OrderTask failed");
+        }
+    }
+
+private:
+
+    std::atomic<uint_t>& counter_;
+    bool fail_;
+    uint_t order_;
+};
+
+}
+
+
+TEST(TestTaskGraph, AddDependencyOnTaskNotInGraph) {
+
+    /***
+     * Test Scenario:   The application adds a dependency between tasks that are not in the graph
+     * Expected Output:	kernel throws a std::invalid_argument exception
+     **/
+
+    std::atomic<uint_t> counter(0);
+    OrderTask t1(counter);
+    OrderTask t2(counter);
+
+    kernel::TaskGraph graph;
+    graph.add_task(t1);
+
+    ASSERT_THROW(graph.add_dependency(t1, t2), std::invalid_argument);
+}
+
+
+TEST(TestTaskGraph, ExecuteGraphWithCycle) {
+
+    /***
+     * Test Scenario:   The application executes a graph with a cycle
+     * Expected Output:	kernel throws a std::logic_error exception
+     **/
+
+    std::atomic<uint_t> counter(0);
+    OrderTask t1(counter);
+    OrderTask t2(counter);
+
+    kernel::TaskGraph graph;
+    graph.add_task(t1);
+    graph.add_task(t2);
+    graph.add_dependency(t1, t2);
+    graph.add_dependency(t2, t1);
+
+    kernel::ThreadPool pool(2);
+    ASSERT_THROW(graph.execute(pool), std::logic_error);
+}
+
+
+TEST(TestTaskGraph, ExecuteDiamondGraph) {
+
+    /***
+     * Test Scenario:   The application executes a pipeline with a fan out and a fan in
+     *                  i.e. a -> {b_0,...,b_7} -> c -> d repeatedly
+     * Expected Output:	Every task is executed after all of its parents
+     **/
+
+    std::atomic<uint_t> counter(0);
+
+    OrderTask a(counter);
+    std::vector<std::unique_ptr<OrderTask>> bs;
+    OrderTask c(counter);
+    OrderTask d(counter);
+
+    kernel::TaskGraph graph;
+    graph.add_task(a);
+    graph.add_task(c);
+    graph.add_task(d);
+
+    for(uint_t b=0; b<8; ++b){
+        bs.push_back(std::make_unique<OrderTask>(counter));
+        graph.add_task(*bs.back());
+        graph.add_dependency(a, *bs.back());
+        graph.add_dependency(*bs.back(), c);
+    }
+
+    graph.add_dependency(c, d);
+
+    ASSERT_EQ(graph.n_tasks(), static_cast<uint_t>(11));
+    ASSERT_EQ(graph.get_roots().size(), static_cast<std::size_t>(1));
+    ASSERT_EQ(graph.n_parents(c), static_cast<uint_t>(8));
+
+    kernel::ThreadPoolOptions options;
+    options.n_threads = 4;
+    options.schedule = kernel::ThreadPoolOptions::ScheduleType::WORK_STEALING;
+    kernel::ThreadPool pool(options);
+
+    for(uint_t itr=0; itr<10; ++itr){
+
+        a.reschedule();
+        c.reschedule();
+        d.reschedule();
+        for(auto& b : bs){
+            b->reschedule();
+        }
+
+        graph.execute(pool);
+
+        ASSERT_TRUE(graph.tasks_finished());
+
+        for(auto& b : bs){
+            ASSERT_EQ(b->get_state(), kernel::TaskBase::TaskState::FINISHED);
+            ASSERT_LT(a.order(), b->order());
+            ASSERT_LT(b->order(), c.order());
+        }
+
+        ASSERT_LT(c.order(), d.order());
+    }
+}
+
+
+TEST(TestTaskGraph, FailedTaskStopsDescendants) {
+
+    /***
+     * Test Scenario:   The application executes a chain a -> b -> c where b fails
+     *                  and an independent task e
+     * Expected Output:	c is not run and its state is STOPPED. a and e finish
+     **/
+
+    std::atomic<uint_t> counter(0);
+    OrderTask a(counter);
+    OrderTask b(counter, true);
+    OrderTask c(counter);
+    OrderTask e(counter);
+
+    kernel::TaskGraph graph;
+    graph.add_task(a);
+    graph.add_task(b);
+    graph.add_task(c);
+    graph.add_task(e);
+    graph.add_dependency(a, b);
+    graph.add_dependency(b, c);
+
+    kernel::ThreadPool pool(2);
+    graph.execute(pool);
+
+    ASSERT_EQ(a.get_state(), kernel::TaskBase::TaskState::FINISHED);
+    ASSERT_EQ(b.get_state(), kernel::TaskBase::TaskState::INTERRUPTED);
+    ASSERT_EQ(c.get_state(), kernel::TaskBase::TaskState::STOPPED);
+    ASSERT_EQ(c.order(), static_cast<uint_t>(0));
+    ASSERT_EQ(e.get_state(), kernel::TaskBase::TaskState::FINISHED);
+}
+
+
+TEST(TestTaskGraph, TasksRunOutsideTheGraph) {
+
+    /***
+     * Test Scenario:   The application executes a chain a -> b with a graph, then runs the
+     *                  tasks directly with the pool and finally in another graph as b -> a
+     * Expected Output:	The direct execution runs both tasks and ignores the dependencies
+     *                  of the first graph. The second graph runs b before a
+     **/
+
+    std::atomic<uint_t> counter(0);
+    OrderTask a(counter);
+    OrderTask b(counter);
+
+    kernel::ThreadPool pool(2);
+
+    {
+        kernel::TaskGraph graph;
+        graph.add_task(a);
+        graph.add_task(b);
+        graph.add_dependency(a, b);
+        graph.execute(pool);
+
+        ASSERT_LT(a.order(), b.order());
+    }
+
+    a.reschedule();
+    b.reschedule();
+
+    pool.add_task(a);
+    pool.add_task(b);
+
+    while(!a.finished() || !b.finished()){
+        std::this_thread::yield();
+    }
+
+    ASSERT_EQ(a.get_state(), kernel::TaskBase::TaskState::FINISHED);
+    ASSERT_EQ(b.get_state(), kernel::TaskBase::TaskState::FINISHED);
+
+    a.reschedule();
+    b.reschedule();
+
+    kernel::TaskGraph reversed;
+    reversed.add_task(a);
+    reversed.add_task(b);
+    reversed.add_dependency(b, a);
+
+    ASSERT_EQ(reversed.n_parents(a), static_cast<uint_t>(1));
+    ASSERT_EQ(reversed.n_parents(b), static_cast<uint_t>(0));
+
+    reversed.execute(pool);
+
+    ASSERT_TRUE(reversed.tasks_finished());
+    ASSERT_LT(b.order(), a.order());
+}
@@ -0,0 +1,87 @@
+#include "kernel/parallel/data_structs/task_queue.h"
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::TaskQueue;
+
+}
+
+TEST(TestTaskQueue, FifoAcrossWrapAround) {
+
+    /***
+     * Test Scenario:   The application repeatedly pushes and pops batches so that the
+     *                  ring buffer wraps around and grows whilst it is not empty
+     * Expected Output:	Tasks are popped in FIFO order and the queue ends up empty
+     **/
+
+    std::vector<uint_t> items(100);
+    for(uint_t i=0; i<items.size(); ++i){
+        items[i] = i;
+    }
+
+    TaskQueue<uint_t> queue;
+
+    uint_t next_push = 0;
+    uint_t next_pop = 0;
+
+    for(uint_t batch : {10, 7, 30, 3, 50}){
+
+        for(uint_t i=0; i<batch; ++i){
+            queue.push_task(items[next_push++]);
+        }
+
+        // leave a few tasks in the queue so that
+        // the next batch wraps around or grows the buffer
+        while(queue.size() > 2){
+
+            uint_t* item = queue.pop();
+            ASSERT_TRUE(item != nullptr);
+            ASSERT_EQ(*item, next_pop++);
+        }
+    }
+
+    uint_t* item = nullptr;
+    while(queue.pop(item)){
+        ASSERT_EQ(*item, next_pop++);
+    }
+
+    ASSERT_EQ(next_pop, next_push);
+    ASSERT_TRUE(queue.empty());
+    ASSERT_TRUE(queue.pop() == nullptr);
+}
+
+TEST(TestTaskQueue, StealFromTheBack) {
+
+    /***
+     * Test Scenario:   The application pushes tasks and then steals and pops them
+     * Expected Output:	steal returns the most recent task and pop the oldest one
+     **/
+
+    std::vector<uint_t> items = {0, 1, 2, 3};
+    std::vector<uint_t*> tasks = {&items[0], &items[1], &items[2], &items[3]};
+
+    TaskQueue<uint_t> queue;
+    queue.push_tasks(tasks.begin(), tasks.end());
+    ASSERT_EQ(queue.size(), static_cast<uint_t>(4));
+
+    uint_t* item = nullptr;
+    ASSERT_TRUE(queue.steal(item));
+    ASSERT_EQ(*item, static_cast<uint_t>(3));
+
+    ASSERT_TRUE(queue.pop(item));
+    ASSERT_EQ(*item, static_cast<uint_t>(0));
+
+    ASSERT_TRUE(queue.steal(item));
+    ASSERT_EQ(*item, static_cast<uint_t>(2));
+
+    ASSERT_TRUE(queue.pop(item));
+    ASSERT_EQ(*item, static_cast<uint_t>(1));
+
+    ASSERT_FALSE(queue.steal(item));
+    ASSERT_FALSE(queue.pop(item));
+}
@@ -1,10 +1,74 @@
 #include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/threading/simple_task.h"
 #include "kernel/base/types.h"
 #include <vector>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
 #include <gtest/gtest.h>
 
 namespace{
 
+using kernel::uint_t;
+
+/// Task that waits until the given flag is raised
+/// or the timeout expires
+class WaitTask: public kernel::SimpleTaskBase<kernel::Null>
+{
+public:
+
+    WaitTask(const std::atomic<bool>& flag, bool& flag_seen)
+        :
+        kernel::SimpleTaskBase<kernel::Null>(),
+        flag_(flag),
+        flag_seen_(flag_seen)
+    {}
+
+protected:
+
+    virtual void run()override final{
+
+        auto start = std::chrono::steady_clock::now();
+        while(!flag_.load()){
+
+            if(std::chrono::steady_clock::now() - start > std::chrono::seconds(2)){
+                return;
+            }
+
+            std::this_thread::yield();
+        }
+
+        flag_seen_ = true;
+    }
+
+private:
+
+    const std::atomic<bool>& flag_;
+    bool& flag_seen_;
+};
+
+/// Task that raises the given flag
+class RaiseTask: public kernel::SimpleTaskBase<kernel::Null>
+{
+public:
+
+    RaiseTask(std::atomic<bool>& flag)
+        :
+        kernel::SimpleTaskBase<kernel::Null>(),
+        flag_(flag)
+    {}
+
+protected:
+
+    virtual void run()override final{flag_.store(true);}
+
+private:
+
+    std::atomic<bool>& flag_;
+};
+
 }
 
 TEST(TestThreadPool, InitializeThreadPoolWithZeroNumberOfThreads) {
@@ -25,5 +89,144 @@ TEST(TestThreadPool, InitializeThreadPoolWithZeroNumberOfThreads) {
 }
 
 
+TEST(TestThreadPool, InitializeThreadPoolWithNumberOfThreads) {
+
+    /***
+     * Test Scenario:   The application launches a thread pool using n_threads = 3
+     * Expected Output:	The pool uses 3 threads
+     **/
+
+    kernel::ThreadPool pool(3);
+    ASSERT_EQ(pool.get_n_threads(), static_cast<uint_t>(3));
+    ASSERT_EQ(pool.schedule_type(), kernel::ThreadPoolOptions::ScheduleType::ROUND_ROBIN);
+}
+
+
+TEST(TestThreadPool, WorkStealingRunsTasksQueuedBehindSlowTask) {
+
+    /***
+     * Test Scenario:   The application launches a work stealing thread pool with two threads.
+     *                  The first task blocks until the third task runs. With round robin dispatch
+     *                  both are queued on the same worker
+     * Expected Output:	The idle worker steals the third task and the first task sees the flag raised
+     **/
+
+    kernel::ThreadPoolOptions options;
+    options.n_threads = 2;
+    options.schedule = kernel::ThreadPoolOptions::ScheduleType::WORK_STEALING;
+
+    kernel::ThreadPool pool(options);
+
+    std::atomic<bool> flag(false);
+    std::atomic<bool> dummy_flag(false);
+    bool flag_seen = false;
+
+    std::vector<std::unique_ptr<kernel::SimpleTaskBase<kernel::Null>>> tasks;
+    tasks.push_back(std::make_unique<WaitTask>(flag, flag_seen));
+
+    // this one is dispatched to the second worker
+    tasks.push_back(std::make_unique<RaiseTask>(dummy_flag));
+
+    // this one is queued behind the first task
+    tasks.push_back(std::make_unique<RaiseTask>(flag));
+
+    pool.execute(tasks, kernel::Null());
+
+    ASSERT_TRUE(flag_seen);
+    for(const auto& task : tasks){
+        ASSERT_EQ(task->get_state(), kernel::TaskBase::TaskState::FINISHED);
+    }
+}
 
 
+TEST(TestThreadPool, LockFreeQueueExecutesAllTasks) {
+
+    /***
+     * Test Scenario:   The application launches a thread pool that uses lock-free queues with
+     *                  a small capacity and submits more tasks than the queues can hold
+     * Expected Output:	All tasks are executed
+     **/
+
+    kernel::ThreadPoolOptions options;
+    options.n_threads = 2;
+    options.queue = kernel::ThreadPoolOptions::QueueType::LOCK_FREE;
+    options.lock_free_queue_capacity = 2;
+
+    kernel::ThreadPool pool(options);
+
+    std::vector<std::atomic<bool>> flags(20);
+    std::vector<std::unique_ptr<kernel::SimpleTaskBase<kernel::Null>>> tasks;
+
+    for(auto& flag : flags){
+        flag.store(false);
+        tasks.push_back(std::make_unique<RaiseTask>(flag));
+    }
+
+    pool.execute(tasks, kernel::Null());
+
+    for(const auto& flag : flags){
+        ASSERT_TRUE(flag.load());
+    }
+}
+
+
+TEST(TestThreadPool, ExplicitAffinityWithEmptyCpuList) {
+
+    /***
+     * Test Scenario:   The application launches a thread pool with AffinityType::EXPLICIT
+     *                  but does not give any CPU
+     * Expected Output:	kernel throws a std::invalid_argument exception
+     **/
+
+    kernel::ThreadPoolOptions options;
+    options.n_threads = 2;
+    options.affinity = kernel::AffinityType::EXPLICIT;
+
+    ASSERT_THROW(kernel::ThreadPool pool(options), std::invalid_argument);
+}
+
+
+TEST(TestThreadPool, PinThreadsWithAffinityPolicies) {
+
+    /***
+     * Test Scenario:   The application launches thread pools using the COMPACT, SCATTER
+     *                  and EXPLICIT affinity policies and executes tasks
+     * Expected Output:	Every worker is assigned one of the available CPUs and all tasks are executed
+     **/
+
+    const std::vector<uint_t> cpus = kernel::detail::available_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    for(auto type : {kernel::AffinityType::COMPACT, kernel::AffinityType::SCATTER, kernel::AffinityType::EXPLICIT}){
+
+        kernel::ThreadPoolOptions options;
+        options.n_threads = 3;
+        options.affinity = type;
+        options.cpu_list = {cpus.back()};
+
+        kernel::ThreadPool pool(options);
+
+        ASSERT_EQ(pool.cpu_assignment().size(), options.n_threads);
+        for(auto cpu : pool.cpu_assignment()){
+            ASSERT_TRUE(std::find(cpus.begin(), cpus.end(), cpu) != cpus.end());
+        }
+
+#ifdef __linux__
+        ASSERT_TRUE(pool.is_pinned());
+#endif
+
+        std::vector<std::atomic<bool>> flags(6);
+        std::vector<std::unique_ptr<kernel::SimpleTaskBase<kernel::Null>>> tasks;
+
+        for(auto& flag : flags){
+            flag.store(false);
+            tasks.push_back(std::make_unique<RaiseTask>(flag));
+        }
+
+        pool.execute(tasks, kernel::Null());
+
+        for(const auto& flag : flags){
+            ASSERT_TRUE(flag.load());
+        }
+    }
+}
@@ -79,8 +79,52 @@ TEST(TrilinosEpetraMatrix, ComputeTranspose) {
 #endif
 }
 
+TEST(TrilinosEpetraMatrix, InitWithSparsityPattern) {
 
+#ifdef USE_TRILINOS
+
+    /// Test Scenario:   Initialize a tridiagonal matrix from a CSR pattern, set and add
+    ///                  entries, zero it and set the entries again
+    /// Expected Output: The matrix is filled after init, the values are overwritten
+    ///                  in place and zero() keeps the pattern
+
+    using kernel::numerics::TrilinosEpetraMatrix;
+    using kernel::uint_t;
+    using kernel::real_t;
+
+    const std::vector<uint_t> row_offsets = {0, 2, 5, 7};
+    const std::vector<uint_t> columns = {0, 1, 0, 1, 2, 1, 2};
+
+    TrilinosEpetraMatrix matrix;
+    matrix.init(row_offsets, columns);
 
+    ASSERT_TRUE(matrix.is_filled());
+    ASSERT_EQ(matrix.m(), 3);
 
+    for(uint_t step=0; step<2; ++step){
 
+        matrix.zero();
 
+        for(uint_t r=0; r<3; ++r){
+
+            matrix.set_entry(r, r, 2.0);
+
+            if(r > 0){
+                matrix.set_entry(r, r - 1, -1.0);
+            }
+
+            if(r < 2){
+                matrix.set_entry(r, r + 1, -1.0);
+            }
+        }
+
+        matrix.add_entry(0, 0, 1.0);
+
+        ASSERT_DOUBLE_EQ(matrix.entry(0, 0), 3.0);
+        ASSERT_DOUBLE_EQ(matrix.entry(1, 1), 2.0);
+        ASSERT_DOUBLE_EQ(matrix.entry(1, 2), -1.0);
+        ASSERT_DOUBLE_EQ(matrix.entry(0, 2), 0.0);
+    }
+
+#endif
+}
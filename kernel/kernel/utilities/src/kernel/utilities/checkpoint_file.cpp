@@ -0,0 +1,403 @@
+#include "kernel/utilities/checkpoint_file.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace kernel
+{
+
+namespace{
+
+/// \brief The magic bytes every checkpoint starts with
+const char CHECKPOINT_MAGIC[8] = {'C', 'E', 'C', 'K', 'P', 'T', '\0', '\0'};
+
+/// \brief The version of the format
+const std::uint64_t CHECKPOINT_VERSION = 1;
+
+/// \brief Written in the byte order of the machine
+/// to detect files from a different byte order
+const std::uint64_t CHECKPOINT_BYTE_ORDER = 0x0102030405060708ULL;
+
+/// \brief The alignment of the section data
+const std::uint64_t CHECKPOINT_ALIGNMENT = 64;
+
+/// \brief Flush the data of the file or directory to the storage device.
+/// Directories on file systems that cannot sync them are skipped
+void
+sync_to_disk(const std::string& name, bool directory){
+
+    const int fd = ::open(name.c_str(), directory ? O_RDONLY | O_DIRECTORY : O_WRONLY);
+
+    if(fd == -1){
+        throw std::logic_error("Cannot open "+name+" for syncing: "+std::strerror(errno));
+    }
+
+    if(::fsync(fd) == -1 && !(directory && errno == EINVAL)){
+
+        const int error = errno;
+        ::close(fd);
+        throw std::logic_error("Cannot sync "+name+": "+std::strerror(error));
+    }
+
+    ::close(fd);
+}
+
+/// \brief Returns the directory the file is in
+std::string
+parent_directory(const std::string& file_name){
+
+    const auto pos = file_name.find_last_of('/');
+
+    if(pos == std::string::npos){
+        return ".";
+    }
+
+    return pos == 0 ? "/" : file_name.substr(0, pos);
+}
+
+struct FileHeader
+{
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t byte_order;
+    std::uint64_t n_sections;
+};
+
+struct SectionEntry
+{
+    char name[40];
+    std::uint32_t type;
+    std::uint32_t element_size;
+    std::uint64_t offset;
+    std::uint64_t count;
+};
+
+static_assert(sizeof(FileHeader) == 32, "Unexpected checkpoint header size");
+static_assert(sizeof(SectionEntry) == 64, "Unexpected checkpoint section entry size");
+
+std::uint64_t
+align(std::uint64_t offset){
+    return (offset + CHECKPOINT_ALIGNMENT - 1)/CHECKPOINT_ALIGNMENT*CHECKPOINT_ALIGNMENT;
+}
+
+uint_t
+element_size(CheckpointDataType type){
+    return type == CheckpointDataType::REAL ? sizeof(real_t) : sizeof(uint_t);
+}
+
+}
+
+void
+CheckpointWriter::check_name(const std::string& name)const{
+
+    if(name.empty() || name.size() > max_name_size()){
+        throw std::logic_error("Invalid checkpoint section name '"+name+"'. The name should have 1 to "+
+                               std::to_string(max_name_size())+" characters");
+    }
+
+    if(has_section(name)){
+        throw std::logic_error("Checkpoint section "+name+" already exists");
+    }
+}
+
+void
+CheckpointWriter::add_section(const std::string& name, const std::vector<real_t>& values){
+
+    check_name(name);
+    sections_.push_back({name, CheckpointDataType::REAL, values, {}});
+}
+
+void
+CheckpointWriter::add_section(const std::string& name, std::vector<real_t>&& values){
+
+    check_name(name);
+    sections_.push_back({name, CheckpointDataType::REAL, std::move(values), {}});
+}
+
+void
+CheckpointWriter::add_section(const std::string& name, const std::vector<uint_t>& values){
+
+    check_name(name);
+    sections_.push_back({name, CheckpointDataType::UINT, {}, values});
+}
+
+void
+CheckpointWriter::add_section(const std::string& name, std::vector<uint_t>&& values){
+
+    check_name(name);
+    sections_.push_back({name, CheckpointDataType::UINT, {}, std::move(values)});
+}
+
+void
+CheckpointWriter::add_value(const std::string& name, real_t value){
+    add_section(name, std::vector<real_t>(1, value));
+}
+
+bool
+CheckpointWriter::has_section(const std::string& name)const{
+
+    for(const auto& section : sections_){
+        if(section.name == name){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+CheckpointWriter::write(const std::string& file_name)const{
+
+    FileHeader header;
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.byte_order = CHECKPOINT_BYTE_ORDER;
+    header.n_sections = sections_.size();
+
+    std::vector<SectionEntry> entries(sections_.size());
+    std::uint64_t offset = sizeof(FileHeader) + sections_.size()*sizeof(SectionEntry);
+
+    for(uint_t s=0; s<sections_.size(); ++s){
+
+        const auto& section = sections_[s];
+        auto& entry = entries[s];
+
+        std::memset(entry.name, 0, sizeof(entry.name));
+        std::memcpy(entry.name, section.name.data(), section.name.size());
+        entry.type = static_cast<std::uint32_t>(section.type);
+        entry.element_size = static_cast<std::uint32_t>(element_size(section.type));
+        entry.count = section.type == CheckpointDataType::REAL ? section.reals.size() : section.uints.size();
+
+        offset = align(offset);
+        entry.offset = offset;
+        offset += entry.count*entry.element_size;
+    }
+
+    // write next to the final file and rename when done so that
+    // an interrupted write leaves the previous checkpoint intact
+    const std::string tmp_name = file_name + ".tmp";
+
+    {
+        std::ofstream out(tmp_name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+        if(!out.is_open()){
+            throw std::logic_error("File "+tmp_name+" is not open");
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()), entries.size()*sizeof(SectionEntry));
+
+        std::uint64_t position = sizeof(FileHeader) + entries.size()*sizeof(SectionEntry);
+        const char padding[CHECKPOINT_ALIGNMENT] = {};
+
+        for(uint_t s=0; s<sections_.size(); ++s){
+
+            out.write(padding, entries[s].offset - position);
+
+            const auto& section = sections_[s];
+            const uint_t n_bytes = entries[s].count*entries[s].element_size;
+
+            if(section.type == CheckpointDataType::REAL){
+                out.write(reinterpret_cast<const char*>(section.reals.data()), n_bytes);
+            }
+            else{
+                out.write(reinterpret_cast<const char*>(section.uints.data()), n_bytes);
+            }
+
+            position = entries[s].offset + n_bytes;
+        }
+
+        out.flush();
+
+        if(!out.good()){
+            throw std::logic_error("Failed to write checkpoint file "+tmp_name);
+        }
+    }
+
+    // the data must reach the disk before the rename does, otherwise
+    // a crash can leave the final name pointing to an empty file
+    sync_to_disk(tmp_name, false);
+
+    if(std::rename(tmp_name.c_str(), file_name.c_str()) != 0){
+        throw std::logic_error("Cannot rename "+tmp_name+" to "+file_name);
+    }
+
+    // the rename itself is only durable once the directory is synced
+    sync_to_disk(parent_directory(file_name), true);
+}
+
+CheckpointReader::CheckpointReader(const std::string& file_name)
+    :
+      file_(file_name),
+      sections_()
+{
+    if(file_.size() < sizeof(FileHeader)){
+        throw std::logic_error("File "+file_name+" is too small to be a checkpoint");
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+
+    if(std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0){
+        throw std::logic_error("File "+file_name+" is not a checkpoint");
+    }
+
+    if(header.version != CHECKPOINT_VERSION){
+        throw std::logic_error("Checkpoint "+file_name+" has version "+std::to_string(header.version)+
+                               " but version "+std::to_string(CHECKPOINT_VERSION)+" is expected");
+    }
+
+    if(header.byte_order != CHECKPOINT_BYTE_ORDER){
+        throw std::logic_error("Checkpoint "+file_name+" was written with a different byte order");
+    }
+
+    // compare by division so that a corrupt
+    // count cannot overflow the products below
+    const std::uint64_t file_size = file_.size();
+
+    if(header.n_sections > (file_size - sizeof(FileHeader))/sizeof(SectionEntry)){
+        throw std::logic_error("Checkpoint "+file_name+" is truncated");
+    }
+
+    for(uint_t s=0; s<header.n_sections; ++s){
+
+        SectionEntry entry;
+        std::memcpy(&entry, file_.data() + sizeof(FileHeader) + s*sizeof(SectionEntry), sizeof(entry));
+
+        const std::string name(entry.name, strnlen(entry.name, sizeof(entry.name)));
+
+        if(entry.type >= static_cast<std::uint32_t>(CheckpointDataType::INVALID_TYPE)){
+            throw std::logic_error("Checkpoint section "+name+" has an invalid type");
+        }
+
+        const auto type = static_cast<CheckpointDataType>(entry.type);
+
+        if(entry.element_size != element_size(type)){
+            throw std::logic_error("Checkpoint section "+name+" has values of "+std::to_string(entry.element_size)+
+                                   " bytes but this build uses "+std::to_string(element_size(type)));
+        }
+
+        if(entry.offset % CHECKPOINT_ALIGNMENT != 0 || entry.offset > file_size ||
+           entry.count > (file_size - entry.offset)/entry.element_size){
+            throw std::logic_error("Checkpoint section "+name+" is out of the file bounds");
+        }
+
+        sections_[name] = {type, entry.offset, entry.count};
+    }
+}
+
+bool
+CheckpointReader::has_section(const std::string& name)const{
+    return sections_.find(name) != sections_.end();
+}
+
+std::vector<std::string>
+CheckpointReader::section_names()const{
+
+    std::vector<std::string> names;
+    names.reserve(sections_.size());
+
+    for(const auto& section : sections_){
+        names.push_back(section.first);
+    }
+
+    return names;
+}
+
+CheckpointDataType
+CheckpointReader::section_type(const std::string& name)const{
+
+    auto itr = sections_.find(name);
+
+    if(itr == sections_.end()){
+        throw std::logic_error("Checkpoint section "+name+" does not exist");
+    }
+
+    return itr->second.type;
+}
+
+const CheckpointReader::SectionInfo&
+CheckpointReader::get_section(const std::string& name, CheckpointDataType type)const{
+
+    auto itr = sections_.find(name);
+
+    if(itr == sections_.end()){
+        throw std::logic_error("Checkpoint section "+name+" does not exist");
+    }
+
+    if(itr->second.type != type){
+        throw std::logic_error("Checkpoint section "+name+" has a different type");
+    }
+
+    return itr->second;
+}
+
+CheckpointView<real_t>
+CheckpointReader::get_real_section(const std::string& name)const{
+
+    const auto& section = get_section(name, CheckpointDataType::REAL);
+    return CheckpointView<real_t>(reinterpret_cast<const real_t*>(file_.data() + section.offset), section.count);
+}
+
+CheckpointView<uint_t>
+CheckpointReader::get_uint_section(const std::string& name)const{
+
+    const auto& section = get_section(name, CheckpointDataType::UINT);
+    return CheckpointView<uint_t>(reinterpret_cast<const uint_t*>(file_.data() + section.offset), section.count);
+}
+
+real_t
+CheckpointReader::get_value(const std::string& name)const{
+
+    auto values = get_real_section(name);
+
+    if(values.size() != 1){
+        throw std::logic_error("Checkpoint section "+name+" does not hold a single value");
+    }
+
+    return values[0];
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter(){
+
+    // the destructor should not throw. A failed write
+    // is reported by wait or the next write
+    if(pending_.valid()){
+        pending_.wait();
+    }
+}
+
+void
+AsyncCheckpointWriter::write(CheckpointWriter&& checkpoint, const std::string& file_name){
+
+    wait();
+
+    pending_ = std::async(std::launch::async,
+                          [checkpoint=std::move(checkpoint), file_name](){checkpoint.write(file_name);});
+}
+
+void
+AsyncCheckpointWriter::wait(){
+
+    if(pending_.valid()){
+        pending_.get();
+    }
+}
+
+bool
+AsyncCheckpointWriter::is_busy()const{
+
+    return pending_.valid() &&
+           pending_.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+}
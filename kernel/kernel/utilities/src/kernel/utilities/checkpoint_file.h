@@ -0,0 +1,210 @@
+#ifndef CHECKPOINT_FILE_H
+#define CHECKPOINT_FILE_H
+
+#include "kernel/base/types.h"
+#include "kernel/utilities/memory_mapped_file.h"
+
+#include <boost/noncopyable.hpp>
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace kernel
+{
+
+/// \brief The type of the values of a checkpoint section
+enum class CheckpointDataType{REAL=0, UINT=1, INVALID_TYPE};
+
+/// \brief Read-only view of the values of a checkpoint section.
+/// The view points into the mapped file and is valid for
+/// as long as the CheckpointReader that created it
+template<typename T>
+class CheckpointView
+{
+public:
+
+    typedef const T* const_iterator;
+
+    /// \brief Constructor
+    CheckpointView(const T* data, uint_t size)
+        :
+        data_(data),
+        size_(size)
+    {}
+
+    /// \brief Returns the first value
+    const T* data()const{return data_;}
+
+    /// \brief Returns the number of values
+    uint_t size()const{return size_;}
+
+    /// \brief Returns true if the section has no values
+    bool empty()const{return size_ == 0;}
+
+    /// \brief Access the i-th value
+    const T& operator[](uint_t i)const{return data_[i];}
+
+    /// \brief Iterators over the values
+    const_iterator begin()const{return data_;}
+    const_iterator end()const{return data_ + size_;}
+
+private:
+
+    const T* data_;
+    uint_t size_;
+};
+
+/// \brief Collects named arrays of values and writes them in one binary
+/// file. The file starts with a header and a table of the sections followed
+/// by the raw values of every section aligned to 64 bytes, so that
+/// CheckpointReader can use the values in place without parsing.
+/// The file is written next to its final name, synced to disk and renamed
+/// when complete so a crash while writing does not destroy an older checkpoint
+class CheckpointWriter
+{
+public:
+
+    /// \brief The maximum length of a section name
+    static uint_t max_name_size(){return 39;}
+
+    /// \brief Constructor
+    CheckpointWriter()=default;
+
+    /// \brief Add a section of real values. The values are copied
+    void add_section(const std::string& name, const std::vector<real_t>& values);
+
+    /// \brief Add a section of real values
+    void add_section(const std::string& name, std::vector<real_t>&& values);
+
+    /// \brief Add a section of integer values. The values are copied
+    void add_section(const std::string& name, const std::vector<uint_t>& values);
+
+    /// \brief Add a section of integer values
+    void add_section(const std::string& name, std::vector<uint_t>&& values);
+
+    /// \brief Add a section that holds a single real value
+    void add_value(const std::string& name, real_t value);
+
+    /// \brief Returns true if a section with the given name exists
+    bool has_section(const std::string& name)const;
+
+    /// \brief Returns the number of sections
+    uint_t n_sections()const{return sections_.size();}
+
+    /// \brief Write the sections into the given file.
+    /// Throws std::logic_error if the file cannot be written
+    void write(const std::string& file_name)const;
+
+private:
+
+    /// \brief A named array of values
+    struct Section
+    {
+        std::string name;
+        CheckpointDataType type;
+        std::vector<real_t> reals;
+        std::vector<uint_t> uints;
+    };
+
+    /// \brief The sections in the order they were added
+    std::vector<Section> sections_;
+
+    /// \brief Throws std::logic_error if the name is
+    /// too long or a section with this name exists
+    void check_name(const std::string& name)const;
+};
+
+/// \brief Reads a file written by CheckpointWriter. The file is memory mapped
+/// and the sections are returned as views into the mapping so loading a
+/// large checkpoint copies nothing until the values are actually used
+class CheckpointReader: private boost::noncopyable
+{
+public:
+
+    /// \brief Constructor. Maps the file and validates its header.
+    /// Throws std::logic_error if the file is not a valid checkpoint
+    /// or it was written on a machine with a different byte order or
+    /// different real_t/uint_t sizes
+    explicit CheckpointReader(const std::string& file_name);
+
+    /// \brief Returns true if a section with the given name exists
+    bool has_section(const std::string& name)const;
+
+    /// \brief Returns the number of sections
+    uint_t n_sections()const{return sections_.size();}
+
+    /// \brief Returns the names of the sections
+    std::vector<std::string> section_names()const;
+
+    /// \brief Returns the type of the given section
+    CheckpointDataType section_type(const std::string& name)const;
+
+    /// \brief Returns a view of the given section of real values.
+    /// Throws std::logic_error if the section does not exist or
+    /// it does not hold real values
+    CheckpointView<real_t> get_real_section(const std::string& name)const;
+
+    /// \brief Returns a view of the given section of integer values.
+    /// Throws std::logic_error if the section does not exist or
+    /// it does not hold integer values
+    CheckpointView<uint_t> get_uint_section(const std::string& name)const;
+
+    /// \brief Returns the value of a section written with add_value
+    real_t get_value(const std::string& name)const;
+
+private:
+
+    /// \brief Where a section is in the file
+    struct SectionInfo
+    {
+        CheckpointDataType type;
+        uint_t offset;
+        uint_t count;
+    };
+
+    /// \brief The mapped file
+    MemoryMappedFile file_;
+
+    /// \brief The sections of the file
+    std::map<std::string, SectionInfo> sections_;
+
+    /// \brief Returns the section with the given name and type
+    const SectionInfo& get_section(const std::string& name, CheckpointDataType type)const;
+};
+
+/// \brief Writes checkpoints in a background thread so that the I/O
+/// overlaps with the computation that follows. The CheckpointWriter is
+/// moved into the background write, so the caller can modify the data it
+/// was built from as soon as write returns. At most one write is in
+/// flight: write waits for the previous one to finish first
+class AsyncCheckpointWriter: private boost::noncopyable
+{
+public:
+
+    /// \brief Constructor
+    AsyncCheckpointWriter()=default;
+
+    /// \brief Destructor. Waits for the pending write
+    ~AsyncCheckpointWriter();
+
+    /// \brief Start writing the given checkpoint into the given file.
+    /// Rethrows the exception of the previous write if it failed
+    void write(CheckpointWriter&& checkpoint, const std::string& file_name);
+
+    /// \brief Wait for the pending write to finish. Rethrows
+    /// the exception of the write if it failed
+    void wait();
+
+    /// \brief Returns true if a write is in progress
+    bool is_busy()const;
+
+private:
+
+    /// \brief The pending write
+    std::future<void> pending_;
+};
+
+}
+
+#endif // CHECKPOINT_FILE_H
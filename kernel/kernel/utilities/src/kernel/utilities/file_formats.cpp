@@ -12,6 +12,10 @@ FileFormats::type_to_string(FileFormats::Type t){
          return "csv";
      case FileFormats::Type::VTK:
         return "vtk";
+     case FileFormats::Type::VTU:
+        return "vtu";
+     case FileFormats::Type::PVTU:
+        return "pvtu";
    }
 
    return "INVALID_TYPE";
@@ -0,0 +1,63 @@
+#include "kernel/utilities/memory_mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace kernel
+{
+
+MemoryMappedFile::MemoryMappedFile(const std::string& file_name)
+    :
+      file_name_(file_name),
+      data_(nullptr),
+      size_(0)
+{
+    const int fd = ::open(file_name_.c_str(), O_RDONLY);
+
+    if(fd == -1){
+        throw std::logic_error("Cannot open file "+file_name_+" for mapping: "+std::strerror(errno));
+    }
+
+    struct stat info;
+    if(::fstat(fd, &info) == -1){
+
+        const int error = errno;
+        ::close(fd);
+        throw std::logic_error("Cannot stat file "+file_name_+": "+std::strerror(error));
+    }
+
+    size_ = static_cast<uint_t>(info.st_size);
+
+    // mmap does not accept a zero length
+    if(size_ != 0){
+
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if(addr == MAP_FAILED){
+
+            const int error = errno;
+            ::close(fd);
+            throw std::logic_error("Cannot map file "+file_name_+": "+std::strerror(error));
+        }
+
+        data_ = static_cast<const char*>(addr);
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+MemoryMappedFile::~MemoryMappedFile(){
+
+    if(data_){
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef MEMORY_MAPPED_FILE_H
+#define MEMORY_MAPPED_FILE_H
+
+#include "kernel/base/types.h"
+
+#include <boost/noncopyable.hpp>
+#include <string>
+
+namespace kernel
+{
+
+/// \brief Maps a whole file read-only into memory. The pages are
+/// loaded lazily by the operating system when they are first accessed
+/// so opening a large file is cheap and only the parts that are read
+/// cost I/O. The mapping is released when the object is destroyed
+class MemoryMappedFile: private boost::noncopyable
+{
+public:
+
+    /// \brief Constructor. Maps the given file.
+    /// Throws std::logic_error if the file cannot be mapped
+    explicit MemoryMappedFile(const std::string& file_name);
+
+    /// \brief Destructor. Unmaps the file
+    ~MemoryMappedFile();
+
+    /// \brief Returns the mapped bytes
+    const char* data()const{return data_;}
+
+    /// \brief Returns the size of the file in bytes
+    uint_t size()const{return size_;}
+
+    /// \brief Returns the name of the mapped file
+    const std::string& get_filename()const{return file_name_;}
+
+private:
+
+    /// \brief The name of the mapped file
+    const std::string file_name_;
+
+    /// \brief The mapped bytes
+    const char* data_;
+
+    /// \brief The size of the file in bytes
+    uint_t size_;
+};
+
+}
+
+#endif // MEMORY_MAPPED_FILE_H
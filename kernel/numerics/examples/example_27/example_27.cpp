@@ -0,0 +1,162 @@
+#include "kernel/base/config.h"
+
+#if  defined(USE_TRILINOS) && defined(USE_FVM)
+
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/dof_manager.h"
+
+#include "kernel/numerics/scalar_variable.h"
+#include "kernel/numerics/fvm/fv_laplace_assemble_policy_threaded.h"
+#include "kernel/numerics/fvm/fv_threaded_assembly_types.h"
+#include "kernel/numerics/fvm/fv_grad_factory.h"
+#include "kernel/numerics/fvm/fv_grad_types.h"
+#include "kernel/numerics/scalar_dirichlet_bc_function.h"
+#include "kernel/maths/functions/numeric_scalar_function.h"
+#include "kernel/maths/trilinos_epetra_matrix.h"
+#include "kernel/maths/trilinos_epetra_vector.h"
+
+#include "kernel/parallel/utilities/linear_mesh_partitioner.h"
+#include "kernel/parallel/utilities/element_coloring.h"
+#include "kernel/parallel/threading/thread_pool.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+namespace example
+{
+using kernel::real_t;
+using kernel::uint_t;
+using kernel::numerics::Mesh;
+using kernel::GeomPoint;
+using kernel::numerics::FVLaplaceAssemblyPolicyThreaded;
+using kernel::numerics::FVThreadedAssemblyType;
+using kernel::numerics::ScalarDirichletBCFunc;
+using kernel::numerics::FVDoFManager;
+using kernel::numerics::ScalarVar;
+using kernel::numerics::TrilinosEpetraMatrix;
+using kernel::numerics::TrilinosEpetraVector;
+using kernel::ThreadPool;
+
+class RhsVals: public kernel::numerics::NumericScalarFunction<2>
+{
+public:
+
+    /// \brief Returns the value of the function
+    virtual real_t value(const GeomPoint<2>&  /*input*/)const override final{return 1.0;}
+};
+
+/// \brief Assemble the Laplace system on the given
+/// mesh and return the assembly time in seconds
+real_t assemble(Mesh<2>& mesh, const FVDoFManager<2>& dof_manager,
+                ThreadPool& executor, FVThreadedAssemblyType type){
+
+    ScalarDirichletBCFunc<2> bc_func(0.0, mesh.n_boundaries());
+    RhsVals rhs;
+
+    TrilinosEpetraMatrix matrix;
+    TrilinosEpetraVector x;
+    TrilinosEpetraVector b;
+
+    // the coloured assembly needs the pattern of the matrix
+    std::vector<uint_t> row_offsets;
+    std::vector<uint_t> columns;
+    dof_manager.sparsity_pattern(mesh, row_offsets, columns);
+
+    matrix.init(row_offsets, columns);
+    x.init(dof_manager.n_dofs(), false);
+    b.init(dof_manager.n_dofs(), false);
+
+    FVLaplaceAssemblyPolicyThreaded<2, ThreadPool> policy;
+
+    auto grad_builder = [](){
+        return kernel::numerics::FVGradFactory<2>::build(kernel::numerics::FVGradType::GAUSS);
+    };
+
+    policy.build_gradient(grad_builder);
+    policy.set_boundary_function(bc_func);
+    policy.set_rhs_function(rhs);
+    policy.set_dof_manager(dof_manager);
+    policy.set_mesh(mesh);
+    policy.set_executor(executor);
+    policy.set_assembly_type(type);
+
+    auto start = std::chrono::steady_clock::now();
+    policy.assemble(matrix, x, b);
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<real_t>(end - start).count();
+}
+
+}
+
+/// Scaling of the threaded FV Laplace assembly on structured quad
+/// meshes. Usage: example_27 [max cells per direction]. The default goes
+/// up to 4096x4096 i.e. about 16.8 million cells
+int main(int argc, char** argv){
+
+    using namespace example;
+
+    uint_t max_n = 4096;
+    if(argc > 1){
+        max_n = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    const std::vector<uint_t> n_threads = {1, 2, 4, 8, 16};
+
+    std::cout<<std::setw(10)<<"cells"<<std::setw(10)<<"threads"<<std::setw(10)<<"colours"
+             <<std::setw(16)<<"partitioned (s)"<<std::setw(14)<<"coloured (s)"<<std::endl;
+
+    try{
+
+        for(uint_t n = 256; n <= max_n; n *= 4){
+
+            Mesh<2> mesh;
+            kernel::numerics::build_quad_mesh(mesh, n, n, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+            FVDoFManager<2> dof_manager;
+            dof_manager.distribute_dofs(mesh, ScalarVar("U"));
+
+            const uint_t n_colors = kernel::numerics::ElementColoring<2>(mesh).n_colors();
+
+            for(auto threads : n_threads){
+
+                ThreadPool executor(threads);
+
+                // the partitioned assembly uses the pid of the elements
+                kernel::numerics::linear_mesh_partition(mesh, executor.n_processing_elements());
+
+                const real_t partitioned = assemble(mesh, dof_manager, executor, FVThreadedAssemblyType::PARTITIONED);
+                const real_t colored = assemble(mesh, dof_manager, executor, FVThreadedAssemblyType::COLORED);
+
+                std::cout<<std::setw(10)<<mesh.n_elements()<<std::setw(10)<<threads<<std::setw(10)<<n_colors
+                         <<std::setw(16)<<partitioned<<std::setw(14)<<colored<<std::endl;
+            }
+        }
+    }
+    catch(std::logic_error& error){
+
+        std::cerr<<error.what()<<std::endl;
+    }
+    catch(...){
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
+
+#else
+
+#include <iostream>
+int main(){
+    std::cout<<"This example requires Trilinos. Reconfigure kernellib such that it uses Trilinos"<<std::endl;
+    return 0;
+}
+#endif
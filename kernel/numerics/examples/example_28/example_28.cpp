@@ -0,0 +1,225 @@
+#include "kernel/base/config.h"
+
+#if  defined(USE_TRILINOS) && defined(USE_FVM)
+
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/dof_manager.h"
+
+#include "kernel/numerics/scalar_variable.h"
+#include "kernel/numerics/fvm/fv_laplace_assemble_policy.h"
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
+#include "kernel/numerics/fvm/fv_grad_factory.h"
+#include "kernel/numerics/fvm/fv_grad_types.h"
+#include "kernel/numerics/scalar_dirichlet_bc_function.h"
+#include "kernel/numerics/krylov_solvers/trilinos_krylov_solver.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_type.h"
+#include "kernel/numerics/krylov_solvers/preconditioner_type.h"
+#include "kernel/maths/functions/numeric_scalar_function.h"
+#include "kernel/maths/trilinos_epetra_matrix.h"
+#include "kernel/maths/trilinos_epetra_vector.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+namespace example
+{
+using kernel::real_t;
+using kernel::uint_t;
+using kernel::numerics::Mesh;
+using kernel::GeomPoint;
+using kernel::numerics::FVLaplaceAssemblyPolicy;
+using kernel::numerics::FVMatrixFreeOperator;
+using kernel::numerics::FVEpetraOperator;
+using kernel::numerics::FVFaceGeometryCache;
+using kernel::numerics::ScalarDirichletBCFunc;
+using kernel::numerics::FVDoFManager;
+using kernel::numerics::ScalarVar;
+using kernel::numerics::TrilinosEpetraMatrix;
+using kernel::numerics::TrilinosEpetraVector;
+using kernel::numerics::TrilinosKrylovSolver;
+using kernel::numerics::KrylovSolverData;
+
+class RhsVals: public kernel::numerics::NumericScalarFunction<2>
+{
+public:
+
+    /// \brief Returns the value of the function
+    virtual real_t value(const GeomPoint<2>&  /*input*/)const override final{return 1.0;}
+};
+
+/// \brief Timings and memory of one solve
+struct SolveResult
+{
+    real_t setup;
+    real_t solve;
+    uint_t iterations;
+    uint_t bytes;
+};
+
+KrylovSolverData
+solver_data(){
+
+    KrylovSolverData data;
+    data.n_iterations = 5000;
+    data.tolerance = 1.0e-8;
+    data.solver_type = kernel::numerics::KrylovSolverType::CG;
+    data.precondioner_type = kernel::numerics::PreconditionerType::NONE;
+    return data;
+}
+
+/// \brief Assemble the Laplace matrix and solve with CG
+SolveResult
+solve_assembled(const Mesh<2>& mesh, const FVFaceGeometryCache<2>& cache, const FVDoFManager<2>& dof_manager){
+
+    ScalarDirichletBCFunc<2> bc_func(0.0, mesh.n_boundaries());
+    RhsVals rhs;
+
+    TrilinosEpetraMatrix matrix;
+    TrilinosEpetraVector x;
+    TrilinosEpetraVector b;
+
+    auto start = std::chrono::steady_clock::now();
+
+    matrix.init(dof_manager.n_dofs(), dof_manager.n_dofs(), 5);
+    x.init(dof_manager.n_dofs(), false);
+    b.init(dof_manager.n_dofs(), false);
+
+    FVLaplaceAssemblyPolicy<2> policy;
+
+    auto grad_builder = [](){
+        return kernel::numerics::FVGradFactory<2>::build(kernel::numerics::FVGradType::GAUSS);
+    };
+
+    policy.build_gradient(grad_builder);
+    policy.set_boundary_function(bc_func);
+    policy.set_rhs_function(rhs);
+    policy.set_dof_manager(dof_manager);
+    policy.set_mesh(mesh);
+    policy.set_face_geometry_cache(cache);
+    policy.assemble(matrix, x, b);
+    matrix.fill_completed();
+
+    auto end = std::chrono::steady_clock::now();
+
+    SolveResult result;
+    result.setup = std::chrono::duration<real_t>(end - start).count();
+
+    // values plus column indices plus row offsets
+    const uint_t nnz = matrix.get_matrix()->NumGlobalNonzeros();
+    result.bytes = nnz*(sizeof(double) + sizeof(int)) + (matrix.m() + 1)*sizeof(int);
+
+    TrilinosKrylovSolver solver(solver_data());
+    auto output = solver.solve(matrix, x, b);
+
+    result.solve = output.runtime.count();
+    result.iterations = output.niterations;
+    return result;
+}
+
+/// \brief Build the matrix-free operator and solve with CG
+SolveResult
+solve_matrix_free(const Mesh<2>& mesh, const FVFaceGeometryCache<2>& cache, const FVDoFManager<2>& dof_manager){
+
+    ScalarDirichletBCFunc<2> bc_func(0.0, mesh.n_boundaries());
+    RhsVals rhs;
+
+    TrilinosEpetraVector x;
+    TrilinosEpetraVector b;
+
+    auto start = std::chrono::steady_clock::now();
+
+    x.init(dof_manager.n_dofs(), false);
+    b.init(dof_manager.n_dofs(), false);
+
+    FVMatrixFreeOperator<2> op;
+    op.set_boundary_function(bc_func);
+    op.set_rhs_function(rhs);
+    op.build(mesh, cache, dof_manager);
+    op.get_rhs(b);
+
+    FVEpetraOperator<2> epetra_op(op);
+
+    auto end = std::chrono::steady_clock::now();
+
+    SolveResult result;
+    result.setup = std::chrono::duration<real_t>(end - start).count();
+    result.bytes = op.memory_consumption();
+
+    TrilinosKrylovSolver solver(solver_data());
+    auto output = solver.solve(epetra_op, x, b);
+
+    result.solve = output.runtime.count();
+    result.iterations = output.niterations;
+    return result;
+}
+
+}
+
+/// Compares an assembled CRS matrix against the matrix-free FV Laplace
+/// operator when solving the Poisson equation with unpreconditioned CG.
+/// Usage: example_28 [max cells per direction]
+int main(int argc, char** argv){
+
+    using namespace example;
+
+    uint_t max_n = 1024;
+    if(argc > 1){
+        max_n = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    std::cout<<std::setw(10)<<"cells"<<std::setw(14)<<"mode"<<std::setw(12)<<"setup (s)"
+             <<std::setw(12)<<"solve (s)"<<std::setw(8)<<"its"<<std::setw(14)<<"memory (MB)"<<std::endl;
+
+    try{
+
+        for(uint_t n = 128; n <= max_n; n *= 2){
+
+            Mesh<2> mesh;
+            kernel::numerics::build_quad_mesh(mesh, n, n, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+            FVDoFManager<2> dof_manager;
+            dof_manager.distribute_dofs(mesh, ScalarVar("U"));
+
+            FVFaceGeometryCache<2> cache(mesh);
+
+            const SolveResult assembled = solve_assembled(mesh, cache, dof_manager);
+            const SolveResult matrix_free = solve_matrix_free(mesh, cache, dof_manager);
+
+            std::cout<<std::setw(10)<<mesh.n_elements()<<std::setw(14)<<"assembled"
+                     <<std::setw(12)<<assembled.setup<<std::setw(12)<<assembled.solve
+                     <<std::setw(8)<<assembled.iterations<<std::setw(14)<<assembled.bytes/1.0e6<<std::endl;
+
+            std::cout<<std::setw(10)<<mesh.n_elements()<<std::setw(14)<<"matrix-free"
+                     <<std::setw(12)<<matrix_free.setup<<std::setw(12)<<matrix_free.solve
+                     <<std::setw(8)<<matrix_free.iterations<<std::setw(14)<<matrix_free.bytes/1.0e6<<std::endl;
+        }
+    }
+    catch(std::logic_error& error){
+
+        std::cerr<<error.what()<<std::endl;
+    }
+    catch(...){
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
+
+#else
+
+#include <iostream>
+int main(){
+    std::cout<<"This example requires Trilinos. Reconfigure kernellib such that it uses Trilinos"<<std::endl;
+    return 0;
+}
+#endif
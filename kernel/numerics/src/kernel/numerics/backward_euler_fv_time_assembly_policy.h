@@ -161,12 +161,13 @@ BackwardEulerFVTimeAssemblyPolicy<dim,
                                                                           TrilinosEpetraVector& b,
                                                                           const std::vector<TrilinosEpetraVector>& old_solutions ){
 
-    auto dofs = spatial_assembly_.get_element_dofs(); //.size();
+    const auto& dofs = spatial_assembly_.get_element_dofs();
     auto elem_volume = spatial_assembly_.get_element_volume();
 
-    std::vector<real_t> row_entries(dofs.size(), 0.0);
-
-    mat.set_entry(dofs[0].id, dofs[0].id, elem_volume/dt_);
+    // the spatial assembly has already set the diagonal.
+    // Adding keeps it when the matrix pattern is fixed and
+    // set_entry would replace the value
+    mat.add_entry(dofs[0].id, dofs[0].id, elem_volume/dt_);
     auto old_sol = old_solutions[0][dofs[0].id];
     b.add(dofs[0].id, (old_sol*elem_volume)/dt_);
 }
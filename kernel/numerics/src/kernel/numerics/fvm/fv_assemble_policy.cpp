@@ -30,43 +30,7 @@ template<int dim>
 void
 FVAssemblyPolicy<dim>::initialize_dofs_(){
 
-
-    dof_manager_->get_dofs(*elem_, cell_dofs_);
-
-    if(cell_dofs_.empty()){
-        throw std::logic_error("Cell without dofs is used");
-    }
-
-    if (cell_dofs_[0].id == KernelConsts::invalid_size_type()) {
-        throw std::logic_error("Invalid DoF index");
-    }
-
-    neigh_dofs_.clear();
-    neigh_dofs_.reserve(elem_->n_neighbors());
-
-
-    // get the dofs off the neighbors
-    for(uint_t neigh=0; neigh<elem_->n_neighbors(); ++neigh){
-
-        auto* neigh_elem = elem_->neighbor_ptr(neigh);
-
-        if(neigh_elem){
-
-            std::vector<DoF> tmp;
-
-            dof_manager_->get_dofs(*neigh_elem, tmp);
-
-            if(tmp.empty()){
-                throw std::logic_error("Cell without dofs is used");
-            }
-
-            if (tmp[0].id == KernelConsts::invalid_size_type()) {
-                throw std::logic_error("Invalid DoF index");
-            }
-
-            neigh_dofs_.push_back(tmp[0]);
-        }
-    }
+    dof_manager_->get_element_dofs(*elem_, cell_dofs_, neigh_dofs_);
 }
 
 
@@ -6,6 +6,7 @@
 
 #include "kernel/numerics/fvm/fv_convection_assemble_policy.h"
 #include "kernel/numerics/fvm/fv_interpolate_base.h"
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
 
 #include "kernel/numerics/boundary_function_base.h"
 #include "kernel/numerics/boundary_conditions_type.h"
@@ -47,50 +48,15 @@ FVConvectionAssemblyPolicy<dim>::FVConvectionAssemblyPolicy()
       rhs_func_(nullptr),
       volume_func_(nullptr),
       velocity_func_(nullptr),
-      m_ptr_(nullptr)
+      m_ptr_(nullptr),
+      face_cache_(nullptr)
 {}
 
 template<int dim>
 void
 FVConvectionAssemblyPolicy<dim>::initialize_dofs_(){
 
-
-    dof_manager_->get_dofs(*elem_, cell_dofs_);
-
-    if(cell_dofs_.empty()){
-        throw std::logic_error("Cell without dofs is used");
-    }
-
-    if (cell_dofs_[0].id == KernelConsts::invalid_size_type()) {
-        throw std::logic_error("Invalid DoF index");
-    }
-
-    neigh_dofs_.clear();
-    neigh_dofs_.reserve(elem_->n_neighbors());
-
-
-    // get the dofs off the neighbors
-    for(uint_t neigh=0; neigh<elem_->n_neighbors(); ++neigh){
-
-        auto* neigh_elem = elem_->neighbor_ptr(neigh);
-
-        if(neigh_elem){
-
-            std::vector<DoF> tmp;
-
-            dof_manager_->get_dofs(*neigh_elem, tmp);
-
-            if(tmp.empty()){
-                throw std::logic_error("Cell without dofs is used");
-            }
-
-            if (tmp[0].id == KernelConsts::invalid_size_type()) {
-                throw std::logic_error("Invalid DoF index");
-            }
-
-            neigh_dofs_.push_back(tmp[0]);
-        }
-    }
+    dof_manager_->get_element_dofs(*elem_, cell_dofs_, neigh_dofs_);
 }
 
 template<int dim>
@@ -101,6 +67,11 @@ FVConvectionAssemblyPolicy<dim>::compute_fluxes(){
         throw  std::logic_error("FV interpolation pointer has not been set");
     }
 
+    if(face_cache_){
+        fv_interpolate_->compute_fluxes(*elem_, *face_cache_, fluxes_);
+        return;
+    }
+
     fv_interpolate_->compute_fluxes(*elem_, fluxes_);
 }
 
@@ -109,7 +80,7 @@ void
 FVConvectionAssemblyPolicy<dim>::reinit(const Element<dim>& element){
 
     elem_ = &element;
-    elem_volume_ = elem_->volume();
+    elem_volume_ = face_cache_ ? face_cache_->element_volume(elem_->get_id()) : elem_->volume();
     initialize_dofs_();
     compute_fluxes();
 }
@@ -118,6 +89,7 @@ template<int dim>
 void
 FVConvectionAssemblyPolicy<dim>::reinit(const Element<dim>& element, std::vector<real_t>&& qvals){
     elem_ = &element;
+    elem_volume_ = face_cache_ ? face_cache_->element_volume(elem_->get_id()) : elem_->volume();
     qvals_ = qvals;
     qvals.clear();
     initialize_dofs_();
@@ -166,28 +138,37 @@ FVConvectionAssemblyPolicy<dim>::assemble_one_element(TrilinosEpetraMatrix& mat,
       row_dofs[n+1] = neigh_dofs_[n].id;
     }
 
-    //a dummy index to start counting from 1
-    uint_t dummy_idx =1;
-    std::map<uint_t, real_t> fluxes;
+    if(face_cache_){
 
-    for(uint_t dof=0; dof<n_dofs; ++dof){
-        fluxes[row_dofs[dof]] = 0.0;
+        // with the cache the contributions are
+        // laid out like row_dofs
+        fv_interpolate_->compute_matrix_contributions(*elem_, *face_cache_, row_entries);
     }
+    else{
 
-    fv_interpolate_->compute_matrix_contributions(*elem_, fluxes);
+        std::map<uint_t, real_t> fluxes;
 
-    for(uint_t f=0; f < elem_->n_faces(); ++f){
+        for(uint_t dof=0; dof<n_dofs; ++dof){
+            fluxes[row_dofs[dof]] = 0.0;
+        }
+
+        fv_interpolate_->compute_matrix_contributions(*elem_, fluxes);
 
-        const auto& face = elem_->get_face(f);
+        for(uint_t idx=0; idx<row_dofs.size(); ++idx){
+            row_entries[idx] = fluxes[row_dofs[idx]];
+        }
+    }
 
-        if(face.on_boundary()){
+    for(uint_t f=0; f < elem_->n_faces(); ++f){
+
+        if(detail::face_on_boundary(*elem_, f, face_cache_)){
             boundary_faces.push_back(f);
         }
     }
 
-    mat.set_entry(row_dofs[0], row_dofs[0], fluxes[row_dofs[0]]);
+    mat.set_entry(row_dofs[0], row_dofs[0], row_entries[0]);
     for(uint_t idx=1; idx<row_dofs.size(); ++idx){
-        mat.set_entry(row_dofs[0], row_dofs[idx], fluxes[row_dofs[idx]]);
+        mat.set_entry(row_dofs[0], row_dofs[idx], row_entries[idx]);
     }
 
     real_t rhs_val = 0.0;
@@ -210,16 +191,14 @@ FVConvectionAssemblyPolicy<dim>::apply_boundary_conditions(const  std::vector<ui
 
         for(uint_t f=0; f<bfaces.size(); ++f){
 
-            auto& face = elem_->get_face(bfaces[f]);
-
             //get the boundary condition type
-            BCType type = boundary_func_->bc_type(face.boundary_indicator());
+            BCType type = boundary_func_->bc_type(detail::face_boundary_indicator(*elem_, bfaces[f], face_cache_));
 
             switch(type){
 
             case BCType::DIRICHLET:
             {
-                real_t bc_val = boundary_func_->value(face.centroid());
+                real_t bc_val = boundary_func_->value(detail::face_centroid(*elem_, bfaces[f], face_cache_));
                 uint_t var_dof = cell_dofs_[0].id;
                 auto flux = fluxes_[bfaces[f]];
 
@@ -16,6 +16,7 @@ template<int dim> class FVInterpolateBase;
 template<int dim> class Element;
 template<int dim> class Mesh;
 template<int dim> class FVDoFManager;
+template<int dim> class FVFaceGeometryCache;
 template<int dim> class BoundaryFunctionBase;
 template<int dim> class NumericScalarFunction;
 template<int dim> class NumericVectorFunctionBase;
@@ -74,6 +75,10 @@ public:
     /// \brief Set the mesh pointer
     void set_mesh(const Mesh<dim>& mesh){m_ptr_ = &mesh;}
 
+    /// \brief Set the precomputed face geometry. When set, the face
+    /// data and the interpolation fluxes are computed from the cache
+    void set_face_geometry_cache(const FVFaceGeometryCache<dim>& cache){face_cache_ = &cache;}
+
     /// \brief Access the mesh
     const Mesh<dim>& get_mesh()const{return *m_ptr_;}
 
@@ -141,6 +146,9 @@ private:
     /// \brief The Mesh over which the policy is working
     const Mesh<dim>* m_ptr_;
 
+    /// \brief The face geometry cache if any
+    const FVFaceGeometryCache<dim>* face_cache_;
+
     /// \brief initialize dofs
     void initialize_dofs_();
 };
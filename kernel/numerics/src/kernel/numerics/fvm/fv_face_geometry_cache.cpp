@@ -0,0 +1,149 @@
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/node.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace kernel{
+namespace numerics{
+
+template<int dim>
+FVFaceGeometryCache<dim>::FVFaceGeometryCache()
+    :
+      elem_face_offsets_(),
+      elem_faces_(),
+      elem_volumes_(),
+      areas_(),
+      normals_(),
+      centroids_(),
+      distances_(),
+      weights_(),
+      owners_(),
+      neighbors_(),
+      boundary_()
+{}
+
+template<int dim>
+FVFaceGeometryCache<dim>::FVFaceGeometryCache(const Mesh<dim>& mesh)
+    :
+      FVFaceGeometryCache<dim>()
+{
+    build(mesh);
+}
+
+template<int dim>
+void
+FVFaceGeometryCache<dim>::clear(){
+
+    elem_face_offsets_.clear();
+    elem_faces_.clear();
+    elem_volumes_.clear();
+    areas_.clear();
+    distances_.clear();
+    weights_.clear();
+    owners_.clear();
+    neighbors_.clear();
+    boundary_.clear();
+
+    for(uint_t d=0; d<dim; ++d){
+        normals_[d].clear();
+        centroids_[d].clear();
+    }
+}
+
+template<int dim>
+void
+FVFaceGeometryCache<dim>::build(const Mesh<dim>& mesh){
+
+    clear();
+
+    // element ids are used to index the CSR table
+    uint_t n_slots = 0;
+    auto elem_itr = mesh.elements_begin();
+    auto elem_itr_e = mesh.elements_end();
+
+    for(; elem_itr != elem_itr_e; ++elem_itr){
+        n_slots = std::max(n_slots, (*elem_itr)->get_id() + 1);
+    }
+
+    std::vector<uint_t> n_elem_faces(n_slots, 0);
+    for(elem_itr = mesh.elements_begin(); elem_itr != elem_itr_e; ++elem_itr){
+        n_elem_faces[(*elem_itr)->get_id()] = (*elem_itr)->n_faces();
+    }
+
+    elem_face_offsets_.resize(n_slots + 1, 0);
+    for(uint_t e=0; e<n_slots; ++e){
+        elem_face_offsets_[e + 1] = elem_face_offsets_[e] + n_elem_faces[e];
+    }
+
+    elem_faces_.resize(elem_face_offsets_.back(), KernelConsts::invalid_size_type());
+    elem_volumes_.resize(n_slots, 0.0);
+
+    // faces are shared so they are numbered the
+    // first time an element refers to them
+    std::unordered_map<const void*, uint_t> face_idx;
+    face_idx.reserve(mesh.n_faces());
+
+    for(elem_itr = mesh.elements_begin(); elem_itr != elem_itr_e; ++elem_itr){
+
+        const Element<dim>* elem = *elem_itr;
+        const uint_t id = elem->get_id();
+
+        elem_volumes_[id] = elem->volume();
+
+        for(uint_t f=0; f<elem->n_faces(); ++f){
+
+            const auto& face = elem->get_face(f);
+            auto result = face_idx.emplace(&face, face_idx.size());
+
+            elem_faces_[elem_face_offsets_[id] + f] = result.first->second;
+
+            if(!result.second){
+                continue;
+            }
+
+            const Element<dim>* neigh = f < elem->n_neighbors() ? elem->neighbor_ptr(f) : nullptr;
+
+            if(!neigh || face.is_owner(id)){
+                owners_.push_back(id);
+                neighbors_.push_back(neigh ? neigh->get_id() : KernelConsts::invalid_size_type());
+            }
+            else{
+                owners_.push_back(neigh->get_id());
+                neighbors_.push_back(id);
+            }
+
+            real_t area = face.volume();
+            real_t distance = face.owner_neighbor_distance();
+
+            areas_.push_back(area);
+            distances_.push_back(distance);
+            weights_.push_back(area/distance);
+            boundary_.push_back(face.boundary_indicator());
+
+            auto normal = face.normal_vector();
+            auto centroid = face.centroid();
+
+            for(uint_t d=0; d<dim; ++d){
+                normals_[d].push_back(d < normal.size() ? normal[d] : 0.0);
+                centroids_[d].push_back(centroid[d]);
+            }
+        }
+    }
+}
+
+template class FVFaceGeometryCache<1>;
+template class FVFaceGeometryCache<2>;
+template class FVFaceGeometryCache<3>;
+
+}
+}
+
+#endif
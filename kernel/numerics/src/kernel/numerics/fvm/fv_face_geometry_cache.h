@@ -0,0 +1,233 @@
+#ifndef FV_FACE_GEOMETRY_CACHE_H
+#define FV_FACE_GEOMETRY_CACHE_H
+
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/numerics/fvm/fv_grad_base.h"
+
+#include <array>
+#include <vector>
+
+namespace kernel{
+namespace numerics{
+
+/// forward declarations
+template<int dim> class Mesh;
+
+/// \brief Precomputed face geometry and connectivity of a Mesh
+/// for FV assembly. The data is stored as structure-of-arrays
+/// indexed by a face index. The faces of an element are found
+/// through a CSR table indexed by the element id. The cache
+/// is a snapshot of the mesh geometry and must be rebuilt if the mesh
+/// changes. For a static mesh it needs to be built only once
+template<int dim>
+class FVFaceGeometryCache
+{
+
+public:
+
+    /// \brief Constructor
+    FVFaceGeometryCache();
+
+    /// \brief Constructor. Build the cache for the given mesh
+    explicit FVFaceGeometryCache(const Mesh<dim>& mesh);
+
+    /// \brief Build the cache for the given mesh.
+    /// Any previous data is discarded
+    void build(const Mesh<dim>& mesh);
+
+    /// \brief Clear the memory
+    void clear();
+
+    /// \brief Returns true if the cache has been built
+    bool is_built()const{return !elem_face_offsets_.empty();}
+
+    /// \brief The number of cached faces
+    uint_t n_faces()const{return areas_.size();}
+
+    /// \brief The number of element slots. This is one
+    /// more than the largest element id in the mesh
+    uint_t n_elements()const{return elem_volumes_.size();}
+
+    /// \brief Returns the number of faces of the element with the given id
+    uint_t n_element_faces(uint_t elem_id)const
+    {return elem_face_offsets_[elem_id + 1] - elem_face_offsets_[elem_id];}
+
+    /// \brief Returns the face index of the f-th face of the element with the given id
+    uint_t face_index(uint_t elem_id, uint_t f)const{return elem_faces_[elem_face_offsets_[elem_id] + f];}
+
+    /// \brief Returns the volume of the element with the given id
+    real_t element_volume(uint_t elem_id)const{return elem_volumes_[elem_id];}
+
+    /// \brief The area of the face
+    real_t area(uint_t face)const{return areas_[face];}
+
+    /// \brief The d-th component of the face normal vector.
+    /// The normal points out of the owner element
+    real_t normal(uint_t face, uint_t d)const{return normals_[d][face];}
+
+    /// \brief The normal vector of the face
+    DynVec<real_t> normal_vector(uint_t face)const;
+
+    /// \brief The centroid of the face
+    GeomPoint<dim> centroid(uint_t face)const;
+
+    /// \brief The distance between the owner and neighbor centroids
+    /// or between the owner and face centroids for boundary faces
+    real_t distance(uint_t face)const{return distances_[face];}
+
+    /// \brief The two point flux weight area/distance
+    real_t weight(uint_t face)const{return weights_[face];}
+
+    /// \brief The id of the element owning the face
+    uint_t owner(uint_t face)const{return owners_[face];}
+
+    /// \brief The id of the neighbor element. KernelConsts::invalid_size_type()
+    /// for boundary faces
+    uint_t neighbor(uint_t face)const{return neighbors_[face];}
+
+    /// \brief Returns true if the element with the given id owns the face
+    bool is_owner(uint_t face, uint_t elem_id)const{return owners_[face] == elem_id;}
+
+    /// \brief The boundary indicator of the face
+    uint_t boundary_indicator(uint_t face)const{return boundary_[face];}
+
+    /// \brief Returns true if the face is on the boundary
+    bool on_boundary(uint_t face)const{return boundary_[face] != KernelConsts::invalid_size_type();}
+
+private:
+
+    /// \brief Element to face CSR table
+    std::vector<uint_t> elem_face_offsets_;
+    std::vector<uint_t> elem_faces_;
+
+    /// \brief The element volumes
+    std::vector<real_t> elem_volumes_;
+
+    /// \brief The face data
+    std::vector<real_t> areas_;
+    std::array<std::vector<real_t>, dim> normals_;
+    std::array<std::vector<real_t>, dim> centroids_;
+    std::vector<real_t> distances_;
+    std::vector<real_t> weights_;
+    std::vector<uint_t> owners_;
+    std::vector<uint_t> neighbors_;
+    std::vector<uint_t> boundary_;
+
+};
+
+template<int dim>
+inline
+DynVec<real_t>
+FVFaceGeometryCache<dim>::normal_vector(uint_t face)const{
+
+    DynVec<real_t> n(dim, 0.0);
+    for(uint_t d=0; d<dim; ++d){
+        n[d] = normals_[d][face];
+    }
+
+    return n;
+}
+
+template<int dim>
+inline
+GeomPoint<dim>
+FVFaceGeometryCache<dim>::centroid(uint_t face)const{
+
+    std::array<real_t, dim> coords;
+    for(uint_t d=0; d<dim; ++d){
+        coords[d] = centroids_[d][face];
+    }
+
+    return GeomPoint<dim>(coords);
+}
+
+/// \brief Helpers that query the f-th face of the given element from the
+/// cache when one is given and from the element itself otherwise
+namespace detail{
+
+template<int dim>
+inline
+bool
+face_on_boundary(const Element<dim>& elem, uint_t f, const FVFaceGeometryCache<dim>* cache){
+
+    if(cache){
+        return cache->on_boundary(cache->face_index(elem.get_id(), f));
+    }
+
+    return elem.get_face(f).on_boundary();
+}
+
+template<int dim>
+inline
+uint_t
+face_boundary_indicator(const Element<dim>& elem, uint_t f, const FVFaceGeometryCache<dim>* cache){
+
+    if(cache){
+        return cache->boundary_indicator(cache->face_index(elem.get_id(), f));
+    }
+
+    return elem.get_face(f).boundary_indicator();
+}
+
+template<int dim>
+inline
+GeomPoint<dim>
+face_centroid(const Element<dim>& elem, uint_t f, const FVFaceGeometryCache<dim>* cache){
+
+    if(cache){
+        return cache->centroid(cache->face_index(elem.get_id(), f));
+    }
+
+    return elem.get_face(f).centroid();
+}
+
+template<int dim>
+inline
+DynVec<real_t>
+face_normal_vector(const Element<dim>& elem, uint_t f, const FVFaceGeometryCache<dim>* cache){
+
+    if(cache){
+        return cache->normal_vector(cache->face_index(elem.get_id(), f));
+    }
+
+    return elem.get_face(f).normal_vector();
+}
+
+/// \brief Compute the diffusive face fluxes of the element. For the Gauss
+/// gradient these are the cached two point flux weights when a cache is given
+template<int dim>
+inline
+void
+laplace_face_fluxes(const Element<dim>& elem, const FVGradBase<dim>& grads,
+                    const FVFaceGeometryCache<dim>* cache, std::vector<real_t>& fluxes){
+
+    if(cache && grads.type() == FVGradType::GAUSS){
+
+        const uint_t id = elem.get_id();
+        fluxes.resize(cache->n_element_faces(id));
+
+        for(uint_t f=0; f<fluxes.size(); ++f){
+            fluxes[f] = cache->weight(cache->face_index(id, f));
+        }
+
+        return;
+    }
+
+    grads.compute_gradients(elem, fluxes);
+}
+
+}
+
+}
+}
+
+#endif
+#endif // FV_FACE_GEOMETRY_CACHE_H
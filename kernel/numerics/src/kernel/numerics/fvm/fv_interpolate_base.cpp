@@ -3,6 +3,10 @@
 #ifdef USE_FVM
 
 #include "kernel/numerics/fvm/fv_interpolate_base.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+
+#include <exception>
 
 namespace kernel{
 namespace numerics{
@@ -17,6 +21,43 @@ template<int dim>
 FVInterpolateBase<dim>::~FVInterpolateBase()
 {}
 
+template<int dim>
+void
+FVInterpolateBase<dim>::compute_fluxes(const Element<dim>& elem, const FVFaceGeometryCache<dim>& /*cache*/,
+                                       std::vector<real_t>& values)const{
+
+    // schemes that do not use the cache compute
+    // the fluxes from the element faces
+    compute_fluxes(elem, values);
+}
+
+template<int dim>
+void
+FVInterpolateBase<dim>::compute_matrix_contributions(const Element<dim>& element, const FVFaceGeometryCache<dim>& /*cache*/,
+                                                     std::vector<real_t>& values)const{
+
+    std::map<uint_t, real_t> contributions;
+    compute_matrix_contributions(element, contributions);
+
+    // lay out the contributions keyed by element id
+    // as the diagonal followed by the neighbors in face order
+    const uint_t id = element.get_id();
+    values[0] += contributions[id];
+
+    uint_t idx = 1;
+    for(uint_t f=0; f<element.n_faces(); ++f){
+
+        auto& face = element.get_face(f);
+
+        if(face.on_boundary()){
+            continue;
+        }
+
+        const uint_t neighbor_id = face.is_owner(id) ? face.get_neighbor().get_id() : face.get_owner().get_id();
+        values[idx++] += contributions[neighbor_id];
+    }
+}
+
 
 template class FVInterpolateBase<1>;
 template class FVInterpolateBase<2>;
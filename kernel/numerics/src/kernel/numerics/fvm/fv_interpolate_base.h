@@ -9,12 +9,14 @@
 #include "kernel/numerics/fvm/fv_interpolation_types.h"
 
 #include <map>
+#include <vector>
 
 namespace kernel {
 namespace numerics{
 
 /// forward declarations
 template<int dim> class Element;
+template<int dim> class FVFaceGeometryCache;
 
 template<int dim>
 class FVInterpolateBase
@@ -31,6 +33,20 @@ public:
     /// that should be used on the given element
     virtual void compute_matrix_contributions(const Element<dim>& element, std::map<uint_t, real_t>&)const=0;
 
+    /// \brief Compute the fluxes for the given element using
+    /// the precomputed face geometry. The default implementation
+    /// ignores the cache and uses the element faces
+    virtual void compute_fluxes(const Element<dim>& elem, const FVFaceGeometryCache<dim>& cache,
+                                std::vector<real_t>& values)const;
+
+    /// \brief Returns the matrix contibutions that should be used on the
+    /// given element using the precomputed face geometry. values[0] is the
+    /// diagonal entry and values[k + 1] the entry of the k-th neighbor
+    /// in face order. values should be sized and zeroed by the caller.
+    /// The default implementation ignores the cache and uses the element faces
+    virtual void compute_matrix_contributions(const Element<dim>& element, const FVFaceGeometryCache<dim>& cache,
+                                              std::vector<real_t>& values)const;
+
     /// \brief Returns the type of the approximation
     FVInterpolationType type()const{return type_;}
 
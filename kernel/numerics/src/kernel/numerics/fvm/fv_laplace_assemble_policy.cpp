@@ -4,6 +4,7 @@
 
 #include "kernel/numerics/fvm/fv_laplace_assemble_policy.h"
 #include "kernel/numerics/fvm/fv_grad_base.h"
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
 #include "kernel/numerics/boundary_function_base.h"
 #include "kernel/numerics/boundary_conditions_type.h"
 #include "kernel/discretization/dof_manager.h"
@@ -38,50 +39,15 @@ FVLaplaceAssemblyPolicy<dim>::FVLaplaceAssemblyPolicy()
       boundary_func_(nullptr),
       rhs_func_(nullptr),
       volume_func_(nullptr),
-      m_ptr_(nullptr)
+      m_ptr_(nullptr),
+      face_cache_(nullptr)
 {}
 
 template<int dim>
 void
 FVLaplaceAssemblyPolicy<dim>::initialize_dofs(){
 
-
-    dof_manager_->get_dofs(*elem_, cell_dofs_);
-
-    if(cell_dofs_.empty()){
-        throw std::logic_error("Cell without dofs is used");
-    }
-
-    if (cell_dofs_[0].id == KernelConsts::invalid_size_type()) {
-        throw std::logic_error("Invalid DoF index");
-    }
-
-    neigh_dofs_.clear();
-    neigh_dofs_.reserve(elem_->n_neighbors());
-
-
-    // get the dofs off the neighbors
-    for(uint_t neigh=0; neigh<elem_->n_neighbors(); ++neigh){
-
-        auto* neigh_elem = elem_->neighbor_ptr(neigh);
-
-        if(neigh_elem){
-
-            std::vector<DoF> tmp;
-
-            dof_manager_->get_dofs(*neigh_elem, tmp);
-
-            if(tmp.empty()){
-                throw std::logic_error("Cell without dofs is used");
-            }
-
-            if (tmp[0].id == KernelConsts::invalid_size_type()) {
-                throw std::logic_error("Invalid DoF index");
-            }
-
-            neigh_dofs_.push_back(tmp[0]);
-        }
-    }
+    dof_manager_->get_element_dofs(*elem_, cell_dofs_, neigh_dofs_);
 }
 
 template<int dim>
@@ -92,7 +58,7 @@ FVLaplaceAssemblyPolicy<dim>::compute_fluxes(){
         throw  std::logic_error("FV gradient pointer has not been set");
     }
 
-    fv_grads_->compute_gradients(*elem_, fluxes_);
+    detail::laplace_face_fluxes(*elem_, *fv_grads_, face_cache_, fluxes_);
 }
 
 template<int dim>
@@ -100,7 +66,7 @@ void
 FVLaplaceAssemblyPolicy<dim>::reinit(const Element<dim>& element){
 
     elem_ = &element;
-    elem_volume_ = elem_->volume();
+    elem_volume_ = face_cache_ ? face_cache_->element_volume(elem_->get_id()) : elem_->volume();
     initialize_dofs();
     compute_fluxes();
 }
@@ -109,6 +75,7 @@ template<int dim>
 void
 FVLaplaceAssemblyPolicy<dim>::reinit(const Element<dim>& element, std::vector<real_t>&& qvals){
     elem_ = &element;
+    elem_volume_ = face_cache_ ? face_cache_->element_volume(elem_->get_id()) : elem_->volume();
     qvals_ = qvals;
     qvals.clear();
     initialize_dofs();
@@ -162,9 +129,7 @@ FVLaplaceAssemblyPolicy<dim>::assemble_one_element(TrilinosEpetraMatrix& mat, Tr
 
     for(uint_t f=0; f < elem_->n_faces(); ++f){
 
-        const auto& face = elem_->get_face(f);
-
-        if(!face.on_boundary()){
+        if(!detail::face_on_boundary(*elem_, f, face_cache_)){
           //for every face we add to the diagonal entry
           real_t qval = qvals_.empty() ? 1.0 : qvals_[f];
 
@@ -179,7 +144,7 @@ FVLaplaceAssemblyPolicy<dim>::assemble_one_element(TrilinosEpetraMatrix& mat, Tr
     }
 
     if(volume_func_){
-        row_entries[0] += volume_func_->value(elem_->centroid())*elem_->volume();
+        row_entries[0] += volume_func_->value(elem_->centroid())*elem_volume_;
     }
 
     mat.set_entry(row_dofs[0], row_dofs[0], row_entries[0]);
@@ -207,14 +172,12 @@ FVLaplaceAssemblyPolicy<dim>::apply_boundary_conditions(const  std::vector<uint_
 
         for(uint_t f=0; f<bfaces.size(); ++f){
 
-            auto& face = elem_->get_face(bfaces[f]);
-
             //get the boundary condition type
-            BCType type = boundary_func_->bc_type(face.boundary_indicator());
+            BCType type = boundary_func_->bc_type(detail::face_boundary_indicator(*elem_, bfaces[f], face_cache_));
 
             if(type == BCType::DIRICHLET || type == BCType::ZERO_DIRICHLET)
             {
-                real_t bc_val = boundary_func_->value(face.centroid());
+                real_t bc_val = boundary_func_->value(detail::face_centroid(*elem_, bfaces[f], face_cache_));
                 uint_t var_dof = cell_dofs_[0].id;
                 real_t qval = qvals_.empty() ? 1.0 : qvals_[bfaces[f]];
 
@@ -228,8 +191,8 @@ FVLaplaceAssemblyPolicy<dim>::apply_boundary_conditions(const  std::vector<uint_
             }//Dirichlet
             else if (type == BCType::NEUMANN) {
 
-                auto gradient = boundary_func_->gradients(face.centroid());
-                auto normal_vector = face.normal_vector();
+                auto gradient = boundary_func_->gradients(detail::face_centroid(*elem_, bfaces[f], face_cache_));
+                auto normal_vector = detail::face_normal_vector(*elem_, bfaces[f], face_cache_);
                 normal_vector /= norm(normal_vector);
                 auto normal_comp = dot(normal_vector , gradient);
                 uint_t var_dof = cell_dofs_[0].id;
@@ -19,6 +19,7 @@ template<int dim> class FVGradBase;
 template<int dim> class Element;
 template<int dim> class Mesh;
 template<int dim> class FVDoFManager;
+template<int dim> class FVFaceGeometryCache;
 template<int dim> class BoundaryFunctionBase;
 template<int dim> class NumericScalarFunction;
 
@@ -77,6 +78,11 @@ public:
     /// \brief Set the mesh pointer
     void set_mesh(const Mesh<dim>& mesh){m_ptr_ = &mesh;}
 
+    /// \brief Set the precomputed face geometry. When set, the
+    /// face data is read from the cache instead of the mesh and
+    /// the Gauss gradient fluxes use the cached weights
+    void set_face_geometry_cache(const FVFaceGeometryCache<dim>& cache){face_cache_ = &cache;}
+
     /// \brief Access the mesh
     const Mesh<dim>& get_mesh()const{return *m_ptr_;}
 
@@ -137,6 +143,8 @@ private:
     /// \brief The Mesh over which the policy is working
     const Mesh<dim>* m_ptr_;
 
+    /// \brief The face geometry cache if any
+    const FVFaceGeometryCache<dim>* face_cache_;
 
 };
 
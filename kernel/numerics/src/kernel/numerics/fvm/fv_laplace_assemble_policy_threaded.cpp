@@ -6,6 +6,7 @@
 #include "kernel/parallel/threading/thread_pool.h"
 #include "kernel/parallel/threading/openmp_executor.h"
 #include <exception>
+#include <algorithm>
 
 namespace kernel{
 namespace numerics{
@@ -21,9 +22,43 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::FVLaplaceAssemblyPolicyThreaded(
     volume_func_(nullptr),
     m_ptr_(nullptr),
     tasks_(),
-    executor_(nullptr)
+    executor_(nullptr),
+    assembly_type_(FVThreadedAssemblyType::PARTITIONED),
+    coloring_(),
+    color_tasks_(),
+    face_cache_(nullptr)
 {}
 
+template<int dim, typename Executor>
+void
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::set_assembly_type(FVThreadedAssemblyType type){
+
+    if(type == FVThreadedAssemblyType::INVALID_TYPE){
+        throw std::logic_error("Invalid threaded assembly type");
+    }
+
+    assembly_type_ = type;
+}
+
+template<int dim, typename Executor>
+void
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::set_mesh(const Mesh<dim>& mesh){
+
+    m_ptr_ = &mesh;
+
+    // the colouring holds element pointers of the old mesh
+    coloring_ = ElementColoring<dim>();
+    clear_tasks_();
+}
+
+template<int dim, typename Executor>
+void
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::clear_tasks_(){
+
+    tasks_.clear();
+    color_tasks_.clear();
+}
+
 
 #ifdef USE_TRILINOS
 
@@ -40,21 +75,84 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::assemble(TrilinosEpetraMatrix& m
         throw std::logic_error("Executor is not set");
     }
 
-    if(tasks_.empty()){
+    typedef FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<TrilinosEpetraMatrix, TrilinosEpetraVector> task_t;
 
-        typedef FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<TrilinosEpetraMatrix, TrilinosEpetraVector> task_t;
+    if(assembly_type_ == FVThreadedAssemblyType::COLORED){
+
+        // inserting entries into an unfilled Epetra_CrsMatrix
+        // updates matrix wide data and is not thread safe
+        if(!mat.is_filled()){
+            throw std::logic_error("The coloured assembly requires a matrix with a fixed sparsity pattern. "
+                                   "Initialize the matrix with the sparsity pattern of the DoFManager");
+        }
+
+        if(color_tasks_.empty()){
+
+            if(coloring_.n_elements() == 0){
+                coloring_.color(*m_ptr_);
+            }
+
+            const uint_t n_threads = executor_->n_processing_elements();
+            color_tasks_.resize(coloring_.n_colors());
+
+            for(uint_t c=0; c<coloring_.n_colors(); ++c){
+
+                const auto& elements = coloring_.get_color(c);
+                const uint_t n_tasks = std::min(n_threads, static_cast<uint_t>(elements.size()));
+                const uint_t load = elements.size()/n_tasks;
+
+                color_tasks_[c].reserve(n_tasks);
+
+                for(uint_t t=0; t<n_tasks; ++t){
+
+                    auto task = std::make_unique<task_t>(t, mat, b, x, fv_grads_, *dof_manager_,
+                                                         *m_ptr_, boundary_func_, rhs_func_, volume_func_);
+
+                    // the last task takes the remainder
+                    const uint_t begin = t*load;
+                    const uint_t end = (t == n_tasks - 1) ? elements.size() : begin + load;
+                    task->set_elements(elements, begin, end);
+                    task->set_face_geometry_cache(face_cache_);
+                    color_tasks_[c].push_back(std::move(task));
+                }
+            }
+        }
+        else{
+
+            // the tasks may have been created for another system
+            for(auto& tasks : color_tasks_){
+                for(auto& task : tasks){
+                    static_cast<task_t&>(*task).set_system(mat, b, x);
+                    task->reschedule();
+                }
+            }
+        }
+
+        // every call blocks so the colours
+        // are assembled one after the other
+        for(auto& tasks : color_tasks_){
+            executor_->execute(tasks, typename Executor::default_options_t());
+        }
+
+        return;
+    }
+
+    if(tasks_.empty()){
 
         tasks_.reserve(executor_->n_processing_elements());
 
         for(uint_t t=0; t<executor_->n_processing_elements(); ++t){
-            tasks_.push_back(std::make_unique<task_t>(t, mat, b, x, fv_grads_, *dof_manager_,
-                                                      *m_ptr_, boundary_func_, rhs_func_, volume_func_));
+            auto task = std::make_unique<task_t>(t, mat, b, x, fv_grads_, *dof_manager_,
+                                                 *m_ptr_, boundary_func_, rhs_func_, volume_func_);
+            task->set_face_geometry_cache(face_cache_);
+            tasks_.push_back(std::move(task));
         }
 
     }
     else{
 
         for(uint_t t=0; t<tasks_.size(); ++t){
+            static_cast<task_t&>(*tasks_[t]).set_system(mat, b, x);
             tasks_[t]->reschedule();
         }
 
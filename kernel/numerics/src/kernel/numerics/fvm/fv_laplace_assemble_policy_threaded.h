@@ -16,9 +16,12 @@
 #include "kernel/numerics/boundary_conditions_type.h"
 #include "kernel/numerics/boundary_function_base.h"
 #include "kernel/numerics/fvm/fv_grad_base.h"
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
+#include "kernel/numerics/fvm/fv_threaded_assembly_types.h"
 #include "kernel/maths/functions/numeric_scalar_function.h"
 
 #include "kernel/parallel/threading/simple_task.h"
+#include "kernel/parallel/utilities/element_coloring.h"
 
 #ifdef USE_TRILINOS
 #include "kernel/maths/trilinos_epetra_matrix.h"
@@ -68,27 +71,46 @@ public:
 #endif
 
     /// \brief Set the function that describes the boundary conditions
-    void set_boundary_function(const BoundaryFunctionBase<dim>& func){boundary_func_ = &func;}
+    void set_boundary_function(const BoundaryFunctionBase<dim>& func){boundary_func_ = &func; clear_tasks_();}
 
     /// \brief Set the function that describes the boundary conditions
-    void set_rhs_function(const NumericScalarFunction<dim>& func){rhs_func_ = &func;}
+    void set_rhs_function(const NumericScalarFunction<dim>& func){rhs_func_ = &func; clear_tasks_();}
 
     /// \brief Set the function that describes the boundary conditions
-    void set_volume_term_function(const NumericScalarFunction<dim>& func){volume_func_ = &func;}
+    void set_volume_term_function(const NumericScalarFunction<dim>& func){volume_func_ = &func; clear_tasks_();}
 
     /// \brief Set the object that describes the dofs
-    void set_dof_manager(const FVDoFManager<dim>& dof_manager){dof_manager_ = &dof_manager;}
+    void set_dof_manager(const FVDoFManager<dim>& dof_manager){dof_manager_ = &dof_manager; clear_tasks_();}
 
-    /// \brief Set the mesh pointer
-    void set_mesh(const Mesh<dim>& mesh){m_ptr_ = &mesh;}
+    /// \brief Set the mesh pointer. The colouring
+    /// of any previous mesh is discarded
+    void set_mesh(const Mesh<dim>& mesh);
 
     /// \brief Set the executor
-    void set_executor(executot_t& executor){executor_ = &executor;}
+    void set_executor(executot_t& executor){executor_ = &executor; clear_tasks_();}
+
+    /// \brief Set the precomputed face geometry. When set, the
+    /// face data is read from the cache instead of the mesh and
+    /// the Gauss gradient fluxes use the cached weights
+    void set_face_geometry_cache(const FVFaceGeometryCache<dim>& cache){face_cache_ = &cache; clear_tasks_();}
 
     /// \brief Build the  gradient scheme
     template<typename Factory>
     void build_gradient(const Factory& factory);
 
+    /// \brief Set how the elements are distributed to the threads.
+    /// The default is FVThreadedAssemblyType::PARTITIONED. With
+    /// FVThreadedAssemblyType::COLORED, assemble() requires a matrix whose
+    /// sparsity pattern is fixed, see TrilinosEpetraMatrix::init(row_offsets, columns)
+    void set_assembly_type(FVThreadedAssemblyType type);
+
+    /// \brief Returns how the elements are distributed to the threads
+    FVThreadedAssemblyType get_assembly_type()const{return assembly_type_;}
+
+    /// \brief Returns the colouring used with FVThreadedAssemblyType::COLORED.
+    /// This is computed upon the first assembly after set_mesh()
+    const ElementColoring<dim>& get_coloring()const{return coloring_;}
+
 private:
 
     template<typename MatrixTp, typename VectorTp>
@@ -119,6 +141,22 @@ private:
 
     /// \brief Pointer to the executor
     executot_t* executor_;
+
+    /// \brief How the elements are distributed to the threads
+    FVThreadedAssemblyType assembly_type_;
+
+    /// \brief The element colouring
+    ElementColoring<dim> coloring_;
+
+    /// \brief The tasks of every colour
+    std::vector<std::vector<std::unique_ptr<TaskBase>>> color_tasks_;
+
+    /// \brief The face geometry cache if any
+    const FVFaceGeometryCache<dim>* face_cache_;
+
+    /// \brief Discard the tasks so that the next assembly
+    /// creates them with the current data of the policy
+    void clear_tasks_();
 };
 
 template<int dim, typename Executor>
@@ -127,6 +165,7 @@ void
 FVLaplaceAssemblyPolicyThreaded<dim, Executor>::build_gradient(const Factory& factory){
 
     fv_grads_ = factory();
+    clear_tasks_();
 }
 
 template<int dim, typename Executor>
@@ -163,18 +202,28 @@ public:
     /// \brief initialize dofs
     void initialize_dofs();
 
+    /// \brief Assemble the elements [begin, end) of the given list
+    /// instead of the elements on the process with id equal to the task id
+    void set_elements(const std::vector<const Element<dim>*>& elements, uint_t begin, uint_t end);
+
+    /// \brief Set the face geometry cache. May be null
+    void set_face_geometry_cache(const FVFaceGeometryCache<dim>* cache){face_cache_ = cache;}
+
+    /// \brief Set the matrix and vectors to assemble
+    void set_system(matrix_t& mat, vector_t& b, vector_t& x){mat_ = &mat; b_ = &b; x_ = &x;}
+
 protected:
 
     virtual void run()override final;
 
     /// \brief The matrix to assemble
-    MatrixTp& mat_;
+    MatrixTp* mat_;
 
     /// \brief The rhs
-    VectorTp& b_;
+    VectorTp* b_;
 
     /// \brief The solution
-    VectorTp& x_;
+    VectorTp* x_;
 
     /// \brief Pointer to the FV gradient approximation
     std::shared_ptr<FVGradBase<dim>> fv_grads_;
@@ -211,6 +260,19 @@ protected:
     /// \brief The cell fluxes
     std::vector<real_t> fluxes_;
 
+    /// \brief The elements to assemble if not null
+    const std::vector<const Element<dim>*>* elements_;
+
+    /// \brief The range of elements_ to assemble
+    uint_t elements_begin_;
+    uint_t elements_end_;
+
+    /// \brief The face geometry cache if any
+    const FVFaceGeometryCache<dim>* face_cache_;
+
+    /// \brief The volume of the element
+    real_t elem_volume_;
+
 };
 
 template<int dim, typename Executor>
@@ -223,9 +285,9 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
                                                                                               const NumericScalarFunction<dim>* vol_func)
     :
     SimpleTaskBase<Null>(t),
-    mat_(mat),
-    b_(b),
-    x_(x),
+    mat_(&mat),
+    b_(&b),
+    x_(&x),
     fv_grads_(fv_grads),
     dof_manager_(&dof_manager),
     m_ptr_(&mesh),
@@ -236,15 +298,44 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
     qvals_(),
     neigh_dofs_(),
     cell_dofs_(),
-    fluxes_()
+    fluxes_(),
+    elements_(nullptr),
+    elements_begin_(0),
+    elements_end_(0),
+    face_cache_(nullptr),
+    elem_volume_(0.0)
 {}
 
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+void
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::set_elements(const std::vector<const Element<dim>*>& elements,
+                                                                                              uint_t begin, uint_t end){
+    elements_ = &elements;
+    elements_begin_ = begin;
+    elements_end_ = end;
+}
+
 
 template<int dim, typename Executor>
 template<typename MatrixTp, typename VectorTp>
 void
 FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::run(){
 
+    // the elements of a colour. The matrix pattern is fixed
+    // so the entries are replaced or summed in place and
+    // the threads never change the structure of the matrix
+    if(elements_){
+
+        for(uint_t e=elements_begin_; e<elements_end_; ++e){
+
+            reinit(*(*elements_)[e]);
+            assemble_one_element();
+        }
+
+        return;
+    }
+
     // loop over the elements
     ConstElementMeshIterator<ActiveOnProc, Mesh<dim>> filter(*m_ptr_);
 
@@ -266,6 +357,7 @@ void
 FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::reinit(const Element<dim>& element){
 
     elem_ = &element;
+    elem_volume_ = face_cache_ ? face_cache_->element_volume(elem_->get_id()) : elem_->volume();
     initialize_dofs();
     compute_fluxes();
 }
@@ -275,43 +367,7 @@ template<typename MatrixTp, typename VectorTp>
 void
 FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::initialize_dofs(){
 
-
-    dof_manager_->get_dofs(*elem_, cell_dofs_);
-
-    if(cell_dofs_.empty()){
-        throw std::logic_error("Cell without dofs is used");
-    }
-
-    if (cell_dofs_[0].id == KernelConsts::invalid_size_type()) {
-        throw std::logic_error("Invalid DoF index");
-    }
-
-    neigh_dofs_.clear();
-    neigh_dofs_.reserve(elem_->n_neighbors());
-
-
-    // get the dofs off the neighbors
-    for(uint_t neigh=0; neigh<elem_->n_neighbors(); ++neigh){
-
-        auto* neigh_elem = elem_->neighbor_ptr(neigh);
-
-        if(neigh_elem){
-
-            std::vector<DoF> tmp;
-
-            dof_manager_->get_dofs(*neigh_elem, tmp);
-
-            if(tmp.empty()){
-                throw std::logic_error("Cell without dofs is used");
-            }
-
-            if (tmp[0].id == KernelConsts::invalid_size_type()) {
-                throw std::logic_error("Invalid DoF index");
-            }
-
-            neigh_dofs_.push_back(tmp[0]);
-        }
-    }
+    dof_manager_->get_element_dofs(*elem_, cell_dofs_, neigh_dofs_);
 }
 
 
@@ -324,7 +380,7 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
         throw  std::logic_error("FV gradient pointer has not been set");
     }
 
-    fv_grads_->compute_gradients(*elem_, fluxes_);
+    detail::laplace_face_fluxes(*elem_, *fv_grads_, face_cache_, fluxes_);
 }
 
 template<int dim, typename Executor>
@@ -336,31 +392,29 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
 
     for(uint_t f=0; f<bfaces.size(); ++f){
 
-        auto& face = elem_->get_face(bfaces[f]);
-
         //get the boundary condition type
-        BCType type = boundary_func_->bc_type(face.boundary_indicator());
+        BCType type = boundary_func_->bc_type(detail::face_boundary_indicator(*elem_, bfaces[f], face_cache_));
 
         if(type == BCType::DIRICHLET || type == BCType::ZERO_DIRICHLET)
         {
-            real_t bc_val = boundary_func_->value(face.centroid());
+            real_t bc_val = boundary_func_->value(detail::face_centroid(*elem_, bfaces[f], face_cache_));
             uint_t var_dof = cell_dofs_[0].id;
             real_t qval = qvals_.empty() ? 1.0 : qvals_[bfaces[f]];
 
             //add the boundary condition type
-            b_.add(var_dof, bc_val*fluxes_[bfaces[f]]);
+            b_->add(var_dof, bc_val*fluxes_[bfaces[f]]);
             auto flux_val = fluxes_[bfaces[f]];
 
             //add to the diagonal of the matrix
-            mat_.add_entry(var_dof, var_dof, qval*flux_val);
+            mat_->add_entry(var_dof, var_dof, qval*flux_val);
 
         }//Dirichlet
         else if (type == BCType::NEUMANN) {
 
-            auto gradient = boundary_func_->gradients(face.centroid());
-            auto normal_comp = dot(gradient, face.normal_vector());
+            auto gradient = boundary_func_->gradients(detail::face_centroid(*elem_, bfaces[f], face_cache_));
+            auto normal_comp = dot(gradient, detail::face_normal_vector(*elem_, bfaces[f], face_cache_));
             uint_t var_dof = cell_dofs_[0].id;
-            b_.add(var_dof, normal_comp);
+            b_->add(var_dof, normal_comp);
         }
         else if(type == BCType::ZERO_NEUMANN){
             // nothing to do here.
@@ -395,9 +449,7 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
 
     for(uint_t f=0; f < elem_->n_faces(); ++f){
 
-        const auto& face = elem_->get_face(f);
-
-        if(!face.on_boundary()){
+        if(!detail::face_on_boundary(*elem_, f, face_cache_)){
           //for every face we add to the diagonal entry
           real_t qval = qvals_.empty() ? 1.0 : qvals_[f];
 
@@ -412,12 +464,12 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
     }
 
     if(volume_func_){
-        row_entries[0] += volume_func_->value(elem_->centroid())*elem_->volume();
+        row_entries[0] += volume_func_->value(elem_->centroid())*elem_volume_;
     }
 
-    mat_.set_entry(row_dofs[0], row_dofs[0], row_entries[0]);
+    mat_->set_entry(row_dofs[0], row_dofs[0], row_entries[0]);
     for(uint_t idx=1; idx<row_dofs.size(); ++idx){
-        mat_.set_entry(row_dofs[0], row_dofs[idx], row_entries[idx]);
+        mat_->set_entry(row_dofs[0], row_dofs[idx], row_entries[idx]);
     }
 
     real_t rhs_val = 0.0;
@@ -425,7 +477,7 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
         rhs_val = rhs_func_->value(elem_->centroid());
     }
 
-    b_.add(cell_dofs_[0].id, rhs_val*elem_->volume());
+    b_->add(cell_dofs_[0].id, rhs_val*elem_volume_);
 
     if(!boundary_faces.empty() && boundary_func_ != nullptr){
         apply_boundary_conditions(boundary_faces);
@@ -0,0 +1,333 @@
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
+#include "kernel/numerics/boundary_function_base.h"
+#include "kernel/numerics/boundary_conditions_type.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/maths/functions/numeric_scalar_function.h"
+#include "kernel/maths/functions/numeric_vector_function.h"
+
+#ifdef USE_TRILINOS
+#include "kernel/maths/trilinos_epetra_vector.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <string>
+
+namespace kernel{
+namespace numerics{
+
+template<int dim>
+FVMatrixFreeOperator<dim>::FVMatrixFreeOperator()
+    :
+      diffusion_(1.0),
+      mass_coeff_(0.0),
+      boundary_func_(nullptr),
+      rhs_func_(nullptr),
+      volume_func_(nullptr),
+      velocity_func_(nullptr),
+      diag_(),
+      rhs_(),
+      face_owners_(),
+      face_neighbors_(),
+      owner_coeffs_(),
+      neighbor_coeffs_(),
+      norm_inf_(0.0)
+{}
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::clear(){
+
+    std::vector<real_t>().swap(diag_);
+    std::vector<real_t>().swap(rhs_);
+    std::vector<uint_t>().swap(face_owners_);
+    std::vector<uint_t>().swap(face_neighbors_);
+    std::vector<real_t>().swap(owner_coeffs_);
+    std::vector<real_t>().swap(neighbor_coeffs_);
+    norm_inf_ = 0.0;
+}
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::build(const Mesh<dim>& mesh, const FVFaceGeometryCache<dim>& cache,
+                                 const FVDoFManager<dim>& dof_manager){
+
+    if(!cache.is_built()){
+        throw std::logic_error("Face geometry cache has not been built");
+    }
+
+    clear();
+
+    const uint_t n_dofs = dof_manager.n_dofs();
+    diag_.resize(n_dofs, 0.0);
+    rhs_.resize(n_dofs, 0.0);
+
+    // the dof of every active element indexed by the element id
+    std::vector<uint_t> elem_dofs(cache.n_elements(), KernelConsts::invalid_size_type());
+
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    auto elem_itr = filter.begin();
+    auto elem_itr_e = filter.end();
+
+    for(; elem_itr != elem_itr_e; ++elem_itr){
+
+        auto* elem = *elem_itr;
+        auto dof = dof_manager.get_dof(*elem);
+
+        if(dof.id == KernelConsts::invalid_size_type() || dof.id >= n_dofs){
+            throw std::logic_error("Invalid DoF index for element "+std::to_string(elem->get_id()));
+        }
+
+        elem_dofs[elem->get_id()] = dof.id;
+
+        const real_t volume = cache.element_volume(elem->get_id());
+        diag_[dof.id] += mass_coeff_*volume;
+
+        if(volume_func_ || rhs_func_){
+
+            auto centroid = elem->centroid();
+
+            if(volume_func_){
+                diag_[dof.id] += volume_func_->value(centroid)*volume;
+            }
+
+            if(rhs_func_){
+                rhs_[dof.id] += rhs_func_->value(centroid)*volume;
+            }
+        }
+    }
+
+    const uint_t n_faces = cache.n_faces();
+    face_owners_.reserve(n_faces);
+    face_neighbors_.reserve(n_faces);
+    owner_coeffs_.reserve(n_faces);
+    neighbor_coeffs_.reserve(n_faces);
+
+    for(uint_t face=0; face<n_faces; ++face){
+
+        const uint_t owner = elem_dofs[cache.owner(face)];
+        const real_t weight = diffusion_*cache.weight(face);
+
+        real_t flux = 0.0;
+        if(velocity_func_){
+
+            auto velocity = velocity_func_->value(cache.centroid(face));
+            for(uint_t d=0; d<dim; ++d){
+                flux += velocity[d]*cache.normal(face, d);
+            }
+        }
+
+        if(!cache.on_boundary(face)){
+
+            const uint_t neighbor = elem_dofs[cache.neighbor(face)];
+
+            // Laplace term
+            diag_[owner] += weight;
+            diag_[neighbor] += weight;
+
+            real_t owner_coeff = -weight;
+            real_t neighbor_coeff = -weight;
+
+            // upwind convection term. The normal
+            // points out of the owner
+            if(flux >= 0.0){
+                diag_[owner] += flux;
+                neighbor_coeff -= flux;
+            }
+            else{
+                owner_coeff += flux;
+                diag_[neighbor] -= flux;
+            }
+
+            face_owners_.push_back(owner);
+            face_neighbors_.push_back(neighbor);
+            owner_coeffs_.push_back(owner_coeff);
+            neighbor_coeffs_.push_back(neighbor_coeff);
+            continue;
+        }
+
+        if(!boundary_func_){
+            continue;
+        }
+
+        BCType type = boundary_func_->bc_type(cache.boundary_indicator(face));
+
+        if(type == BCType::DIRICHLET || type == BCType::ZERO_DIRICHLET){
+
+            real_t bc_val = boundary_func_->value(cache.centroid(face));
+            diag_[owner] += weight;
+            rhs_[owner] += (weight - flux)*bc_val;
+        }
+        else if(type == BCType::NEUMANN){
+
+            auto gradient = boundary_func_->gradients(cache.centroid(face));
+
+            real_t norm = 0.0;
+            real_t normal_comp = 0.0;
+            for(uint_t d=0; d<dim; ++d){
+                norm += cache.normal(face, d)*cache.normal(face, d);
+                normal_comp += cache.normal(face, d)*(d < gradient.size() ? gradient[d] : 0.0);
+            }
+
+            rhs_[owner] += diffusion_*normal_comp/std::sqrt(norm);
+        }
+        else if(type == BCType::ZERO_NEUMANN){
+            diag_[owner] += flux;
+        }
+    }
+
+    // the infinity norm is the largest absolute row sum
+    std::vector<real_t> row_sums(n_dofs, 0.0);
+    for(uint_t r=0; r<n_dofs; ++r){
+        row_sums[r] = std::abs(diag_[r]);
+    }
+
+    for(uint_t f=0; f<face_owners_.size(); ++f){
+        row_sums[face_owners_[f]] += std::abs(owner_coeffs_[f]);
+        row_sums[face_neighbors_[f]] += std::abs(neighbor_coeffs_[f]);
+    }
+
+    norm_inf_ = row_sums.empty() ? 0.0 : *std::max_element(row_sums.begin(), row_sums.end());
+}
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::apply(const real_t* x, real_t* y)const{
+
+    const uint_t n_dofs = diag_.size();
+    for(uint_t r=0; r<n_dofs; ++r){
+        y[r] = diag_[r]*x[r];
+    }
+
+    const uint_t n_faces = face_owners_.size();
+    for(uint_t f=0; f<n_faces; ++f){
+
+        const uint_t owner = face_owners_[f];
+        const uint_t neighbor = face_neighbors_[f];
+
+        y[owner] += owner_coeffs_[f]*x[neighbor];
+        y[neighbor] += neighbor_coeffs_[f]*x[owner];
+    }
+}
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::apply_transpose(const real_t* x, real_t* y)const{
+
+    const uint_t n_dofs = diag_.size();
+    for(uint_t r=0; r<n_dofs; ++r){
+        y[r] = diag_[r]*x[r];
+    }
+
+    const uint_t n_faces = face_owners_.size();
+    for(uint_t f=0; f<n_faces; ++f){
+
+        const uint_t owner = face_owners_[f];
+        const uint_t neighbor = face_neighbors_[f];
+
+        y[neighbor] += owner_coeffs_[f]*x[owner];
+        y[owner] += neighbor_coeffs_[f]*x[neighbor];
+    }
+}
+
+template<int dim>
+uint_t
+FVMatrixFreeOperator<dim>::memory_consumption()const{
+
+    uint_t bytes = (diag_.capacity() + rhs_.capacity() +
+                    owner_coeffs_.capacity() + neighbor_coeffs_.capacity())*sizeof(real_t);
+    bytes += (face_owners_.capacity() + face_neighbors_.capacity())*sizeof(uint_t);
+    return bytes;
+}
+
+#ifdef USE_TRILINOS
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::get_rhs(TrilinosEpetraVector& b)const{
+
+    for(uint_t r=0; r<rhs_.size(); ++r){
+        b.set_entry(r, rhs_[r]);
+    }
+}
+
+template<int dim>
+FVEpetraOperator<dim>::FVEpetraOperator(const FVMatrixFreeOperator<dim>& op)
+    :
+    Epetra_Operator(),
+    op_(&op),
+    use_transpose_(false),
+    comm_(),
+    map_()
+{
+    if(!op.is_built()){
+        throw std::logic_error("The matrix-free operator has not been built");
+    }
+
+    auto n = static_cast<int>(op.n_dofs());
+    map_.reset(new Epetra_Map(n, n, 0, comm_));
+}
+
+template<int dim>
+int
+FVEpetraOperator<dim>::SetUseTranspose(bool use_transpose){
+
+    use_transpose_ = use_transpose;
+    return 0;
+}
+
+template<int dim>
+int
+FVEpetraOperator<dim>::Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y)const{
+
+    if(X.NumVectors() != Y.NumVectors() ||
+       static_cast<uint_t>(X.MyLength()) != op_->n_dofs() ||
+       static_cast<uint_t>(Y.MyLength()) != op_->n_dofs()){
+        return -1;
+    }
+
+    for(int v=0; v<X.NumVectors(); ++v){
+
+        if(use_transpose_){
+            op_->apply_transpose(X[v], Y[v]);
+        }
+        else{
+            op_->apply(X[v], Y[v]);
+        }
+    }
+
+    return 0;
+}
+
+template<int dim>
+int
+FVEpetraOperator<dim>::ApplyInverse(const Epetra_MultiVector& /*X*/, Epetra_MultiVector& /*Y*/)const{
+    return -1;
+}
+
+template class FVEpetraOperator<1>;
+template class FVEpetraOperator<2>;
+template class FVEpetraOperator<3>;
+
+#endif
+
+template class FVMatrixFreeOperator<1>;
+template class FVMatrixFreeOperator<2>;
+template class FVMatrixFreeOperator<3>;
+
+}
+}
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef FV_MATRIX_FREE_OPERATOR_H
+#define FV_MATRIX_FREE_OPERATOR_H
+
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <memory>
+
+#ifdef USE_TRILINOS
+#include <Epetra_Operator.h>
+#include <Epetra_MultiVector.h>
+#include <Epetra_SerialComm.h>
+#include <Epetra_Map.h>
+#endif
+
+namespace kernel{
+namespace numerics{
+
+/// forward declarations
+template<int dim> class Mesh;
+template<int dim> class FVDoFManager;
+template<int dim> class FVFaceGeometryCache;
+template<int dim> class BoundaryFunctionBase;
+template<int dim> class NumericScalarFunction;
+template<int dim> class NumericVectorFunctionBase;
+
+#ifdef USE_TRILINOS
+class TrilinosEpetraVector;
+#endif
+
+/// \brief Matrix-free application of the FV operator that
+/// FVLaplaceAssemblyPolicy and FVConvectionAssemblyPolicy (UD) assemble.
+/// Instead of a sparse matrix, build() computes from the face geometry cache
+/// the diagonal and two coefficients per interior face: the coefficient of the
+/// neighbor in the owner row and of the owner in the neighbor row. apply() then
+/// sweeps the faces once. Dirichlet boundaries contribute to the diagonal and
+/// the right hand side exactly like the assembly policies do. The operator
+/// uses the Gauss (two point) gradient and holds a single scalar variable
+template<int dim>
+class FVMatrixFreeOperator
+{
+
+public:
+
+    /// \brief Constructor
+    FVMatrixFreeOperator();
+
+    /// \brief Set the diffusion coefficient. A zero
+    /// coefficient switches off the Laplace term
+    void set_diffusion_coefficient(real_t k){diffusion_ = k;}
+
+    /// \brief Set the boundary function
+    void set_boundary_function(const BoundaryFunctionBase<dim>& func){boundary_func_ = &func;}
+
+    /// \brief Set the rhs function
+    void set_rhs_function(const NumericScalarFunction<dim>& func){rhs_func_ = &func;}
+
+    /// \brief Set the volume term function
+    void set_volume_term_function(const NumericScalarFunction<dim>& func){volume_func_ = &func;}
+
+    /// \brief Set the velocity. This switches on the
+    /// upwind convection term
+    void set_velocity_function(const NumericVectorFunctionBase<dim>& func){velocity_func_ = &func;}
+
+    /// \brief Set the coefficient c of the mass term c*volume that is
+    /// added to the diagonal e.g. 1/dt for a backward Euler step
+    void set_mass_coefficient(real_t c){mass_coeff_ = c;}
+
+    /// \brief The coefficient of the mass term
+    real_t mass_coefficient()const{return mass_coeff_;}
+
+    /// \brief Compute the operator coefficients and the right hand side.
+    /// It should be called again when the mesh, the coefficients or the
+    /// boundary conditions change
+    void build(const Mesh<dim>& mesh, const FVFaceGeometryCache<dim>& cache,
+               const FVDoFManager<dim>& dof_manager);
+
+    /// \brief Clear the memory
+    void clear();
+
+    /// \brief Returns true if build() has been called
+    bool is_built()const{return !diag_.empty();}
+
+    /// \brief The number of rows
+    uint_t n_dofs()const{return diag_.size();}
+
+    /// \brief The number of interior faces i.e. the number of
+    /// off diagonal pairs of the operator
+    uint_t n_interior_faces()const{return face_owners_.size();}
+
+    /// \brief Compute y = A*x. x and y must hold n_dofs() entries
+    void apply(const real_t* x, real_t* y)const;
+
+    /// \brief Compute y = A^T*x. x and y must hold n_dofs() entries
+    void apply_transpose(const real_t* x, real_t* y)const;
+
+    /// \brief Compute y = A*x
+    void apply(const std::vector<real_t>& x, std::vector<real_t>& y)const;
+
+    /// \brief The diagonal of the operator
+    const std::vector<real_t>& diagonal()const{return diag_;}
+
+    /// \brief The right hand side computed by build()
+    const std::vector<real_t>& rhs()const{return rhs_;}
+
+#ifdef USE_TRILINOS
+    /// \brief Copy the right hand side into the given vector
+    void get_rhs(TrilinosEpetraVector& b)const;
+#endif
+
+    /// \brief The infinity norm of the operator
+    real_t norm_inf()const{return norm_inf_;}
+
+    /// \brief Returns an estimate of the memory in bytes
+    /// the operator uses
+    uint_t memory_consumption()const;
+
+private:
+
+    /// \brief The diffusion coefficient
+    real_t diffusion_;
+
+    /// \brief The coefficient of the mass term
+    real_t mass_coeff_;
+
+    /// \brief The functions describing the problem
+    const BoundaryFunctionBase<dim>* boundary_func_;
+    const NumericScalarFunction<dim>* rhs_func_;
+    const NumericScalarFunction<dim>* volume_func_;
+    const NumericVectorFunctionBase<dim>* velocity_func_;
+
+    /// \brief The diagonal and right hand side per dof
+    std::vector<real_t> diag_;
+    std::vector<real_t> rhs_;
+
+    /// \brief Per interior face: the owner and neighbor dofs, the coefficient
+    /// of the neighbor in the owner row and of the owner in the neighbor row
+    std::vector<uint_t> face_owners_;
+    std::vector<uint_t> face_neighbors_;
+    std::vector<real_t> owner_coeffs_;
+    std::vector<real_t> neighbor_coeffs_;
+
+    /// \brief The infinity norm
+    real_t norm_inf_;
+
+};
+
+template<int dim>
+inline
+void
+FVMatrixFreeOperator<dim>::apply(const std::vector<real_t>& x, std::vector<real_t>& y)const{
+
+    y.resize(diag_.size());
+    apply(x.data(), y.data());
+}
+
+#ifdef USE_TRILINOS
+
+/// \brief Exposes an FVMatrixFreeOperator as an Epetra_Operator so that
+/// it can be handed to TrilinosKrylovSolver. The wrapped operator must
+/// outlive this object and must be built before the wrapper is constructed
+template<int dim>
+class FVEpetraOperator: public Epetra_Operator
+{
+
+public:
+
+    /// \brief Constructor
+    explicit FVEpetraOperator(const FVMatrixFreeOperator<dim>& op);
+
+    /// \brief Destructor
+    virtual ~FVEpetraOperator()
+    {}
+
+    /// \brief Use the transpose of the operator in Apply
+    virtual int SetUseTranspose(bool use_transpose)override;
+
+    /// \brief Compute Y = A*X
+    virtual int Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y)const override;
+
+    /// \brief Not supported. Returns -1
+    virtual int ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y)const override;
+
+    /// \brief The infinity norm of the operator
+    virtual double NormInf()const override{return op_->norm_inf();}
+
+    /// \brief The label of the operator
+    virtual const char* Label()const override{return "FVEpetraOperator";}
+
+    /// \brief Returns true if the transpose is applied
+    virtual bool UseTranspose()const override{return use_transpose_;}
+
+    /// \brief The norm is always available
+    virtual bool HasNormInf()const override{return true;}
+
+    /// \brief The communicator
+    virtual const Epetra_Comm& Comm()const override{return comm_;}
+
+    /// \brief The domain map
+    virtual const Epetra_Map& OperatorDomainMap()const override{return *map_;}
+
+    /// \brief The range map
+    virtual const Epetra_Map& OperatorRangeMap()const override{return *map_;}
+
+private:
+
+    /// \brief The operator we wrap
+    const FVMatrixFreeOperator<dim>* op_;
+
+    /// \brief Flag indicating whether the transpose is applied
+    bool use_transpose_;
+
+    /// \brief The communicator
+    Epetra_SerialComm comm_;
+
+    /// \brief The map of the domain and range
+    std::unique_ptr<Epetra_Map> map_;
+
+};
+
+#endif
+
+}
+}
+
+#endif
+#endif // FV_MATRIX_FREE_OPERATOR_H
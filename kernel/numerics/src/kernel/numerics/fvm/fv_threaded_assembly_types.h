@@ -0,0 +1,25 @@
+#ifndef FV_THREADED_ASSEMBLY_TYPES_H
+#define FV_THREADED_ASSEMBLY_TYPES_H
+
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+namespace kernel{
+namespace numerics{
+
+/// \brief How the threaded FV assembly policies distribute the
+/// elements to the threads. PARTITIONED lets every thread assemble the
+/// elements whose pid is equal to the thread id. COLORED assembles the
+/// colours of an ElementColoring one after the other and splits the elements
+/// of every colour evenly over the threads. COLORED only accepts a matrix
+/// with a fixed sparsity pattern so that the threads update values in
+/// place and never insert entries concurrently
+enum class FVThreadedAssemblyType{PARTITIONED,
+                                  COLORED,
+                                  INVALID_TYPE};
+}
+}
+
+#endif
+#endif // FV_THREADED_ASSEMBLY_TYPES_H
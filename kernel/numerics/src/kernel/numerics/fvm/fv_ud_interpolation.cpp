@@ -3,6 +3,7 @@
 #ifdef USE_FVM
 
 #include "kernel/numerics/fvm/fv_ud_interpolation.h"
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
 #include "kernel/discretization/element.h"
 #include "kernel/discretization/face_element.h"
 
@@ -124,6 +125,83 @@ FVUDInterpolate<dim>::compute_matrix_contributions(const Element<dim>& element,
     }
 }
 
+template<int dim>
+real_t
+FVUDInterpolate<dim>::compute_flux(const FVFaceGeometryCache<dim>& cache, uint_t face)const{
+
+    if(!velocity_){
+        throw std::logic_error("Velocity pointer is NULL");
+    }
+
+    const DynVec<real_t> velocity_value = velocity_->value(cache.centroid(face));
+
+    real_t flux = 0.0;
+    for(uint_t d=0; d<dim; ++d){
+        flux += velocity_value[d]*cache.normal(face, d);
+    }
+
+    return flux;
+}
+
+template<int dim>
+void
+FVUDInterpolate<dim>::compute_fluxes(const Element<dim>& element, const FVFaceGeometryCache<dim>& cache,
+                                     std::vector<real_t>& values)const{
+
+    const uint_t id = element.get_id();
+    values.resize(cache.n_element_faces(id));
+
+    for(uint_t f=0; f<values.size(); ++f){
+        values[f] = compute_flux(cache, cache.face_index(id, f));
+    }
+}
+
+template<int dim>
+void
+FVUDInterpolate<dim>::compute_matrix_contributions(const Element<dim>& element, const FVFaceGeometryCache<dim>& cache,
+                                                   std::vector<real_t>& values)const{
+
+    const uint_t id = element.get_id();
+
+    // the slot of the next neighbor
+    uint_t idx = 1;
+
+    for(uint_t f=0; f<cache.n_element_faces(id); ++f){
+
+        const uint_t face = cache.face_index(id, f);
+
+        if(cache.on_boundary(face)){
+            continue;
+        }
+
+        auto flux = compute_flux(cache, face);
+
+        if(cache.is_owner(face, id)){
+
+            // outflow goes to the diagonal and
+            // inflow to the neighbor
+            if(flux >= 0.0){
+                values[0] += flux;
+            }
+            else{
+                values[idx] += flux;
+            }
+        }
+        else{
+
+            // the normal points into the element
+            if(flux >= 0.0){
+                values[idx] -= flux;
+            }
+            else{
+                values[0] -= flux;
+            }
+        }
+
+        idx++;
+    }
+}
+
 template class FVUDInterpolate<1>;
 template class FVUDInterpolate<2>;
 template class FVUDInterpolate<3>;
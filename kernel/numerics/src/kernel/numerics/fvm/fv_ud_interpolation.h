@@ -35,12 +35,26 @@ public:
     /// that should be used on the given element
     virtual void compute_matrix_contributions(const Element<dim>& element,  std::map<uint_t, real_t>& values)const override;
 
+    /// \brief Compute the fluxes for the given element using
+    /// the precomputed face geometry
+    virtual void compute_fluxes(const Element<dim>& elem, const FVFaceGeometryCache<dim>& cache,
+                                std::vector<real_t>& values)const override;
+
+    /// \brief Returns the matrix contibutions that should be used on the
+    /// given element using the precomputed face geometry
+    virtual void compute_matrix_contributions(const Element<dim>& element, const FVFaceGeometryCache<dim>& cache,
+                                              std::vector<real_t>& values)const override;
+
     /// \brief Compute the dot product of the
     /// velocity computed on the given face and
     /// the face normal vector
     template<typename FaceTp>
     real_t compute_flux(const FaceTp& face)const;
 
+    /// \brief Same as above for the face with
+    /// the given index in the cache
+    real_t compute_flux(const FVFaceGeometryCache<dim>& cache, uint_t face)const;
+
 
     /// \brief Set the object that calculates the velocity
     /// field needed for the calculation of fluxes
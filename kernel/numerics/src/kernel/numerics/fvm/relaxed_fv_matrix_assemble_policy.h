@@ -94,14 +94,16 @@ public:
     /// \brief Add to the i-th diagonal entry the value
     void add_to_lower_diagonal_entry(uint_t i, real_t val){lowerD_.add(i, val);}
 
-    /// \brief Relax
-    template<typename MeshTp>
-    void relax(const MeshTp& mesh, const vector_t& old_solution);
+    /// \brief Relax. The DoFs of the cells are
+    /// looked up through the given DoF manager
+    template<typename MeshTp, typename DoFManagerTp>
+    void relax(const MeshTp& mesh, const DoFManagerTp& dof_manager, const vector_t& old_solution);
 
     /// \brief Calculates the sum-mag of the off diagonal entries
     /// for the interior sides
-    template<typename MeshTp>
-    void sum_mag_off_diag(const MeshTp& mesh, std::vector<real_t> &sum_Off_diag)const;
+    template<typename MeshTp, typename DoFManagerTp>
+    void sum_mag_off_diag(const MeshTp& mesh, const DoFManagerTp& dof_manager,
+                          std::vector<real_t> &sum_Off_diag)const;
 
 private:
 
@@ -198,18 +200,17 @@ RelaxedFVMatrixAssemblyPolicy<MatrixPolicy>::get_boundary_entry_rhs(uint_t side_
 }
 
 template<typename MatrixPolicy>
-template<typename MeshTp>
+template<typename MeshTp, typename DoFManagerTp>
 void
-RelaxedFVMatrixAssemblyPolicy<MatrixPolicy>::relax(const MeshTp& mesh, const vector_t& old_solution){
+RelaxedFVMatrixAssemblyPolicy<MatrixPolicy>::relax(const MeshTp& mesh, const DoFManagerTp& dof_manager,
+                                                   const vector_t& old_solution){
 
     std::vector<real_t> sum_off(D_.size(), 0.0);
 
-    sum_mag_off_diag(sum_off);
+    sum_mag_off_diag(mesh, dof_manager, sum_off);
 
     std::vector<real_t> internal_coeffs;
 
-    std::vector<DoF> dofs;
-
     ConstElementMeshIterator<Active, MeshTp> filter(mesh);
 
     auto begin = filter.begin();
@@ -219,8 +220,8 @@ RelaxedFVMatrixAssemblyPolicy<MatrixPolicy>::relax(const MeshTp& mesh, const vec
 
           auto* cell = *begin;
 
-          cell->get_dofs(var_name_, dofs);
-          real_t diag_0 = D_.get(dofs[0].id);
+          const uint_t dof = dof_manager.get_dof(*cell).id;
+          real_t diag_0 = D_.get(dof);
 
            for(uint_t f=0; f<cell->n_faces(); ++f){
 
@@ -231,27 +232,28 @@ RelaxedFVMatrixAssemblyPolicy<MatrixPolicy>::relax(const MeshTp& mesh, const vec
                    get_internal_coefficients(face,internal_coeffs);
 
                    auto min_elem = std::min_element(internal_coeffs.begin(), internal_coeffs.end());
-                   D_.add(dofs[0].id, (std::fabs(*min_elem) - *min_elem));
-                   sum_off[dofs[0].id] += (std::fabs(*min_elem) - *min_elem);
+                   D_.add(dof, (std::fabs(*min_elem) - *min_elem));
+                   sum_off[dof] += (std::fabs(*min_elem) - *min_elem);
                }
            }
 
            //make sure that the matrix remains diagonally dominant
-           D_.set(dofs[0].id,std::max(std::fabs(D_.get(dofs[0].id)),sum_off[dofs[0].id]));
+           D_.set(dof,std::max(std::fabs(D_.get(dof)),sum_off[dof]));
 
            //then relax
-           D_.set(dofs[0].id, D_.get(dofs[0].id)/relax_factor_);
+           D_.set(dof, D_.get(dof)/relax_factor_);
 
-           const real_t old_sol = old_solution.get(dofs[0].id);
-           rhs_.add(dofs[0].id, (D_.get(dofs[0].id) - diag_0)*old_sol);
+           const real_t old_sol = old_solution.get(dof);
+           rhs_.add(dof, (D_.get(dof) - diag_0)*old_sol);
        }
 
 }
 
 template<typename MatrixPolicy>
-template<typename MeshTp>
+template<typename MeshTp, typename DoFManagerTp>
 void
-RelaxedFVMatrixAssemblyPolicy<MatrixPolicy>::sum_mag_off_diag(const MeshTp& mesh, std::vector<real_t> &sum_Off_diag)const
+RelaxedFVMatrixAssemblyPolicy<MatrixPolicy>::sum_mag_off_diag(const MeshTp& mesh, const DoFManagerTp& dof_manager,
+                                                              std::vector<real_t> &sum_Off_diag)const
 {
 
    ConstFaceMeshIterator<Active, MeshTp> filter(mesh);
@@ -259,20 +261,17 @@ RelaxedFVMatrixAssemblyPolicy<MatrixPolicy>::sum_mag_off_diag(const MeshTp& mesh
    auto begin = filter.begin();
    auto end = filter.end();
 
-   std::vector<DoF> dofs;
-   std::vector<DoF> neigh_dofs;
-
    for(; begin != end; ++begin){
 
     auto* face = *begin;
 
     if(face->on_boundary() == false){
 
-      face->owner_element()->get_dofs(var_name_, dofs);
-      face->shared_element()->get_dofs(var_name_, neigh_dofs);
+      const uint_t dof = dof_manager.get_dof(*face->owner_element()).id;
+      const uint_t neigh_dof = dof_manager.get_dof(*face->shared_element()).id;
 
-      sum_Off_diag[dofs[0].id]  += upper_D_entry(face->id());
-      sum_Off_diag[neigh_dofs[0].id] += lower_D_entry(face->id());
+      sum_Off_diag[dof]  += upper_D_entry(face->id());
+      sum_Off_diag[neigh_dof] += lower_D_entry(face->id());
     }
 
   }
@@ -13,6 +13,8 @@ std::string preconditioner_to_string(PreconditionerType type){
         return "ILU";
     case PreconditionerType::JACOBI:
         return "JACOBI";
+    case PreconditionerType::NONE:
+        return "NONE";
     }
 
     return "INVALID_PREC";
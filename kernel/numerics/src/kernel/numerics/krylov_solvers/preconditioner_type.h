@@ -8,7 +8,7 @@ namespace numerics{
 
 
   /// \brief  useful enumeration of the preconditioner types we support
-  enum class PreconditionerType{JACOBI, ILU,LU,ICC,INVALID_PREC};
+  enum class PreconditionerType{JACOBI, ILU,LU,ICC,NONE,INVALID_PREC};
 
   /// \brief Return a string with the preconditioner name
   std::string preconditioner_to_string(PreconditionerType type);
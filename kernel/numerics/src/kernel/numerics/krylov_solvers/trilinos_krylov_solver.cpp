@@ -42,6 +42,10 @@ TrilinosKrylovSolver::set_preconditioner()
         linear_solver_.SetAztecOption(AZ_subdomain_solve, AZ_lu);
       break;
 
+    case PreconditionerType::NONE:
+      linear_solver_.SetAztecOption(AZ_precond, AZ_none);
+      break;
+
     default:
         linear_solver_.SetAztecOption(AZ_precond, AZ_dom_decomp);
         linear_solver_.SetAztecOption(AZ_subdomain_solve, AZ_ilu);
@@ -153,6 +157,47 @@ TrilinosKrylovSolver::solve(const TrilinosEpetraMatrix& A, TrilinosEpetraVector&
 
 }
 
+TrilinosKrylovSolver::output_t
+TrilinosKrylovSolver::solve(const Epetra_Operator& A, TrilinosEpetraVector& x, const TrilinosEpetraVector& b){
+
+   std::chrono::time_point<std::chrono::system_clock> start, end;
+   start = std::chrono::system_clock::now();
+   KrylovSolverResult result;
+
+   result.nprocs = 1;
+   result.nthreads = 1;
+   result.solver_type = data_.solver_type;
+   result.precondioner_type = PreconditionerType::NONE;
+
+   if(data_.n_iterations == 0){
+       data_.n_iterations = A.OperatorRangeMap().NumGlobalElements();
+   }
+
+   if(data_.tolerance == std::numeric_limits<real_t>::max()){
+       data_.tolerance = KernelConsts::tolerance();
+   }
+
+   linear_solver_.SetAztecOption(AZ_max_iter, data_.n_iterations);
+   linear_solver_.SetAztecParam(AZ_tol, data_.tolerance);
+   linear_solver_.SetAztecOption(AZ_precond, AZ_none);
+
+   linear_solver_.SetUserOperator(const_cast<Epetra_Operator*>(&A));
+   linear_solver_.SetLHS(x.get_vector());
+   linear_solver_.SetRHS(const_cast<TrilinosEpetraVector&>(b).get_vector());
+
+   linear_solver_.Iterate(data_.n_iterations, data_.tolerance);
+
+   end = std::chrono::system_clock::now();
+
+   result.runtime = end-start;
+   result.niterations = linear_solver_.NumIters();
+   result.residual = linear_solver_.TrueResidual();
+
+   // restore the preconditioner for the matrix based solves
+   set_preconditioner();
+   return result;
+}
+
 }
 
 }
@@ -57,6 +57,13 @@ public:
     output_t solve(const TrilinosEpetraMatrix& A,
                  TrilinosEpetraVector& x, const TrilinosEpetraVector& b);
 
+    /// \brief Solve the system whose matrix is only known through
+    /// its action e.g. an FVEpetraOperator. There is no matrix
+    /// to build a preconditioner from so the system is solved
+    /// unpreconditioned
+    output_t solve(const Epetra_Operator& A,
+                 TrilinosEpetraVector& x, const TrilinosEpetraVector& b);
+
 protected:
 
     /// \brief set the preconditioner that the solver uses
@@ -14,11 +14,15 @@
 #include "kernel/discretization/mesh_predicates.h"
 #include "kernel/discretization/element.h"
 #include "kernel/discretization/vtk_writer.h"
+#include "kernel/discretization/mesh_checkpoint.h"
+#include "kernel/utilities/checkpoint_file.h"
 
 #include <boost/noncopyable.hpp>
 #include <string>
 #include <memory>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 namespace kernel{
 namespace numerics{
@@ -73,6 +77,26 @@ public:
     ///
     virtual void save_solution(const std::string& file_name)const;
 
+    ///
+    /// \brief Write the mesh topology, the DoF map and the solution
+    /// into a binary checkpoint that load_checkpoint can restart from
+    ///
+    void save_checkpoint(const std::string& file_name)const;
+
+    ///
+    /// \brief Take a snapshot of the checkpoint data and write it
+    /// in the background. The solution can be modified as soon as
+    /// this returns so the I/O overlaps with the next time step
+    ///
+    void save_checkpoint(AsyncCheckpointWriter& writer, const std::string& file_name)const;
+
+    ///
+    /// \brief Restore the solution from a checkpoint. The dofs should
+    /// be distributed on the mesh the checkpoint was written from.
+    /// Throws std::logic_error if the mesh or the DoF map differ
+    ///
+    void load_checkpoint(const std::string& file_name);
+
     ///
     /// \brief Returns the number of dofs
     ///
@@ -85,6 +109,27 @@ public:
 
 protected:
 
+    ///
+    /// \brief Collect the data of the system into a checkpoint
+    ///
+    virtual CheckpointWriter make_checkpoint()const;
+
+    ///
+    /// \brief Restore the data of the system from the checkpoint
+    ///
+    virtual void read_checkpoint(const CheckpointReader& checkpoint);
+
+    ///
+    /// \brief Copy the values of the given vector
+    ///
+    static std::vector<real_t> vector_values(const vector_t& vec);
+
+    ///
+    /// \brief Copy the checkpoint values into the given vector.
+    /// Throws std::logic_error if the sizes differ
+    ///
+    static void assign_vector_values(const CheckpointView<real_t>& values, vector_t& vec);
+
     ///
     /// \brief The object that manages the DoFs for the system
     ///
@@ -164,6 +209,88 @@ ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>::save_solution(const std::st
 
 }
 
+template<int dim, typename AssemblyPolicy, typename SolutionPolicy>
+void
+ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>::save_checkpoint(const std::string& file_name)const{
+
+    make_checkpoint().write(file_name);
+}
+
+template<int dim, typename AssemblyPolicy, typename SolutionPolicy>
+void
+ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>::save_checkpoint(AsyncCheckpointWriter& writer,
+                                                                     const std::string& file_name)const{
+
+    // the checkpoint owns copies of the data so
+    // the system can continue while it is written
+    writer.write(make_checkpoint(), file_name);
+}
+
+template<int dim, typename AssemblyPolicy, typename SolutionPolicy>
+void
+ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>::load_checkpoint(const std::string& file_name){
+
+    CheckpointReader checkpoint(file_name);
+    read_checkpoint(checkpoint);
+}
+
+template<int dim, typename AssemblyPolicy, typename SolutionPolicy>
+void
+ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>::read_checkpoint(const CheckpointReader& checkpoint){
+
+    if(!this->m_ptr_){
+        throw std::logic_error("Mesh pointer is null");
+    }
+
+    check_mesh_sections(checkpoint, *this->m_ptr_);
+    check_dof_sections(checkpoint, *this->m_ptr_, dofs_manager_);
+
+    assign_vector_values(checkpoint.get_real_section("solution"), this->solution_);
+}
+
+template<int dim, typename AssemblyPolicy, typename SolutionPolicy>
+CheckpointWriter
+ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>::make_checkpoint()const{
+
+    if(!this->m_ptr_){
+        throw std::logic_error("Mesh pointer is null");
+    }
+
+    CheckpointWriter checkpoint;
+    add_mesh_sections(checkpoint, *this->m_ptr_);
+    add_dof_sections(checkpoint, *this->m_ptr_, dofs_manager_);
+    checkpoint.add_section("solution", vector_values(this->solution_));
+    return checkpoint;
+}
+
+template<int dim, typename AssemblyPolicy, typename SolutionPolicy>
+std::vector<real_t>
+ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>::vector_values(const vector_t& vec){
+
+    std::vector<real_t> values(vec.size());
+
+    for(uint_t i=0; i<values.size(); ++i){
+        values[i] = vec[i];
+    }
+
+    return values;
+}
+
+template<int dim, typename AssemblyPolicy, typename SolutionPolicy>
+void
+ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>::assign_vector_values(const CheckpointView<real_t>& values,
+                                                                          vector_t& vec){
+
+    if(values.size() != vec.size()){
+        throw std::logic_error("The checkpoint vector has "+std::to_string(values.size())+
+                               " values but the system vector has "+std::to_string(vec.size()));
+    }
+
+    for(uint_t i=0; i<values.size(); ++i){
+        vec[i] = values[i];
+    }
+}
+
 
 
 }
@@ -6,11 +6,47 @@
 #ifdef USE_FVM
 
 #include "kernel/numerics/pdes/fv_scalar_system.h"
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_output.h"
+
+#ifdef USE_TRILINOS
+#include "kernel/numerics/krylov_solvers/trilinos_krylov_solver.h"
+#include "kernel/maths/trilinos_epetra_vector.h"
+#endif
+
+#include <chrono>
 #include <vector>
+#include <stdexcept>
 
 namespace kernel {
 namespace numerics {
 
+namespace detail{
+
+/// \brief Solve with the matrix-free operator. Only the
+/// Trilinos solvers accept an operator so any other
+/// solver throws std::logic_error
+template<int dim, typename Solver, typename Vector>
+KrylovSolverResult
+matrix_free_solve(Solver& /*solver*/, const FVMatrixFreeOperator<dim>& /*op*/,
+                  Vector& /*x*/, const Vector& /*b*/){
+    throw std::logic_error("The matrix-free mode requires the Trilinos solution policy");
+}
+
+#ifdef USE_TRILINOS
+template<int dim>
+KrylovSolverResult
+matrix_free_solve(TrilinosKrylovSolver& solver, const FVMatrixFreeOperator<dim>& op,
+                  TrilinosEpetraVector& x, const TrilinosEpetraVector& b){
+
+    FVEpetraOperator<dim> epetra_op(op);
+    return solver.solve(epetra_op, x, b);
+}
+#endif
+
+}
+
 template<int dim, typename TimeStepper, typename AssemblePolicy, typename SolutionPolicy>
 class FVScalarTimedSystem: public ScalarFVSystem<dim, AssemblePolicy, SolutionPolicy>
 {
@@ -56,14 +92,94 @@ public:
     /// \brief Return the i-th old solution vector
     vector_t& get_old_solution_vector(uint_t s){return old_solutions_[s];}
 
+    /// \brief Advance the simulation time by one time step
+    void advance_time(){time_ += stepper_.time_step(); n_time_steps_++;}
+
+    /// \brief Set the simulation time and the number of time steps taken
+    void set_time(real_t time, uint_t n_time_steps){time_ = time; n_time_steps_ = n_time_steps;}
+
+    /// \brief The simulation time. It is saved in the
+    /// checkpoint and restored by load_checkpoint
+    real_t get_time()const{return time_;}
+
+    /// \brief The number of time steps taken. It is saved in
+    /// the checkpoint and restored by load_checkpoint
+    uint_t n_time_steps()const{return n_time_steps_;}
+
+    /// \brief The time in seconds spent computing and inserting the
+    /// sparsity pattern. This happens once in distribute_dofs
+    real_t pattern_assembly_time()const{return pattern_time_.count();}
+
+    /// \brief The time in seconds the last assemble_system call spent
+    /// writing the matrix and vector values
+    real_t value_assembly_time()const{return value_time_.count();}
+
+    /// \brief The accumulated time in seconds of all the assemble_system calls
+    real_t total_value_assembly_time()const{return total_value_time_.count();}
+
+    /// \brief How many times assemble_system has been called
+    uint_t n_value_assemblies()const{return n_assemblies_;}
+
+    /// \brief Solve without assembling the matrix. assemble_system then builds
+    /// the FVMatrixFreeOperator from the face geometry cache and solve hands
+    /// it to the Krylov solver. The operator reproduces the Laplace and the
+    /// upwind convection policies so its diffusion coefficient and velocity
+    /// should be set through get_matrix_free_operator(). The time derivative
+    /// is discretized with backward Euler. It should be set before
+    /// distribute_dofs as the sparsity pattern is then not computed
+    void set_matrix_free(bool matrix_free){matrix_free_ = matrix_free;}
+
+    /// \brief Returns true if the system is solved matrix-free
+    bool is_matrix_free()const{return matrix_free_;}
+
+    /// \brief Read/write access to the matrix-free operator
+    FVMatrixFreeOperator<dim>& get_matrix_free_operator(){return matrix_free_op_;}
+
+    /// \brief Read access to the matrix-free operator
+    const FVMatrixFreeOperator<dim>& get_matrix_free_operator()const{return matrix_free_op_;}
+
 protected:
 
+    /// \brief Collect the solution, the old solution vectors,
+    /// the time and the time step number into a checkpoint
+    virtual CheckpointWriter make_checkpoint()const override;
+
+    /// \brief Restore the solution, the old solution vectors,
+    /// the time and the time step number from the checkpoint
+    virtual void read_checkpoint(const CheckpointReader& checkpoint)override;
+
+    /// \brief Build the matrix-free operator and the right hand side
+    void assemble_matrix_free_();
+
+    /// \brief The name of the section of the s-th old solution
+    static std::string old_solution_section(uint_t s){return "old_solution_" + std::to_string(s);}
+
     /// \brief The old solutions vector
     std::vector<vector_t> old_solutions_;
 
     /// \brief the object responsible for time stepping
     time_stepper_t stepper_;
 
+    /// \brief The simulation time and the number of time steps taken
+    real_t time_;
+    uint_t n_time_steps_;
+
+    /// \brief The face geometry of the mesh. The mesh does not
+    /// change between time steps so this is built once
+    FVFaceGeometryCache<dim> face_cache_;
+
+    /// \brief Flag indicating whether the system is solved matrix-free
+    bool matrix_free_;
+
+    /// \brief The operator used in the matrix-free mode
+    FVMatrixFreeOperator<dim> matrix_free_op_;
+
+    /// \brief Assembly timings
+    std::chrono::duration<real_t> pattern_time_;
+    std::chrono::duration<real_t> value_time_;
+    std::chrono::duration<real_t> total_value_time_;
+    uint_t n_assemblies_;
+
 };
 
 template<int dim, typename TimeStepper, typename AssemblyPolicy, typename SolutionPolicy>
@@ -71,7 +187,16 @@ FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy>::FVScalarT
     :
    ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>(sys_name, var_name),
    old_solutions_(),
-   stepper_()
+   stepper_(),
+   time_(0.0),
+   n_time_steps_(0),
+   face_cache_(),
+   matrix_free_(false),
+   matrix_free_op_(),
+   pattern_time_(0.0),
+   value_time_(0.0),
+   total_value_time_(0.0),
+   n_assemblies_(0)
 {}
 
 
@@ -80,7 +205,16 @@ FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::FVScalar
     :
       ScalarFVSystem<dim, AssemblyPolicy, SolutionPolicy>(std::move(sys_name), std::move(var_name), mesh),
       old_solutions_(),
-      stepper_()
+      stepper_(),
+      time_(0.0),
+      n_time_steps_(0),
+      face_cache_(),
+      matrix_free_(false),
+      matrix_free_op_(),
+      pattern_time_(0.0),
+      value_time_(0.0),
+      total_value_time_(0.0),
+      n_assemblies_(0)
 {}
 
 template<int dim, typename TimeStepper, typename AssemblyPolicy, typename SolutionPolicy>
@@ -98,9 +232,26 @@ FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::distribu
     }
 
     this->dofs_manager_.distribute_dofs(*this->m_ptr_, this->var_);
+    face_cache_.build(*this->m_ptr_);
+
+    // the mesh does not change between time steps so the
+    // sparsity pattern is computed and inserted only once.
+    // assemble_system then only overwrites the values
+    auto start = std::chrono::steady_clock::now();
+
+    if(!matrix_free_){
+
+        std::vector<uint_t> row_offsets;
+        std::vector<uint_t> columns;
+        this->dofs_manager_.sparsity_pattern(*this->m_ptr_, row_offsets, columns);
+        this->matrix_.init(row_offsets, columns);
+    }
+
+    pattern_time_ = std::chrono::steady_clock::now() - start;
+    value_time_ = std::chrono::duration<real_t>(0.0);
+    total_value_time_ = std::chrono::duration<real_t>(0.0);
+    n_assemblies_ = 0;
 
-    // let's initialize the matrix and vector
-    this->matrix_.init(this->dofs_manager_.n_dofs(), this->dofs_manager_.n_dofs(), 6);
     this->solution_.init(this->dofs_manager_.n_dofs(), false);
     this->rhs_.init(this->dofs_manager_.n_dofs(), false);
 
@@ -116,7 +267,15 @@ template<int dim, typename TimeStepper, typename AssemblyPolicy, typename Soluti
 void
 FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::assemble_system(){
 
-    // zero the system entries
+    if(matrix_free_){
+        assemble_matrix_free_();
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // zero the system entries. This
+    // keeps the matrix pattern
     this->matrix_.zero();
     this->rhs_.zero();
     this->solution_.zero();
@@ -137,23 +296,98 @@ FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::assemble
     }
 
     this->assembly_.set_mesh(*this->m_ptr_);
+    this->assembly_.set_face_geometry_cache(face_cache_);
     this->assembly_.assemble(this->matrix_, this->solution_, this->rhs_);
 
     stepper_.set_mesh(*this->m_ptr_);
     stepper_.assemble(this->matrix_, this->solution_, this->rhs_, old_solutions_);
 
-    this->matrix_.fill_completed();
+    // the matrix is filled when the pattern is inserted
+    if(!this->matrix_.is_filled()){
+        this->matrix_.fill_completed();
+    }
+
     this->solution_.compress();
     this->rhs_.compress();
+
+    value_time_ = std::chrono::steady_clock::now() - start;
+    total_value_time_ += value_time_;
+    n_assemblies_++;
 }
 
 template<int dim, typename TimeStepper, typename AssemblyPolicy, typename SolutionPolicy>
 typename FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::solver_output_t
 FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::solve(){
 
+    if(matrix_free_){
+        return detail::matrix_free_solve(this->solver_, matrix_free_op_, this->solution_, this->rhs_);
+    }
+
     return this->solver_.solve(this->matrix_, this->solution_, this->rhs_);
 }
 
+template<int dim, typename TimeStepper, typename AssemblyPolicy, typename SolutionPolicy>
+void
+FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::assemble_matrix_free_(){
+
+    if(!face_cache_.is_built()){
+        throw std::logic_error("distribute_dofs should be called before assemble_system");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    this->rhs_.zero();
+    this->solution_.zero();
+
+    if(this->boundary_func_){
+        matrix_free_op_.set_boundary_function(*this->boundary_func_);
+    }
+
+    if(this->rhs_func_){
+        matrix_free_op_.set_rhs_function(*this->rhs_func_);
+    }
+
+    if(this->volume_func_){
+        matrix_free_op_.set_volume_term_function(*this->volume_func_);
+    }
+
+    // backward Euler: volume/dt on the diagonal
+    // and old_solution*volume/dt on the right hand side
+    const bool timed = !old_solutions_.empty();
+    const real_t mass_coeff = timed ? 1.0/stepper_.time_step() : 0.0;
+
+    matrix_free_op_.set_mass_coefficient(mass_coeff);
+    matrix_free_op_.build(*this->m_ptr_, face_cache_, this->dofs_manager_);
+
+    const auto& rhs = matrix_free_op_.rhs();
+    for(uint_t r=0; r<rhs.size(); ++r){
+        this->rhs_.set_entry(r, rhs[r]);
+    }
+
+    if(timed){
+
+        ConstElementMeshIterator<Active, Mesh<dim>> filter(*this->m_ptr_);
+
+        auto elem_itr = filter.begin();
+        auto elem_itr_e = filter.end();
+
+        for(; elem_itr != elem_itr_e; ++elem_itr){
+
+            auto* elem = *elem_itr;
+            auto dof = this->dofs_manager_.get_dof(*elem);
+            auto volume = face_cache_.element_volume(elem->get_id());
+            this->rhs_.add(dof.id, old_solutions_[0][dof.id]*volume*mass_coeff);
+        }
+    }
+
+    this->solution_.compress();
+    this->rhs_.compress();
+
+    value_time_ = std::chrono::steady_clock::now() - start;
+    total_value_time_ += value_time_;
+    n_assemblies_++;
+}
+
 template<int dim, typename TimeStepper, typename AssemblyPolicy, typename SolutionPolicy>
 void
 FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::save_solution(const std::string& file_name)const{
@@ -164,6 +398,43 @@ FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::save_sol
 
 }
 
+template<int dim, typename TimeStepper, typename AssemblyPolicy, typename SolutionPolicy>
+CheckpointWriter
+FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::make_checkpoint()const{
+
+    auto checkpoint = this->base_t::make_checkpoint();
+
+    for(uint_t s=0; s<old_solutions_.size(); ++s){
+        checkpoint.add_section(old_solution_section(s), this->vector_values(old_solutions_[s]));
+    }
+
+    checkpoint.add_value("time", time_);
+    checkpoint.add_section("time_step_number", std::vector<uint_t>(1, n_time_steps_));
+
+    return checkpoint;
+}
+
+template<int dim, typename TimeStepper, typename AssemblyPolicy, typename SolutionPolicy>
+void
+FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::read_checkpoint(const CheckpointReader& checkpoint){
+
+    this->base_t::read_checkpoint(checkpoint);
+
+    for(uint_t s=0; s<old_solutions_.size(); ++s){
+        this->assign_vector_values(checkpoint.get_real_section(old_solution_section(s)), old_solutions_[s]);
+    }
+
+    auto step = checkpoint.get_uint_section("time_step_number");
+
+    if(step.size() != 1){
+        throw std::logic_error("The checkpoint time step number has "+std::to_string(step.size())+
+                               " values but 1 is expected");
+    }
+
+    time_ = checkpoint.get_value("time");
+    n_time_steps_ = step[0];
+}
+
 
 }
 }
@@ -0,0 +1,165 @@
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
+#include "kernel/numerics/fvm/fv_ud_interpolation.h"
+#include "kernel/maths/functions/numeric_vector_function.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+/// \brief Velocity field that changes direction inside the domain
+class Velocity: public kernel::numerics::NumericVectorFunctionBase<2>
+{
+public:
+
+    virtual kernel::DynVec<kernel::real_t> value(const kernel::GeomPoint<2>& p)const override final{
+
+        kernel::DynVec<kernel::real_t> v(2, 0.0);
+        v[0] = p[0] - 1.0;
+        v[1] = 0.5 - p[1];
+        return v;
+    }
+};
+
+}
+
+TEST(TestFVFaceGeometryCache, TestDefaultConstruction) {
+
+    /***
+       * Test Scenario:    The application attempts to instantiate an empty FVFaceGeometryCache
+       * Expected Output:  The cache is not built and holds no faces
+     **/
+
+    using kernel::uint_t;
+    using kernel::numerics::FVFaceGeometryCache;
+
+    FVFaceGeometryCache<2> cache;
+    ASSERT_FALSE(cache.is_built());
+    ASSERT_EQ(cache.n_faces(), static_cast<uint_t>(0));
+}
+
+TEST(TestFVFaceGeometryCache, TestBuildFromQuadMesh) {
+
+    /***
+       * Test Scenario:    The application builds the cache for a quad mesh
+       * Expected Output:  The cached face data matches what the faces of the mesh compute
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::KernelConsts;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVFaceGeometryCache;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 5, 4, GeomPoint<2>(0.0), GeomPoint<2>(2.0));
+
+    FVFaceGeometryCache<2> cache(mesh);
+
+    ASSERT_TRUE(cache.is_built());
+    ASSERT_EQ(cache.n_faces(), mesh.n_faces());
+    ASSERT_EQ(cache.n_elements(), mesh.n_elements());
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        auto* elem = mesh.element(e);
+        const uint_t id = elem->get_id();
+
+        ASSERT_EQ(cache.n_element_faces(id), elem->n_faces());
+        ASSERT_DOUBLE_EQ(cache.element_volume(id), elem->volume());
+
+        for(uint_t f=0; f<elem->n_faces(); ++f){
+
+            const auto& face = elem->get_face(f);
+            const uint_t idx = cache.face_index(id, f);
+
+            ASSERT_EQ(cache.on_boundary(idx), face.on_boundary());
+            ASSERT_EQ(cache.boundary_indicator(idx), face.boundary_indicator());
+            ASSERT_EQ(cache.is_owner(idx, id), face.is_owner(id));
+            ASSERT_DOUBLE_EQ(cache.area(idx), face.volume());
+            ASSERT_DOUBLE_EQ(cache.weight(idx), face.volume()/face.owner_neighbor_distance());
+            ASSERT_DOUBLE_EQ(cache.centroid(idx)[0], face.centroid()[0]);
+            ASSERT_DOUBLE_EQ(cache.centroid(idx)[1], face.centroid()[1]);
+
+            auto normal = face.normal_vector();
+            ASSERT_DOUBLE_EQ(cache.normal(idx, 0), normal[0]);
+            ASSERT_DOUBLE_EQ(cache.normal(idx, 1), normal[1]);
+
+            auto* neigh = elem->neighbor_ptr(f);
+            if(!neigh){
+                ASSERT_EQ(cache.neighbor(idx), KernelConsts::invalid_size_type());
+                ASSERT_EQ(cache.owner(idx), id);
+            }
+            else if(cache.is_owner(idx, id)){
+                ASSERT_EQ(cache.neighbor(idx), neigh->get_id());
+            }
+            else{
+                ASSERT_EQ(cache.owner(idx), neigh->get_id());
+                ASSERT_EQ(cache.neighbor(idx), id);
+            }
+        }
+    }
+}
+
+TEST(TestFVFaceGeometryCache, TestInterpolationFallbackWithoutCacheSupport) {
+
+    /***
+       * Test Scenario:    The application calls the cached overloads of FVInterpolateBase
+       *                   that a scheme without cache support inherits
+       * Expected Output:  They compute the same fluxes and matrix contributions as the
+       *                   cached overloads of FVUDInterpolate
+     **/
+
+    using kernel::uint_t;
+    using kernel::real_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVFaceGeometryCache;
+    using kernel::numerics::FVInterpolateBase;
+    using kernel::numerics::FVUDInterpolate;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 5, 4, GeomPoint<2>(0.0), GeomPoint<2>(2.0));
+
+    FVFaceGeometryCache<2> cache(mesh);
+    Velocity velocity;
+    FVUDInterpolate<2> interpolate(velocity);
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        auto* elem = mesh.element(e);
+
+        std::vector<real_t> cached;
+        std::vector<real_t> fallback;
+        interpolate.compute_fluxes(*elem, cache, cached);
+        interpolate.FVInterpolateBase<2>::compute_fluxes(*elem, cache, fallback);
+
+        ASSERT_EQ(cached.size(), fallback.size());
+        for(uint_t f=0; f<cached.size(); ++f){
+            ASSERT_NEAR(cached[f], fallback[f], 1.0e-12);
+        }
+
+        const uint_t n_entries = elem->n_neighbors() + 1;
+        std::vector<real_t> cached_entries(n_entries, 0.0);
+        std::vector<real_t> fallback_entries(n_entries, 0.0);
+        interpolate.compute_matrix_contributions(*elem, cache, cached_entries);
+        interpolate.FVInterpolateBase<2>::compute_matrix_contributions(*elem, cache, fallback_entries);
+
+        for(uint_t k=0; k<n_entries; ++k){
+            ASSERT_NEAR(cached_entries[k], fallback_entries[k], 1.0e-12);
+        }
+    }
+}
+
+#endif
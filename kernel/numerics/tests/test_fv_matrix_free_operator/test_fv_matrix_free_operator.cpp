@@ -0,0 +1,402 @@
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
+#include "kernel/numerics/fvm/fv_face_geometry_cache.h"
+#include "kernel/numerics/boundary_function_base.h"
+#include "kernel/numerics/boundary_conditions_type.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+
+#ifdef USE_TRILINOS
+#include "kernel/numerics/fvm/fv_laplace_assemble_policy.h"
+#include "kernel/numerics/fvm/fv_convection_assemble_policy.h"
+#include "kernel/numerics/fvm/fv_grad_factory.h"
+#include "kernel/numerics/fvm/fv_grad_types.h"
+#include "kernel/numerics/fvm/fv_interpolation_factory.h"
+#include "kernel/numerics/fvm/fv_interpolation_types.h"
+#include "kernel/numerics/fvm/fv_ud_interpolation.h"
+#include "kernel/maths/functions/numeric_vector_function.h"
+#include "kernel/maths/trilinos_epetra_matrix.h"
+#include "kernel/maths/trilinos_epetra_vector.h"
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+struct Variable
+{
+    const std::string& name()const{return name_;}
+    std::string name_{"U"};
+};
+
+class UnitDirichlet: public kernel::numerics::BoundaryFunctionBase<2>
+{
+public:
+
+    UnitDirichlet()
+        :
+        kernel::numerics::BoundaryFunctionBase<2>()
+    {
+        for(kernel::uint_t b=0; b<4; ++b){
+            set_bc_type(b, kernel::numerics::BCType::DIRICHLET);
+        }
+    }
+
+    virtual output_t value(const kernel::GeomPoint<2>&  input)const override{return 1.0;}
+};
+
+#ifdef USE_TRILINOS
+
+/// \brief Dirichlet on the first two boundaries,
+/// the given type on the other two
+class MixedBoundary: public kernel::numerics::BoundaryFunctionBase<2>
+{
+public:
+
+    explicit MixedBoundary(kernel::numerics::BCType type)
+        :
+        kernel::numerics::BoundaryFunctionBase<2>()
+    {
+        set_bc_type(0, kernel::numerics::BCType::DIRICHLET);
+        set_bc_type(1, kernel::numerics::BCType::DIRICHLET);
+        set_bc_type(2, type);
+        set_bc_type(3, type);
+    }
+
+    virtual output_t value(const kernel::GeomPoint<2>&  input)const override{return 1.0 + input[0] - 2.0*input[1];}
+
+    virtual kernel::DynVec<kernel::real_t> gradients(const kernel::GeomPoint<2>&  input)const override{
+
+        kernel::DynVec<kernel::real_t> grad(2, 0.0);
+        grad[0] = 1.0;
+        grad[1] = -2.0;
+        return grad;
+    }
+};
+
+/// \brief Velocity field that changes direction inside the domain
+class Velocity: public kernel::numerics::NumericVectorFunctionBase<2>
+{
+public:
+
+    virtual kernel::DynVec<kernel::real_t> value(const kernel::GeomPoint<2>& p)const override final{
+
+        kernel::DynVec<kernel::real_t> v(2, 0.0);
+        v[0] = p[0] - 1.0;
+        v[1] = 0.5 - p[1];
+        return v;
+    }
+};
+
+/// \brief Assert that the operator applied to x matches the
+/// assembled matrix and that both right hand sides agree
+void
+assert_matches_matrix(const kernel::numerics::FVMatrixFreeOperator<2>& op,
+                      const kernel::numerics::TrilinosEpetraMatrix& mat,
+                      const kernel::numerics::TrilinosEpetraVector& b){
+
+    using kernel::uint_t;
+    using kernel::real_t;
+
+    const uint_t n = op.n_dofs();
+
+    std::vector<real_t> x(n);
+    for(uint_t r=0; r<n; ++r){
+        x[r] = 1.0 + static_cast<real_t>((5*r) % 7) - 0.25*static_cast<real_t>(r % 3);
+    }
+
+    std::vector<real_t> y;
+    op.apply(x, y);
+
+    for(uint_t r=0; r<n; ++r){
+
+        real_t expected = 0.0;
+        for(uint_t c=0; c<n; ++c){
+            expected += mat.entry(r, c)*x[c];
+        }
+
+        ASSERT_NEAR(y[r], expected, 1.0e-10);
+        ASSERT_NEAR(op.rhs()[r], b[r], 1.0e-10);
+    }
+}
+
+#endif
+
+}
+
+TEST(TestFVMatrixFreeOperator, TestPureLaplaceIsSymmetric) {
+
+    /***
+       * Test Scenario:    The application builds the Laplace operator without boundary conditions
+       * Expected Output:  Constants are in the null space and the operator is symmetric
+     **/
+
+    using kernel::uint_t;
+    using kernel::real_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVDoFManager;
+    using kernel::numerics::FVFaceGeometryCache;
+    using kernel::numerics::FVMatrixFreeOperator;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 6, 5, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    Variable var;
+    FVDoFManager<2> manager;
+    manager.distribute_dofs(mesh, var);
+
+    FVFaceGeometryCache<2> cache(mesh);
+    FVMatrixFreeOperator<2> op;
+    op.build(mesh, cache, manager);
+
+    ASSERT_EQ(op.n_dofs(), manager.n_dofs());
+    ASSERT_EQ(op.n_interior_faces(), static_cast<uint_t>(6*4 + 5*5));
+
+    std::vector<real_t> ones(op.n_dofs(), 1.0);
+    std::vector<real_t> y;
+    op.apply(ones, y);
+
+    for(uint_t r=0; r<op.n_dofs(); ++r){
+        ASSERT_NEAR(y[r], 0.0, 1.0e-12);
+    }
+
+    std::vector<real_t> x1(op.n_dofs());
+    std::vector<real_t> x2(op.n_dofs());
+    for(uint_t r=0; r<op.n_dofs(); ++r){
+        x1[r] = static_cast<real_t>(r % 7);
+        x2[r] = static_cast<real_t>((3*r) % 5) - 2.0;
+    }
+
+    std::vector<real_t> y1;
+    std::vector<real_t> y2;
+    op.apply(x1, y1);
+    op.apply(x2, y2);
+
+    real_t dot1 = 0.0;
+    real_t dot2 = 0.0;
+    for(uint_t r=0; r<op.n_dofs(); ++r){
+        dot1 += x2[r]*y1[r];
+        dot2 += x1[r]*y2[r];
+    }
+
+    ASSERT_NEAR(dot1, dot2, 1.0e-10);
+}
+
+TEST(TestFVMatrixFreeOperator, TestDirichletMatchesFaceSweep) {
+
+    /***
+       * Test Scenario:    The application builds the Laplace operator with Dirichlet boundaries
+       * Expected Output:  Applying the operator and the rhs match the two point
+       *                   flux stencil computed from the mesh faces
+     **/
+
+    using kernel::uint_t;
+    using kernel::real_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVDoFManager;
+    using kernel::numerics::FVFaceGeometryCache;
+    using kernel::numerics::FVMatrixFreeOperator;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 5, 4, GeomPoint<2>(0.0), GeomPoint<2>(2.0));
+
+    Variable var;
+    FVDoFManager<2> manager;
+    manager.distribute_dofs(mesh, var);
+
+    UnitDirichlet bc;
+    FVFaceGeometryCache<2> cache(mesh);
+    FVMatrixFreeOperator<2> op;
+    op.set_boundary_function(bc);
+    op.build(mesh, cache, manager);
+
+    std::vector<real_t> x(op.n_dofs());
+    for(uint_t r=0; r<op.n_dofs(); ++r){
+        x[r] = 1.0 + 0.5*static_cast<real_t>(r);
+    }
+
+    std::vector<real_t> y;
+    op.apply(x, y);
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        auto* elem = mesh.element(e);
+        const uint_t row = manager.get_dof(*elem).id;
+
+        real_t expected = 0.0;
+        real_t expected_rhs = 0.0;
+
+        for(uint_t f=0; f<elem->n_faces(); ++f){
+
+            const auto& face = elem->get_face(f);
+            const real_t w = face.volume()/face.owner_neighbor_distance();
+
+            if(face.on_boundary()){
+                expected += w*x[row];
+                expected_rhs += w;
+            }
+            else{
+                const uint_t col = manager.get_dof(*elem->neighbor_ptr(f)).id;
+                expected += w*(x[row] - x[col]);
+            }
+        }
+
+        ASSERT_NEAR(y[row], expected, 1.0e-10);
+        ASSERT_NEAR(op.rhs()[row], expected_rhs, 1.0e-10);
+    }
+
+    ASSERT_GT(op.norm_inf(), 0.0);
+}
+
+#ifdef USE_TRILINOS
+
+TEST(TestFVMatrixFreeOperator, TestLaplaceMatchesAssembledMatrix) {
+
+    /***
+       * Test Scenario:    The application builds the Laplace operator with Dirichlet,
+       *                   Neumann and zero Neumann boundaries and assembles the same
+       *                   problem with FVLaplaceAssemblyPolicy
+       * Expected Output:  Applying the operator and the rhs match the assembled system
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::BCType;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVDoFManager;
+    using kernel::numerics::FVFaceGeometryCache;
+    using kernel::numerics::FVMatrixFreeOperator;
+    using kernel::numerics::FVLaplaceAssemblyPolicy;
+    using kernel::numerics::TrilinosEpetraMatrix;
+    using kernel::numerics::TrilinosEpetraVector;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 5, 4, GeomPoint<2>(0.0), GeomPoint<2>(2.0));
+
+    Variable var;
+    FVDoFManager<2> manager;
+    manager.distribute_dofs(mesh, var);
+
+    FVFaceGeometryCache<2> cache(mesh);
+
+    for(auto type : {BCType::NEUMANN, BCType::ZERO_NEUMANN}){
+
+        MixedBoundary bc(type);
+
+        std::vector<uint_t> row_offsets;
+        std::vector<uint_t> columns;
+        manager.sparsity_pattern(mesh, row_offsets, columns);
+
+        TrilinosEpetraMatrix mat;
+        mat.init(row_offsets, columns);
+
+        TrilinosEpetraVector x;
+        x.init(manager.n_dofs(), false);
+
+        TrilinosEpetraVector b;
+        b.init(manager.n_dofs(), false);
+
+        FVLaplaceAssemblyPolicy<2> assembly;
+        assembly.build_gradient([](){
+            return kernel::numerics::FVGradFactory<2>::build(kernel::numerics::FVGradType::GAUSS);
+        });
+
+        assembly.set_dof_manager(manager);
+        assembly.set_mesh(mesh);
+        assembly.set_face_geometry_cache(cache);
+        assembly.set_boundary_function(bc);
+        assembly.assemble(mat, x, b);
+
+        FVMatrixFreeOperator<2> op;
+        op.set_boundary_function(bc);
+        op.build(mesh, cache, manager);
+
+        assert_matches_matrix(op, mat, b);
+    }
+}
+
+TEST(TestFVMatrixFreeOperator, TestUpwindConvectionMatchesAssembledMatrix) {
+
+    /***
+       * Test Scenario:    The application builds the upwind convection operator for a velocity
+       *                   that changes direction inside the domain with Dirichlet and zero
+       *                   Neumann boundaries and assembles the same problem with
+       *                   FVConvectionAssemblyPolicy and the UD interpolation
+       * Expected Output:  Applying the operator and the rhs match the assembled system
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::BCType;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVDoFManager;
+    using kernel::numerics::FVFaceGeometryCache;
+    using kernel::numerics::FVMatrixFreeOperator;
+    using kernel::numerics::FVConvectionAssemblyPolicy;
+    using kernel::numerics::FVUDInterpolate;
+    using kernel::numerics::TrilinosEpetraMatrix;
+    using kernel::numerics::TrilinosEpetraVector;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 6, 5, GeomPoint<2>(0.0), GeomPoint<2>(2.0));
+
+    Variable var;
+    FVDoFManager<2> manager;
+    manager.distribute_dofs(mesh, var);
+
+    FVFaceGeometryCache<2> cache(mesh);
+    MixedBoundary bc(BCType::ZERO_NEUMANN);
+    Velocity velocity;
+
+    std::vector<uint_t> row_offsets;
+    std::vector<uint_t> columns;
+    manager.sparsity_pattern(mesh, row_offsets, columns);
+
+    TrilinosEpetraMatrix mat;
+    mat.init(row_offsets, columns);
+
+    TrilinosEpetraVector x;
+    x.init(manager.n_dofs(), false);
+
+    TrilinosEpetraVector b;
+    b.init(manager.n_dofs(), false);
+
+    FVConvectionAssemblyPolicy<2> assembly;
+    assembly.build_interpolate_scheme([](){
+        return kernel::numerics::FVInterpolationFactory<2>::build(kernel::numerics::FVInterpolationType::UD);
+    });
+
+    dynamic_cast<FVUDInterpolate<2>&>(*assembly.get_interpolation()).set_velocity(velocity);
+
+    assembly.set_dof_manager(manager);
+    assembly.set_mesh(mesh);
+    assembly.set_face_geometry_cache(cache);
+    assembly.set_boundary_function(bc);
+    assembly.assemble(mat, x, b);
+
+    // pure convection
+    FVMatrixFreeOperator<2> op;
+    op.set_diffusion_coefficient(0.0);
+    op.set_velocity_function(velocity);
+    op.set_boundary_function(bc);
+    op.build(mesh, cache, manager);
+
+    assert_matches_matrix(op, mat, b);
+}
+
+#endif
+
+#endif